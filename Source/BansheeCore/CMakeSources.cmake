@@ -56,6 +56,7 @@ set(BS_BANSHEECORE_INC_CORETHREAD
 	"Include/BsCoreObjectManager.h"
 	"Include/BsCoreObject.h"
 	"Include/BsCommandQueue.h"
+	"Include/BsCommandRing.h"
 	"Include/BsCoreObjectCore.h"
 )
 
@@ -167,6 +168,7 @@ set(BS_BANSHEECORE_INC_RENDERAPI_MANAGERS
 
 set(BS_BANSHEECORE_SRC_CORETHREAD
 	"Source/BsCommandQueue.cpp"
+	"Source/BsCommandRing.cpp"
 	"Source/BsCoreObject.cpp"
 	"Source/BsCoreObjectManager.cpp"
 	"Source/BsCoreThread.cpp"
@@ -560,7 +562,6 @@ set(BS_BANSHEECORE_INC_PLATFORM
 )
 
 set(BS_BANSHEECORE_INC_PLATFORM_WIN32
-	"Include/Win32/BsWin32FolderMonitor.h"
 	"Include/Win32/BsWin32DropTarget.h"
 	"Include/Win32/BsWin32Defs.h"
 	"Include/Win32/BSWin32PlatformData.h"
@@ -577,9 +578,15 @@ set(BS_BANSHEECORE_SRC_PLATFORM_WIN32
 	"Source/Win32/BsWin32BrowseDialogs.cpp"
 )
 
+set(BS_BANSHEECORE_SRC_PLATFORM_UNIX
+	"Source/Unix/BsUnixFolderMonitor.cpp"
+)
+
 if(WIN32)
 	list(APPEND BS_BANSHEECORE_INC_PLATFORM ${BS_BANSHEECORE_INC_PLATFORM_WIN32})
 	list(APPEND BS_BANSHEECORE_SRC_PLATFORM ${BS_BANSHEECORE_SRC_PLATFORM_WIN32})
+else()
+	list(APPEND BS_BANSHEECORE_SRC_PLATFORM ${BS_BANSHEECORE_SRC_PLATFORM_UNIX})
 endif()
 
 source_group("Header Files\\Components" FILES ${BS_BANSHEECORE_INC_COMPONENTS})
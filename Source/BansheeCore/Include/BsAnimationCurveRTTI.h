@@ -5,6 +5,8 @@
 #include "BsCorePrerequisites.h"
 #include "BsRTTIType.h"
 #include "BsAnimationCurve.h"
+#include "BsVector3.h"
+#include "BsQuaternion.h"
 
 namespace bs
 {
@@ -17,6 +19,10 @@ namespace bs
 	{
 		enum { id = TID_KeyFrame }; enum { hasDynamicSize = 0 };
 
+		// Members are written in declaration order, so if the keyframe has no padding its serialized form matches its
+		// memory layout, allowing keyframe arrays to be serialized in bulk
+		enum { isMemcpy = RTTIPlainTypeIsMemcpy<T>::value != 0 && sizeof(TKeyframe<T>) == sizeof(T) * 3 + sizeof(float) };
+
 		/** @copydoc RTTIPlainType::toMemory */
 		static void toMemory(const TKeyframe<T>& data, char* memory)
 		{
@@ -45,6 +51,9 @@ namespace bs
 		}
 	};
 
+	static_assert(RTTIPlainType<TKeyframe<Vector3>>::isMemcpy != 0 && RTTIPlainType<TKeyframe<Quaternion>>::isMemcpy != 0 &&
+		RTTIPlainType<TKeyframe<float>>::isMemcpy != 0, "Keyframes of the curve types used by animation clips are expected to be serialized in bulk.");
+
 	template<class T> struct RTTIPlainType<TAnimationCurve<T>>
 	{
 		enum { id = TID_AnimationCurve }; enum { hasDynamicSize = 1 };
@@ -110,6 +110,18 @@ namespace bs
 			DataReady
 		};
 
+		/** Information about a single animation proxy that passed culling and needs to be evaluated this frame. */
+		struct EvaluatedProxy
+		{
+			AnimationProxy* proxy;
+			UINT32 boneIdx;
+			bool hasAnimInfo;
+			RendererAnimationData::AnimInfo animInfo;
+		};
+
+		/** Maximum number of animation proxies that will be evaluated by a single task. */
+		static const UINT32 PROXIES_PER_TASK = 8;
+
 		/** 
 		 * Registers a new animation and returns a unique ID for it. Must be called whenever an Animation is constructed. 
 		 */
@@ -118,9 +130,20 @@ namespace bs
 		/** Unregisters an animation with the specified ID. Must be called before an Animation is destroyed. */
 		void unregisterAnimation(UINT64 id);
 
-		/** Worker method ran on the animation thread that evaluates all animation at the provided time. */
+		/** 
+		 * Worker method ran on the animation thread that evaluates all animation at the provided time. Evaluation of
+		 * individual animations is distributed among the task scheduler workers.
+		 */
 		void evaluateAnimation();
 
+		/** 
+		 * Evaluates a single animation proxy, writing its skeleton pose into the transform buffer of @p renderData, 
+		 * and outputting the rest of the information into @p output. Only touches data owned by the proxy, and is
+		 * therefore safe to call for different proxies in parallel.
+		 */
+		void evaluateProxy(EvaluatedProxy& output, RendererAnimationData& renderData, 
+			const RendererAnimationData& prevRenderData);
+
 		UINT64 mNextId;
 		UnorderedMap<UINT64, Animation*> mAnimations;
 		
@@ -137,6 +160,7 @@ namespace bs
 		// Animation thread
 		Vector<SPtr<AnimationProxy>> mProxies;
 		Vector<ConvexVolume> mCullFrustums;
+		Vector<EvaluatedProxy> mEvaluatedProxies;
 		RendererAnimationData mAnimData[CoreThread::NUM_SYNC_BUFFERS];
 
 		UINT32 mPoseReadBufferIdx;
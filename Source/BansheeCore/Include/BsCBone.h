@@ -77,7 +77,7 @@ namespace bs
 		RTTITypeBase* getRTTI() const override;
 
 	protected:
-		CBone() {} // Serialization only
+		CBone() { setFlag(ComponentFlag::TracksModifications, true); } // Serialization only
      };
 
 	 /** @} */
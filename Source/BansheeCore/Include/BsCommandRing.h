@@ -0,0 +1,215 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "BsAsyncOp.h"
+#include <atomic>
+
+namespace bs
+{
+	/** @addtogroup CoreThread-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Command queue that records commands into a ring of pre-allocated fixed-size slots. Meant to be written to by a single
+	 * producer thread and played back by a single consumer thread. Recorded commands are not visible to the consumer until
+	 * published, and publishing or playing back commands requires no locks.
+	 *
+	 * Callables that fit in a slot are stored directly in it, so queuing a command usually requires no allocations. Larger
+	 * callables are allocated on the heap.
+	 *
+	 * @note
+	 * If the ring fills up while the consumer is idle it grows in order to fit the new commands. If the consumer is
+	 * still playing back previously published commands the producer waits for it to finish first, meaning published
+	 * commands must always eventually be played back.
+	 */
+	class BS_CORE_EXPORT CommandRing
+	{
+	public:
+		/**
+		 * Constructs a new ring.
+		 *
+		 * @param[in]	capacity	Initial number of slots in the ring. Rounded up to a power of two.
+		 */
+		CommandRing(UINT32 capacity = 1024);
+		~CommandRing();
+
+		/**
+		 * Records a new command to execute. Producer thread only.
+		 *
+		 * @param[in]	callback			Callable with signature void(), to execute on the consumer thread.
+		 * @param[in]	notifyWhenComplete	(optional) Call the notify method (provided in the call to playback()) when the
+		 *									command is complete.
+		 * @param[in]	callbackId			(optional) Identifier passed to the notify method.
+		 */
+		template<class T>
+		void queue(T&& callback, bool notifyWhenComplete = false, UINT32 callbackId = 0)
+		{
+			Command& command = allocateCommand();
+			command.setCallable<false>(std::forward<T>(callback));
+			command.notifyWhenComplete = notifyWhenComplete;
+			command.callbackId = callbackId;
+
+			mWriteIdx++;
+		}
+
+		/**
+		 * Records a new command to execute, which returns a value. Producer thread only.
+		 *
+		 * @param[in]	callback			Callable with signature void(AsyncOp&), to execute on the consumer thread. The
+		 *									callable should complete the provided async operation once done.
+		 * @param[in]	notifyWhenComplete	(optional) Call the notify method (provided in the call to playback()) when the
+		 *									command is complete.
+		 * @param[in]	callbackId			(optional) Identifier passed to the notify method.
+		 * @return							Async operation object that completes once the command executes.
+		 */
+		template<class T>
+		AsyncOp queueReturn(T&& callback, bool notifyWhenComplete = false, UINT32 callbackId = 0)
+		{
+			Command& command = allocateCommand();
+			command.setCallable<true>(std::forward<T>(callback));
+			command.asyncOp = AsyncOp(mAsyncOpSyncData);
+			command.notifyWhenComplete = notifyWhenComplete;
+			command.callbackId = callbackId;
+
+			mWriteIdx++;
+			return command.asyncOp;
+		}
+
+		/** Makes all commands recorded so far visible to the consumer thread. Producer thread only. */
+		void publish();
+
+		/** Destroys all recorded commands that haven't been published yet. Producer thread only. */
+		void cancelUnpublished();
+
+		/**
+		 * Executes all published commands in the order they were recorded. Consumer thread only.
+		 *
+		 * @param[in]	notifyCallback  	Callback that will be called for commands that have the @p notifyWhenComplete
+		 *									flag set. The callback will receive @p callbackId of the command.
+		 */
+		void playback(const std::function<void(UINT32)>& notifyCallback = nullptr);
+
+		/** Returns true if there are no commands in the ring, published or otherwise. Producer thread only. */
+		bool isEmpty() const { return mWriteIdx == mReadIdx.load(std::memory_order_acquire); }
+
+		/** Returns true if there are commands that were recorded but not yet published. Producer thread only. */
+		bool hasUnpublished() const { return mWriteIdx != mPublishedIdx.load(std::memory_order_relaxed); }
+
+		/** Returns the number of slots in the ring. Producer thread only. */
+		UINT32 getCapacity() const { return (UINT32)mCommands.size(); }
+
+	private:
+		/** Size of storage in a command slot, in bytes. Callables larger than this are allocated on the heap. */
+		static const UINT32 INLINE_STORAGE_SIZE = 64;
+
+		/** Operations on a callable stored within a command slot. */
+		template<class T, bool IsInline, bool ReturnsValue>
+		struct CallableOps
+		{
+			static T* get(void* storage) { return IsInline ? (T*)storage : *(T**)storage; }
+
+			static void invoke(T& callable, AsyncOp& op, std::true_type) { callable(op); }
+			static void invoke(T& callable, AsyncOp& op, std::false_type) { callable(); }
+
+			static void execute(void* storage, AsyncOp& op)
+			{
+				invoke(*get(storage), op, std::integral_constant<bool, ReturnsValue>());
+			}
+
+			static void destroy(void* storage)
+			{
+				if (IsInline)
+					get(storage)->~T();
+				else
+					bs_delete(get(storage));
+			}
+
+			static void relocate(void* dst, void* src)
+			{
+				if (IsInline)
+				{
+					new (dst) T(std::move(*get(src)));
+					get(src)->~T();
+				}
+				else
+					*(T**)dst = get(src);
+			}
+		};
+
+		/** A single slot in the ring. */
+		struct Command
+		{
+			Command()
+				:asyncOp(AsyncOpEmpty())
+			{ }
+
+			/** Stores the callable in the slot, either inline or on the heap, depending on its size. */
+			template<bool ReturnsValue, class T>
+			void setCallable(T&& callable)
+			{
+				typedef typename std::decay<T>::type CallableType;
+				static const bool isInline = sizeof(CallableType) <= INLINE_STORAGE_SIZE &&
+					std::alignment_of<CallableType>::value <= std::alignment_of<decltype(storage)>::value;
+
+				typedef CallableOps<CallableType, isInline, ReturnsValue> Ops;
+
+				if (isInline)
+					new (&storage) CallableType(std::forward<T>(callable));
+				else
+					*(CallableType**)&storage = bs_new<CallableType>(std::forward<T>(callable));
+
+				execute = &Ops::execute;
+				destroy = &Ops::destroy;
+				relocate = &Ops::relocate;
+				returnsValue = ReturnsValue;
+			}
+
+			/** Destroys the stored callable and releases the async operation. */
+			void clear()
+			{
+				destroy(&storage);
+				asyncOp = AsyncOp(AsyncOpEmpty());
+			}
+
+			void (*execute)(void*, AsyncOp&) = nullptr;
+			void (*destroy)(void*) = nullptr;
+			void (*relocate)(void*, void*) = nullptr;
+
+			AsyncOp asyncOp;
+			UINT32 callbackId = 0;
+			bool returnsValue = false;
+			bool notifyWhenComplete = false;
+
+			std::aligned_storage<INLINE_STORAGE_SIZE, 16>::type storage;
+		};
+
+		/** Returns the slot the next command should be written to, making room for it if needed. */
+		Command& allocateCommand()
+		{
+			if ((mWriteIdx - mReadIdx.load(std::memory_order_acquire)) == (UINT32)mCommands.size())
+				makeRoom();
+
+			return mCommands[mWriteIdx & mMask];
+		}
+
+		/**
+		 * Called when the ring is full. Waits until the consumer plays back all published commands, and grows the ring if
+		 * it is still full.
+		 */
+		void makeRoom();
+
+		Vector<Command> mCommands;
+		UINT32 mMask;
+
+		UINT32 mWriteIdx = 0; /**< Index of the next command to be recorded. Only accessed by the producer. */
+		std::atomic<UINT32> mPublishedIdx; /**< Index one past the last command the consumer is allowed to execute. */
+		std::atomic<UINT32> mReadIdx; /**< Index of the next command to be executed by the consumer. */
+
+		SPtr<AsyncOpSyncData> mAsyncOpSyncData;
+	};
+
+	/** @} */
+}
@@ -15,7 +15,12 @@ namespace bs
 	/** Flags that control behavior of a Component. */
 	enum class ComponentFlag
 	{
-		AlwaysRun = 1 /**< Ensures that scene manager cannot pause or stop component callbacks from executing. Off by default. */
+		AlwaysRun = 1, /**< Ensures that scene manager cannot pause or stop component callbacks from executing. Off by default. */
+		/** 
+		 * Component calls _markModified() whenever any of its serialized data changes, allowing systems that cache data
+		 * derived from the component to skip checking unmodified components. Off by default.
+		 */
+		TracksModifications = 2
 	};
 
 	typedef Flags<ComponentFlag> ComponentFlags;
@@ -97,6 +102,22 @@ namespace bs
 		/** Gets the currently assigned notify flags. See _setNotifyFlags(). */
 		TransformChangedFlags _getNotifyFlags() const { return mNotifyFlags; }
 
+		/** 
+		 * Notifies the component that its serialized data was modified. Must be called by components with the
+		 * ComponentFlag::TracksModifications flag whenever any of their serialized fields change.
+		 */
+		void _markModified();
+
+		/** 
+		 * Returns a counter that changes every time _markModified() is called. Counter values are unique across all 
+		 * components, so a re-created component (for example one restored through deserialization) never reports the same
+		 * value as the component it replaced.
+		 */
+		UINT64 _getModificationCount() const { return mModificationCount; }
+
+		/** Checks if the component reports all modifications to its serialized data through _markModified(). */
+		bool _tracksModifications() const { return hasFlag(ComponentFlag::TracksModifications); }
+
 		/** @} */
 	protected:
 		friend class SceneManager;
@@ -173,6 +194,7 @@ namespace bs
 
 	private:
 		HSceneObject mParent;
+		UINT64 mModificationCount;
 
 		/************************************************************************/
 		/* 								RTTI		                     		*/
@@ -5,6 +5,7 @@
 #include "BsCorePrerequisites.h"
 #include "BsCoreObjectCore.h"
 #include "BsAsyncOp.h"
+#include "BsSlotMap.h"
 
 namespace bs
 {
@@ -150,6 +151,7 @@ namespace bs
 		volatile UINT8 mFlags;
 		UINT32 mCoreDirtyFlags;
 		UINT64 mInternalID; // ID == 0 is not a valid ID
+		SlotHandle mManagerHandle; // Handle to the entry in CoreObjectManager
 		std::weak_ptr<CoreObject> mThis;
 
 		/**
@@ -5,6 +5,7 @@
 #include "BsCorePrerequisites.h"
 #include "BsCoreObjectCore.h"
 #include "BsModule.h"
+#include "BsSlotMap.h"
 
 namespace bs
 {
@@ -12,6 +13,14 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Information about the work performed by the last sync of dirty CoreObject%s to the core thread. */
+	struct CoreObjectSyncStats
+	{
+		UINT32 numObjects = 0; /**< Number of objects whose data was synced. */
+		UINT64 numBytes = 0; /**< Total size of the sync data copied for the objects, in bytes. */
+		float timeMs = 0.0f; /**< Time it took to gather the sync data, in milliseconds. */
+	};
+
 	// TODO Low priority - Add debug option that would remember a call stack for each resource initialization,
 	// so when we fail to release one we know which one it is.
 	
@@ -52,11 +61,28 @@ namespace bs
 			Vector<CoreStoredSyncObjData> entries;
 		};
 
+		/** Contains information about a registered CoreObject. */
+		struct ObjectData
+		{
+			CoreObject* object;
+			Vector<CoreObject*> dependencies; /**< Sorted list of objects this object depends on. */
+			Vector<CoreObject*> dependants;
+			UINT32 dirtyIdx; /**< Index of the object's entry in the dirty object list, or -1 if not dirty. */
+
+			/**
+			 * Length of the longest chain of dependencies below this object. Dependencies always have a lower level than
+			 * their dependants, so syncing in increasing level order syncs dependencies first.
+			 */
+			UINT32 syncLevel;
+		};
+
 		/** Contains information about a dirty CoreObject that requires syncing to the core thread. */	
 		struct DirtyObjectData
 		{
+			UINT64 id;
 			CoreObject* object;
 			INT32 syncDataId;
+			UINT32 syncLevel;
 		};
 
 	public:
@@ -93,6 +119,9 @@ namespace bs
 		 */
 		void syncToCore(CoreObject* object);
 
+		/** Returns information about the work performed by the last call to syncToCore(). */
+		CoreObjectSyncStats getSyncStats() const;
+
 	private:
 		/**
 		 * Stores all syncable data from dirty core objects into memory allocated by the provided allocator. Additional 
@@ -121,16 +150,28 @@ namespace bs
 		 */
 		void updateDependencies(CoreObject* object, Vector<CoreObject*>* dependencies);
 
+		/** Adds the object to the dirty object list, unless it is already in it. */
+		void queueDirty(ObjectData& data);
+
+		/** Recalculates sync levels for all objects. Called after object dependencies change. */
+		void updateSyncLevels();
+
+		/** Calculates the sync level of the object, and of all of its dependencies whose level is not yet known. */
+		UINT32 calculateSyncLevel(ObjectData& data);
+
+		static const UINT32 SYNC_LEVEL_UNKNOWN = (UINT32)-1;
+		static const UINT32 SYNC_LEVEL_VISITING = (UINT32)-2;
+
 		UINT64 mNextAvailableID;
-		Map<UINT64, CoreObject*> mObjects;
-		Map<UINT64, DirtyObjectData> mDirtyObjects;
-		Map<UINT64, Vector<CoreObject*>> mDependencies;
-		Map<UINT64, Vector<CoreObject*>> mDependants;
+		SlotMap<ObjectData> mObjects;
+		Vector<DirtyObjectData> mDirtyObjects; /**< Unordered, entries with null object and no sync data are skipped. */
+		bool mSyncLevelsDirty;
+		CoreObjectSyncStats mSyncStats;
 
 		Vector<CoreStoredSyncObjData> mDestroyedSyncData;
 		List<CoreStoredSyncData> mCoreSyncData;
 
-		Mutex mObjectsMutex;
+		mutable Mutex mObjectsMutex;
 	};
 
 	/** @} */
@@ -51,7 +51,9 @@ namespace bs
 	 *    - Core thread continually polls the internal command queue for new commands, and executes them in order they were
 	 *      submitted.
 	 *    - Commands queued on the per-thread queues are submitted to the internal command queue by calling submit(), at
-	 *      which point they are made visible to the core thread, and will begin executing.
+	 *      which point they are made visible to the core thread, and will begin executing. Each thread must submit its
+	 *      own queue, submitAll() only submits the calling thread's queue. Commands queued by a TaskScheduler task are
+	 *      submitted automatically once the task finishes, if the task didn't submit them itself.
 	 * 	  - Commands can also be submitted directly to the internal command queue (via a special flag), but with a 
 	 * 	    performance cost due to extra synchronization required.
 	 */
@@ -79,7 +81,16 @@ namespace bs
 		/** Returns the id of the core thread.  */
 		ThreadId getCoreThreadId() { return mCoreThreadId; }
 
-		/** Submits the commands from all queues and starts executing them on the core thread. */
+		/**
+		 * Submits the commands from the current thread's queue, and starts executing them along with commands previously
+		 * submitted from other threads' queues on the core thread.
+		 *
+		 * @note	
+		 * Commands queued on other threads are only executed once those threads call submit() themselves, as queues
+		 * are recorded without synchronization and can only be submitted by the thread that owns them. Tasks executed by
+		 * the TaskScheduler submit their commands when they finish, so commands of any task that completed before this
+		 * call are executed.
+		 */
 		void submitAll(bool blockUntilComplete = false);
 
 		/** Submits the commands from the current thread's queue and starts executing them on the core thread. */
@@ -183,6 +194,12 @@ namespace bs
 		/** Creates or retrieves a queue for the calling thread. */
 		SPtr<TCoreThreadQueue<CommandQueueNoSync>> getQueue();
 
+		/** 
+		 * Submits any commands the calling worker thread queued but didn't submit. Called by the TaskScheduler whenever a
+		 * task finishes.
+		 */
+		static void submitTaskCommands();
+
 		/**
 		 * Blocks the calling thread until the command with the specified ID completes. Make sure that the specified ID 
 		 * actually exists, otherwise this will block forever.
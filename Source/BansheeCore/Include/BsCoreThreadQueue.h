@@ -4,6 +4,7 @@
 
 #include "BsCorePrerequisites.h"
 #include "BsCommandQueue.h"
+#include "BsCommandRing.h"
 #include "BsAsyncOp.h"
 
 namespace bs
@@ -16,7 +17,7 @@ namespace bs
 	class BS_CORE_EXPORT CoreThreadQueueBase
 	{
 	public:
-		CoreThreadQueueBase(CommandQueueBase* commandQueue);
+		CoreThreadQueueBase(ThreadId threadId);
 		virtual ~CoreThreadQueueBase();
 
 		/**
@@ -28,9 +29,28 @@ namespace bs
 		/** Queues a new generic command that will be added to the command queue. */
 		void queueCommand(std::function<void()> commandCallback);
 
+		/** 
+		 * Queues a new generic command that will be added to the command queue. Same as queueCommand(), except that the
+		 * callable is stored directly in the command queue instead of being wrapped in a std::function first. 
+		 *
+		 * @param[in]	commandCallback		Callable with signature void().
+		 */
+		template<class T>
+		void queue(T&& commandCallback)
+		{
+			checkThread();
+			mCommands.queue(std::forward<T>(commandCallback));
+
+#if BS_FORCE_SINGLETHREADED_RENDERING
+			mCommands.publish();
+			mCommands.playback();
+#endif
+		}
+
 		/**
 		 * Makes all the currently queued commands available to the core thread. They will be executed as soon as the core 
-		 * thread is ready. All queued commands are removed from the queue.
+		 * thread is ready. All queued commands are removed from the queue. Must be called from the thread that created
+		 * the queue.
 		 *
 		 * @param[in]	blockUntilComplete	If true, the calling thread will block until the core thread finished executing
 		 *									all currently queued commands. This is usually very expensive and should only be
@@ -38,18 +58,44 @@ namespace bs
 		 */
 		void submitToCoreThread(bool blockUntilComplete = false);
 
-		/** Cancels all commands in the queue. */
+		/**
+		 * Executes commands that were already made available by the thread that created the queue, through a previous
+		 * call to submitToCoreThread(). Unlike submitToCoreThread() this may be called from any thread, as it never makes
+		 * new commands visible to the core thread.
+		 *
+		 * @param[in]	blockUntilComplete	If true, the calling thread will block until the core thread finished executing
+		 *									the commands.
+		 */
+		void playbackSubmitted(bool blockUntilComplete = false);
+
+		/** Cancels all commands in the queue that haven't been submitted yet. */
 		void cancelAll();
 
+		/** Returns true if there are queued commands that haven't been submitted yet. */
+		bool hasUnsubmitted() const { checkThread(); return mCommands.hasUnpublished(); }
+
 	private:
-		CommandQueueBase* mCommandQueue;
+		/** Asserts that the queue is being accessed from the thread that created it. Does nothing in release builds. */
+		void checkThread() const
+		{
+#if BS_DEBUG_MODE
+#if BS_THREAD_SUPPORT != 0
+			assert(BS_THREAD_CURRENT_ID == mThreadId && "Core thread queue accessed outside of its creation thread.");
+#endif
+#endif
+		}
+
+		CommandRing mCommands;
+		ThreadId mThreadId;
 	};
 
 	/**
 	 * Queue that allows the calling thread to queue commands for execution on the core thread. Commands will only be
 	 * executed after they have been submitted to the core thread.
 	 * 			
-	 * @note	Queued commands are only executed after the call to submitToCoreThread(), in the order they were submitted.
+	 * @note	
+	 * Queued commands are only executed after the call to submitToCoreThread(), in the order they were submitted. Each
+	 * queue must only be used from the thread that created it, as commands are recorded without synchronization.
 	 */
 	template <class CommandQueueSyncPolicy = CommandQueueNoSync>
 	class BS_CORE_EXPORT TCoreThreadQueue : public CoreThreadQueueBase
@@ -61,7 +107,7 @@ namespace bs
 		 * @param[in]	threadId		Identifier for the thread that created the queue.
 		 */
 		TCoreThreadQueue(ThreadId threadId)
-			:CoreThreadQueueBase(bs_new<CommandQueue<CommandQueueSyncPolicy>>(threadId))
+			:CoreThreadQueueBase(threadId)
 		{ }
 	};
 
@@ -36,6 +36,7 @@ namespace bs
 	 */
 	class BS_CORE_EXPORT GameObjectManager : public Module<GameObjectManager>
 	{
+	public:
 		/**	Contains data for an yet unresolved game object handle. */
 		struct UnresolvedHandle
 		{
@@ -43,7 +44,6 @@ namespace bs
 			GameObjectHandleBase handle;
 		};
 
-	public:
 		GameObjectManager();
 		~GameObjectManager();
 
@@ -137,14 +137,25 @@ namespace bs
 		UINT32 getDeserializationFlags() const { return mGODeserializationMode; }
 
 	private:
+		/**
+		 * Finds the object that handles deserialized with the provided original ID should be resolved to. Game object
+		 * deserialization must be active.
+		 *
+		 * @param[in]	originalId	ID of the object the handles were pointing to when they were serialized.
+		 * @param[in]	flags		Flags that control how are the handles resolved. See GameObjectHandleDeserializationMode.
+		 * @param[out]	object		Object the handles should point to, or null if the handles should be cleared.
+		 * @return					False if the handles should be left as they are, true otherwise.
+		 */
+		bool findDeserializedObject(UINT64 originalId, UINT32 flags, const GameObjectHandleBase*& object) const;
+
 		UINT64 mNextAvailableID; // 0 is not a valid ID
-		Map<UINT64, GameObjectHandleBase> mObjects;
+		UnorderedMap<UINT64, GameObjectHandleBase> mObjects;
 		Map<UINT64, GameObjectHandleBase> mQueuedForDestroy;
 
 		GameObject* mActiveDeserializedObject;
 		bool mIsDeserializationActive;
-		Map<UINT64, UINT64> mIdMapping;
-		Map<UINT64, SPtr<GameObjectHandleData>> mUnresolvedHandleData;
+		UnorderedMap<UINT64, UINT64> mIdMapping;
+		UnorderedMap<UINT64, SPtr<GameObjectHandleData>> mUnresolvedHandleData;
 		Vector<UnresolvedHandle> mUnresolvedHandles;
 		Vector<std::function<void()>> mEndCallbacks;
 		UINT32 mGODeserializationMode;
@@ -66,6 +66,15 @@ namespace bs
 		 */
 		void setExternalBuffer(UINT8* data);
 
+		/**
+		 * Makes the internal data pointer point to memory owned by the provided stream, such as a file mapped into memory.
+		 * No copying is done, and the stream is kept alive for as long as this object (or any of its copies) references
+		 * the data.
+		 *
+		 * @note	If any internal data is allocated, it is freed.
+		 */
+		void setExternalBuffer(UINT8* data, const SPtr<DataStream>& owner);
+
 		/** Checks if the internal buffer is locked due to some other thread using it. */
 		bool isLocked() const { return mLocked; }
 
@@ -84,6 +93,7 @@ namespace bs
 
 	private:
 		UINT8* mData;
+		SPtr<DataStream> mDataOwner;
 		bool mOwnsData;
 		mutable bool mLocked;
 
@@ -137,6 +137,18 @@ namespace bs
 		/** Alternative to importAll() which doesn't create resource handles, but instead returns raw resource pointers. */
 		Vector<SubResourceRaw> _importAllRaw(const Path& inputFilePath, SPtr<const ImportOptions> importOptions = nullptr);
 
+		/**
+		 * Checks can _importAllRaw() be called for the provided file from a thread other than the main thread, 
+		 * concurrently with other imports.
+		 */
+		bool _supportsConcurrentImport(const Path& inputFilePath) const;
+
+		/** 
+		 * Returns the version of the importer used for importing the provided file (see SpecificImporter::getVersion()).
+		 * Returns 0 if there is no importer for the file.
+		 */
+		UINT32 _getImporterVersion(const Path& inputFilePath) const;
+
 		/** @} */
 	private:
 		/** 
@@ -13,13 +13,15 @@ namespace bs
 	 *  @{
 	 */
 
+	BS_ALLOW_MEMCPY_SERIALIZATION(MorphVertex);
+
 	class BS_CORE_EXPORT MorphShapeRTTI : public RTTIType <MorphShape, IReflectable, MorphShapeRTTI>
 	{
 	private:
 		BS_BEGIN_RTTI_MEMBERS
 			BS_RTTI_MEMBER_PLAIN(mName, 0)
 			BS_RTTI_MEMBER_PLAIN(mWeight, 1)
-			BS_RTTI_MEMBER_PLAIN_ARRAY(mVertices, 2)
+			BS_RTTI_MEMBER_PLAIN_ARRAY_BULK(mVertices, 2)
 		BS_END_RTTI_MEMBERS
 		
 	public:
@@ -104,8 +106,6 @@ namespace bs
 		}
 	};
 
-	BS_ALLOW_MEMCPY_SERIALIZATION(MorphVertex);
-
 	/** @} */
 	/** @endcond */
 }
\ No newline at end of file
@@ -52,6 +52,16 @@ namespace bs
 
 		void setData(PixelData* obj, const SPtr<DataStream>& value, UINT32 size)
 		{
+			// Reference the data directly if it was loaded from a file mapped into memory
+			if (value->isMapped())
+			{
+				SPtr<MemoryDataStream> memStream = std::static_pointer_cast<MemoryDataStream>(value);
+				obj->setExternalBuffer(memStream->getCurrentPtr(), value);
+				value->skip(size);
+
+				return;
+			}
+
 			obj->allocateInternalBuffer(size);
 			value->read(obj->getData(), size);
 		}
@@ -93,6 +93,26 @@ namespace bs
 		 */
 		static SPtr<PrefabDiff> create(const HSceneObject& prefab, const HSceneObject& instance);
 
+		/**
+		 * Creates a new prefab diff by comparing the provided instanced scene object hierarchy with the prefab scene 
+		 * object hierarchy. Data cached by a diff previously created for the same instance is reused, so that only the
+		 * components modified since then (or since the prefab changed) need to be diffed again.
+		 *
+		 * Components with the ComponentFlag::TracksModifications flag that weren't modified since the previous diff are
+		 * skipped entirely. Other components are still serialized on each call, since their modifications are detected by
+		 * comparing a hash of their serialized data with the cached hash. For them the cache only saves the field-by-field
+		 * diff of unmodified components, and serialization of their prefab counterparts.
+		 *
+		 * @param[in]	prefab		Root of the prefab scene object hierarchy.
+		 * @param[in]	instance	Root of the prefab instance to compare with the prefab.
+		 * @param[in]	prefabHash	Hash of the prefab resource, as returned by Prefab::getHash(). Cached data is only
+		 *							reused if the hash matches the one it was created with.
+		 * @param[in]	previous	Diff previously created for the same instance. Can be null. The cached data is moved
+		 *							from this diff into the returned one.
+		 */
+		static SPtr<PrefabDiff> create(const HSceneObject& prefab, const HSceneObject& instance, UINT32 prefabHash,
+			const SPtr<PrefabDiff>& previous);
+
 		/**
 		 * Applies the internal prefab diff to the provided object. The object should have similar hierarchy as the prefab
 		 * the diff was created for, otherwise the results are undefined.
@@ -103,7 +123,48 @@ namespace bs
 		 */
 		void apply(const HSceneObject& object);
 
+		/**
+		 * Applies a set of diffs to their respective objects, same as calling apply() for each pair. Game object handles
+		 * referenced by the diffs are resolved once, after all of the diffs are applied, making this method preferable
+		 * when updating many prefab instances at once.
+		 */
+		static void apply(const Vector<std::pair<SPtr<PrefabDiff>, HSceneObject>>& diffs);
+
+		/** 
+		 * Returns differences for the root scene object, or null if the instance is identical to the prefab.
+		 *
+		 * @note	Internal method.
+		 */
+		SPtr<PrefabObjectDiff> _getRoot() const { return mRoot; }
+
 	private:
+		/** Component data cached from the last time a diff was generated for the component. */
+		struct CachedComponentDiff
+		{
+			String prefabHash;
+			String instanceHash;
+			UINT64 instanceModificationCount = 0;
+			String instanceName;
+			SPtr<SerializedObject> diff;
+		};
+
+		/** 
+		 * Data cached during diff generation, used for speeding up later diff generation for the same prefab instance. 
+		 * Components are only diffed if the hash of their serialized data differs from the hash they had when the diff
+		 * was last generated. Cached data is valid as long as the prefab and the mapping between prefab and instance IDs 
+		 * remains unchanged.
+		 */
+		struct DiffCache
+		{
+			String prefabUUID;
+			UINT32 prefabHash = 0;
+			Vector<UINT64> renamedIds;
+			UnorderedMap<UINT32, CachedComponentDiff> components;
+
+			/** Entries from the previous diff generation, only populated while a new diff is being generated. */
+			UnorderedMap<UINT32, CachedComponentDiff> prevComponents;
+		};
+
 		/** A reference to a renamed game object instance data, and its original ID so it may be restored later. */
 		struct RenamedGameObject
 		{
@@ -116,7 +177,16 @@ namespace bs
 		 *
 		 * @see		create
 		 */
-		static SPtr<PrefabObjectDiff> generateDiff(const HSceneObject& prefab, const HSceneObject& instance);
+		static SPtr<PrefabObjectDiff> generateDiff(const HSceneObject& prefab, const HSceneObject& instance, 
+			DiffCache* cache);
+
+		/**
+		 * Generates differences between a component in the prefab and its instanced version. Returns null if the
+		 * components are identical. Data in @p cache is used if present, and is updated with the generated
+		 * data. If @p cache is null the components are always diffed.
+		 */
+		static SPtr<SerializedObject> generateComponentDiff(const HComponent& prefab, const HComponent& instance,
+			DiffCache* cache);
 
 		/**
 		 * Recursively applies a per-object set of prefab differences to a specific object.
@@ -147,6 +217,7 @@ namespace bs
 		static void restoreInstanceIds(const Vector<RenamedGameObject>& renamedObjects);
 
 		SPtr<PrefabObjectDiff> mRoot;
+		SPtr<DiffCache> mCache;
 
 		/************************************************************************/
 		/* 								RTTI		                     		*/
@@ -61,6 +61,14 @@ namespace bs
 			UINT32 numInternalRefs;
 		};
 
+		/** Information about an asynchronous load waiting to be started. */
+		struct QueuedLoad
+		{
+			Path filePath;
+			HResource resource;
+			bool loadWithSaveData;
+		};
+
 		/** Information about a resource that's currently being loaded. */
 		struct ResourceLoadData
 		{
@@ -73,6 +81,13 @@ namespace bs
 			UINT32 remainingDependencies;
 			Vector<HResource> dependencies;
 			bool notifyImmediately;
+
+			/** 
+			 * Asynchronous file read of the resource, held back until all of its dependencies finish loading so that
+			 * dependencies are always deserialized before the resources that reference them.
+			 */
+			QueuedLoad pendingLoad;
+			bool hasPendingLoad = false;
 		};
 
 	public:
@@ -221,6 +236,20 @@ namespace bs
 		 */
 		bool isLoaded(const String& uuid, bool checkInProgress = true);
 
+		/**
+		 * Sets the maximum number of resources that can be read and deserialized on worker threads at once. Any further
+		 * asynchronous loads are queued and started as the previous ones finish, in the order they were requested (which
+		 * ensures dependencies start loading before the resources that depend on them). Limiting this can improve load 
+		 * times on storage that performs poorly under concurrent access (e.g. hard drives).
+		 *
+		 * @param[in]	count	Maximum number of simultaneous loads, or 0 for no limit (the default). Synchronous loads
+		 *						are never limited.
+		 */
+		void setMaxConcurrentLoads(UINT32 count);
+
+		/** Returns the maximum number of resources loaded simultaneously. 0 if unlimited. */
+		UINT32 getMaxConcurrentLoads() const { return mMaxConcurrentLoads; }
+
 		/**
 		 *Allows you to set a resource manifest containing UUID <-> file path mapping that is used when resolving 
 		 * resource references.
@@ -311,12 +340,28 @@ namespace bs
 		/** Performs actually reading and deserializing of the resource file. Called from various worker threads. */
 		SPtr<Resource> loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData);
 
-		/**	Triggered when individual resource has finished loading. */
+		/**	
+		 * Triggered when individual resource has finished loading. Queues the file reads of any dependant resources
+		 * that were waiting on this resource as their last remaining dependency.
+		 */
 		void loadComplete(HResource& resource);
 
 		/**	Callback triggered when the task manager is ready to process the loading task. */
 		void loadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData);
 
+		/** 
+		 * Queues an asynchronous load of a resource on a worker thread. The load is started immediately unless the limit
+		 * set by setMaxConcurrentLoads() has been reached. Should only be called once all of the resource's dependencies
+		 * have finished loading.
+		 */
+		void queueAsyncLoad(const Path& filePath, const HResource& resource, bool loadWithSaveData);
+
+		/** Starts queued asynchronous loads, until the concurrent load limit is reached or the queue is empty. */
+		void startQueuedLoads();
+
+		/**	Callback triggered when the task manager is ready to process an asynchronous loading task. */
+		void asyncLoadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData);
+
 		/**	Destroys a resource, freeing its memory. */
 		void destroy(ResourceHandleBase& resource);
 
@@ -331,6 +376,11 @@ namespace bs
 		UnorderedMap<String, LoadedResourceData> mLoadedResources;
 		UnorderedMap<String, ResourceLoadData*> mInProgressResources; // Resources that are being asynchronously loaded
 		UnorderedMap<String, Vector<ResourceLoadData*>> mDependantLoads; // Allows dependency to be notified when a dependant is loaded
+
+		Mutex mQueuedLoadsMutex;
+		Queue<QueuedLoad> mQueuedLoads;
+		UINT32 mNumActiveLoads = 0;
+		UINT32 mMaxConcurrentLoads = 0;
 	};
 
 	/** Provides easier access to Resources manager. */
@@ -28,7 +28,10 @@ namespace bs
 		/**	Returns true if this resource is allow to be asynchronously loaded. */
 		bool allowAsyncLoading() const { return mAllowAsync; }
 
-		/** Returns the method used for compressing the resource. 0 if none. */
+		/** 
+		 * Returns the method used for compressing the resource. 0 if none, 1 if compressed as a single block using
+		 * Compression::compress(), or 2 if compressed using Compression::compressChunked().
+		 */
 		UINT32 getCompressionMethod() const { return mCompressionMethod; }
 
 	private:
@@ -5,6 +5,7 @@
 #include "BsCorePrerequisites.h"
 #include "BsModule.h"
 #include "BsGameObject.h"
+#include "BsSlotMap.h"
 
 namespace bs
 {
@@ -98,7 +99,7 @@ namespace bs
 		bool isRunning() const { return mComponentState == ComponentState::Running; }
 
 		/** Returns all cameras in the scene. */
-		const Map<Camera*, SceneCameraData>& getAllCameras() const { return mCameras; }
+		const SlotMap<SceneCameraData>& getAllCameras() const { return mCameras; }
 
 		/**
 		 * Returns the camera in the scene marked as main. Main camera controls the final render surface that is displayed
@@ -112,8 +113,19 @@ namespace bs
 		 */
 		void setMainRenderTarget(const SPtr<RenderTarget>& rt);
 
+		/**
+		 * Enables or disables batched world transform updates. When enabled, scene objects whose transforms change are
+		 * recorded and have their world transforms updated all at once at the end of the frame, sorted so that parents
+		 * are always updated before their children, with objects at the same depth updated in parallel. When disabled,
+		 * world transforms are only updated lazily when queried. Disabled by default.
+		 */
+		void setBatchedTransformUpdates(bool enabled);
+
+		/** Checks are batched world transform updates enabled. See setBatchedTransformUpdates(). */
+		bool getBatchedTransformUpdates() const { return mBatchedTransformUpdates; }
+
 		/**	Returns all renderables in the scene. */
-		const Map<Renderable*, SceneRenderableData>& getAllRenderables() const { return mRenderables; }
+		const SlotMap<SceneRenderableData>& getAllRenderables() const { return mRenderables; }
 
 		/** Notifies the scene manager that a new renderable was created. */
 		void _registerRenderable(const SPtr<Renderable>& renderable, const HSceneObject& so);
@@ -148,9 +160,24 @@ namespace bs
 		/** Called every frame. Calls update methods on all scene objects and their components. */
 		void _update();
 
-		/** Updates dirty transforms on any core objects that may be tied with scene objects. */
+		/** 
+		 * Updates dirty transforms on any core objects that may be tied with scene objects. If batched transform updates
+		 * are enabled, updates the world transforms of all modified scene objects first.
+		 */
 		void _updateCoreObjectTransforms();
 
+		/** 
+		 * Updates world transforms of all scene objects queued by _queueTransformUpdate(), as well as their children. 
+		 * Objects are processed one hierarchy depth at a time, in parallel within the same depth.
+		 */
+		void _updateWorldTransforms();
+
+		/** 
+		 * Queues a scene object whose transform was modified for the next _updateWorldTransforms() call. Only used when
+		 * batched transform updates are enabled.
+		 */
+		void _queueTransformUpdate(const HSceneObject& so);
+
 		/** Notifies the manager that a new component has just been created. The manager triggers necessary callbacks. */
 		void _notifyComponentCreated(const HComponent& component, bool parentActive);
 
@@ -209,12 +236,17 @@ namespace bs
 	protected:
 		HSceneObject mRootNode;
 
-		Map<Camera*, SceneCameraData> mCameras;
-		Vector<SceneCameraData> mMainCameras;
+		SlotMap<SceneCameraData> mCameras;
+		SlotMap<SceneRenderableData> mRenderables;
+		SlotMap<SceneLightData> mLights;
+		SlotMap<SceneReflectionProbeData> mReflectionProbes;
+
+		UnorderedMap<Camera*, SlotHandle> mCameraHandles;
+		UnorderedMap<Renderable*, SlotHandle> mRenderableHandles;
+		UnorderedMap<Light*, SlotHandle> mLightHandles;
+		UnorderedMap<ReflectionProbe*, SlotHandle> mReflectionProbeHandles;
 
-		Map<Renderable*, SceneRenderableData> mRenderables;
-		Map<Light*, SceneLightData> mLights;
-		Map<ReflectionProbe*, SceneReflectionProbeData> mReflectionProbes;
+		Vector<SceneCameraData> mMainCameras;
 
 		Vector<HComponent> mActiveComponents;
 		Vector<HComponent> mInactiveComponents;
@@ -224,6 +256,11 @@ namespace bs
 		HEvent mMainRTResizedConn;
 
 		ComponentState mComponentState = ComponentState::Running;
+
+		bool mBatchedTransformUpdates = false;
+		Vector<HSceneObject> mDirtyTransforms;
+		Vector<SceneObject*> mTransformUpdateQueue; /**< Dirty objects sorted by depth relative to their dirty root. */
+		Vector<UINT32> mTransformUpdateLevels; /**< Offsets of each depth level in mTransformUpdateQueue. */
 	};
 
 	/**	Provides easy access to the SceneManager. */
@@ -39,7 +39,8 @@ namespace bs
 		enum DirtyFlags
 		{
 			LocalTfrmDirty = 0x01,
-			WorldTfrmDirty = 0x02
+			WorldTfrmDirty = 0x02,
+			QueuedForUpdate = 0x04 /**< Object is queued for the batched transform update in SceneManager. */
 		};
 
 		friend class SceneManager;
@@ -70,6 +70,19 @@ namespace bs
 		 */
 		virtual SPtr<ImportOptions> createImportOptions() const;
 
+		/**
+		 * Checks can import() and importAll() be safely called from multiple threads at once. Importers that rely on
+		 * third party libraries with global state should leave this as false, in which case imports using this importer
+		 * are always performed on the calling thread.
+		 */
+		virtual bool isThreadSafe() const { return false; }
+
+		/** 
+		 * Returns the version of the importer. Should be incremented whenever a change to the importer changes the
+		 * resources it outputs, so that previously cached import results get discarded.
+		 */
+		virtual UINT32 getVersion() const { return 0; }
+
 		/**
 		 * Gets the default import options.
 		 *
@@ -13,6 +13,7 @@ namespace bs
 		: Component(parent)
 	{
 		setName("Bone");
+		setFlag(ComponentFlag::TracksModifications, true);
 
 		mNotifyFlags = TCF_Parent;
 	}
@@ -23,6 +24,7 @@ namespace bs
 			return;
 
 		mBoneName = name;
+		_markModified();
 
 		if (mParent != nullptr)
 			mParent->_notifyBoneChanged(getHandle());
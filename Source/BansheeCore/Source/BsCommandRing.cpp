@@ -0,0 +1,113 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsCommandRing.h"
+#include "BsBitwise.h"
+#include "BsDebug.h"
+
+namespace bs
+{
+	CommandRing::CommandRing(UINT32 capacity)
+		:mPublishedIdx(0), mReadIdx(0)
+	{
+		capacity = Bitwise::nextPow2(std::max(capacity, 2U));
+
+		mCommands.resize(capacity);
+		mMask = capacity - 1;
+
+		mAsyncOpSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
+	}
+
+	CommandRing::~CommandRing()
+	{
+		// Published commands that were never played back are discarded along with the unpublished ones
+		UINT32 readIdx = mReadIdx.load(std::memory_order_acquire);
+		for (UINT32 i = readIdx; i != mWriteIdx; i++)
+			mCommands[i & mMask].clear();
+	}
+
+	void CommandRing::publish()
+	{
+		mPublishedIdx.store(mWriteIdx, std::memory_order_release);
+	}
+
+	void CommandRing::cancelUnpublished()
+	{
+		// Note that this won't free any Frame data allocated for the canceled commands, since frame data will only get
+		// cleared at frame start
+		UINT32 publishedIdx = mPublishedIdx.load(std::memory_order_relaxed);
+		for (UINT32 i = publishedIdx; i != mWriteIdx; i++)
+			mCommands[i & mMask].clear();
+
+		mWriteIdx = publishedIdx;
+	}
+
+	void CommandRing::playback(const std::function<void(UINT32)>& notifyCallback)
+	{
+		UINT32 publishedIdx = mPublishedIdx.load(std::memory_order_acquire);
+		UINT32 readIdx = mReadIdx.load(std::memory_order_relaxed);
+
+		while (readIdx != publishedIdx)
+		{
+			Command& command = mCommands[readIdx & mMask];
+			command.execute(&command.storage, command.asyncOp);
+
+			if (command.returnsValue && !command.asyncOp.hasCompleted())
+			{
+				LOGDBG("Async operation return value wasn't resolved properly. Resolving automatically to nullptr. " \
+					"Make sure to complete the operation before returning from the command callback method.");
+				command.asyncOp._completeOperation(nullptr);
+			}
+
+			if (command.notifyWhenComplete && notifyCallback != nullptr)
+				notifyCallback(command.callbackId);
+
+			command.clear();
+
+			// Release the slot back to the producer
+			readIdx++;
+			mReadIdx.store(readIdx, std::memory_order_release);
+		}
+	}
+
+	void CommandRing::makeRoom()
+	{
+		// Wait for the consumer to play back any published commands, after which it no longer touches the ring until the
+		// next publish, and the ring can be safely resized
+		UINT32 publishedIdx = mPublishedIdx.load(std::memory_order_relaxed);
+		UINT32 readIdx = mReadIdx.load(std::memory_order_acquire);
+		while (readIdx != publishedIdx)
+		{
+			if ((mWriteIdx - readIdx) < (UINT32)mCommands.size())
+				return;
+
+			std::this_thread::yield();
+			readIdx = mReadIdx.load(std::memory_order_acquire);
+		}
+
+		if ((mWriteIdx - readIdx) < (UINT32)mCommands.size())
+			return;
+
+		// Ring is full of unpublished commands, grow it
+		UINT32 newCapacity = (UINT32)mCommands.size() * 2;
+		UINT32 newMask = newCapacity - 1;
+
+		Vector<Command> newCommands(newCapacity);
+		for (UINT32 i = readIdx; i != mWriteIdx; i++)
+		{
+			Command& src = mCommands[i & mMask];
+			Command& dst = newCommands[i & newMask];
+
+			src.relocate(&dst.storage, &src.storage);
+			dst.execute = src.execute;
+			dst.destroy = src.destroy;
+			dst.relocate = src.relocate;
+			dst.asyncOp = std::move(src.asyncOp);
+			dst.callbackId = src.callbackId;
+			dst.returnsValue = src.returnsValue;
+			dst.notifyWhenComplete = src.notifyWhenComplete;
+		}
+
+		mCommands.swap(newCommands);
+		mMask = newMask;
+	}
+}
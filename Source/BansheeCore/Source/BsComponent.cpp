@@ -6,12 +6,15 @@
 
 namespace bs
 {
+	/** Source of component modification counter values, shared by all components so that values are never reused. */
+	static std::atomic<UINT64> sNextModificationCount { 1 };
+
 	Component::Component()
-		:mNotifyFlags(TCF_None), mSceneManagerId(-1)
+		:mNotifyFlags(TCF_None), mSceneManagerId(-1), mModificationCount(sNextModificationCount++)
 	{ }
 
 	Component::Component(const HSceneObject& parent)
-		:mNotifyFlags(TCF_None), mParent(parent), mSceneManagerId(-1)
+		:mNotifyFlags(TCF_None), mSceneManagerId(-1), mParent(parent), mModificationCount(sNextModificationCount++)
 	{
 		setName("Component");
 	}
@@ -21,6 +24,11 @@ namespace bs
 
 	}
 
+	void Component::_markModified()
+	{
+		mModificationCount = sNextModificationCount++;
+	}
+
 	bool Component::typeEquals(const Component& other)
 	{
 		return getRTTI()->getRTTIId() == other.getRTTI()->getRTTIId();
@@ -7,11 +7,13 @@
 #include "BsMath.h"
 #include "BsFrameAlloc.h"
 #include "BsCoreThread.h"
+#include "BsProfilerCPU.h"
+#include "BsTime.h"
 
 namespace bs
 {
 	CoreObjectManager::CoreObjectManager()
-		:mNextAvailableID(1)
+		:mNextAvailableID(1), mSyncLevelsDirty(false)
 	{
 
 	} 
@@ -39,10 +41,17 @@ namespace bs
 
 		Lock lock(mObjectsMutex);
 
-		mObjects[mNextAvailableID] = object;
-		mDirtyObjects[mNextAvailableID] = { object, -1 };
+		UINT64 id = mNextAvailableID++;
 
-		return mNextAvailableID++;
+		ObjectData data;
+		data.object = object;
+		data.dirtyIdx = (UINT32)mDirtyObjects.size();
+		data.syncLevel = 0;
+
+		object->mManagerHandle = mObjects.insert(std::move(data));
+		mDirtyObjects.push_back({ id, object, -1, 0 });
+
+		return id;
 	}
 
 	void CoreObjectManager::unregisterObject(CoreObject* object)
@@ -54,30 +63,30 @@ namespace bs
 		// If dirty, we generate sync data before it is destroyed
 		{
 			Lock lock(mObjectsMutex);
-			bool isDirty = object->isCoreDirty() || (mDirtyObjects.find(internalId) != mDirtyObjects.end());
+
+			ObjectData& data = mObjects[object->mManagerHandle];
+			bool isDirty = object->isCoreDirty() || data.dirtyIdx != (UINT32)-1;
 
 			if (isDirty)
 			{
+				INT32 syncDataId = -1;
+
 				SPtr<ct::CoreObject> coreObject = object->getCore();
 				if (coreObject != nullptr)
 				{
 					CoreSyncData objSyncData = object->syncToCore(gCoreThread().getFrameAlloc());
 				
 					mDestroyedSyncData.push_back(CoreStoredSyncObjData(coreObject, internalId, objSyncData));
-
-					DirtyObjectData& dirtyObjData = mDirtyObjects[internalId];
-					dirtyObjData.syncDataId = (INT32)mDestroyedSyncData.size() - 1;
-					dirtyObjData.object = nullptr;
+					syncDataId = (INT32)mDestroyedSyncData.size() - 1;
 				}
-				else
-				{
-					DirtyObjectData& dirtyObjData = mDirtyObjects[internalId];
-					dirtyObjData.syncDataId = -1;
-					dirtyObjData.object = nullptr;
-				}
-			}
 
-			mObjects.erase(internalId);
+				queueDirty(data);
+
+				DirtyObjectData& dirtyObjData = mDirtyObjects[data.dirtyIdx];
+				dirtyObjData.syncDataId = syncDataId;
+				dirtyObjData.syncLevel = data.syncLevel;
+				dirtyObjData.object = nullptr;
+			}
 		}
 
 		updateDependencies(object, nullptr);
@@ -86,40 +95,75 @@ namespace bs
 		{
 			Lock lock(mObjectsMutex);
 
-			auto iterFind = mDependants.find(internalId);
-			if (iterFind != mDependants.end())
+			ObjectData& data = mObjects[object->mManagerHandle];
+			for (auto& entry : data.dependants)
 			{
-				Vector<CoreObject*>& dependants = iterFind->second;
-				for (auto& entry : dependants)
-				{
-					auto iterFind2 = mDependencies.find(entry->getInternalID());
-					if (iterFind2 != mDependencies.end())
-					{
-						Vector<CoreObject*>& dependencies = iterFind2->second;
-						auto iterFind3 = std::find(dependencies.begin(), dependencies.end(), object);
-
-						if (iterFind3 != dependencies.end())
-							dependencies.erase(iterFind3);
-
-						if (dependencies.size() == 0)
-							mDependencies.erase(iterFind2);
-					}
-				}
+				ObjectData* dependantData = mObjects.find(entry->mManagerHandle);
+				if (dependantData == nullptr)
+					continue;
 
-				mDependants.erase(iterFind);
+				Vector<CoreObject*>& dependencies = dependantData->dependencies;
+				auto iterFind = std::find(dependencies.begin(), dependencies.end(), object);
+
+				if (iterFind != dependencies.end())
+					dependencies.erase(iterFind);
 			}
 
-			mDependencies.erase(internalId);
+			mObjects.remove(object->mManagerHandle);
+			object->mManagerHandle = SlotHandle();
 		}
 	}
 
 	void CoreObjectManager::notifyCoreDirty(CoreObject* object)
 	{
-		UINT64 id = object->getInternalID();
-
 		Lock lock(mObjectsMutex);
 
-		mDirtyObjects[id] = { object, -1 };
+		ObjectData* data = mObjects.find(object->mManagerHandle);
+		if (data != nullptr)
+			queueDirty(*data);
+	}
+
+	void CoreObjectManager::queueDirty(ObjectData& data)
+	{
+		if (data.dirtyIdx != (UINT32)-1)
+			return;
+
+		data.dirtyIdx = (UINT32)mDirtyObjects.size();
+		mDirtyObjects.push_back({ data.object->getInternalID(), data.object, -1, data.syncLevel });
+	}
+
+	void CoreObjectManager::updateSyncLevels()
+	{
+		for (auto& entry : mObjects)
+			entry.syncLevel = SYNC_LEVEL_UNKNOWN;
+
+		for (auto& entry : mObjects)
+			calculateSyncLevel(entry);
+
+		mSyncLevelsDirty = false;
+	}
+
+	UINT32 CoreObjectManager::calculateSyncLevel(ObjectData& data)
+	{
+		// Circular dependency, ignore the edge that closes the cycle
+		if (data.syncLevel == SYNC_LEVEL_VISITING)
+			return 0;
+
+		if (data.syncLevel != SYNC_LEVEL_UNKNOWN)
+			return data.syncLevel;
+
+		data.syncLevel = SYNC_LEVEL_VISITING;
+
+		UINT32 level = 0;
+		for (auto& dependency : data.dependencies)
+		{
+			ObjectData* dependencyData = mObjects.find(dependency->mManagerHandle);
+			if (dependencyData != nullptr)
+				level = std::max(level, calculateSyncLevel(*dependencyData) + 1);
+		}
+
+		data.syncLevel = level;
+		return level;
 	}
 
 	void CoreObjectManager::notifyDependenciesDirty(CoreObject* object)
@@ -132,8 +176,6 @@ namespace bs
 
 	void CoreObjectManager::updateDependencies(CoreObject* object, Vector<CoreObject*>* dependencies)
 	{
-		UINT64 id = object->getInternalID();
-
 		bs_frame_mark();
 		{
 			FrameVector<CoreObject*> toRemove;
@@ -141,70 +183,57 @@ namespace bs
 
 			Lock lock(mObjectsMutex);
 
+			ObjectData& data = mObjects[object->mManagerHandle];
+
 			// Add dependencies and clear old dependencies from dependants
 			{
 				if (dependencies != nullptr)
 					std::sort(dependencies->begin(), dependencies->end());
 
-				auto iterFind = mDependencies.find(id);
-				if (iterFind != mDependencies.end())
+				const Vector<CoreObject*>& oldDependencies = data.dependencies;
+				if (dependencies != nullptr)
 				{
-					const Vector<CoreObject*>& oldDependencies = iterFind->second;
-
-					if (dependencies != nullptr)
-					{
-						std::set_difference(oldDependencies.begin(), oldDependencies.end(),
-							dependencies->begin(), dependencies->end(), std::inserter(toRemove, toRemove.begin()));
-
-						std::set_difference(dependencies->begin(), dependencies->end(),
-							oldDependencies.begin(), oldDependencies.end(), std::inserter(toAdd, toAdd.begin()));
-					}
-					else
-					{
-						for (auto& dependency : oldDependencies)
-							toRemove.push_back(dependency);
-					}
-
-					for (auto& dependency : toRemove)
-					{
-						UINT64 dependencyId = dependency->getInternalID();
-						auto iterFind2 = mDependants.find(dependencyId);
-
-						if (iterFind2 != mDependants.end())
-						{
-							Vector<CoreObject*>& dependants = iterFind2->second;
-							auto findIter3 = std::find(dependants.begin(), dependants.end(), object);
-							dependants.erase(findIter3);
-
-							if (dependants.size() == 0)
-								mDependants.erase(iterFind2);
-						}
-					}
-
-					if (dependencies != nullptr && dependencies->size() > 0)
-						mDependencies[id] = *dependencies;
-					else
-						mDependencies.erase(id);
+					std::set_difference(oldDependencies.begin(), oldDependencies.end(),
+						dependencies->begin(), dependencies->end(), std::inserter(toRemove, toRemove.begin()));
+
+					std::set_difference(dependencies->begin(), dependencies->end(),
+						oldDependencies.begin(), oldDependencies.end(), std::inserter(toAdd, toAdd.begin()));
 				}
 				else
 				{
-					if (dependencies != nullptr && dependencies->size() > 0)
-					{
-						for (auto& dependency : *dependencies)
-							toAdd.push_back(dependency);
+					for (auto& dependency : oldDependencies)
+						toRemove.push_back(dependency);
+				}
 
-						mDependencies[id] = *dependencies;
-					}
+				for (auto& dependency : toRemove)
+				{
+					ObjectData* dependencyData = mObjects.find(dependency->mManagerHandle);
+					if (dependencyData == nullptr)
+						continue;
+
+					Vector<CoreObject*>& dependants = dependencyData->dependants;
+					auto iterFind = std::find(dependants.begin(), dependants.end(), object);
+
+					if (iterFind != dependants.end())
+						dependants.erase(iterFind);
 				}
+
+				if (!toRemove.empty() || !toAdd.empty())
+					mSyncLevelsDirty = true;
+
+				if (dependencies != nullptr)
+					data.dependencies = *dependencies;
+				else
+					data.dependencies.clear();
 			}
 
 			// Register dependants
 			{
 				for (auto& dependency : toAdd)
 				{
-					UINT64 dependencyId = dependency->getInternalID();
-					Vector<CoreObject*>& dependants = mDependants[dependencyId];
-					dependants.push_back(object);
+					ObjectData* dependencyData = mObjects.find(dependency->mManagerHandle);
+					if (dependencyData != nullptr)
+						dependencyData->dependants.push_back(object);
 				}
 			}
 		}
@@ -213,7 +242,7 @@ namespace bs
 
 	void CoreObjectManager::syncToCore()
 	{
-		syncDownload(gCoreThread().getFrameAlloc());
+		PROFILE_CALL(syncDownload(gCoreThread().getFrameAlloc()), "CoreObjectSync");
 		gCoreThread().queueCommand(std::bind(&CoreObjectManager::syncUpload, this));
 	}
 
@@ -231,52 +260,77 @@ namespace bs
 		FrameAlloc* allocator = gCoreThread().getFrameAlloc();
 		Vector<IndividualCoreSyncData> syncData;
 
-		std::function<void(CoreObject*)> syncObject = [&](CoreObject* curObj)
+		bs_frame_mark();
 		{
-			if (!curObj->isCoreDirty())
-				return; // We already processed it as some other object's dependency
+			// Find the object and all of its dirty dependencies. Clean objects were already synced, along with their
+			// dependencies. The visited set guards against circular dependencies.
+			FrameVector<ObjectData*> toSync;
+			FrameUnorderedSet<CoreObject*> visited;
+			FrameVector<CoreObject*> todo = { object };
+			while (!todo.empty())
+			{
+				CoreObject* curObj = todo.back();
+				todo.pop_back();
 
-			// Sync dependencies before dependants
-			// Note: I don't check for recursion. Possible infinite loop if two objects
-			// are dependent on one another.
+				if (!curObj->isCoreDirty() || !visited.insert(curObj).second)
+					continue;
 
-			UINT64 id = curObj->getInternalID();
-			auto iterFind = mDependencies.find(id);
+				ObjectData* objData = mObjects.find(curObj->mManagerHandle);
+				if (objData == nullptr)
+					continue;
 
-			if (iterFind != mDependencies.end())
-			{
-				const Vector<CoreObject*>& dependencies = iterFind->second;
-				for (auto& dependency : dependencies)
-					syncObject(dependency);
+				toSync.push_back(objData);
+				for (auto& dependency : objData->dependencies)
+					todo.push_back(dependency);
 			}
 
-			SPtr<ct::CoreObject> objectCore = curObj->getCore();
-			if (objectCore == nullptr)
+			// Sync dependencies before dependants, in the same order as syncDownload()
+			if (mSyncLevelsDirty)
+				updateSyncLevels();
+
+			std::sort(toSync.begin(), toSync.end(),
+				[](const ObjectData* a, const ObjectData* b)
 			{
-				curObj->markCoreClean();
-				mDirtyObjects.erase(id);
-				return;
-			}
+				if (a->syncLevel != b->syncLevel)
+					return a->syncLevel < b->syncLevel;
 
-			syncData.push_back(IndividualCoreSyncData());
-			IndividualCoreSyncData& data = syncData.back();
-			data.allocator = allocator;
-			data.destination = objectCore;
-			data.syncData = curObj->syncToCore(allocator);
+				return a->object->getInternalID() < b->object->getInternalID();
+			});
 
-			curObj->markCoreClean();
-			mDirtyObjects.erase(id);
-		};
+			for (auto& objData : toSync)
+			{
+				CoreObject* curObj = objData->object;
 
-		syncObject(object);
+				// Leave a blank entry in the dirty list, as removing it would invalidate indices of other entries
+				if (objData->dirtyIdx != (UINT32)-1)
+				{
+					mDirtyObjects[objData->dirtyIdx].object = nullptr;
+					objData->dirtyIdx = (UINT32)-1;
+				}
+
+				SPtr<ct::CoreObject> objectCore = curObj->getCore();
+				if (objectCore == nullptr)
+				{
+					curObj->markCoreClean();
+					continue;
+				}
+
+				syncData.push_back(IndividualCoreSyncData());
+				IndividualCoreSyncData& data = syncData.back();
+				data.allocator = allocator;
+				data.destination = objectCore;
+				data.syncData = curObj->syncToCore(allocator);
+
+				curObj->markCoreClean();
+			}
+		}
+		bs_frame_clear();
 
 		std::function<void(const Vector<IndividualCoreSyncData>&)> callback =
 			[](const Vector<IndividualCoreSyncData>& data)
 		{
-			// Traverse in reverse to sync dependencies before dependants
-			for (auto riter = data.rbegin(); riter != data.rend(); ++riter)
+			for (auto& entry : data)
 			{
-				const IndividualCoreSyncData& entry = *riter;
 				entry.destination->syncToCore(entry.syncData);
 
 				UINT8* dataPtr = entry.syncData.getBuffer();
@@ -290,8 +344,17 @@ namespace bs
 			gCoreThread().queueCommand(std::bind(callback, syncData));
 	}
 
+	CoreObjectSyncStats CoreObjectManager::getSyncStats() const
+	{
+		Lock lock(mObjectsMutex);
+
+		return mSyncStats;
+	}
+
 	void CoreObjectManager::syncDownload(FrameAlloc* allocator)
 	{
+		UINT64 startTime = gTime().getTimePrecise();
+
 		Lock lock(mObjectsMutex);
 
 		mCoreSyncData.push_back(CoreStoredSyncData());
@@ -300,84 +363,86 @@ namespace bs
 		syncData.alloc = allocator;
 		
 		// Add all objects dependant on the dirty objects
-		bs_frame_mark();
+		UINT32 numDirty = (UINT32)mDirtyObjects.size();
+		for (UINT32 i = 0; i < numDirty; i++)
 		{
-			FrameSet<CoreObject*> dirtyDependants;
-			for (auto& objectData : mDirtyObjects)
+			CoreObject* object = mDirtyObjects[i].object;
+			if (object == nullptr)
+				continue;
+
+			// Queuing dependants only grows the dirty list, so the reference into the object list remains valid
+			const Vector<CoreObject*>& dependants = mObjects[object->mManagerHandle].dependants;
+			for (auto& dependant : dependants)
 			{
-				auto iterFind = mDependants.find(objectData.first);
-				if (iterFind != mDependants.end())
+				if (!dependant->isCoreDirty())
 				{
-					const Vector<CoreObject*>& dependants = iterFind->second;
-					for (auto& dependant : dependants)
-					{
-						if (!dependant->isCoreDirty())
-						{
-							dependant->mCoreDirtyFlags |= 0xFFFFFFFF; // To ensure the loop below doesn't skip it
-							dirtyDependants.insert(dependant);
-						}
-					}
+					dependant->mCoreDirtyFlags |= 0xFFFFFFFF; // To ensure the loop below doesn't skip it
+					queueDirty(mObjects[dependant->mManagerHandle]);
 				}
 			}
+		}
 
-			for (auto& dirtyDependant : dirtyDependants)
-			{
-				UINT64 id = dirtyDependant->getInternalID();
+		// Sync dependencies before dependants. Order between objects on the same level matters as well, ones with lower
+		// ID will have been created before ones with higher ones and should be updated first.
+		if (mSyncLevelsDirty)
+			updateSyncLevels();
 
-				mDirtyObjects[id] = { dirtyDependant, -1 };
-			}
+		for (auto& entry : mDirtyObjects)
+		{
+			if (entry.object != nullptr)
+				entry.syncLevel = mObjects[entry.object->mManagerHandle].syncLevel;
 		}
 
-		bs_frame_clear();
-		
-		// Order in which objects are recursed in matters, ones with lower ID will have been created before
-		// ones with higher ones and should be updated first.
-		for (auto& objectData : mDirtyObjects)
+		std::sort(mDirtyObjects.begin(), mDirtyObjects.end(),
+			[](const DirtyObjectData& a, const DirtyObjectData& b)
 		{
-			std::function<void(CoreObject*)> syncObject = [&](CoreObject* curObj)
+			if (a.syncLevel != b.syncLevel)
+				return a.syncLevel < b.syncLevel;
+
+			return a.id < b.id;
+		});
+
+		// All dirty objects are in the list, so a single walk over it handles dependencies as well
+		CoreObjectSyncStats stats;
+		for (auto& entry : mDirtyObjects)
+		{
+			CoreObject* object = entry.object;
+			if (object != nullptr)
 			{
-				if (!curObj->isCoreDirty())
-					return; // We already processed it as some other object's dependency
+				mObjects[object->mManagerHandle].dirtyIdx = (UINT32)-1;
 
-				// Sync dependencies before dependants
-				// Note: I don't check for recursion. Possible infinite loop if two objects
-				// are dependent on one another.
-				
-				UINT64 id = curObj->getInternalID();
-				auto iterFind = mDependencies.find(id);
+				if (!object->isCoreDirty())
+					continue;
 
-				if (iterFind != mDependencies.end())
+				SPtr<ct::CoreObject> objectCore = object->getCore();
+				if (objectCore != nullptr)
 				{
-					const Vector<CoreObject*>& dependencies = iterFind->second;
-					for (auto& dependency : dependencies)
-						syncObject(dependency);
-				}
+					CoreSyncData objSyncData = object->syncToCore(allocator);
+					syncData.entries.push_back(CoreStoredSyncObjData(objectCore, entry.id, objSyncData));
 
-				SPtr<ct::CoreObject> objectCore = curObj->getCore();
-				if (objectCore == nullptr)
-				{
-					curObj->markCoreClean();
-					return;
+					stats.numObjects++;
+					stats.numBytes += objSyncData.getBufferSize();
 				}
 
-				CoreSyncData objSyncData = curObj->syncToCore(allocator);
-				curObj->markCoreClean();
-
-				syncData.entries.push_back(CoreStoredSyncObjData(objectCore,
-					curObj->getInternalID(), objSyncData));
-			};
-
-			CoreObject* object = objectData.second.object;
-			if (object != nullptr)
-				syncObject(object);
+				object->markCoreClean();
+			}
 			else
 			{
 				// Object was destroyed but we still need to sync its modifications before it was destroyed
-				if (objectData.second.syncDataId != -1)
-					syncData.entries.push_back(mDestroyedSyncData[objectData.second.syncDataId]);
+				if (entry.syncDataId != -1)
+				{
+					const CoreStoredSyncObjData& destroyedData = mDestroyedSyncData[entry.syncDataId];
+					syncData.entries.push_back(destroyedData);
+
+					stats.numObjects++;
+					stats.numBytes += destroyedData.syncData.getBufferSize();
+				}
 			}
 		}
 
+		stats.timeMs = (gTime().getTimePrecise() - startTime) / 1000.0f;
+		mSyncStats = stats;
+
 		mDirtyObjects.clear();
 		mDestroyedSyncData.clear();
 	}
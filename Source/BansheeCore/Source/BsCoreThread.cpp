@@ -31,10 +31,14 @@ namespace bs
 		mCommandQueue = bs_new<CommandQueue<CommandQueueSync>>(BS_THREAD_CURRENT_ID);
 
 		initCoreThread();
+
+		TaskScheduler::instance().setTaskEndCallback(&CoreThread::submitTaskCommands);
 	}
 
 	CoreThread::~CoreThread()
 	{
+		TaskScheduler::instance().setTaskEndCallback(nullptr);
+
 		// TODO - What if something gets queued between the queued call to destroy_internal and this!?
 		shutdownCoreThread();
 
@@ -154,6 +158,18 @@ namespace bs
 		return mPerThreadQueue.current->queue;
 	}
 
+	void CoreThread::submitTaskCommands()
+	{
+		// Without this commands queued by tasks that never call submit() would never become visible to submitAll(), as
+		// only the thread that recorded them is allowed to publish them
+		ThreadQueueContainer* container = mPerThreadQueue.current;
+		if (container == nullptr || container->isMain)
+			return;
+
+		if (container->queue->hasUnsubmitted())
+			container->queue->submitToCoreThread();
+	}
+
 	void CoreThread::submitAll(bool blockUntilComplete)
 	{
 		Vector<ThreadQueueContainer*> queueCopies;
@@ -164,19 +180,30 @@ namespace bs
 			queueCopies = mAllQueues;
 		}
 
-		// Submit workers first
+		// Submit workers first. Their queues can only be published by their own threads, so only the commands they
+		// already submitted (including any left over by finished tasks) are played back.
 		ThreadQueueContainer* mainQueue = nullptr;
 		for (auto& queue : queueCopies)
 		{
 			if (!queue->isMain)
-				queue->queue->submitToCoreThread(blockUntilComplete);
+			{
+				if (queue == mPerThreadQueue.current)
+					queue->queue->submitToCoreThread(blockUntilComplete);
+				else
+					queue->queue->playbackSubmitted(blockUntilComplete);
+			}
 			else
 				mainQueue = queue;
 		}
 
 		// Then main
 		if (mainQueue != nullptr)
-			mainQueue->queue->submitToCoreThread(blockUntilComplete);
+		{
+			if (mainQueue == mPerThreadQueue.current)
+				mainQueue->queue->submitToCoreThread(blockUntilComplete);
+			else
+				mainQueue->queue->playbackSubmitted(blockUntilComplete);
+		}
 	}
 
 	void CoreThread::submit(bool blockUntilComplete)
@@ -7,39 +7,57 @@
 
 namespace bs
 {
-	CoreThreadQueueBase::CoreThreadQueueBase(CommandQueueBase* commandQueue)
-		:mCommandQueue(commandQueue)
+	CoreThreadQueueBase::CoreThreadQueueBase(ThreadId threadId)
+		:mThreadId(threadId)
 	{
 
 	}
 
 	CoreThreadQueueBase::~CoreThreadQueueBase()
 	{
-		bs_delete(mCommandQueue);
+
 	}
 
 	AsyncOp CoreThreadQueueBase::queueReturnCommand(std::function<void(AsyncOp&)> commandCallback)
 	{
-		return mCommandQueue->queueReturn(commandCallback);
+		checkThread();
+
+		AsyncOp op = mCommands.queueReturn(std::move(commandCallback));
+
+#if BS_FORCE_SINGLETHREADED_RENDERING
+		mCommands.publish();
+		mCommands.playback();
+#endif
+
+		return op;
 	}
 
 	void CoreThreadQueueBase::queueCommand(std::function<void()> commandCallback)
 	{
-		mCommandQueue->queue(commandCallback);
+		queue(std::move(commandCallback));
 	}
 
 	void CoreThreadQueueBase::submitToCoreThread(bool blockUntilComplete)
 	{
-		Queue<QueuedCommand>* commands = mCommandQueue->flush();
+		// Publishing reads the producer's write index and must be ordered after the writes of the recorded commands,
+		// so only the recording thread may do it
+		checkThread();
+
+		// Commands are handed over to the core thread without copying, it only needs to be told to play them back
+		mCommands.publish();
 
-		gCoreThread().queueCommand(std::bind(&CommandQueueBase::playback, mCommandQueue, commands), 
-			CTQF_InternalQueue | CTQF_BlockUntilComplete);
+		playbackSubmitted(blockUntilComplete);
+	}
+
+	void CoreThreadQueueBase::playbackSubmitted(bool blockUntilComplete)
+	{
+		gCoreThread().queueCommand([this]() { mCommands.playback(); }, CTQF_InternalQueue | CTQF_BlockUntilComplete);
 	}
 
 	void CoreThreadQueueBase::cancelAll()
 	{
-		// Note that this won't free any Frame data allocated for all the canceled commands since
-		// frame data will only get cleared at frame start
-		mCommandQueue->cancelAll();
+		checkThread();
+
+		mCommands.cancelUnpublished();
 	}
 }
\ No newline at end of file
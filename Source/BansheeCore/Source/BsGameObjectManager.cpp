@@ -132,8 +132,35 @@ namespace bs
 	{
 		assert(mIsDeserializationActive);
 
-		for (auto& unresolvedHandle : mUnresolvedHandles)
-			resolveDeserializedHandle(unresolvedHandle, mGODeserializationMode);
+		// Sort the handles so all handles pointing to the same object are next to each other, and then resolve them in a
+		// single pass, only looking up the object once per group
+		std::sort(mUnresolvedHandles.begin(), mUnresolvedHandles.end(),
+			[](const UnresolvedHandle& a, const UnresolvedHandle& b)
+		{
+			return a.originalInstanceId < b.originalInstanceId;
+		});
+
+		GameObjectHandleBase nullHandle(nullptr);
+
+		UINT32 numHandles = (UINT32)mUnresolvedHandles.size();
+		for (UINT32 i = 0; i < numHandles;)
+		{
+			UINT64 originalId = mUnresolvedHandles[i].originalInstanceId;
+
+			UINT32 end = i + 1;
+			while (end < numHandles && mUnresolvedHandles[end].originalInstanceId == originalId)
+				end++;
+
+			const GameObjectHandleBase* object = nullptr;
+			if (findDeserializedObject(originalId, mGODeserializationMode, object))
+			{
+				const GameObjectHandleBase& target = object != nullptr ? *object : nullHandle;
+				for (UINT32 j = i; j < end; j++)
+					mUnresolvedHandles[j].handle._resolve(target);
+			}
+
+			i = end;
+		}
 
 		for (auto iter = mEndCallbacks.rbegin(); iter != mEndCallbacks.rend(); ++iter)
 		{
@@ -149,10 +176,23 @@ namespace bs
 	}
 
 	void GameObjectManager::resolveDeserializedHandle(UnresolvedHandle& data, UINT32 flags)
+	{
+		const GameObjectHandleBase* object = nullptr;
+		if (!findDeserializedObject(data.originalInstanceId, flags, object))
+			return;
+
+		if (object != nullptr)
+			data.handle._resolve(*object);
+		else
+			data.handle._resolve(nullptr);
+	}
+
+	bool GameObjectManager::findDeserializedObject(UINT64 originalId, UINT32 flags,
+		const GameObjectHandleBase*& object) const
 	{
 		assert(mIsDeserializationActive);
 
-		UINT64 instanceId = data.originalInstanceId;
+		UINT64 instanceId = originalId;
 
 		bool isInternalReference = false;
 
@@ -165,23 +205,19 @@ namespace bs
 			isInternalReference = true;
 		}
 
+		object = nullptr;
 		if (isInternalReference || (!isInternalReference && (flags & GODM_RestoreExternal) != 0))
 		{
 			auto findIterObj = mObjects.find(instanceId);
 
 			if (findIterObj != mObjects.end())
-				data.handle._resolve(findIterObj->second);
-			else
 			{
-				if ((flags & GODM_KeepMissing) == 0)
-					data.handle._resolve(nullptr);
+				object = &findIterObj->second;
+				return true;
 			}
 		}
-		else
-		{
-			if ((flags & GODM_KeepMissing) == 0)
-				data.handle._resolve(nullptr);
-		}
+
+		return (flags & GODM_KeepMissing) == 0;
 	}
 
 	void GameObjectManager::registerUnresolvedHandle(UINT64 originalId, GameObjectHandleBase& object)
@@ -16,6 +16,7 @@ namespace bs
 	GpuResourceData::GpuResourceData(const GpuResourceData& copy)
 	{
 		mData = copy.mData;
+		mDataOwner = copy.mDataOwner;
 		mLocked = copy.mLocked; // TODO - This should be shared by all copies pointing to the same data?
 		mOwnsData = false;
 	}
@@ -28,6 +29,7 @@ namespace bs
 	GpuResourceData& GpuResourceData::operator=(const GpuResourceData& rhs)
 	{
 		mData = rhs.mData;
+		mDataOwner = rhs.mDataOwner;
 		mLocked = rhs.mLocked; // TODO - This should be shared by all copies pointing to the same data?
 		mOwnsData = false;
 
@@ -65,6 +67,7 @@ namespace bs
 		freeInternalBuffer();
 
 		mData = (UINT8*)bs_alloc(size);
+		mDataOwner = nullptr;
 		mOwnsData = true;
 	}
 
@@ -98,9 +101,17 @@ namespace bs
 		freeInternalBuffer();
 
 		mData = data;
+		mDataOwner = nullptr;
 		mOwnsData = false;
 	}
 
+	void GpuResourceData::setExternalBuffer(UINT8* data, const SPtr<DataStream>& owner)
+	{
+		setExternalBuffer(data);
+
+		mDataOwner = owner;
+	}
+
 	void GpuResourceData::_lock() const
 	{
 		mLocked = true;
@@ -177,9 +177,30 @@ namespace bs
 			return;
 		}
 
+		// Create default import options up front, so they can be safely retrieved during concurrent imports
+		importer->getDefaultImportOptions();
+
 		mAssetImporters.push_back(importer);
 	}
 
+	bool Importer::_supportsConcurrentImport(const Path& inputFilePath) const
+	{
+		SpecificImporter* importer = getImporterForFile(inputFilePath);
+		if (importer == nullptr)
+			return false;
+
+		return importer->isThreadSafe();
+	}
+
+	UINT32 Importer::_getImporterVersion(const Path& inputFilePath) const
+	{
+		SpecificImporter* importer = getImporterForFile(inputFilePath);
+		if (importer == nullptr)
+			return 0;
+
+		return importer->getVersion();
+	}
+
 	SpecificImporter* Importer::getImporterForFile(const Path& inputFilePath) const
 	{
 		WString ext = inputFilePath.getWExtension();
@@ -7,6 +7,7 @@
 #include "BsBinarySerializer.h"
 #include "BsBinaryDiff.h"
 #include "BsSceneManager.h"
+#include "BsDataStream.h"
 
 namespace bs
 {
@@ -30,7 +31,42 @@ namespace bs
 		return PrefabObjectDiff::getRTTIStatic();
 	}
 
+	/** 
+	 * Returns a hash of the provided component's serialized data, used for quickly checking if two components are 
+	 * identical.
+	 */
+	static String hashComponent(const HComponent& component)
+	{
+		Vector<UINT8> data;
+
+		MemorySerializer ms;
+		UINT32 numBytes = 0;
+		ms.encode(component.get(), numBytes, [&data](UINT32 size) { data.resize(size); return data.data(); });
+
+		SPtr<DataStream> stream = bs_shared_ptr_new<MemoryDataStream>(data.data(), data.size(), false);
+		return md5(stream);
+	}
+
 	SPtr<PrefabDiff> PrefabDiff::create(const HSceneObject& prefab, const HSceneObject& instance)
+	{
+		if (prefab->mPrefabLinkUUID != instance->mPrefabLinkUUID)
+			return nullptr;
+
+		// Rename instance objects so they share the same IDs as the prefab objects (see the other create() overload)
+		Vector<RenamedGameObject> renamedObjects;
+		renameInstanceIds(prefab, instance, renamedObjects);
+
+		// Prefab hash is unknown, so there is no point in caching anything for later
+		SPtr<PrefabDiff> output = bs_shared_ptr_new<PrefabDiff>();
+		output->mRoot = generateDiff(prefab, instance, nullptr);
+
+		restoreInstanceIds(renamedObjects);
+
+		return output;
+	}
+
+	SPtr<PrefabDiff> PrefabDiff::create(const HSceneObject& prefab, const HSceneObject& instance, UINT32 prefabHash,
+		const SPtr<PrefabDiff>& previous)
 	{
 		if (prefab->mPrefabLinkUUID != instance->mPrefabLinkUUID)
 			return nullptr;
@@ -45,8 +81,42 @@ namespace bs
 		Vector<RenamedGameObject> renamedObjects;
 		renameInstanceIds(prefab, instance, renamedObjects);
 
+		// Prefab data serialized for the cache depends on the IDs the prefab objects were renamed to
+		Vector<UINT64> renamedIds;
+		renamedIds.reserve(renamedObjects.size() * 2);
+		for (auto& renamedGO : renamedObjects)
+		{
+			renamedIds.push_back(renamedGO.originalId);
+			renamedIds.push_back(renamedGO.instanceData->mInstanceId);
+		}
+
+		SPtr<DiffCache> cache;
+		if (previous != nullptr)
+			cache = std::move(previous->mCache);
+
+		if (cache == nullptr)
+			cache = bs_shared_ptr_new<DiffCache>();
+
+		bool useCache = cache->prefabUUID == instance->mPrefabLinkUUID && cache->prefabHash == prefabHash &&
+			cache->renamedIds == renamedIds;
+
+		if (!useCache)
+		{
+			cache->prefabUUID = instance->mPrefabLinkUUID;
+			cache->prefabHash = prefabHash;
+			cache->renamedIds = std::move(renamedIds);
+			cache->components.clear();
+		}
+
+		// Entries are rebuilt from the components visited during this pass, so entries of components no longer present
+		// in the instance are dropped
+		cache->prevComponents.swap(cache->components);
+
 		SPtr<PrefabDiff> output = bs_shared_ptr_new<PrefabDiff>();
-		output->mRoot = generateDiff(prefab, instance);
+		output->mRoot = generateDiff(prefab, instance, cache.get());
+		output->mCache = cache;
+
+		cache->prevComponents.clear();
 
 		restoreInstanceIds(renamedObjects);
 
@@ -63,6 +133,19 @@ namespace bs
 		GameObjectManager::instance().endDeserialization();
 	}
 
+	void PrefabDiff::apply(const Vector<std::pair<SPtr<PrefabDiff>, HSceneObject>>& diffs)
+	{
+		GameObjectManager::instance().startDeserialization();
+
+		for (auto& entry : diffs)
+		{
+			if (entry.first != nullptr && entry.first->mRoot != nullptr)
+				applyDiff(entry.first->mRoot, entry.second);
+		}
+
+		GameObjectManager::instance().endDeserialization();
+	}
+
 	void PrefabDiff::applyDiff(const SPtr<PrefabObjectDiff>& diff, const HSceneObject& object)
 	{
 		if ((diff->soFlags & (UINT32)SceneObjectDiffFlags::Name) != 0)
@@ -136,6 +219,7 @@ namespace bs
 				{
 					IDiff& diffHandler = component->getRTTI()->getDiffHandler();
 					diffHandler.applyDiff(component.getInternalPtr(), componentDiff->data);
+					component->_markModified();
 					break;
 				}
 			}
@@ -156,7 +240,8 @@ namespace bs
 		}
 	}
 
-	SPtr<PrefabObjectDiff> PrefabDiff::generateDiff(const HSceneObject& prefab, const HSceneObject& instance)
+	SPtr<PrefabObjectDiff> PrefabDiff::generateDiff(const HSceneObject& prefab, const HSceneObject& instance,
+		DiffCache* cache)
 	{
 		SPtr<PrefabObjectDiff> output;
 
@@ -222,7 +307,7 @@ namespace bs
 				if (prefabChild->getLinkId() == instanceChild->getLinkId())
 				{
 					if (instanceChild->mPrefabLinkUUID.empty())
-						childDiff = generateDiff(prefabChild, instanceChild);
+						childDiff = generateDiff(prefabChild, instanceChild, cache);
 
 					foundMatching = true;
 					break;
@@ -302,12 +387,7 @@ namespace bs
 
 				if (prefabComponent->getLinkId() == instanceComponent->getLinkId())
 				{
-					BinarySerializer bs;
-					SPtr<SerializedObject> encodedPrefab = bs._encodeToIntermediate(prefabComponent.get());
-					SPtr<SerializedObject> encodedInstance = bs._encodeToIntermediate(instanceComponent.get());
-
-					IDiff& diffHandler = prefabComponent->getRTTI()->getDiffHandler();
-					SPtr<SerializedObject> diff = diffHandler.generateDiff(encodedPrefab, encodedInstance);
+					SPtr<SerializedObject> diff = generateComponentDiff(prefabComponent, instanceComponent, cache);
 
 					if (diff != nullptr)
 					{
@@ -378,6 +458,73 @@ namespace bs
 		return output;
 	}
 
+	SPtr<SerializedObject> PrefabDiff::generateComponentDiff(const HComponent& prefab, const HComponent& instance,
+		DiffCache* cache)
+	{
+		if (cache == nullptr)
+		{
+			BinarySerializer bs;
+			SPtr<SerializedObject> encodedPrefab = bs._encodeToIntermediate(prefab.get());
+			SPtr<SerializedObject> encodedInstance = bs._encodeToIntermediate(instance.get());
+
+			IDiff& diffHandler = prefab->getRTTI()->getDiffHandler();
+			return diffHandler.generateDiff(encodedPrefab, encodedInstance);
+		}
+
+		UINT32 linkId = instance->getLinkId();
+		CachedComponentDiff& entry = cache->components[linkId];
+
+		String instanceHash;
+		auto iterFind = cache->prevComponents.find(linkId);
+		if (iterFind != cache->prevComponents.end())
+		{
+			entry = std::move(iterFind->second);
+
+			// Component reports all of its modifications, so if it reported none its data doesn't need to be checked. Name
+			// is serialized as well but modified outside of the component's control, so it is checked separately.
+			bool isModified = !instance->_tracksModifications() || 
+				entry.instanceModificationCount != instance->_getModificationCount() || 
+				entry.instanceName != instance->getName();
+
+			if (!isModified)
+				return entry.diff;
+
+			// Unchanged since the last diff was generated
+			instanceHash = hashComponent(instance);
+			if (entry.instanceHash == instanceHash)
+			{
+				entry.instanceModificationCount = instance->_getModificationCount();
+				entry.instanceName = instance->getName();
+
+				return entry.diff;
+			}
+		}
+		else
+		{
+			instanceHash = hashComponent(instance);
+			entry.prefabHash = hashComponent(prefab);
+		}
+
+		// Only perform the (much more expensive) field-by-field diff if the serialized data differs
+		SPtr<SerializedObject> diff;
+		if (entry.prefabHash != instanceHash)
+		{
+			BinarySerializer bs;
+			SPtr<SerializedObject> encodedPrefab = bs._encodeToIntermediate(prefab.get());
+			SPtr<SerializedObject> encodedInstance = bs._encodeToIntermediate(instance.get());
+
+			IDiff& diffHandler = prefab->getRTTI()->getDiffHandler();
+			diff = diffHandler.generateDiff(encodedPrefab, encodedInstance);
+		}
+
+		entry.instanceHash = std::move(instanceHash);
+		entry.instanceModificationCount = instance->_getModificationCount();
+		entry.instanceName = instance->getName();
+		entry.diff = diff;
+
+		return diff;
+	}
+
 	void PrefabDiff::renameInstanceIds(const HSceneObject& prefab, const HSceneObject& instance, Vector<RenamedGameObject>& output)
 	{
 		UnorderedMap<String, UnorderedMap<UINT32, UINT64>> linkToInstanceId;
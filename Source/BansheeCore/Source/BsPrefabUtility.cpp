@@ -88,6 +88,9 @@ namespace bs
 
 		Vector<RestoredPrefabInstance> newPrefabInstanceData;
 
+		// Many instances usually share the same prefab, so make sure it is only looked up once
+		UnorderedMap<String, HPrefab> prefabLinks;
+
 		// For each prefab instance load its reference prefab from the disk and check if it changed. If it has changed
 		// instantiate the prefab and destroy the current instance. Then apply instance specific changes stored in a
 		// prefab diff, if any, as well as restore the original parent and link id (link id of the root prefab instance
@@ -99,7 +102,16 @@ namespace bs
 		for (auto iter = prefabInstanceRoots.rbegin(); iter != prefabInstanceRoots.rend(); ++iter)
 		{
 			HSceneObject current = *iter;
-			HPrefab prefabLink = static_resource_cast<Prefab>(gResources().loadFromUUID(current->mPrefabLinkUUID, false, ResourceLoadFlag::None));
+
+			HPrefab prefabLink;
+			auto iterFind = prefabLinks.find(current->mPrefabLinkUUID);
+			if (iterFind == prefabLinks.end())
+			{
+				prefabLink = static_resource_cast<Prefab>(gResources().loadFromUUID(current->mPrefabLinkUUID, false, ResourceLoadFlag::None));
+				prefabLinks[current->mPrefabLinkUUID] = prefabLink;
+			}
+			else
+				prefabLink = iterFind->second;
 
 			if (prefabLink.isLoaded(false) && prefabLink->getHash() != current->mPrefabHash)
 			{
@@ -128,13 +140,21 @@ namespace bs
 		}
 
 		// Once everything is cloned, apply diffs, restore old parents & link IDs for root.
+		// Diffs must be applied after everything is instantiated and instance data restored since it may contain
+		// game object handles within or external to its prefab instance. All diffs are applied at once so the handles
+		// are resolved in a single pass.
+		Vector<std::pair<SPtr<PrefabDiff>, HSceneObject>> diffs;
 		for (auto& entry : newPrefabInstanceData)
 		{
-			// Diffs must be applied after everything is instantiated and instance data restored since it may contain
-			// game object handles within or external to its prefab instance.
 			if (entry.diff != nullptr)
-				entry.diff->apply(entry.newInstance);
+				diffs.push_back(std::make_pair(entry.diff, entry.newInstance));
+		}
 
+		if (!diffs.empty())
+			PrefabDiff::apply(diffs);
+
+		for (auto& entry : newPrefabInstanceData)
+		{
 			entry.newInstance->mPrefabDiff = entry.diff;
 
 			entry.newInstance->setParent(entry.originalParent, false);
@@ -148,6 +168,7 @@ namespace bs
 				entry.newInstance->_instantiate(true);
 		}
 
+		prefabLinks.clear();
 		gResources().unloadAllUnused();
 	}
 
@@ -274,6 +295,7 @@ namespace bs
 		Stack<HSceneObject> todo;
 		todo.push(topLevelObject);
 
+		UnorderedMap<String, HPrefab> prefabLinks;
 		while (!todo.empty())
 		{
 			HSceneObject current = todo.top();
@@ -281,11 +303,25 @@ namespace bs
 
 			if (!current->mPrefabLinkUUID.empty())
 			{
+				// Previous diff is provided so components that haven't changed since it was recorded aren't diffed again
+				SPtr<PrefabDiff> previousDiff = current->mPrefabDiff;
 				current->mPrefabDiff = nullptr;
 
-				HPrefab prefabLink = static_resource_cast<Prefab>(gResources().loadFromUUID(current->mPrefabLinkUUID, false, ResourceLoadFlag::None));
+				HPrefab prefabLink;
+				auto iterFind = prefabLinks.find(current->mPrefabLinkUUID);
+				if (iterFind == prefabLinks.end())
+				{
+					prefabLink = static_resource_cast<Prefab>(gResources().loadFromUUID(current->mPrefabLinkUUID, false, ResourceLoadFlag::None));
+					prefabLinks[current->mPrefabLinkUUID] = prefabLink;
+				}
+				else
+					prefabLink = iterFind->second;
+
 				if (prefabLink.isLoaded(false))
-					current->mPrefabDiff = PrefabDiff::create(prefabLink->_getRoot(), current->getHandle());
+				{
+					current->mPrefabDiff = PrefabDiff::create(prefabLink->_getRoot(), current->getHandle(),
+						prefabLink->getHash(), previousDiff);
+				}
 			}
 
 			UINT32 childCount = current->getNumChildren();
@@ -296,6 +332,7 @@ namespace bs
 			}
 		}
 
+		prefabLinks.clear();
 		gResources().unloadAllUnused();
 	}
 
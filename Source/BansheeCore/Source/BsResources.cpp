@@ -16,6 +16,7 @@
 #include "BsCompression.h"
 #include "BsDataStream.h"
 #include "BsBinarySerializer.h"
+#include "BsCoreThread.h"
 
 namespace bs
 {
@@ -327,13 +328,25 @@ namespace bs
 			}
 			else // Asynchronous, read the file on a worker thread
 			{
-				String fileName = filePath.getFilename();
-				String taskName = "Resource load: " + fileName;
-
 				bool keepSourceData = loadFlags.isSet(ResourceLoadFlag::KeepSourceData);
-				SPtr<Task> task = Task::create(taskName, 
-					std::bind(&Resources::loadCallback, this, filePath, outputResource, keepSourceData));
-				TaskScheduler::instance().addTask(task);
+
+				// Dependencies are read first, so if any are still loading hold the read until the last one completes
+				bool waitForDependencies = false;
+				{
+					Lock lock(mInProgressResourcesMutex);
+
+					ResourceLoadData* loadData = mInProgressResources[UUID];
+					if (loadData->remainingDependencies > 1)
+					{
+						loadData->pendingLoad = { filePath, outputResource, keepSourceData };
+						loadData->hasPendingLoad = true;
+
+						waitForDependencies = true;
+					}
+				}
+
+				if (!waitForDependencies)
+					queueAsyncLoad(filePath, outputResource, keepSourceData);
 			}
 		}
 		else // File already loaded or in progress
@@ -363,7 +376,9 @@ namespace bs
 		// work best when they are reading one thing at a time, and it won't have benefits on an SSD either. Think about
 		// executing all file reads on a single thread, while decompression and similar operations can execute on multiple.
 
-		SPtr<DataStream> stream = FileSystem::openFile(filePath, true);
+		// File is mapped into memory so that large data blocks (e.g. mesh and pixel data) can reference the mapping
+		// directly, instead of being copied into separately allocated buffers
+		SPtr<DataStream> stream = FileSystem::openFileMapped(filePath);
 		if (stream == nullptr)
 			return nullptr;
 
@@ -398,11 +413,17 @@ namespace bs
 				UINT32 objectSize = 0;
 				stream->read(&objectSize, sizeof(objectSize));
 
-				if (metaData->getCompressionMethod() != 0)
+				UINT32 compressionMethod = metaData->getCompressionMethod();
+				if (compressionMethod == 1)
 					stream = Compression::decompress(stream);
+				else if (compressionMethod == 2)
+					stream = Compression::decompressChunked(stream);
 
-				BinarySerializer bs;
-				loadedData = std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize, params));
+				if (stream != nullptr)
+				{
+					BinarySerializer bs;
+					loadedData = std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize, params));
+				}
 			}
 		}
 
@@ -576,7 +597,7 @@ namespace bs
 		for (UINT32 i = 0; i < (UINT32)dependencyList.size(); i++)
 			dependencyUUIDs[i] = dependencyList[i].resource.getUUID();
 
-		UINT32 compressionMethod = (compress && resource->isCompressible()) ? 1 : 0;
+		UINT32 compressionMethod = (compress && resource->isCompressible()) ? 2 : 0;
 		SPtr<SavedResourceData> resourceData = bs_shared_ptr_new<SavedResourceData>(dependencyUUIDs, 
 			resource->allowAsyncLoading(), compressionMethod);
 
@@ -611,7 +632,7 @@ namespace bs
 			if (compressionMethod != 0)
 			{
 				SPtr<DataStream> srcStream = std::static_pointer_cast<DataStream>(objStream);
-				objStream = Compression::compress(srcStream);
+				objStream = Compression::compressChunked(srcStream);
 			}
 
 			stream.write((char*)&numBytes, sizeof(numBytes));
@@ -790,6 +811,7 @@ namespace bs
 		ResourceLoadData* myLoadData = nullptr;
 		bool finishLoad = true;
 		Vector<ResourceLoadData*> dependantLoads;
+		Vector<QueuedLoad> readyLoads;
 		{
 			Lock inProgresslock(mInProgressResourcesMutex);
 
@@ -823,10 +845,24 @@ namespace bs
 				}
 
 				for (auto& dependantLoad : dependantLoads)
+				{
 					dependantLoad->remainingDependencies--;
+
+					// Only the dependant's own file read remains, so it can now be started
+					if (dependantLoad->hasPendingLoad && dependantLoad->remainingDependencies == 1)
+					{
+						readyLoads.push_back(dependantLoad->pendingLoad);
+
+						dependantLoad->pendingLoad = QueuedLoad();
+						dependantLoad->hasPendingLoad = false;
+					}
+				}
 			}
 		}
 
+		for (auto& entry : readyLoads)
+			queueAsyncLoad(entry.filePath, entry.resource, entry.loadWithSaveData);
+
 		for (auto& dependantLoad : dependantLoads)
 		{
 			HResource dependant = dependantLoad->resData.resource.lock();
@@ -861,6 +897,81 @@ namespace bs
 		loadComplete(resource);
 	}
 
+	void Resources::asyncLoadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData)
+	{
+		auto releaseLoadSlot = [this]()
+		{
+			// Core objects created during the load queue their initialization on this thread's core thread queue, which
+			// only this thread can submit
+			gCoreThread().submit();
+
+			{
+				Lock lock(mQueuedLoadsMutex);
+				mNumActiveLoads--;
+			}
+
+			startQueuedLoads();
+		};
+
+		// Make sure the slot is released even if the load fails, otherwise the queued loads could never start
+		try
+		{
+			loadCallback(filePath, resource, loadWithSaveData);
+		}
+		catch (...)
+		{
+			releaseLoadSlot();
+			throw;
+		}
+
+		releaseLoadSlot();
+	}
+
+	void Resources::queueAsyncLoad(const Path& filePath, const HResource& resource, bool loadWithSaveData)
+	{
+		{
+			Lock lock(mQueuedLoadsMutex);
+			mQueuedLoads.push({ filePath, resource, loadWithSaveData });
+		}
+
+		startQueuedLoads();
+	}
+
+	void Resources::startQueuedLoads()
+	{
+		Vector<QueuedLoad> loadsToStart;
+		{
+			Lock lock(mQueuedLoadsMutex);
+			while (!mQueuedLoads.empty() && (mMaxConcurrentLoads == 0 || mNumActiveLoads < mMaxConcurrentLoads))
+			{
+				loadsToStart.push_back(mQueuedLoads.front());
+				mQueuedLoads.pop();
+
+				mNumActiveLoads++;
+			}
+		}
+
+		for (auto& entry : loadsToStart)
+		{
+			String fileName = entry.filePath.getFilename();
+			String taskName = "Resource load: " + fileName;
+
+			SPtr<Task> task = Task::create(taskName,
+				std::bind(&Resources::asyncLoadCallback, this, entry.filePath, entry.resource, entry.loadWithSaveData));
+			TaskScheduler::instance().addTask(task);
+		}
+	}
+
+	void Resources::setMaxConcurrentLoads(UINT32 count)
+	{
+		{
+			Lock lock(mQueuedLoadsMutex);
+			mMaxConcurrentLoads = count;
+		}
+
+		startQueuedLoads();
+	}
+
 	BS_CORE_EXPORT Resources& gResources()
 	{
 		return Resources::instance();
@@ -10,6 +10,7 @@
 #include "BsViewport.h"
 #include "BsGameObjectManager.h"
 #include "BsRenderTarget.h"
+#include "BsTaskScheduler.h"
 
 namespace bs
 {
@@ -20,6 +21,32 @@ namespace bs
 		UninitializedList = 2
 	};
 
+	/** Number of scene objects processed by a single task during the batched world transform update. */
+	static const UINT32 TRANSFORM_UPDATE_GRAIN_SIZE = 256;
+
+	/** Adds an entry to a registry of scene objects, or replaces the existing entry for the same object. */
+	template<class T, class Data>
+	void registerEntry(SlotMap<Data>& entries, UnorderedMap<T*, SlotHandle>& handles, T* object, const Data& data)
+	{
+		auto iterFind = handles.find(object);
+		if (iterFind != handles.end())
+			entries[iterFind->second] = data;
+		else
+			handles[object] = entries.insert(data);
+	}
+
+	/** Removes an entry from a registry of scene objects, if it exists. */
+	template<class T, class Data>
+	void unregisterEntry(SlotMap<Data>& entries, UnorderedMap<T*, SlotHandle>& handles, T* object)
+	{
+		auto iterFind = handles.find(object);
+		if (iterFind == handles.end())
+			return;
+
+		entries.remove(iterFind->second);
+		handles.erase(iterFind);
+	}
+
 	SceneManager::SceneManager()
 	{
 		mRootNode = SceneObject::createInternal("SceneRoot");
@@ -86,32 +113,32 @@ namespace bs
 
 	void SceneManager::_registerRenderable(const SPtr<Renderable>& renderable, const HSceneObject& so)
 	{
-		mRenderables[renderable.get()] = SceneRenderableData(renderable, so);
+		registerEntry(mRenderables, mRenderableHandles, renderable.get(), SceneRenderableData(renderable, so));
 	}
 
 	void SceneManager::_unregisterRenderable(const SPtr<Renderable>& renderable)
 	{
-		mRenderables.erase(renderable.get());
+		unregisterEntry(mRenderables, mRenderableHandles, renderable.get());
 	}
 
 	void SceneManager::_registerLight(const SPtr<Light>& light, const HSceneObject& so)
 	{
-		mLights[light.get()] = SceneLightData(light, so);
+		registerEntry(mLights, mLightHandles, light.get(), SceneLightData(light, so));
 	}
 
 	void SceneManager::_unregisterLight(const SPtr<Light>& light)
 	{
-		mLights.erase(light.get());
+		unregisterEntry(mLights, mLightHandles, light.get());
 	}
 
 	void SceneManager::_registerCamera(const SPtr<Camera>& camera, const HSceneObject& so)
 	{
-		mCameras[camera.get()] = SceneCameraData(camera, so);
+		registerEntry(mCameras, mCameraHandles, camera.get(), SceneCameraData(camera, so));
 	}
 
 	void SceneManager::_unregisterCamera(const SPtr<Camera>& camera)
 	{
-		mCameras.erase(camera.get());
+		unregisterEntry(mCameras, mCameraHandles, camera.get());
 
 		auto iterFind = std::find_if(mMainCameras.begin(), mMainCameras.end(),
 			[&](const SceneCameraData& x)
@@ -125,12 +152,12 @@ namespace bs
 
 	void SceneManager::_registerReflectionProbe(const SPtr<ReflectionProbe>& probe, const HSceneObject& so)
 	{
-		mReflectionProbes[probe.get()] = SceneReflectionProbeData(probe, so);
+		registerEntry(mReflectionProbes, mReflectionProbeHandles, probe.get(), SceneReflectionProbeData(probe, so));
 	}
 
 	void SceneManager::_unregisterReflectionProbe(const SPtr<ReflectionProbe>& probe)
 	{
-		mReflectionProbes.erase(probe.get());
+		unregisterEntry(mReflectionProbes, mReflectionProbeHandles, probe.get());
 	}
 
 	void SceneManager::_notifyMainCameraStateChanged(const SPtr<Camera>& camera)
@@ -145,7 +172,11 @@ namespace bs
 		if (camera->isMain())
 		{
 			if (iterFind == mMainCameras.end())
-				mMainCameras.push_back(mCameras[camera.get()]);
+			{
+				auto iterFindHandle = mCameraHandles.find(camera.get());
+				if (iterFindHandle != mCameraHandles.end())
+					mMainCameras.push_back(mCameras[iterFindHandle->second]);
+			}
 
 			viewport->setTarget(mMainRT);
 		}
@@ -159,12 +190,131 @@ namespace bs
 		}
 	}
 
+	void SceneManager::setBatchedTransformUpdates(bool enabled)
+	{
+		if (mBatchedTransformUpdates == enabled)
+			return;
+
+		// Objects still queued are left to be updated lazily
+		for (auto& so : mDirtyTransforms)
+		{
+			if (!so.isDestroyed())
+				so->mDirtyFlags &= ~SceneObject::QueuedForUpdate;
+		}
+
+		mDirtyTransforms.clear();
+		mBatchedTransformUpdates = enabled;
+	}
+
+	void SceneManager::_queueTransformUpdate(const HSceneObject& so)
+	{
+		mDirtyTransforms.push_back(so);
+	}
+
+	void SceneManager::_updateWorldTransforms()
+	{
+		if (mDirtyTransforms.empty())
+			return;
+
+		// Find roots of all dirty sub-hierarchies, i.e. dirty objects with no dirty parent. Dirty state propagates to all
+		// children, so the remaining objects are found by walking down from the roots.
+		mTransformUpdateQueue.clear();
+		for (auto& so : mDirtyTransforms)
+		{
+			if (so.isDestroyed() || so->isCachedWorldTfrmUpToDate())
+				continue;
+
+			SceneObject* root = so.get();
+			bool isRoot = true;
+			while (root->mParent != nullptr && !root->mParent.isDestroyed() && 
+				!root->mParent->isCachedWorldTfrmUpToDate())
+			{
+				root = root->mParent.get();
+
+				// Queued parent will either be a root itself or will be reached from one
+				if ((root->mDirtyFlags & SceneObject::QueuedForUpdate) != 0)
+				{
+					isRoot = false;
+					break;
+				}
+			}
+
+			if (!isRoot)
+				continue;
+
+			// Parent that was dirty before batched updates were enabled, was never queued
+			if (root != so.get())
+				root->mDirtyFlags |= SceneObject::QueuedForUpdate;
+
+			mTransformUpdateQueue.push_back(root);
+		}
+
+		// Append children of each depth level, resulting in a list sorted by depth
+		mTransformUpdateLevels.clear();
+		mTransformUpdateLevels.push_back(0);
+
+		UINT32 levelStart = 0;
+		UINT32 levelEnd = (UINT32)mTransformUpdateQueue.size();
+		while (levelStart != levelEnd)
+		{
+			mTransformUpdateLevels.push_back(levelEnd);
+
+			for (UINT32 i = levelStart; i < levelEnd; i++)
+			{
+				for (auto& child : mTransformUpdateQueue[i]->mChildren)
+				{
+					if (!child.isDestroyed() && !child->isCachedWorldTfrmUpToDate())
+						mTransformUpdateQueue.push_back(child.get());
+				}
+			}
+
+			levelStart = levelEnd;
+			levelEnd = (UINT32)mTransformUpdateQueue.size();
+		}
+
+		// Update one level at a time. Parents of all objects in a level are up to date at this point, so objects within
+		// the level don't touch each other and can be updated in parallel.
+		auto updateRange = [this](UINT32 begin, UINT32 end)
+		{
+			for (UINT32 i = begin; i < end; i++)
+				mTransformUpdateQueue[i]->updateTransformsIfDirty();
+		};
+
+		for (UINT32 i = 0; i < (UINT32)mTransformUpdateLevels.size() - 1; i++)
+		{
+			UINT32 begin = mTransformUpdateLevels[i];
+			UINT32 end = mTransformUpdateLevels[i + 1];
+
+			if ((end - begin) <= TRANSFORM_UPDATE_GRAIN_SIZE)
+				updateRange(begin, end);
+			else
+			{
+				TaskScheduler::instance().parallelFor("WorldTransformUpdate", begin, end, TRANSFORM_UPDATE_GRAIN_SIZE,
+					updateRange, TaskPriority::High);
+			}
+		}
+
+		for (auto& sceneObject : mTransformUpdateQueue)
+			sceneObject->mDirtyFlags &= ~SceneObject::QueuedForUpdate;
+
+		for (auto& so : mDirtyTransforms)
+		{
+			if (!so.isDestroyed())
+				so->mDirtyFlags &= ~SceneObject::QueuedForUpdate;
+		}
+
+		mDirtyTransforms.clear();
+	}
+
 	void SceneManager::_updateCoreObjectTransforms()
 	{
-		for (auto& renderablePair : mRenderables)
+		if (mBatchedTransformUpdates)
+			_updateWorldTransforms();
+
+		for (auto& renderableData : mRenderables)
 		{
-			SPtr<Renderable> renderable = renderablePair.second.renderable;
-			HSceneObject so = renderablePair.second.sceneObject;
+			SPtr<Renderable> renderable = renderableData.renderable;
+			HSceneObject so = renderableData.sceneObject;
 
 			if (so->getMobility() != renderable->getMobility())
 				renderable->setMobility(so->getMobility());
@@ -175,10 +325,10 @@ namespace bs
 				renderable->setIsActive(so->getActive());
 		}
 
-		for (auto& cameraPair : mCameras)
+		for (auto& cameraData : mCameras)
 		{
-			SPtr<Camera> handler = cameraPair.second.camera;
-			HSceneObject so = cameraPair.second.sceneObject;
+			SPtr<Camera> handler = cameraData.camera;
+			HSceneObject so = cameraData.sceneObject;
 
 			UINT32 curHash = so->getTransformHash();
 			if (curHash != handler->_getLastModifiedHash())
@@ -195,10 +345,10 @@ namespace bs
 			}
 		}
 
-		for (auto& lightPair : mLights)
+		for (auto& lightData : mLights)
 		{
-			SPtr<Light> handler = lightPair.second.light;
-			HSceneObject so = lightPair.second.sceneObject;
+			SPtr<Light> handler = lightData.light;
+			HSceneObject so = lightData.sceneObject;
 
 			if (so->getMobility() != handler->getMobility())
 				handler->setMobility(so->getMobility());
@@ -218,10 +368,10 @@ namespace bs
 			}
 		}
 
-		for (auto& probePair : mReflectionProbes)
+		for (auto& probeData : mReflectionProbes)
 		{
-			SPtr<ReflectionProbe> probe = probePair.second.probe;
-			HSceneObject so = probePair.second.sceneObject;
+			SPtr<ReflectionProbe> probe = probeData.probe;
+			HSceneObject so = probeData.sceneObject;
 
 			UINT32 curHash = so->getTransformHash();
 			if (curHash != probe->_getLastModifiedHash())
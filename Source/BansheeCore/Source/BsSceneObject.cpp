@@ -6,7 +6,7 @@
 #include "BsException.h"
 #include "BsDebug.h"
 #include "BsSceneObjectRTTI.h"
-#include "BsMemorySerializer.h"
+#include "BsBinaryCloner.h"
 #include "BsGameObjectManager.h"
 #include "BsPrefabUtility.h"
 #include "BsMatrix3.h"
@@ -18,7 +18,7 @@ namespace bs
 		: GameObject(), mPrefabHash(0), mFlags(flags), mPosition(Vector3::ZERO), mRotation(Quaternion::IDENTITY)
 		, mScale(Vector3::ONE), mWorldPosition(Vector3::ZERO), mWorldRotation(Quaternion::IDENTITY)
 		, mWorldScale(Vector3::ONE), mCachedLocalTfrm(Matrix4::IDENTITY), mCachedWorldTfrm(Matrix4::IDENTITY)
-		, mDirtyFlags(0xFFFFFFFF), mDirtyHash(0), mActiveSelf(true), mActiveHierarchy(true)
+		, mDirtyFlags(DirtyFlags::LocalTfrmDirty | DirtyFlags::WorldTfrmDirty), mDirtyHash(0), mActiveSelf(true), mActiveHierarchy(true)
 		, mMobility(ObjectMobility::Movable)
 	{
 		setName(name);
@@ -460,6 +460,12 @@ namespace bs
 		{
 			mDirtyFlags |= DirtyFlags::LocalTfrmDirty | DirtyFlags::WorldTfrmDirty;
 			mDirtyHash++;
+
+			if ((mDirtyFlags & DirtyFlags::QueuedForUpdate) == 0 && gSceneManager().getBatchedTransformUpdates())
+			{
+				mDirtyFlags |= DirtyFlags::QueuedForUpdate;
+				gSceneManager()._queueTransformUpdate(mThisHandle);
+			}
 		}
 
 		// Only send component flags if we haven't removed them all
@@ -742,14 +748,8 @@ namespace bs
 		else
 			_unsetFlags(SOF_DontInstantiate);
 
-		UINT32 bufferSize = 0;
-
-		MemorySerializer serializer;
-		UINT8* buffer = serializer.encode(this, bufferSize, (void*(*)(UINT32))&bs_alloc);
-
 		GameObjectManager::instance().setDeserializationMode(GODM_UseNewIds | GODM_RestoreExternal);
-		SPtr<SceneObject> cloneObj = std::static_pointer_cast<SceneObject>(serializer.decode(buffer, bufferSize));
-		bs_free(buffer);
+		SPtr<SceneObject> cloneObj = std::static_pointer_cast<SceneObject>(BinaryCloner::clone(this));
 
 		if(isInstantiated)
 			_unsetFlags(SOF_DontInstantiate);
@@ -0,0 +1,679 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsFolderMonitor.h"
+#include "BsFileSystem.h"
+#include "BsException.h"
+
+#include <sys/inotify.h>
+#include <dirent.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+
+namespace bs
+{
+	/**
+	 * Information about a single folder passed to startMonitor(). Each folder uses its own inotify instance, with a watch
+	 * registered for every monitored sub-directory.
+	 */
+	struct FolderMonitor::FolderWatchInfo
+	{
+		FolderWatchInfo(const Path& folderToMonitor, int inotifyHandle, bool monitorSubdirectories, UINT32 monitorFlags);
+		~FolderWatchInfo();
+
+		/** Checks should changes of the specified type be reported. */
+		bool isMonitoring(FolderChange change) const { return (mMonitorFlags & (UINT32)change) != 0; }
+
+		/**
+		 * Registers a watch for the provided directory, and optionally all of its sub-directories. Paths of any files and
+		 * folders found in the sub-directories are output to @p foundEntries, if provided.
+		 */
+		void addWatches(const String& dirPath, bool recursive, Vector<String>* foundEntries);
+
+		/** Removes watches for the provided directory and all of its sub-directories. */
+		void removeWatches(const String& dirPath);
+
+		/** Updates paths of watches after a directory was renamed. */
+		void renameWatches(const String& oldDirPath, const String& newDirPath);
+
+		Path mFolderToMonitor;
+		int mInotifyHandle;
+		bool mMonitorSubdirectories;
+		UINT32 mMonitorFlags;
+
+		UnorderedMap<int, String> mWatches; /**< Watched directory paths (including the trailing separator). */
+	};
+
+	/** Iterates over inotify events read into a buffer. */
+	class FolderMonitor::FileNotifyInfo
+	{
+	public:
+		FileNotifyInfo(UINT8* notifyBuffer, UINT32 bufferSize)
+			:mBuffer(notifyBuffer), mBufferSize(bufferSize), mOffset(0)
+		{ }
+
+		/** Returns the next event in the buffer, or null if there are no more events. */
+		const inotify_event* getNext()
+		{
+			if (mOffset + sizeof(inotify_event) > mBufferSize)
+				return nullptr;
+
+			const inotify_event* event = (const inotify_event*)(mBuffer + mOffset);
+			mOffset += (UINT32)(sizeof(inotify_event) + event->len);
+
+			return event;
+		}
+
+	protected:
+		UINT8* mBuffer;
+		UINT32 mBufferSize;
+		UINT32 mOffset;
+	};
+
+	enum class FileActionType
+	{
+		Added,
+		Removed,
+		Modified,
+		Renamed
+	};
+
+	struct FileAction
+	{
+		FileAction(FileActionType type, const String& newName, const String& oldName = StringUtil::BLANK)
+			:oldName(oldName), newName(newName), type(type), lastSize(0), checkForWriteStarted(false)
+		{ }
+
+		String oldName;
+		String newName;
+		FileActionType type;
+
+		UINT64 lastSize;
+		bool checkForWriteStarted;
+	};
+
+	struct FolderMonitor::Pimpl
+	{
+		Vector<FolderWatchInfo*> mFoldersToWatch;
+		int mWakePipe[2] = { -1, -1 }; /**< Written to in order to wake up the worker thread. */
+		bool mShutdown = false;
+		Mutex mWatchMutex;
+
+		Queue<FileAction*> mFileActions;
+		List<FileAction*> mActiveFileActions;
+		UnorderedSet<String> mPendingModifications; /**< Files with an unreported modification, used for coalescing. */
+
+		Mutex mMainMutex;
+		Thread* mWorkerThread = nullptr;
+	};
+
+	/** Size of the buffer inotify events are read into. */
+	static const UINT32 READ_BUFFER_SIZE = 65536;
+
+	/** Events that always need to be monitored, so watches can be kept up to date as the directory tree changes. */
+	static const UINT32 STRUCTURE_EVENTS = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR |
+		IN_DONT_FOLLOW | IN_EXCL_UNLINK;
+
+	/** Converts the folder change flags into an inotify event mask. */
+	static UINT32 getInotifyMask(UINT32 changeFilter)
+	{
+		UINT32 mask = STRUCTURE_EVENTS;
+
+		if ((changeFilter & ((UINT32)FolderChange::Size | (UINT32)FolderChange::LastWrite)) != 0)
+			mask |= IN_MODIFY | IN_CLOSE_WRITE;
+
+		if ((changeFilter & ((UINT32)FolderChange::Attributes | (UINT32)FolderChange::Security)) != 0)
+			mask |= IN_ATTRIB;
+
+		if ((changeFilter & (UINT32)FolderChange::LastAccess) != 0)
+			mask |= IN_ACCESS;
+
+		return mask;
+	}
+
+	/** Writes to the provided wake-up pipe, causing the worker thread to stop waiting for notifications. */
+	static void wakeWorker(int pipeHandle)
+	{
+		char wake = 0;
+		while (write(pipeHandle, &wake, sizeof(wake)) == -1)
+		{
+			if (errno == EINTR)
+				continue;
+
+			// A full pipe means the worker already has a pending wake-up, so there's nothing more to do
+			if (errno != EAGAIN)
+				LOGERR("Failed to wake up the folder monitor worker thread. Error code: " + toString(errno));
+
+			break;
+		}
+	}
+
+	FolderMonitor::FolderWatchInfo::FolderWatchInfo(const Path& folderToMonitor, int inotifyHandle, 
+		bool monitorSubdirectories, UINT32 monitorFlags)
+		:mFolderToMonitor(folderToMonitor), mInotifyHandle(inotifyHandle), mMonitorSubdirectories(monitorSubdirectories)
+		, mMonitorFlags(monitorFlags)
+	{ }
+
+	FolderMonitor::FolderWatchInfo::~FolderWatchInfo()
+	{
+		// Closing the inotify handle releases all of its watches
+		if (mInotifyHandle != -1)
+			close(mInotifyHandle);
+	}
+
+	void FolderMonitor::FolderWatchInfo::addWatches(const String& dirPath, bool recursive, Vector<String>* foundEntries)
+	{
+		int watchHandle = inotify_add_watch(mInotifyHandle, dirPath.c_str(), getInotifyMask(mMonitorFlags));
+		if (watchHandle == -1)
+		{
+			if (errno == ENOSPC)
+			{
+				LOGWRN("Failed to monitor folder \"" + dirPath + "\" because the inotify watch limit was reached. "
+					"Increase the limit in /proc/sys/fs/inotify/max_user_watches.");
+			}
+
+			return;
+		}
+
+		mWatches[watchHandle] = dirPath;
+
+		if (!recursive)
+			return;
+
+		DIR* dir = opendir(dirPath.c_str());
+		if (dir == nullptr)
+			return;
+
+		while (dirent* entry = readdir(dir))
+		{
+			if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+				continue;
+
+			String childPath = dirPath + entry->d_name;
+
+			bool isDirectory = entry->d_type == DT_DIR;
+			if (entry->d_type == DT_UNKNOWN)
+				isDirectory = FileSystem::isDirectory(childPath);
+
+			if (foundEntries != nullptr)
+				foundEntries->push_back(childPath);
+
+			if (isDirectory)
+				addWatches(childPath + "/", recursive, foundEntries);
+		}
+
+		closedir(dir);
+	}
+
+	void FolderMonitor::FolderWatchInfo::removeWatches(const String& dirPath)
+	{
+		for (auto iter = mWatches.begin(); iter != mWatches.end();)
+		{
+			if (StringUtil::startsWith(iter->second, dirPath, false))
+			{
+				inotify_rm_watch(mInotifyHandle, iter->first);
+				iter = mWatches.erase(iter);
+			}
+			else
+				++iter;
+		}
+	}
+
+	void FolderMonitor::FolderWatchInfo::renameWatches(const String& oldDirPath, const String& newDirPath)
+	{
+		for (auto& entry : mWatches)
+		{
+			if (StringUtil::startsWith(entry.second, oldDirPath, false))
+				entry.second = newDirPath + entry.second.substr(oldDirPath.size());
+		}
+	}
+
+	FolderMonitor::FolderMonitor()
+	{
+		mPimpl = bs_new<Pimpl>();
+	}
+
+	FolderMonitor::~FolderMonitor()
+	{
+		stopMonitorAll();
+
+		// No need for mutex since we know worker thread is shut down by now
+		while (!mPimpl->mFileActions.empty())
+		{
+			FileAction* action = mPimpl->mFileActions.front();
+			mPimpl->mFileActions.pop();
+
+			bs_delete(action);
+		}
+
+		for (auto& action : mPimpl->mActiveFileActions)
+			bs_delete(action);
+
+		bs_delete(mPimpl);
+	}
+
+	void FolderMonitor::startMonitor(const Path& folderPath, bool subdirectories, FolderChange changeFilter)
+	{
+		if (!FileSystem::isDirectory(folderPath))
+		{
+			LOGERR("Provided path \"" + folderPath.toString() + "\" is not a directory");
+			return;
+		}
+
+		if (mPimpl->mWakePipe[0] == -1)
+		{
+			if (pipe2(mPimpl->mWakePipe, O_NONBLOCK | O_CLOEXEC) == -1)
+			{
+				BS_EXCEPT(InternalErrorException, "Failed to create a pipe for folder monitoring. Error code: " +
+					toString(errno));
+			}
+		}
+
+		int inotifyHandle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (inotifyHandle == -1)
+		{
+			BS_EXCEPT(InternalErrorException, "Failed to initialize inotify for folder \"" + folderPath.toString() + 
+				"\". Error code: " + toString(errno));
+		}
+
+		String rootPath = folderPath.toString();
+		if (rootPath.empty() || rootPath.back() != '/')
+			rootPath += "/";
+
+		FolderWatchInfo* watchInfo = bs_new<FolderWatchInfo>(Path(rootPath), inotifyHandle, subdirectories, 
+			(UINT32)changeFilter);
+		watchInfo->addWatches(rootPath, subdirectories, nullptr);
+
+		{
+			Lock lock(mPimpl->mWatchMutex);
+
+			mPimpl->mFoldersToWatch.push_back(watchInfo);
+			mPimpl->mShutdown = false;
+		}
+
+		if (mPimpl->mWorkerThread == nullptr)
+		{
+			mPimpl->mWorkerThread = bs_new<Thread>(std::bind(&FolderMonitor::workerThreadMain, this));
+
+			if (mPimpl->mWorkerThread == nullptr)
+			{
+				stopMonitor(folderPath);
+				BS_EXCEPT(InternalErrorException, "Failed to create a new worker thread for folder monitoring");
+			}
+		}
+		else
+		{
+			// Wake up the worker so it starts waiting on the new inotify instance
+			wakeWorker(mPimpl->mWakePipe[1]);
+		}
+	}
+
+	void FolderMonitor::stopMonitor(const Path& folderPath)
+	{
+		String rootPath = folderPath.toString();
+		if (rootPath.empty() || rootPath.back() != '/')
+			rootPath += "/";
+
+		Path dirPath(rootPath);
+		bool isEmpty;
+		{
+			Lock lock(mPimpl->mWatchMutex);
+
+			auto findIter = std::find_if(mPimpl->mFoldersToWatch.begin(), mPimpl->mFoldersToWatch.end(),
+				[&](const FolderWatchInfo* x) { return x->mFolderToMonitor == dirPath; });
+
+			if (findIter != mPimpl->mFoldersToWatch.end())
+			{
+				// Note: Worker only accesses watch infos while holding the mutex, and checks they're still in the list
+				bs_delete(*findIter);
+				mPimpl->mFoldersToWatch.erase(findIter);
+			}
+
+			isEmpty = mPimpl->mFoldersToWatch.empty();
+		}
+
+		if (isEmpty)
+			stopMonitorAll();
+		else if (mPimpl->mWorkerThread != nullptr)
+			wakeWorker(mPimpl->mWakePipe[1]);
+	}
+
+	void FolderMonitor::stopMonitorAll()
+	{
+		if (mPimpl->mWorkerThread != nullptr)
+		{
+			{
+				Lock lock(mPimpl->mWatchMutex);
+				mPimpl->mShutdown = true;
+			}
+
+			wakeWorker(mPimpl->mWakePipe[1]);
+
+			mPimpl->mWorkerThread->join();
+			bs_delete(mPimpl->mWorkerThread);
+			mPimpl->mWorkerThread = nullptr;
+		}
+
+		// Worker is shut down, no need for a mutex
+		for (auto& watchInfo : mPimpl->mFoldersToWatch)
+			bs_delete(watchInfo);
+
+		mPimpl->mFoldersToWatch.clear();
+
+		for (auto& handle : mPimpl->mWakePipe)
+		{
+			if (handle != -1)
+			{
+				close(handle);
+				handle = -1;
+			}
+		}
+	}
+
+	void FolderMonitor::workerThreadMain()
+	{
+		UINT8* buffer = (UINT8*)bs_alloc(READ_BUFFER_SIZE);
+
+		Vector<pollfd> fds;
+		Vector<FolderWatchInfo*> watchInfos;
+		while (true)
+		{
+			fds.clear();
+			watchInfos.clear();
+
+			{
+				Lock lock(mPimpl->mWatchMutex);
+
+				if (mPimpl->mShutdown)
+					break;
+
+				fds.push_back({ mPimpl->mWakePipe[0], POLLIN, 0 });
+				for (auto& entry : mPimpl->mFoldersToWatch)
+				{
+					fds.push_back({ entry->mInotifyHandle, POLLIN, 0 });
+					watchInfos.push_back(entry);
+				}
+			}
+
+			if (poll(fds.data(), (nfds_t)fds.size(), -1) == -1)
+			{
+				if (errno == EINTR)
+					continue;
+
+				LOGERR("Folder monitor failed while waiting for notifications. Error code: " + toString(errno));
+				break;
+			}
+
+			// Set of monitored folders changed, or we're shutting down
+			if ((fds[0].revents & POLLIN) != 0)
+			{
+				char wake[64];
+				while (read(mPimpl->mWakePipe[0], wake, sizeof(wake)) > 0)
+				{ }
+
+				continue;
+			}
+
+			Lock lock(mPimpl->mWatchMutex);
+			for (UINT32 i = 0; i < (UINT32)watchInfos.size(); i++)
+			{
+				if ((fds[i + 1].revents & POLLIN) == 0)
+					continue;
+
+				FolderWatchInfo* watchInfo = watchInfos[i];
+
+				// Monitor might have been stopped while we were waiting
+				auto iterFind = std::find(mPimpl->mFoldersToWatch.begin(), mPimpl->mFoldersToWatch.end(), watchInfo);
+				if (iterFind == mPimpl->mFoldersToWatch.end())
+					continue;
+
+				// Read everything available, so a rename split across multiple reads is handled together
+				UINT32 numBytes = 0;
+				while (numBytes + sizeof(inotify_event) + NAME_MAX + 1 <= READ_BUFFER_SIZE)
+				{
+					ssize_t numRead = read(watchInfo->mInotifyHandle, buffer + numBytes, READ_BUFFER_SIZE - numBytes);
+					if (numRead <= 0)
+						break;
+
+					numBytes += (UINT32)numRead;
+				}
+
+				if (numBytes > 0)
+				{
+					FileNotifyInfo info(buffer, numBytes);
+					handleNotifications(info, *watchInfo);
+				}
+			}
+		}
+
+		bs_free(buffer);
+	}
+
+	void FolderMonitor::handleNotifications(FileNotifyInfo& notifyInfo, FolderWatchInfo& watchInfo)
+	{
+		// Note: Called with the watch mutex held
+		struct MoveInfo
+		{
+			String path;
+			bool isDirectory;
+		};
+
+		Vector<FileAction*> actions;
+		UnorderedMap<UINT32, MoveInfo> pendingMoves;
+
+		auto reportAdded = [&](const String& path, bool isDirectory)
+		{
+			if (watchInfo.isMonitoring(isDirectory ? FolderChange::DirName : FolderChange::FileName) ||
+				watchInfo.isMonitoring(FolderChange::Creation))
+			{
+				actions.push_back(bs_new<FileAction>(FileActionType::Added, path));
+			}
+		};
+
+		auto reportRemoved = [&](const String& path, bool isDirectory)
+		{
+			if (watchInfo.isMonitoring(isDirectory ? FolderChange::DirName : FolderChange::FileName))
+				actions.push_back(bs_new<FileAction>(FileActionType::Removed, path));
+		};
+
+		// Registers watches for a newly added directory. Anything created in it before the watch was registered won't
+		// be reported by inotify, so its contents are reported as added.
+		auto addDirectory = [&](const String& path)
+		{
+			if (!watchInfo.mMonitorSubdirectories)
+				return;
+
+			Vector<String> contents;
+			watchInfo.addWatches(path + "/", true, &contents);
+
+			for (auto& entry : contents)
+				reportAdded(entry, FileSystem::isDirectory(entry));
+		};
+
+		while (const inotify_event* event = notifyInfo.getNext())
+		{
+			if ((event->mask & IN_Q_OVERFLOW) != 0)
+			{
+				// Events were lost, report the root folder as modified so it gets checked in full
+				actions.push_back(bs_new<FileAction>(FileActionType::Modified, watchInfo.mFolderToMonitor.toString()));
+				continue;
+			}
+
+			auto iterFind = watchInfo.mWatches.find(event->wd);
+			if (iterFind == watchInfo.mWatches.end())
+				continue;
+
+			if ((event->mask & IN_IGNORED) != 0)
+			{
+				// Watched directory was deleted (or the watch removed)
+				watchInfo.mWatches.erase(iterFind);
+				continue;
+			}
+
+			// Ignore notifications about the watched directory itself
+			if (event->len == 0)
+				continue;
+
+			String path = iterFind->second + event->name;
+			bool isDirectory = (event->mask & IN_ISDIR) != 0;
+
+			if ((event->mask & IN_CREATE) != 0)
+			{
+				reportAdded(path, isDirectory);
+
+				if (isDirectory)
+					addDirectory(path);
+			}
+			else if ((event->mask & IN_DELETE) != 0)
+			{
+				reportRemoved(path, isDirectory);
+			}
+			else if ((event->mask & IN_MOVED_FROM) != 0)
+			{
+				pendingMoves[event->cookie] = { path, isDirectory };
+			}
+			else if ((event->mask & IN_MOVED_TO) != 0)
+			{
+				auto iterFindMove = pendingMoves.find(event->cookie);
+				if (iterFindMove != pendingMoves.end())
+				{
+					const MoveInfo& moveInfo = iterFindMove->second;
+
+					if (isDirectory)
+						watchInfo.renameWatches(moveInfo.path + "/", path + "/");
+
+					if (watchInfo.isMonitoring(isDirectory ? FolderChange::DirName : FolderChange::FileName))
+						actions.push_back(bs_new<FileAction>(FileActionType::Renamed, path, moveInfo.path));
+
+					pendingMoves.erase(iterFindMove);
+				}
+				else // Moved from outside of the monitored folder
+				{
+					reportAdded(path, isDirectory);
+
+					if (isDirectory)
+						addDirectory(path);
+				}
+			}
+			else if ((event->mask & (IN_MODIFY | IN_CLOSE_WRITE)) != 0)
+			{
+				if (watchInfo.isMonitoring(FolderChange::Size) || watchInfo.isMonitoring(FolderChange::LastWrite))
+					actions.push_back(bs_new<FileAction>(FileActionType::Modified, path));
+			}
+			else if ((event->mask & IN_ATTRIB) != 0)
+			{
+				if (watchInfo.isMonitoring(FolderChange::Attributes) || watchInfo.isMonitoring(FolderChange::Security))
+					actions.push_back(bs_new<FileAction>(FileActionType::Modified, path));
+			}
+			else if ((event->mask & IN_ACCESS) != 0)
+			{
+				if (watchInfo.isMonitoring(FolderChange::LastAccess))
+					actions.push_back(bs_new<FileAction>(FileActionType::Modified, path));
+			}
+		}
+
+		// Anything moved without a matching destination was moved outside of the monitored folder
+		for (auto& entry : pendingMoves)
+		{
+			const MoveInfo& moveInfo = entry.second;
+
+			if (moveInfo.isDirectory)
+				watchInfo.removeWatches(moveInfo.path + "/");
+
+			reportRemoved(moveInfo.path, moveInfo.isDirectory);
+		}
+
+		{
+			Lock lock(mPimpl->mMainMutex);
+
+			for (auto& action : actions)
+			{
+				// Coalesce multiple modifications of the same file (e.g. one per write() call) into one notification
+				if (action->type == FileActionType::Modified)
+				{
+					if (!mPimpl->mPendingModifications.insert(action->newName).second)
+					{
+						bs_delete(action);
+						continue;
+					}
+				}
+
+				mPimpl->mFileActions.push(action);
+			}
+		}
+	}
+
+	void FolderMonitor::_update()
+	{
+		{
+			Lock lock(mPimpl->mMainMutex);
+
+			while (!mPimpl->mFileActions.empty())
+			{
+				FileAction* action = mPimpl->mFileActions.front();
+				mPimpl->mFileActions.pop();
+
+				mPimpl->mActiveFileActions.push_back(action);
+			}
+		}
+
+		for (auto iter = mPimpl->mActiveFileActions.begin(); iter != mPimpl->mActiveFileActions.end();)
+		{
+			FileAction* action = *iter;
+
+			// Reported file actions might still be in progress (i.e. something might still be writing to those files).
+			// Check for at least a couple of frames if the file's size hasn't changed before reporting a file action.
+			if (action->type != FileActionType::Removed && FileSystem::isFile(action->newName))
+			{
+				UINT64 size = FileSystem::getFileSize(action->newName);
+				if (!action->checkForWriteStarted)
+				{
+					action->checkForWriteStarted = true;
+					action->lastSize = size;
+
+					++iter;
+					continue;
+				}
+				else
+				{
+					if (action->lastSize != size)
+					{
+						action->lastSize = size;
+						++iter;
+						continue;
+					}
+				}
+			}
+
+			if (action->type == FileActionType::Modified)
+			{
+				Lock lock(mPimpl->mMainMutex);
+				mPimpl->mPendingModifications.erase(action->newName);
+			}
+
+			switch (action->type)
+			{
+			case FileActionType::Added:
+				if (!onAdded.empty())
+					onAdded(Path(action->newName));
+				break;
+			case FileActionType::Removed:
+				if (!onRemoved.empty())
+					onRemoved(Path(action->newName));
+				break;
+			case FileActionType::Modified:
+				if (!onModified.empty())
+					onModified(Path(action->newName));
+				break;
+			case FileActionType::Renamed:
+				if (!onRenamed.empty())
+					onRenamed(Path(action->oldName), Path(action->newName));
+				break;
+			}
+
+			mPimpl->mActiveFileActions.erase(iter++);
+			bs_delete(action);
+		}
+	}
+}
@@ -1,6 +1,6 @@
 //********************************** Banshee Engine (www.banshee3d.com) **************************************************//
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
-#include "Win32/BsWin32FolderMonitor.h"
+#include "BsFolderMonitor.h"
 #include "BsFileSystem.h"
 #include "BsException.h"
 
@@ -9,6 +9,7 @@ set(BS_BANSHEEEDITOR_SRC_LIBRARY
 	"Source/BsProjectLibraryEntries.cpp"
 	"Source/BsProjectResourceMeta.cpp"
 	"Source/BsEditorShaderIncludeHandler.cpp"
+	"Source/BsImportCache.cpp"
 )
 
 set(BS_BANSHEEEDITOR_INC_EDITORWINDOW
@@ -68,6 +69,7 @@ set(BS_BANSHEEEDITOR_INC_LIBRARY
 	"Include/BsProjectLibraryEntries.h"
 	"Include/BsProjectResourceMeta.h"
 	"Include/BsEditorShaderIncludeHandler.h"
+	"Include/BsImportCache.h"
 )
 
 set(BS_BANSHEEEDITOR_INC_GUI
@@ -174,6 +174,7 @@ namespace bs
 	class EditorCommand;
 	class ProjectFileMeta;
 	class ProjectResourceMeta;
+	class ImportCache;
 	class SceneGrid;
 	class HandleSlider;
 	class HandleSliderLine;
@@ -241,6 +242,7 @@ namespace bs
 		TID_Settings = 40019,
 		TID_ProjectSettings = 40020,
 		TID_WindowFrameWidget = 40021,
-		TID_ProjectResourceMeta = 40022
+		TID_ProjectResourceMeta = 40022,
+		TID_TestResource = 40023
 	};
 }
@@ -85,14 +85,60 @@ namespace bs
 		/** Tests native diff by modifiying an object, generating a diff and re-applying the modifications. */
 		void BinaryDiff();
 
+		/** Tests that an object decoded by the binary serializer matches the encoded object. */
+		void BinarySerializerDecode();
+
 		/** Tests prefab diff by modifiying a prefab, generating a diff and re-applying the modifications. */
 		void TestPrefabDiff();
 
+		/** 
+		 * Tests that diffs created from a previous diff reuse cached data for unmodified components, including components
+		 * that track their own modifications, and that the cache is discarded when the prefab changes.
+		 */
+		void TestPrefabDiffCache();
+
 		/** Tests a complex set of operations on a prefab. */
 		void TestPrefabComplex();
 
 		/**	Tests the frame allocator. */
 		void TestFrameAlloc();
+
+		/** 
+		 * Tests that the folder monitor reports created, modified and renamed files, and that changes in a large folder
+		 * tree are reported without requiring the tree to be rescanned.
+		 */
+		void TestFolderMonitor();
+
+		/** 
+		 * Tests that the import cache restores stored resources when the source contents match, and discards them when
+		 * the source file or one of its dependencies changes.
+		 */
+		void TestImportCache();
+
+		/** 
+		 * Tests that asynchronously loading a resource with many dependencies loads all of them, never starts deserializing
+		 * a resource before its dependencies are deserialized, and never loads more resources at once than allowed by
+		 * Resources::setMaxConcurrentLoads().
+		 */
+		void TestDependencyOrderedLoad();
+
+		/** 
+		 * Tests that core thread commands queued by a task that never submits them are executed by a later
+		 * CoreThread::submitAll() call on the main thread.
+		 */
+		void TestTaskCoreCommands();
+
+		/** 
+		 * Tests that text sprites updated by appending text to multi-paragraph text generate the same quads as when the
+		 * entire text is laid out at once.
+		 */
+		void TestTextSpriteAppend();
+
+		/** 
+		 * Tests that handles resolved in bulk at the end of game object deserialization point to the same objects as
+		 * handles resolved one by one, for internal, external and missing objects referenced by multiple handles.
+		 */
+		void TestDeserializedHandleResolve();
 	};
 
 	/** @} */
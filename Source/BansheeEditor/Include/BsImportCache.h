@@ -0,0 +1,153 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsEditorPrerequisites.h"
+#include "BsSpecificImporter.h"
+#include "BsImporter.h"
+
+namespace bs
+{
+	/** @addtogroup Library
+	 *  @{
+	 */
+
+	/** Contents of an import cache entry, as restored by ImportCache::find(). */
+	struct ImportCacheEntry
+	{
+		Vector<SubResourceRaw> resources; /**< Restored resources, in the order they were stored in. */
+		Vector<String> uuids; /**< UUIDs the resources had when they were stored, one per resource. */
+
+		/** 
+		 * Contents of the files the resources were saved to when they were stored, one per resource. As long as the
+		 * resources keep the same UUIDs these can be written out directly, instead of saving the resources again.
+		 */
+		Vector<SPtr<MemoryDataStream>> files;
+
+		float importTime = 0.0f; /**< Time in seconds it took to originally import and save the resources. */
+		float restoreTime = 0.0f; /**< Time in seconds it took to restore the entry. */
+	};
+
+	/** Contains statistics about ImportCache lookups. */
+	struct ImportCacheStats
+	{
+		UINT32 numHits = 0; /**< Number of imports that were restored from the cache. */
+		UINT32 numMisses = 0; /**< Number of imports that weren't found in the cache. */
+
+		/** Estimated time in seconds saved by restoring imports from the cache, instead of running the importer. */
+		float timeSaved = 0.0f;
+
+		/** Returns the ratio of lookups that were found in the cache, in [0, 1] range. */
+		float getHitRate() const
+		{
+			UINT32 numLookups = numHits + numMisses;
+			if (numLookups == 0)
+				return 0.0f;
+
+			return numHits / (float)numLookups;
+		}
+	};
+
+	/**
+	 * Stores results of resource imports on disk, addressed by a hash of the source file contents and name, import
+	 * options and the version of the importer. This allows files whose contents match a previous import (for example after
+	 * switching between version control branches, or after a file was touched without being modified) to be restored
+	 * without running the importer again.
+	 *
+	 * Files the import depends on (for example shader includes) are recorded with the cache entry, and the entry is
+	 * ignored if any of them changed since.
+	 *
+	 * Entries store the resource files saved by the project library as they are, so storing an entry doesn't require the
+	 * resources to be serialized again. Once the cache grows over its maximum size, the least recently stored entries are
+	 * removed.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_ED_EXPORT ImportCache
+	{
+	public:
+		/**
+		 * @param[in]	folder	Absolute path to the folder in which to store the cache entries.
+		 * @param[in]	maxSize	Maximum size of all cache entries, in bytes.
+		 */
+		ImportCache(const Path& folder, UINT64 maxSize = DEFAULT_MAX_SIZE);
+
+		/**
+		 * Generates a key that identifies the import of the provided source file using the provided import options.
+		 * Returns an empty string if the file cannot be read.
+		 */
+		String getKey(const Path& sourcePath, const SPtr<const ImportOptions>& importOptions) const;
+
+		/**
+		 * Restores the resources previously stored with the provided key. Returns false if the entry doesn't exist or is
+		 * no longer valid. Any existing contents of @p output are cleared.
+		 */
+		bool find(const String& key, ImportCacheEntry& output);
+
+		/**
+		 * Stores the imported resources under the provided key.
+		 *
+		 * @param[in]	key				Key returned by getKey() for the imported file.
+		 * @param[in]	resources		Imported resources.
+		 * @param[in]	files			Absolute paths to the files the resources were saved to, one per resource.
+		 * @param[in]	dependencies	Absolute paths to files the import depends on, other than the source file.
+		 * @param[in]	importTime		Time in seconds it took to import and save the resources. Used for estimating how
+		 *								much time is saved when the entry is restored.
+		 */
+		void add(const String& key, const Vector<SubResource>& resources, const Vector<Path>& files,
+			const Vector<Path>& dependencies, float importTime);
+
+		/** 
+		 * Records the time saved by restoring an entry, once the restored resources have been stored. 
+		 *
+		 * @param[in]	entry		Entry returned by find().
+		 * @param[in]	storeTime	Time in seconds it took to store the restored resources.
+		 */
+		void notifyRestored(const ImportCacheEntry& entry, float storeTime);
+
+		/** Removes the least recently stored entries until the cache is within its maximum size. */
+		void prune();
+
+		/** Removes all entries from the cache. */
+		void clear();
+
+		/** Returns statistics about cache lookups performed since creation, or since the last call to resetStats(). */
+		ImportCacheStats getStats() const;
+
+		/** Resets the statistics returned by getStats(). */
+		void resetStats();
+
+		/** Default maximum size of all cache entries, in bytes. */
+		static const UINT64 DEFAULT_MAX_SIZE = 1024 * 1024 * 1024;
+
+	private:
+		/** Returns the path to the file storing the cache entry with the specified key. */
+		Path getEntryPath(const String& key) const;
+
+		/** Returns a hash of the contents of the provided file, or an empty string if it cannot be read. */
+		static String getFileHash(const Path& path);
+
+		/** 
+		 * Decodes a resource from the contents of a file it was saved to by Resources::save(). Returns null if the
+		 * contents are not valid.
+		 */
+		static SPtr<Resource> decodeResource(const SPtr<MemoryDataStream>& file);
+
+		/** 
+		 * Removes the least recently stored entries, other than the entry at @p keepPath, until the cache is within its
+		 * maximum size. Caller must hold the cache mutex.
+		 */
+		void trim(const Path& keepPath);
+
+		/** Version of the cache entry format. Increment to invalidate all existing entries. */
+		static const UINT32 VERSION = 2;
+
+		Path mFolder;
+		UINT64 mMaxSize;
+		UINT64 mSize;
+		ImportCacheStats mStats;
+		mutable Mutex mMutex;
+	};
+
+	/** @} */
+}
@@ -257,6 +257,18 @@ namespace bs
 		/** Triggered when a resource is being (re)imported. Path provided is absolute. */
 		Event<void(const Path&)> onEntryImported; 
 
+		/** 
+		 * Triggered as resources found by checkForModifications() are being imported. Reports the number of resources
+		 * processed so far, followed by the total number of resources that need to be processed.
+		 */
+		Event<void(UINT32, UINT32)> onImportProgress;
+
+		/** 
+		 * Returns the cache that stores results of previous imports, allowing resources whose source files match a 
+		 * previous import to be restored without running the importer. Null if no library is loaded.
+		 */
+		const SPtr<ImportCache>& getImportCache() const { return mImportCache; }
+
 		/** @name Internal 
 		 *  @{
 		 */
@@ -269,6 +281,8 @@ namespace bs
 		static const Path RESOURCES_DIR;
 		static const Path INTERNAL_RESOURCES_DIR;
 	private:
+		struct ImportJob;
+
 		/**
 		 * Common code for adding a new resource entry to the library.
 		 *
@@ -279,10 +293,12 @@ namespace bs
 		 *								provided default import options are used.
 		 * @param[in]	forceReimport	Should the resource be reimported even if we detect no changes. This should be true
 		 *								if import options changed since last import.
+		 * @param[in]	import			If false the entry is added without being imported. Caller is then expected to
+		 *								import it through importResources().
 		 * @return						Newly added resource entry.
 		 */
 		FileEntry* addResourceInternal(DirectoryEntry* parent, const Path& filePath, 
-			const SPtr<ImportOptions>& importOptions = nullptr, bool forceReimport = false);
+			const SPtr<ImportOptions>& importOptions = nullptr, bool forceReimport = false, bool import = true);
 
 		/**
 		 * Common code for adding a new folder entry to the library.
@@ -327,6 +343,37 @@ namespace bs
 		void reimportResourceInternal(FileEntry* file, const SPtr<ImportOptions>& importOptions = nullptr, 
 			bool forceReimport = false, bool pruneResourceMetas = false);
 
+		/**
+		 * Imports the provided set of resources, if needed, using their existing or default import options. Source 
+		 * files handled by thread-safe importers are imported in parallel, while others are imported on the calling
+		 * thread. A resource is only imported once the resources it depends on (as reported by getImportDependencies())
+		 * have been imported. Triggers onImportProgress as resources are processed.
+		 */
+		void importResources(const Vector<FileEntry*>& files);
+
+		/** Loads the .meta file for the provided entry, if it exists and isn't already loaded. */
+		void loadMeta(FileEntry* file);
+
+		/**
+		 * Determines if a resource needs to be (re)imported and fills out the import job if it does. Returns false if no 
+		 * import is needed. Parameters are as in reimportResourceInternal().
+		 */
+		bool prepareImport(FileEntry* file, const SPtr<ImportOptions>& importOptions, bool forceReimport, 
+			ImportJob& job);
+
+		/** 
+		 * Imports the source file referenced by the job, or restores it from the import cache, and stores the results in 
+		 * the job. Can be called from worker threads if ImportJob::concurrent is true. Exceptions are stored in the job 
+		 * and rethrown by finishImport().
+		 */
+		void importSourceData(ImportJob& job) const;
+
+		/** 
+		 * Updates the library, .meta file and internal resources with the results of an import job. Must be called on the
+		 * main thread. See reimportResourceInternal() for @p pruneResourceMetas.
+		 */
+		void finishImport(ImportJob& job, bool pruneResourceMetas);
+
 		/**
 		 * Creates a full hierarchy of directory entries up to the provided directory, if any are needed.
 		 *
@@ -382,8 +429,10 @@ namespace bs
 
 		static const WString LIBRARY_ENTRIES_FILENAME;
 		static const WString RESOURCE_MANIFEST_FILENAME;
+		static const Path IMPORT_CACHE_DIR;
 
 		SPtr<ResourceManifest> mResourceManifest;
+		SPtr<ImportCache> mImportCache;
 		DirectoryEntry* mRootEntry;
 		Path mProjectFolder;
 		Path mResourcesFolder;
@@ -16,6 +16,17 @@
 #include "BsFrameAlloc.h"
 #include "BsFileSystem.h"
 #include "BsSceneManager.h"
+#include "BsFolderMonitor.h"
+#include "BsDataStream.h"
+#include "BsTime.h"
+#include "BsImportCache.h"
+#include "BsPlainText.h"
+#include "BsCoreThread.h"
+#include "BsTaskScheduler.h"
+#include "BsTextSprite.h"
+#include "BsBuiltinResources.h"
+#include "BsFont.h"
+#include "BsCBone.h"
 
 namespace bs
 {
@@ -406,14 +417,139 @@ namespace bs
 		return TestComponentD::getRTTIStatic();
 	}
 
+	class TestResource : public Resource
+	{
+	public:
+		Vector<HResource> dependencies;
+
+		/** Number of test resources currently being deserialized. */
+		static std::atomic<UINT32> numDeserializing;
+
+		/** Maximum value numDeserializing reached since it was last reset. */
+		static std::atomic<UINT32> maxDeserializing;
+
+		/** Counter incremented whenever a test resource starts or finishes deserializing. */
+		static std::atomic<UINT32> deserializationCounter;
+
+		/** Values of deserializationCounter when this resource started and finished deserializing. */
+		UINT32 deserializationStart = 0;
+		UINT32 deserializationEnd = 0;
+
+		static SPtr<TestResource> _createPtr()
+		{
+			SPtr<TestResource> resource = bs_core_ptr<TestResource>(new (bs_alloc<TestResource>()) TestResource());
+			resource->_setThisPtr(resource);
+			resource->initialize();
+
+			return resource;
+		}
+
+	protected:
+		TestResource()
+			:Resource(false)
+		{ }
+
+		void getResourceDependencies(FrameVector<HResource>& dependencies) const override
+		{
+			for (auto& dependency : this->dependencies)
+			{
+				if (dependency != nullptr)
+					dependencies.push_back(dependency);
+			}
+		}
+
+		/************************************************************************/
+		/* 								RTTI		                     		*/
+		/************************************************************************/
+	public:
+		friend class TestResourceRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	std::atomic<UINT32> TestResource::numDeserializing { 0 };
+	std::atomic<UINT32> TestResource::maxDeserializing { 0 };
+	std::atomic<UINT32> TestResource::deserializationCounter { 0 };
+
+	class TestResourceRTTI : public RTTIType<TestResource, Resource, TestResourceRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_REFL_ARRAY(dependencies, 0)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		TestResourceRTTI()
+			:mInitMembers(this)
+		{ }
+
+		void onDeserializationStarted(IReflectable* obj, const UnorderedMap<String, UINT64>& params) override
+		{
+			TestResource* resource = static_cast<TestResource*>(obj);
+			resource->deserializationStart = ++TestResource::deserializationCounter;
+
+			UINT32 numDeserializing = ++TestResource::numDeserializing;
+
+			UINT32 maxDeserializing = TestResource::maxDeserializing;
+			while (numDeserializing > maxDeserializing && 
+				!TestResource::maxDeserializing.compare_exchange_weak(maxDeserializing, numDeserializing))
+			{ }
+
+			// Keep the load going for a while, so that any loads exceeding the limit would overlap
+			BS_THREAD_SLEEP(2);
+		}
+
+		void onDeserializationEnded(IReflectable* obj, const UnorderedMap<String, UINT64>& params) override
+		{
+			--TestResource::numDeserializing;
+
+			TestResource* resource = static_cast<TestResource*>(obj);
+			resource->deserializationEnd = ++TestResource::deserializationCounter;
+		}
+
+		const String& getRTTIName() override
+		{
+			static String name = "TestResource";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_TestResource;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return TestResource::_createPtr();
+		}
+	};
+
+	RTTITypeBase* TestResource::getRTTIStatic()
+	{
+		return TestResourceRTTI::instance();
+	}
+
+	RTTITypeBase* TestResource::getRTTI() const
+	{
+		return TestResource::getRTTIStatic();
+	}
+
 	EditorTestSuite::EditorTestSuite()
 	{
 		BS_ADD_TEST(EditorTestSuite::SceneObjectRecord_UndoRedo);
 		BS_ADD_TEST(EditorTestSuite::SceneObjectDelete_UndoRedo);
 		BS_ADD_TEST(EditorTestSuite::BinaryDiff);
+		BS_ADD_TEST(EditorTestSuite::BinarySerializerDecode);
 		BS_ADD_TEST(EditorTestSuite::TestPrefabComplex);
 		BS_ADD_TEST(EditorTestSuite::TestPrefabDiff);
+		BS_ADD_TEST(EditorTestSuite::TestPrefabDiffCache);
 		BS_ADD_TEST(EditorTestSuite::TestFrameAlloc);
+		BS_ADD_TEST(EditorTestSuite::TestFolderMonitor);
+		BS_ADD_TEST(EditorTestSuite::TestImportCache);
+		BS_ADD_TEST(EditorTestSuite::TestDependencyOrderedLoad);
+		BS_ADD_TEST(EditorTestSuite::TestTaskCoreCommands);
+		BS_ADD_TEST(EditorTestSuite::TestTextSpriteAppend);
+		BS_ADD_TEST(EditorTestSuite::TestDeserializedHandleResolve);
 	}
 
 	void EditorTestSuite::SceneObjectRecord_UndoRedo()
@@ -572,6 +708,56 @@ namespace bs
 			BS_TEST_ASSERT(orgObj->arrObjPtrB[i]->intA == newObj->arrObjPtrB[i]->intA);
 	}
 
+	void EditorTestSuite::BinarySerializerDecode()
+	{
+		SPtr<TestObjectA> orgObj = bs_shared_ptr_new<TestObjectA>();
+		orgObj->intA = 995;
+		orgObj->strA = "potato";
+		orgObj->arrStrB = { "orange", "carrot" };
+		orgObj->objB.intA = 9940;
+		orgObj->objPtrB->strA = "kiwi";
+		orgObj->objPtrC = nullptr;
+		orgObj->arrObjB[1].strA = "strawberry";
+		orgObj->arrObjPtrA[1] = orgObj->objPtrA;
+		orgObj->arrObjPtrB[0]->intA = 99100;
+
+		MemorySerializer ms;
+		UINT32 numBytes = 0;
+		UINT8* bytes = ms.encode(orgObj.get(), numBytes);
+
+		SPtr<TestObjectA> newObj = std::static_pointer_cast<TestObjectA>(ms.decode(bytes, numBytes));
+		bs_free(bytes);
+
+		BS_TEST_ASSERT(newObj != nullptr);
+		if (newObj == nullptr)
+			return;
+
+		BS_TEST_ASSERT(newObj->intA == orgObj->intA);
+		BS_TEST_ASSERT(newObj->strA == orgObj->strA);
+		BS_TEST_ASSERT(newObj->strB == orgObj->strB);
+		BS_TEST_ASSERT(newObj->objB.intA == orgObj->objB.intA);
+
+		BS_TEST_ASSERT(newObj->objPtrA != nullptr && newObj->objPtrA->strA == orgObj->objPtrA->strA);
+		BS_TEST_ASSERT(newObj->objPtrB != nullptr && newObj->objPtrB->strA == orgObj->objPtrB->strA);
+		BS_TEST_ASSERT(newObj->objPtrC == nullptr);
+		BS_TEST_ASSERT(newObj->objPtrD == nullptr);
+
+		BS_TEST_ASSERT(newObj->arrStrB.size() == orgObj->arrStrB.size());
+		for (UINT32 i = 0; i < (UINT32)newObj->arrStrB.size(); i++)
+			BS_TEST_ASSERT(newObj->arrStrB[i] == orgObj->arrStrB[i]);
+
+		BS_TEST_ASSERT(newObj->arrObjB.size() == orgObj->arrObjB.size());
+		for (UINT32 i = 0; i < (UINT32)newObj->arrObjB.size(); i++)
+			BS_TEST_ASSERT(newObj->arrObjB[i].strA == orgObj->arrObjB[i].strA);
+
+		BS_TEST_ASSERT(newObj->arrObjPtrB.size() == orgObj->arrObjPtrB.size());
+		for (UINT32 i = 0; i < (UINT32)newObj->arrObjPtrB.size(); i++)
+			BS_TEST_ASSERT(newObj->arrObjPtrB[i]->intA == orgObj->arrObjPtrB[i]->intA);
+
+		// Objects referenced from multiple fields must be decoded as a single object
+		BS_TEST_ASSERT(newObj->arrObjPtrA[1] == newObj->objPtrA);
+	}
+
 	void EditorTestSuite::TestPrefabComplex()
 	{
 		HSceneObject aDeleteMe = SceneObject::create("A");
@@ -763,6 +949,134 @@ namespace bs
 		newRoot->destroy();
 	}
 
+	/** Finds the diff of the specified component in the prefab diff. Returns null if the component has no differences. */
+	static SPtr<SerializedObject> findComponentDiff(const SPtr<PrefabObjectDiff>& diff, const HComponent& component)
+	{
+		if (diff == nullptr)
+			return nullptr;
+
+		for (auto& componentDiff : diff->componentDiffs)
+		{
+			if (componentDiff->id == (INT32)component->getLinkId())
+				return componentDiff->data;
+		}
+
+		for (auto& childDiff : diff->childDiffs)
+		{
+			SPtr<SerializedObject> output = findComponentDiff(childDiff, component);
+			if (output != nullptr)
+				return output;
+		}
+
+		return nullptr;
+	}
+
+	void EditorTestSuite::TestPrefabDiffCache()
+	{
+		HSceneObject root = SceneObject::create("root");
+		HSceneObject so0 = SceneObject::create("so0");
+		HSceneObject so1 = SceneObject::create("so1");
+
+		so0->setParent(root);
+		so1->setParent(root);
+
+		GameObjectHandle<TestComponentC> cmp0 = so0->addComponent<TestComponentC>();
+		GameObjectHandle<TestComponentD> cmp1 = so1->addComponent<TestComponentD>();
+
+		// Bone reports its modifications, so it is only diffed again after it is modified
+		HBone bone = so0->addComponent<CBone>();
+		bone->setBoneName("boneA");
+
+		Path prefabPath = Path::combine(FileSystem::getTempDirectoryPath(), "testprefabcache.asset");
+		HPrefab prefab = Prefab::create(root);
+		gResources().save(prefab, prefabPath, true);
+
+		// Modify all components and record the initial diff
+		cmp0->obj.strA = "banana";
+		cmp1->obj.strA = "apple";
+		bone->setBoneName("boneB");
+
+		UINT32 prefabHash = prefab->getHash();
+		SPtr<PrefabDiff> firstDiff = PrefabDiff::create(prefab->_getRoot(), root, prefabHash, nullptr);
+
+		SPtr<SerializedObject> firstDiff0 = findComponentDiff(firstDiff->_getRoot(), cmp0);
+		SPtr<SerializedObject> firstDiff1 = findComponentDiff(firstDiff->_getRoot(), cmp1);
+		SPtr<SerializedObject> firstDiffBone = findComponentDiff(firstDiff->_getRoot(), bone);
+		BS_TEST_ASSERT(firstDiff0 != nullptr);
+		BS_TEST_ASSERT(firstDiff1 != nullptr);
+		BS_TEST_ASSERT(firstDiffBone != nullptr);
+
+		// Modify a single component and record again, providing the previous diff
+		cmp1->obj.strA = "orange";
+
+		SPtr<PrefabDiff> secondDiff = PrefabDiff::create(prefab->_getRoot(), root, prefabHash, firstDiff);
+
+		SPtr<SerializedObject> secondDiff0 = findComponentDiff(secondDiff->_getRoot(), cmp0);
+		SPtr<SerializedObject> secondDiff1 = findComponentDiff(secondDiff->_getRoot(), cmp1);
+		SPtr<SerializedObject> secondDiffBone = findComponentDiff(secondDiff->_getRoot(), bone);
+		BS_TEST_ASSERT(secondDiff0 != nullptr && secondDiff0 == firstDiff0);
+		BS_TEST_ASSERT(secondDiff1 != nullptr && secondDiff1 != firstDiff1);
+		BS_TEST_ASSERT(secondDiffBone != nullptr && secondDiffBone == firstDiffBone);
+
+		// Both the reused and the newly generated diff must apply correctly
+		prefab = gResources().load<Prefab>(prefabPath);
+		HSceneObject newRoot = prefab->instantiate();
+		secondDiff->apply(newRoot);
+
+		GameObjectHandle<TestComponentC> ncmp0 = newRoot->getChild(0)->getComponent<TestComponentC>();
+		GameObjectHandle<TestComponentD> ncmp1 = newRoot->getChild(1)->getComponent<TestComponentD>();
+		HBone nbone = newRoot->getChild(0)->getComponent<CBone>();
+		BS_TEST_ASSERT(ncmp0->obj.strA == "banana");
+		BS_TEST_ASSERT(ncmp1->obj.strA == "orange");
+		BS_TEST_ASSERT(nbone->getBoneName() == "boneB");
+
+		// A different prefab hash must invalidate the cache, even if the instance didn't change
+		SPtr<PrefabDiff> thirdDiff = PrefabDiff::create(prefab->_getRoot(), root, prefabHash + 1, secondDiff);
+
+		SPtr<SerializedObject> thirdDiff0 = findComponentDiff(thirdDiff->_getRoot(), cmp0);
+		SPtr<SerializedObject> thirdDiff1 = findComponentDiff(thirdDiff->_getRoot(), cmp1);
+		BS_TEST_ASSERT(thirdDiff0 != nullptr && thirdDiff0 != secondDiff0);
+		BS_TEST_ASSERT(thirdDiff1 != nullptr && thirdDiff1 != secondDiff1);
+
+		HSceneObject thirdRoot = prefab->instantiate();
+		thirdDiff->apply(thirdRoot);
+
+		ncmp0 = thirdRoot->getChild(0)->getComponent<TestComponentC>();
+		ncmp1 = thirdRoot->getChild(1)->getComponent<TestComponentD>();
+		nbone = thirdRoot->getChild(0)->getComponent<CBone>();
+		BS_TEST_ASSERT(ncmp0->obj.strA == "banana");
+		BS_TEST_ASSERT(ncmp1->obj.strA == "orange");
+		BS_TEST_ASSERT(nbone->getBoneName() == "boneB");
+
+		// Modifying the bone must invalidate only its own cached diff
+		bone->setBoneName("boneC");
+
+		SPtr<PrefabDiff> fourthDiff = PrefabDiff::create(prefab->_getRoot(), root, prefabHash + 1, thirdDiff);
+
+		SPtr<SerializedObject> thirdDiffBone = findComponentDiff(thirdDiff->_getRoot(), bone);
+		SPtr<SerializedObject> fourthDiff0 = findComponentDiff(fourthDiff->_getRoot(), cmp0);
+		SPtr<SerializedObject> fourthDiffBone = findComponentDiff(fourthDiff->_getRoot(), bone);
+		BS_TEST_ASSERT(fourthDiff0 != nullptr && fourthDiff0 == thirdDiff0);
+		BS_TEST_ASSERT(fourthDiffBone != nullptr && fourthDiffBone != thirdDiffBone);
+
+		HSceneObject fourthRoot = prefab->instantiate();
+		fourthDiff->apply(fourthRoot);
+
+		nbone = fourthRoot->getChild(0)->getComponent<CBone>();
+		BS_TEST_ASSERT(nbone->getBoneName() == "boneC");
+
+		// Diffs created without a cache must match the cached ones
+		SPtr<PrefabDiff> uncachedDiff = PrefabDiff::create(prefab->_getRoot(), root);
+		BS_TEST_ASSERT(findComponentDiff(uncachedDiff->_getRoot(), cmp0) != nullptr);
+		BS_TEST_ASSERT(findComponentDiff(uncachedDiff->_getRoot(), cmp1) != nullptr);
+		BS_TEST_ASSERT(findComponentDiff(uncachedDiff->_getRoot(), bone) != nullptr);
+
+		root->destroy();
+		newRoot->destroy();
+		thirdRoot->destroy();
+		fourthRoot->destroy();
+	}
+
 	void EditorTestSuite::TestFrameAlloc()
 	{
 		FrameAlloc alloc(128);
@@ -808,4 +1122,488 @@ namespace bs
 		alloc.dealloc(a13);
 		alloc.clear();
 	}
+
+	/**
+	 * Creates an empty folder with the specified name in the temporary directory, removing any contents left over from a
+	 * previous run.
+	 */
+	static Path createTestFolder(const String& name)
+	{
+		Path testFolder = FileSystem::getTempDirectoryPath();
+		testFolder.append(name + "/");
+
+		if (FileSystem::exists(testFolder))
+			FileSystem::remove(testFolder);
+
+		FileSystem::createDir(testFolder);
+		return testFolder;
+	}
+
+	/** Creates or overwrites a file at the specified path and writes the provided contents to it. */
+	static void writeTestFile(const Path& path, const String& contents)
+	{
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(path);
+		stream->write(contents.data(), contents.size());
+		stream->close();
+	}
+
+	void EditorTestSuite::TestFolderMonitor()
+	{
+		Path testFolder = createTestFolder("BsFolderMonitorTest");
+
+		// Create a small tree, with changes happening in the last folder
+		Path folder;
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			folder = testFolder;
+			folder.append("Folder" + toString(i) + "/");
+			FileSystem::createDir(folder);
+
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				Path file = folder;
+				file.append("File" + toString(j) + ".txt");
+				writeTestFile(file, "");
+			}
+		}
+
+		FolderMonitor monitor;
+
+		// Any reported path outside of the modified folder (e.g. the root folder being reported as modified) means
+		// the tree would need to be rescanned
+		bool reportedOtherPath = false;
+		auto checkPath = [&](const Path& path)
+		{
+			if (!folder.includes(path))
+				reportedOtherPath = true;
+		};
+
+		Path added, modified, renamedFrom, renamedTo;
+		monitor.onAdded.connect([&](const Path& path) { added = path; checkPath(path); });
+		monitor.onModified.connect([&](const Path& path) { modified = path; checkPath(path); });
+		monitor.onRemoved.connect([&](const Path& path) { checkPath(path); });
+		monitor.onRenamed.connect([&](const Path& from, const Path& to)
+		{
+			renamedFrom = from;
+			renamedTo = to;
+
+			checkPath(from);
+			checkPath(to);
+		});
+
+		FolderChange folderChanges = (FolderChange)((UINT32)FolderChange::FileName | (UINT32)FolderChange::DirName |
+			(UINT32)FolderChange::Creation | (UINT32)FolderChange::LastWrite);
+		monitor.startMonitor(testFolder, true, folderChanges);
+
+		auto waitUntil = [&](const std::function<bool()>& condition)
+		{
+			UINT64 timeout = gTime().getTimePrecise() + 5000 * 1000;
+			while (!condition() && gTime().getTimePrecise() < timeout)
+			{
+				monitor._update();
+				BS_THREAD_SLEEP(1);
+			}
+		};
+
+		Path file = folder;
+		file.append("NewFile.txt");
+
+		Path renamedFile = folder;
+		renamedFile.append("RenamedFile.txt");
+
+		writeTestFile(file, "");
+		waitUntil([&]() { return added == file; });
+		BS_TEST_ASSERT(added == file);
+
+		writeTestFile(file, "Modified");
+		waitUntil([&]() { return modified == file; });
+		BS_TEST_ASSERT(modified == file);
+
+		FileSystem::move(file, renamedFile);
+		waitUntil([&]() { return renamedFrom == file && renamedTo == renamedFile; });
+		BS_TEST_ASSERT(renamedFrom == file && renamedTo == renamedFile);
+
+		// Files starting with a dot are reported like any other
+		Path hiddenFile = folder;
+		hiddenFile.append(".HiddenFile");
+
+		writeTestFile(hiddenFile, "");
+		waitUntil([&]() { return added == hiddenFile; });
+		BS_TEST_ASSERT(added == hiddenFile);
+
+		BS_TEST_ASSERT(!reportedOtherPath);
+
+		monitor.stopMonitorAll();
+		FileSystem::remove(testFolder);
+	}
+
+	void EditorTestSuite::TestImportCache()
+	{
+		Path testFolder = createTestFolder("BsImportCacheTest");
+
+		Path cacheFolder = testFolder;
+		cacheFolder.append("Cache/");
+
+		Path sourcePath = testFolder;
+		sourcePath.append("Source.txt");
+
+		Path includePath = testFolder;
+		includePath.append("Include.txt");
+
+		writeTestFile(sourcePath, "Original");
+		writeTestFile(includePath, "Include");
+
+		// Saves a resource the same way the project library saves imported resources, before they are cached
+		auto saveResource = [&testFolder](const WString& contents, const String& fileName, Vector<SubResource>& resources,
+			Vector<Path>& files)
+		{
+			HResource handle = gResources()._createResourceHandle(PlainText::_createPtr(contents));
+
+			Path path = testFolder;
+			path.append(fileName);
+			gResources().save(handle, path, true);
+
+			resources = { { L"primary", handle } };
+			files = { path };
+		};
+
+		ImportCache cache(cacheFolder);
+
+		String key = cache.getKey(sourcePath, nullptr);
+		BS_TEST_ASSERT(!key.empty());
+
+		ImportCacheEntry entry;
+		BS_TEST_ASSERT(!cache.find(key, entry));
+
+		Vector<SubResource> resources;
+		Vector<Path> files;
+		saveResource(L"Original", "Original.asset", resources, files);
+
+		cache.add(key, resources, files, { includePath }, 1.0f);
+
+		BS_TEST_ASSERT(cache.find(key, entry));
+		BS_TEST_ASSERT(entry.resources.size() == 1 && entry.resources[0].name == L"primary");
+		BS_TEST_ASSERT(entry.uuids.size() == 1 && entry.uuids[0] == resources[0].value.getUUID());
+
+		SPtr<PlainText> text = std::static_pointer_cast<PlainText>(entry.resources[0].value);
+		BS_TEST_ASSERT(text != nullptr && text->getString() == L"Original");
+
+		// Cached files are stored as they were saved, so they can be written out without serializing them again
+		BS_TEST_ASSERT(entry.files.size() == 1 && entry.files[0]->size() == FileSystem::getFileSize(files[0]));
+
+		cache.notifyRestored(entry, 0.0f);
+
+		// Touching or rewriting the file with the same contents must map to the same entry
+		writeTestFile(sourcePath, "Modified");
+		BS_TEST_ASSERT(cache.getKey(sourcePath, nullptr) != key);
+
+		writeTestFile(sourcePath, "Original");
+		BS_TEST_ASSERT(cache.getKey(sourcePath, nullptr) == key);
+
+		// Importers name the resources after the source file, so a file with the same contents but a different name
+		// must not restore the entry
+		Path copyPath = testFolder;
+		copyPath.append("Copy.txt");
+		writeTestFile(copyPath, "Original");
+
+		String copyKey = cache.getKey(copyPath, nullptr);
+		BS_TEST_ASSERT(!copyKey.empty() && copyKey != key);
+		BS_TEST_ASSERT(!cache.find(copyKey, entry));
+		BS_TEST_ASSERT(entry.resources.empty());
+
+		Vector<SubResource> copyResources;
+		Vector<Path> copyFiles;
+		saveResource(L"Copy", "Copy.asset", copyResources, copyFiles);
+
+		cache.add(copyKey, copyResources, copyFiles, {}, 1.0f);
+
+		// Found entries replace the output contents, rather than being appended to them
+		BS_TEST_ASSERT(cache.find(copyKey, entry));
+		BS_TEST_ASSERT(cache.find(key, entry));
+		BS_TEST_ASSERT(entry.resources.size() == 1);
+
+		text = std::static_pointer_cast<PlainText>(entry.resources[0].value);
+		BS_TEST_ASSERT(text != nullptr && text->getString() == L"Original");
+
+		// Modifying a dependency invalidates the entry
+		writeTestFile(includePath, "Modified include");
+		BS_TEST_ASSERT(!cache.find(key, entry));
+
+		ImportCacheStats stats = cache.getStats();
+		BS_TEST_ASSERT(stats.numHits == 3 && stats.numMisses == 3);
+		BS_TEST_ASSERT(stats.timeSaved > 0.0f);
+
+		// Once over the size limit, older entries are evicted while the newly stored one is kept
+		ImportCache smallCache(cacheFolder, 1);
+		smallCache.add(key, resources, files, {}, 1.0f);
+		BS_TEST_ASSERT(!smallCache.find(copyKey, entry));
+		BS_TEST_ASSERT(smallCache.find(key, entry));
+
+		smallCache.add(copyKey, copyResources, copyFiles, {}, 1.0f);
+		BS_TEST_ASSERT(!smallCache.find(key, entry));
+		BS_TEST_ASSERT(smallCache.find(copyKey, entry));
+
+		FileSystem::remove(testFolder);
+	}
+
+	void EditorTestSuite::TestDependencyOrderedLoad()
+	{
+		const UINT32 MAX_CONCURRENT_LOADS = 2;
+		const UINT32 NUM_LEVELS = 4;
+
+		Path testFolder = createTestFolder("BsDependencyOrderedLoadTest");
+
+		// Create a tree of resources where each resource depends on two resources in the level below it, and save them
+		Path rootPath;
+		Vector<String> uuids;
+		{
+			Vector<HResource> level;
+			for (UINT32 i = 0; i < NUM_LEVELS; i++)
+			{
+				UINT32 numResources = 1 << (NUM_LEVELS - i - 1);
+
+				Vector<HResource> nextLevel;
+				for (UINT32 j = 0; j < numResources; j++)
+				{
+					SPtr<TestResource> resource = TestResource::_createPtr();
+					if (!level.empty())
+						resource->dependencies = { level[j * 2], level[j * 2 + 1] };
+
+					HResource handle = gResources()._createResourceHandle(resource);
+
+					Path path = testFolder;
+					path.append("Resource" + toString(i) + "_" + toString(j) + ".asset");
+					gResources().save(handle, path, true);
+
+					uuids.push_back(handle.getUUID());
+					nextLevel.push_back(handle);
+
+					rootPath = path;
+				}
+
+				level = nextLevel;
+			}
+		}
+
+		// All handles went out of scope, so everything needs to be loaded from disk again
+		for (auto& uuid : uuids)
+			BS_TEST_ASSERT(!gResources().isLoaded(uuid));
+
+		UINT32 prevMaxConcurrentLoads = gResources().getMaxConcurrentLoads();
+		gResources().setMaxConcurrentLoads(MAX_CONCURRENT_LOADS);
+
+		TestResource::numDeserializing = 0;
+		TestResource::maxDeserializing = 0;
+
+		HResource root = gResources().loadAsync(rootPath, ResourceLoadFlag::LoadDependencies);
+		root.blockUntilLoaded(true);
+
+		for (auto& uuid : uuids)
+			BS_TEST_ASSERT(gResources().isLoaded(uuid, false));
+
+		BS_TEST_ASSERT(TestResource::maxDeserializing > 0);
+		BS_TEST_ASSERT(TestResource::maxDeserializing <= MAX_CONCURRENT_LOADS);
+
+		// Every resource must start deserializing only after all of its dependencies finished deserializing
+		for (auto& uuid : uuids)
+		{
+			HResource handle = gResources()._getResourceHandle(uuid);
+			SPtr<TestResource> resource = std::static_pointer_cast<TestResource>(handle.getInternalPtr());
+
+			BS_TEST_ASSERT(resource->deserializationStart > 0);
+			BS_TEST_ASSERT(resource->deserializationEnd > resource->deserializationStart);
+
+			for (auto& dependency : resource->dependencies)
+			{
+				SPtr<TestResource> depResource = std::static_pointer_cast<TestResource>(dependency.getInternalPtr());
+				BS_TEST_ASSERT(depResource->deserializationEnd > 0);
+				BS_TEST_ASSERT(depResource->deserializationEnd < resource->deserializationStart);
+			}
+		}
+
+		gResources().setMaxConcurrentLoads(prevMaxConcurrentLoads);
+
+		root = nullptr;
+		FileSystem::remove(testFolder);
+	}
+
+	void EditorTestSuite::TestTaskCoreCommands()
+	{
+		std::atomic<bool> executed(false);
+
+		SPtr<Task> task = Task::create("TestCoreCommands", [&executed]()
+		{
+			// Deliberately not followed by a submit()
+			gCoreThread().queueCommand([&executed]() { executed.store(true); });
+		});
+
+		TaskScheduler::instance().addTask(task);
+		task->wait();
+
+		gCoreThread().submitAll(true);
+		BS_TEST_ASSERT(executed.load());
+	}
+
+	void EditorTestSuite::TestTextSpriteAppend()
+	{
+		TEXT_SPRITE_DESC desc;
+		desc.font = BuiltinResources::instance().getDefaultFont();
+		desc.fontSize = (UINT32)desc.font->getClosestSize(8);
+
+		// Long enough to skip the layout cache, with empty lines and both kinds of line breaks
+		for (UINT32 i = 0; i < 8; i++)
+			desc.text += L"Paragraph " + toWString(i) + L" of the text, followed by an empty line.\n\n";
+
+		desc.text += L"Last\tline\r\nof the first paragraphs";
+
+		// Appended pieces continue the last line, add new lines, and start with line breaks that could merge with ones
+		// at the end of the previous text
+		WString appendedText[] = { L" continued", L"\n\nNew paragraph", L"\r", L"\nAfter a split break", L"\n",
+			L"\nAfter an empty line", L" \t tail" };
+
+		TextSprite appendedSprite;
+		appendedSprite.update(desc, 0);
+
+		for (auto& entry : appendedText)
+		{
+			desc.text += entry;
+			appendedSprite.update(desc, 0);
+
+			TextSprite fullSprite;
+			fullSprite.update(desc, 0);
+
+			UINT32 numElements = fullSprite.getNumRenderElements();
+			BS_TEST_ASSERT(appendedSprite.getNumRenderElements() == numElements);
+			if (appendedSprite.getNumRenderElements() != numElements)
+				return;
+
+			for (UINT32 i = 0; i < numElements; i++)
+			{
+				UINT32 numQuads = fullSprite.getNumQuads(i);
+				BS_TEST_ASSERT(appendedSprite.getNumQuads(i) == numQuads);
+				BS_TEST_ASSERT(appendedSprite.getMaterialInfo(i).texture == fullSprite.getMaterialInfo(i).texture);
+
+				if (appendedSprite.getNumQuads(i) != numQuads)
+					continue;
+
+				Vector<Vector2> vertices[2] = { Vector<Vector2>(numQuads * 4), Vector<Vector2>(numQuads * 4) };
+				Vector<Vector2> uvs[2] = { Vector<Vector2>(numQuads * 4), Vector<Vector2>(numQuads * 4) };
+				Vector<UINT32> indices[2] = { Vector<UINT32>(numQuads * 6), Vector<UINT32>(numQuads * 6) };
+
+				const TextSprite* sprites[2] = { &appendedSprite, &fullSprite };
+				for (UINT32 j = 0; j < 2; j++)
+				{
+					sprites[j]->fillBuffer((UINT8*)vertices[j].data(), (UINT8*)uvs[j].data(), indices[j].data(), 0, 0,
+						numQuads * 4, numQuads * 6, sizeof(Vector2), sizeof(UINT32), i, Vector2I(), Rect2I(), false);
+				}
+
+				for (UINT32 j = 0; j < numQuads * 4; j++)
+				{
+					BS_TEST_ASSERT(Math::approxEquals(vertices[0][j], vertices[1][j]));
+					BS_TEST_ASSERT(Math::approxEquals(uvs[0][j], uvs[1][j]));
+				}
+
+				BS_TEST_ASSERT(indices[0] == indices[1]);
+			}
+		}
+	}
+	void EditorTestSuite::TestDeserializedHandleResolve()
+	{
+		HSceneObject root = SceneObject::create("root");
+		HSceneObject soExternal = SceneObject::create("soExternal");
+		HSceneObject soMissing = SceneObject::create("soMissing");
+		GameObjectHandle<TestComponentA> cmpExternal = soExternal->addComponent<TestComponentA>();
+
+		Vector<GameObjectHandle<TestComponentA>> components;
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			HSceneObject child = SceneObject::create("child" + toString(i));
+			child->setParent(root);
+
+			components.push_back(child->addComponent<TestComponentA>());
+		}
+
+		// Internal, external and missing objects are each referenced by more than one handle
+		components[0]->ref1 = components[1]->SO();
+		components[0]->ref2 = cmpExternal;
+		components[1]->ref1 = components[1]->SO();
+		components[1]->ref2 = components[0];
+		components[2]->ref1 = soMissing;
+		components[2]->ref2 = cmpExternal;
+		components[3]->ref1 = soMissing;
+		components[3]->ref2 = components[0];
+
+		soMissing->destroy(true);
+
+		MemorySerializer ms;
+		UINT32 numBytes = 0;
+		UINT8* bytes = ms.encode(root.get(), numBytes);
+
+		GameObjectManager& gom = GameObjectManager::instance();
+		UINT32 prevFlags = gom.getDeserializationFlags();
+
+		UINT32 flagSets[] =
+		{
+			GODM_UseNewIds | GODM_RestoreExternal,
+			GODM_UseNewIds | GODM_BreakExternal,
+			GODM_UseNewIds | GODM_RestoreExternal | GODM_KeepMissing,
+			GODM_UseNewIds | GODM_BreakExternal | GODM_KeepMissing
+		};
+
+		for (auto& flags : flagSets)
+		{
+			gom.setDeserializationMode(flags);
+
+			// Keep deserialization active after decoding, so handles can also be resolved one by one for comparison
+			gom.startDeserialization();
+			SPtr<SceneObject> copy = std::static_pointer_cast<SceneObject>(ms.decode(bytes, numBytes));
+
+			Vector<GameObjectHandle<TestComponentA>> copyComponents;
+			Vector<GameObjectManager::UnresolvedHandle> expectedHandles;
+			for (UINT32 i = 0; i < (UINT32)components.size(); i++)
+			{
+				copyComponents.push_back(copy->getChild(i)->getComponent<TestComponentA>());
+
+				expectedHandles.push_back({ components[i]->ref1.getInstanceId(), HSceneObject() });
+				expectedHandles.push_back({ components[i]->ref2.getInstanceId(), HComponent() });
+			}
+
+			for (auto& entry : expectedHandles)
+				gom.resolveDeserializedHandle(entry, flags);
+
+			gom.endDeserialization();
+			copy->_instantiate();
+
+			for (UINT32 i = 0; i < (UINT32)copyComponents.size(); i++)
+			{
+				const GameObjectHandleBase& expectedRef1 = expectedHandles[i * 2 + 0].handle;
+				const GameObjectHandleBase& expectedRef2 = expectedHandles[i * 2 + 1].handle;
+
+				BS_TEST_ASSERT(copyComponents[i]->ref1._getHandleData()->mPtr == expectedRef1._getHandleData()->mPtr);
+				BS_TEST_ASSERT(copyComponents[i]->ref2._getHandleData()->mPtr == expectedRef2._getHandleData()->mPtr);
+			}
+
+			// Handles deserialized with the same ID share handle data
+			BS_TEST_ASSERT(copyComponents[0]->ref1._getHandleData() == copyComponents[1]->ref1._getHandleData());
+			BS_TEST_ASSERT(copyComponents[0]->ref2._getHandleData() == copyComponents[2]->ref2._getHandleData());
+			BS_TEST_ASSERT(copyComponents[1]->ref2._getHandleData() == copyComponents[3]->ref2._getHandleData());
+			BS_TEST_ASSERT(copyComponents[2]->ref1._getHandleData() == copyComponents[3]->ref1._getHandleData());
+
+			BS_TEST_ASSERT(copyComponents[0]->ref1 == copyComponents[1]->SO());
+			BS_TEST_ASSERT(copyComponents[1]->ref2 == copyComponents[0]);
+
+			bool externalRestored = copyComponents[0]->ref2 == cmpExternal;
+			BS_TEST_ASSERT(externalRestored == ((flags & GODM_RestoreExternal) != 0));
+
+			BS_TEST_ASSERT(copyComponents[2]->ref1.isDestroyed());
+
+			copy->getHandle()->destroy(true);
+		}
+
+		gom.setDeserializationMode(prevFlags);
+		bs_free(bytes);
+
+		root->destroy();
+		soExternal->destroy();
+	}
 }
\ No newline at end of file
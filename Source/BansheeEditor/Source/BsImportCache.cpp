@@ -0,0 +1,370 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsImportCache.h"
+#include "BsImporter.h"
+#include "BsImportOptions.h"
+#include "BsResource.h"
+#include "BsFileSystem.h"
+#include "BsDataStream.h"
+#include "BsMemorySerializer.h"
+#include "BsBinarySerializer.h"
+#include "BsTimer.h"
+#include "BsSavedResourceData.h"
+#include "BsCompression.h"
+
+namespace bs
+{
+	/** Writes a string to the stream, prefixed with its length. */
+	template<class T>
+	static void writeString(const SPtr<DataStream>& stream, const T& value)
+	{
+		UINT32 length = (UINT32)value.size();
+		stream->write(&length, sizeof(length));
+		stream->write(value.data(), length * sizeof(typename T::value_type));
+	}
+
+	/** Reads a string written by writeString(). Returns false if the stream doesn't contain enough data. */
+	template<class T>
+	static bool readString(const SPtr<DataStream>& stream, T& value)
+	{
+		UINT32 length = 0;
+		if (stream->read(&length, sizeof(length)) != sizeof(length))
+			return false;
+
+		UINT32 numBytes = length * sizeof(typename T::value_type);
+		if (numBytes > stream->size() - stream->tell())
+			return false;
+
+		value.resize(length);
+		return length == 0 || stream->read(&value[0], numBytes) == numBytes;
+	}
+
+	ImportCache::ImportCache(const Path& folder, UINT64 maxSize)
+		:mFolder(folder), mMaxSize(maxSize), mSize(0)
+	{ }
+
+	String ImportCache::getKey(const Path& sourcePath, const SPtr<const ImportOptions>& importOptions) const
+	{
+		String sourceHash = getFileHash(sourcePath);
+		if (sourceHash.empty())
+			return StringUtil::BLANK;
+
+		// Same contents could be imported differently depending on the extension, so it is included as well. Importers
+		// also name the resources after the source file, so files with same contents but different names can't share
+		// an entry.
+		String key = sourceHash + toString(sourcePath.getWFilename(false)) + toString(sourcePath.getWExtension()) + "_" +
+			toString(gImporter()._getImporterVersion(sourcePath));
+
+		if (importOptions != nullptr)
+		{
+			MemorySerializer ms;
+			UINT32 numBytes = 0;
+			UINT8* bytes = ms.encode(const_cast<ImportOptions*>(importOptions.get()), numBytes);
+
+			key += md5(String((const char*)bytes, numBytes));
+			bs_free(bytes);
+		}
+
+		return md5(key);
+	}
+
+	bool ImportCache::find(const String& key, ImportCacheEntry& output)
+	{
+		output = ImportCacheEntry();
+
+		Timer timer;
+
+		auto miss = [&]()
+		{
+			output = ImportCacheEntry();
+
+			Lock lock(mMutex);
+			mStats.numMisses++;
+
+			return false;
+		};
+
+		Path path = getEntryPath(key);
+		if (!FileSystem::isFile(path))
+			return miss();
+
+		// Read the entire entry into memory, since restored data blocks (e.g. pixel data) keep referencing the stream
+		// after this method returns, while the entry file itself can be overwritten by add() or deleted by clear()
+		SPtr<DataStream> fileStream = FileSystem::openFile(path);
+		if (fileStream == nullptr)
+			return miss();
+
+		SPtr<DataStream> stream = bs_shared_ptr_new<MemoryDataStream>(fileStream);
+		fileStream->close();
+
+		UINT32 version = 0;
+		if (stream->read(&version, sizeof(version)) != sizeof(version) || version != VERSION)
+			return miss();
+
+		if (stream->read(&output.importTime, sizeof(output.importTime)) != sizeof(output.importTime))
+			return miss();
+
+		UINT32 numDependencies = 0;
+		if (stream->read(&numDependencies, sizeof(numDependencies)) != sizeof(numDependencies))
+			return miss();
+
+		for (UINT32 i = 0; i < numDependencies; i++)
+		{
+			String dependencyPath;
+			String dependencyHash;
+			if (!readString(stream, dependencyPath) || !readString(stream, dependencyHash))
+				return miss();
+
+			if (getFileHash(dependencyPath) != dependencyHash)
+				return miss();
+		}
+
+		UINT32 numResources = 0;
+		if (stream->read(&numResources, sizeof(numResources)) != sizeof(numResources))
+			return miss();
+
+		for (UINT32 i = 0; i < numResources; i++)
+		{
+			WString name;
+			String uuid;
+			if (!readString(stream, name) || !readString(stream, uuid))
+				return miss();
+
+			UINT32 size = 0;
+			if (stream->read(&size, sizeof(size)) != sizeof(size) || size > stream->size() - stream->tell())
+				return miss();
+
+			SPtr<MemoryDataStream> file = bs_shared_ptr_new<MemoryDataStream>(size);
+			stream->read(file->getPtr(), size);
+
+			SPtr<Resource> resource = decodeResource(file);
+			if (resource == nullptr)
+				return miss();
+
+			output.resources.push_back({ name, resource });
+			output.uuids.push_back(uuid);
+			output.files.push_back(file);
+		}
+
+		output.restoreTime = timer.getMicroseconds() / 1000000.0f;
+
+		Lock lock(mMutex);
+		mStats.numHits++;
+
+		return true;
+	}
+
+	void ImportCache::add(const String& key, const Vector<SubResource>& resources, const Vector<Path>& files,
+		const Vector<Path>& dependencies, float importTime)
+	{
+		assert(resources.size() == files.size());
+
+		// Resources were already serialized when they were saved, so their files are stored as they are
+		Vector<SPtr<MemoryDataStream>> fileContents;
+		for (auto& entry : files)
+		{
+			if (!FileSystem::isFile(entry))
+				return;
+
+			SPtr<DataStream> fileStream = FileSystem::openFile(entry);
+			fileContents.push_back(bs_shared_ptr_new<MemoryDataStream>(fileStream));
+			fileStream->close();
+		}
+
+		Path path = getEntryPath(key);
+
+		// Write to a temporary file first, so readers never see a partially written entry
+		Path tempPath = path;
+		tempPath.setExtension(".tmp");
+
+		Lock lock(mMutex);
+
+		if (!FileSystem::exists(mFolder))
+			FileSystem::createDir(mFolder);
+
+		{
+			SPtr<DataStream> stream = FileSystem::createAndOpenFile(tempPath);
+
+			UINT32 version = VERSION;
+			stream->write(&version, sizeof(version));
+			stream->write(&importTime, sizeof(importTime));
+
+			UINT32 numDependencies = (UINT32)dependencies.size();
+			stream->write(&numDependencies, sizeof(numDependencies));
+
+			for (auto& dependency : dependencies)
+			{
+				writeString(stream, dependency.toString());
+				writeString(stream, getFileHash(dependency));
+			}
+
+			UINT32 numResources = (UINT32)resources.size();
+			stream->write(&numResources, sizeof(numResources));
+
+			for (UINT32 i = 0; i < numResources; i++)
+			{
+				writeString(stream, resources[i].name);
+				writeString(stream, resources[i].value.getUUID());
+
+				UINT32 numBytes = (UINT32)fileContents[i]->size();
+				stream->write(&numBytes, sizeof(numBytes));
+				stream->write(fileContents[i]->getPtr(), numBytes);
+			}
+
+			stream->close();
+		}
+
+		if (FileSystem::isFile(path))
+			mSize -= std::min(mSize, FileSystem::getFileSize(path));
+
+		FileSystem::move(tempPath, path, true);
+
+		mSize += FileSystem::getFileSize(path);
+		if (mSize > mMaxSize)
+			trim(path);
+	}
+
+	void ImportCache::notifyRestored(const ImportCacheEntry& entry, float storeTime)
+	{
+		Lock lock(mMutex);
+		mStats.timeSaved += std::max(0.0f, entry.importTime - (entry.restoreTime + storeTime));
+	}
+
+	void ImportCache::prune()
+	{
+		Lock lock(mMutex);
+		trim(Path::BLANK);
+	}
+
+	void ImportCache::clear()
+	{
+		Lock lock(mMutex);
+
+		if (FileSystem::exists(mFolder))
+			FileSystem::remove(mFolder, true);
+
+		mSize = 0;
+	}
+
+	ImportCacheStats ImportCache::getStats() const
+	{
+		Lock lock(mMutex);
+		return mStats;
+	}
+
+	void ImportCache::resetStats()
+	{
+		Lock lock(mMutex);
+		mStats = ImportCacheStats();
+	}
+
+	Path ImportCache::getEntryPath(const String& key) const
+	{
+		Path path = mFolder;
+		path.setFilename(key + ".asset");
+
+		return path;
+	}
+
+	String ImportCache::getFileHash(const Path& path)
+	{
+		if (!FileSystem::isFile(path))
+			return StringUtil::BLANK;
+
+		SPtr<DataStream> stream = FileSystem::openFile(path);
+		if (stream == nullptr)
+			return StringUtil::BLANK;
+
+		return md5(stream);
+	}
+
+	SPtr<Resource> ImportCache::decodeResource(const SPtr<MemoryDataStream>& file)
+	{
+		// Mirrors the format written by Resources::save()
+		UnorderedMap<String, UINT64> params;
+		params["keepSourceData"] = 1;
+
+		SPtr<DataStream> stream = file;
+
+		UINT32 size = 0;
+		if (stream->read(&size, sizeof(size)) != sizeof(size) || size > stream->size() - stream->tell())
+			return nullptr;
+
+		BinarySerializer bs;
+		SPtr<IReflectable> metaData = bs.decode(stream, size, params);
+		if (metaData == nullptr || !metaData->isDerivedFrom(SavedResourceData::getRTTIStatic()))
+			return nullptr;
+
+		if (stream->read(&size, sizeof(size)) != sizeof(size))
+			return nullptr;
+
+		UINT32 compressionMethod = std::static_pointer_cast<SavedResourceData>(metaData)->getCompressionMethod();
+		if (compressionMethod == 1)
+			stream = Compression::decompress(stream);
+		else if (compressionMethod == 2)
+			stream = Compression::decompressChunked(stream);
+		else if (size > stream->size() - stream->tell())
+			return nullptr;
+
+		if (stream == nullptr)
+			return nullptr;
+
+		SPtr<IReflectable> resource = bs.decode(stream, size, params);
+		if (resource == nullptr || !resource->isDerivedFrom(Resource::getRTTIStatic()))
+			return nullptr;
+
+		return std::static_pointer_cast<Resource>(resource);
+	}
+
+	void ImportCache::trim(const Path& keepPath)
+	{
+		struct EntryFile
+		{
+			Path path;
+			std::time_t time;
+			UINT64 size;
+		};
+
+		Vector<EntryFile> entries;
+		mSize = 0;
+
+		if (FileSystem::isDirectory(mFolder))
+		{
+			auto addEntry = [&](const Path& path)
+			{
+				// Left over by entries that failed to be written
+				if (path.getWExtension() != L".asset")
+				{
+					FileSystem::remove(path);
+					return true;
+				}
+
+				UINT64 size = FileSystem::getFileSize(path);
+				entries.push_back({ path, FileSystem::getLastModifiedTime(path), size });
+
+				mSize += size;
+				return true;
+			};
+
+			FileSystem::iterate(mFolder, addEntry, nullptr, false);
+		}
+
+		if (mSize <= mMaxSize)
+			return;
+
+		std::sort(entries.begin(), entries.end(),
+			[](const EntryFile& a, const EntryFile& b) { return a.time < b.time; });
+
+		for (auto& entry : entries)
+		{
+			if (mSize <= mMaxSize)
+				break;
+
+			if (entry.path == keepPath)
+				continue;
+
+			FileSystem::remove(entry.path);
+			mSize -= entry.size;
+		}
+	}
+}
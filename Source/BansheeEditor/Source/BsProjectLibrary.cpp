@@ -16,7 +16,13 @@
 #include "BsResource.h"
 #include "BsEditorApplication.h"
 #include "BsShader.h"
+#include "BsTaskScheduler.h"
+#include "BsCoreThread.h"
+#include "BsImportCache.h"
+#include "BsTimer.h"
+#include "BsDataStream.h"
 #include <regex>
+#include <exception>
 
 using namespace std::placeholders;
 
@@ -26,6 +32,7 @@ namespace bs
 	const Path ProjectLibrary::INTERNAL_RESOURCES_DIR = PROJECT_INTERNAL_DIR + GAME_RESOURCES_FOLDER_NAME;
 	const WString ProjectLibrary::LIBRARY_ENTRIES_FILENAME = L"ProjectLibrary.asset";
 	const WString ProjectLibrary::RESOURCE_MANIFEST_FILENAME = L"ResourceManifest.asset";
+	const Path ProjectLibrary::IMPORT_CACHE_DIR = PROJECT_INTERNAL_DIR + "ImportCache\\";
 
 	ProjectLibrary::LibraryEntry::LibraryEntry()
 		:type(LibraryEntryType::Directory), parent(nullptr)
@@ -50,6 +57,22 @@ namespace bs
 		:LibraryEntry(path, name, parent, LibraryEntryType::Directory)
 	{ }
 
+	struct ProjectLibrary::ImportJob
+	{
+		FileEntry* entry = nullptr;
+		SPtr<ImportOptions> importOptions;
+		bool isNative = false;
+		bool concurrent = false; /**< True if the source file can be imported on a worker thread. */
+
+		String cacheKey;
+		bool isCached = false; /**< True if the resources were restored from the import cache. */
+		ImportCacheEntry cacheEntry;
+		float importTime = 0.0f;
+
+		Vector<SubResourceRaw> resources;
+		std::exception_ptr error;
+	};
+
 	ProjectLibrary::ProjectLibrary()
 		: mRootEntry(nullptr), mIsLoaded(false)
 	{
@@ -157,6 +180,10 @@ namespace bs
 				Vector<bool> existingEntries;
 				Vector<LibraryEntry*> toDelete;
 
+				// Imports are deferred until the entire hierarchy is checked, so they can be performed as a batch
+				Vector<FileEntry*> toImport;
+				Vector<FileEntry*> existingToImport;
+
 				while(!todo.empty())
 				{
 					DirectoryEntry* currentDir = todo.top();
@@ -205,15 +232,17 @@ namespace bs
 							if(existingEntry != nullptr)
 							{
 								if (import)
-									reimportResourceInternal(existingEntry);
-
-								if (!isUpToDate(existingEntry))
+								{
+									toImport.push_back(existingEntry);
+									existingToImport.push_back(existingEntry);
+								}
+								else if (!isUpToDate(existingEntry))
 									dirtyResources.push_back(existingEntry->path);
 							}
 							else
 							{
 								if (import)
-									addResourceInternal(currentDir, filePath);
+									toImport.push_back(addResourceInternal(currentDir, filePath, nullptr, false, false));
 
 								dirtyResources.push_back(filePath);
 							}
@@ -266,17 +295,30 @@ namespace bs
 							todo.push(static_cast<DirectoryEntry*>(child));
 					}
 				}
+
+				if (!toImport.empty())
+				{
+					importResources(toImport);
+
+					for (auto& file : existingToImport)
+					{
+						if (!isUpToDate(file))
+							dirtyResources.push_back(file->path);
+					}
+				}
 			}
 		}
 	}
 
 	ProjectLibrary::FileEntry* ProjectLibrary::addResourceInternal(DirectoryEntry* parent, const Path& filePath, 
-		const SPtr<ImportOptions>& importOptions, bool forceReimport)
+		const SPtr<ImportOptions>& importOptions, bool forceReimport, bool import)
 	{
 		FileEntry* newResource = bs_new<FileEntry>(filePath, filePath.getWTail(), parent);
 		parent->mChildren.push_back(newResource);
 
-		reimportResourceInternal(newResource, importOptions, forceReimport);
+		if(import)
+			reimportResourceInternal(newResource, importOptions, forceReimport);
+
 		onEntryAdded(newResource->path);
 
 		return newResource;
@@ -362,202 +404,403 @@ namespace bs
 	void ProjectLibrary::reimportResourceInternal(FileEntry* fileEntry, const SPtr<ImportOptions>& importOptions,
 		bool forceReimport, bool pruneResourceMetas)
 	{
-		Path metaPath = fileEntry->path;
-		metaPath.setFilename(metaPath.getWFilename() + L".meta");
+		loadMeta(fileEntry);
 
-		if(fileEntry->meta == nullptr)
+		ImportJob job;
+		if (!prepareImport(fileEntry, importOptions, forceReimport, job))
+			return;
+
+		importSourceData(job);
+		finishImport(job, pruneResourceMetas);
+	}
+
+	void ProjectLibrary::importResources(const Vector<FileEntry*>& files)
+	{
+		UnorderedSet<Path> pending;
+		for (auto& file : files)
 		{
-			if(FileSystem::isFile(metaPath))
-			{
-				FileDecoder fs(metaPath);
-				SPtr<IReflectable> loadedMeta = fs.decode();
+			loadMeta(file);
+			pending.insert(file->path);
+		}
 
-				if(loadedMeta != nullptr && loadedMeta->isDerivedFrom(ProjectFileMeta::getRTTIStatic()))
-				{
-					SPtr<ProjectFileMeta> fileMeta = std::static_pointer_cast<ProjectFileMeta>(loadedMeta);
-					fileEntry->meta = fileMeta;
+		UINT32 numProcessed = 0;
+		UINT32 numTotal = (UINT32)files.size();
 
-					auto& resourceMetas = fileEntry->meta->getResourceMetaData();
+		Vector<FileEntry*> remaining = files;
+		Vector<FileEntry*> ready;
+		Vector<FileEntry*> blocked;
+		Vector<ImportJob> jobs;
+		while (!remaining.empty())
+		{
+			ready.clear();
+			blocked.clear();
 
-					if (resourceMetas.size() > 0)
-					{
-						mUUIDToPath[resourceMetas[0]->getUUID()] = fileEntry->path;
+			// Delay files that depend on files that haven't been imported yet (e.g. shaders and their includes)
+			for (auto& file : remaining)
+			{
+				bool isBlocked = false;
 
-						for (UINT32 i = 1; i < (UINT32)resourceMetas.size(); i++)
-						{
-							SPtr<ProjectResourceMeta> entry = resourceMetas[i];
-							mUUIDToPath[entry->getUUID()] = fileEntry->path + entry->getUniqueName();
-						}
+				Vector<Path> dependencies = getImportDependencies(file);
+				for (auto& dependency : dependencies)
+				{
+					if (dependency != file->path && pending.find(dependency) != pending.end())
+					{
+						isBlocked = true;
+						break;
 					}
 				}
+
+				if (isBlocked)
+					blocked.push_back(file);
+				else
+					ready.push_back(file);
 			}
-		}
 
-		if (!isUpToDate(fileEntry) || forceReimport)
-		{
-			// Note: If resource is native we just copy it to the internal folder. We could avoid the copy and 
-			// load the resource directly from the Resources folder but that requires complicating library code.
-			bool isNativeResource = isNative(fileEntry->path);
+			// Circular dependency, import everything that's left
+			if (ready.empty())
+				std::swap(ready, blocked);
+
+			for (auto& file : ready)
+				pending.erase(file->path);
 
-			SPtr<ImportOptions> curImportOptions = nullptr;
-			if (importOptions == nullptr && !isNativeResource)
+			jobs.clear();
+			for (auto& file : ready)
 			{
-				if (fileEntry->meta != nullptr)
-					curImportOptions = fileEntry->meta->getImportOptions();
+				ImportJob job;
+				if (prepareImport(file, nullptr, false, job))
+					jobs.push_back(job);
 				else
-					curImportOptions = Importer::instance().createImportOptions(fileEntry->path);
+					onImportProgress(++numProcessed, numTotal);
 			}
-			else
-				curImportOptions = importOptions;
 
-			Vector<SubResource> importedResources;
-			if (isNativeResource)
+			// Import source files using thread-safe importers on worker threads, while the rest are imported here
+			SPtr<TaskGroup> importGroup = TaskGroup::create("ProjectLibraryImport");
+			for (auto& job : jobs)
 			{
-				// If meta exists make sure it is registered in the manifest before load, otherwise it will get assigned a new UUID.
-				// This can happen if library isn't properly saved before exiting the application.
-				if (fileEntry->meta != nullptr)
+				if (job.concurrent)
 				{
-					auto& resourceMetas = fileEntry->meta->getResourceMetaData();
-					mResourceManifest->registerResource(resourceMetas[0]->getUUID(), fileEntry->path);
-				}
+					ImportJob* jobPtr = &job;
+					importGroup->run([this, jobPtr]()
+					{
+						importSourceData(*jobPtr);
 
-				// Don't load dependencies because we don't need them, but also because they might not be in the manifest
-				// which would screw up their UUIDs.
-				importedResources.push_back({ L"primary", gResources().load(fileEntry->path, ResourceLoadFlag::KeepSourceData) });
+						// Core thread commands queued by the importer (e.g. texture writes) can only be submitted from
+						// this thread. This also ensures they execute before any commands we queue when saving the
+						// resources, as submission blocks until they do.
+						gCoreThread().submit();
+					});
+				}
 			}
 
-			if(fileEntry->meta == nullptr)
+			for (auto& job : jobs)
 			{
-				if (!isNativeResource)
-					importedResources = Importer::instance().importAll(fileEntry->path, curImportOptions);
+				if (!job.concurrent)
+					importSourceData(job);
+			}
 
-				fileEntry->meta = ProjectFileMeta::create(curImportOptions);
+			importGroup->wait();
 
-				for(auto& entry : importedResources)
+			// A file that fails to import shouldn't prevent the rest of the files from being imported
+			for (auto& job : jobs)
+			{
+				try
 				{
-					SPtr<ResourceMetaData> subMeta = entry.value->getMetaData();
-					UINT32 typeId = entry.value->getTypeId();
-					const String& UUID = entry.value.getUUID();
-
-					SPtr<ProjectResourceMeta> resMeta = ProjectResourceMeta::create(entry.name, UUID, typeId, subMeta);
-					fileEntry->meta->add(resMeta);
+					finishImport(job, false);
 				}
+				catch (const std::exception& e)
+				{
+					LOGERR("Failed to import \"" + job.entry->path.toString() + "\": " + e.what());
+				}
+				catch (...)
+				{
+					LOGERR("Failed to import \"" + job.entry->path.toString() + "\".");
+				}
+
+				onImportProgress(++numProcessed, numTotal);
+			}
+
+			std::swap(remaining, blocked);
+		}
+	}
+
+	void ProjectLibrary::loadMeta(FileEntry* fileEntry)
+	{
+		if (fileEntry->meta != nullptr)
+			return;
+
+		Path metaPath = fileEntry->path;
+		metaPath.setFilename(metaPath.getWFilename() + L".meta");
+
+		if(FileSystem::isFile(metaPath))
+		{
+			FileDecoder fs(metaPath);
+			SPtr<IReflectable> loadedMeta = fs.decode();
+
+			if(loadedMeta != nullptr && loadedMeta->isDerivedFrom(ProjectFileMeta::getRTTIStatic()))
+			{
+				SPtr<ProjectFileMeta> fileMeta = std::static_pointer_cast<ProjectFileMeta>(loadedMeta);
+				fileEntry->meta = fileMeta;
 
-				if(importedResources.size() > 0)
+				auto& resourceMetas = fileEntry->meta->getResourceMetaData();
+
+				if (resourceMetas.size() > 0)
 				{
-					HResource primary = importedResources[0].value;
+					mUUIDToPath[resourceMetas[0]->getUUID()] = fileEntry->path;
 
-					mUUIDToPath[primary.getUUID()] = fileEntry->path;
-					for (UINT32 i = 1; i < (UINT32)importedResources.size(); i++)
+					for (UINT32 i = 1; i < (UINT32)resourceMetas.size(); i++)
 					{
-						SubResource& entry = importedResources[i];
-
-						const String& UUID = entry.value.getUUID();
-						mUUIDToPath[UUID] = fileEntry->path + entry.name;
+						SPtr<ProjectResourceMeta> entry = resourceMetas[i];
+						mUUIDToPath[entry->getUUID()] = fileEntry->path + entry->getUniqueName();
 					}
 				}
-
-				FileEncoder fs(metaPath);
-				fs.encode(fileEntry->meta.get());
 			}
+		}
+	}
+
+	bool ProjectLibrary::prepareImport(FileEntry* fileEntry, const SPtr<ImportOptions>& importOptions,
+		bool forceReimport, ImportJob& job)
+	{
+		if (isUpToDate(fileEntry) && !forceReimport)
+			return false;
+
+		// Note: If resource is native we just copy it to the internal folder. We could avoid the copy and
+		// load the resource directly from the Resources folder but that requires complicating library code.
+		job.entry = fileEntry;
+		job.isNative = isNative(fileEntry->path);
+
+		if (importOptions == nullptr && !job.isNative)
+		{
+			if (fileEntry->meta != nullptr)
+				job.importOptions = fileEntry->meta->getImportOptions();
 			else
+				job.importOptions = Importer::instance().createImportOptions(fileEntry->path);
+		}
+		else
+			job.importOptions = importOptions;
+
+		job.concurrent = !job.isNative && gImporter()._supportsConcurrentImport(fileEntry->path);
+		return true;
+	}
+
+	void ProjectLibrary::importSourceData(ImportJob& job) const
+	{
+		if (job.isNative)
+			return;
+
+		try
+		{
+			if (mImportCache != nullptr)
+			{
+				job.cacheKey = mImportCache->getKey(job.entry->path, job.importOptions);
+				if (!job.cacheKey.empty() && mImportCache->find(job.cacheKey, job.cacheEntry))
+				{
+					job.resources = job.cacheEntry.resources;
+					job.isCached = true;
+					return;
+				}
+			}
+
+			Timer timer;
+			job.resources = gImporter()._importAllRaw(job.entry->path, job.importOptions);
+			job.importTime = timer.getMicroseconds() / 1000000.0f;
+		}
+		catch (...)
+		{
+			job.error = std::current_exception();
+		}
+	}
+
+	void ProjectLibrary::finishImport(ImportJob& job, bool pruneResourceMetas)
+	{
+		if (job.error != nullptr)
+			std::rethrow_exception(job.error);
+
+		FileEntry* fileEntry = job.entry;
+
+		Path metaPath = fileEntry->path;
+		metaPath.setFilename(metaPath.getWFilename() + L".meta");
+
+		Vector<SubResource> importedResources;
+		if (job.isNative)
+		{
+			// If meta exists make sure it is registered in the manifest before load, otherwise it will get assigned a new UUID.
+			// This can happen if library isn't properly saved before exiting the application.
+			if (fileEntry->meta != nullptr)
+			{
+				auto& resourceMetas = fileEntry->meta->getResourceMetaData();
+				mResourceManifest->registerResource(resourceMetas[0]->getUUID(), fileEntry->path);
+			}
+
+			// Don't load dependencies because we don't need them, but also because they might not be in the manifest
+			// which would screw up their UUIDs.
+			importedResources.push_back({ L"primary", gResources().load(fileEntry->path, ResourceLoadFlag::KeepSourceData) });
+		}
+
+		if(fileEntry->meta == nullptr)
+		{
+			for (auto& entry : job.resources)
+				importedResources.push_back({ entry.name, gResources()._createResourceHandle(entry.value) });
+
+			fileEntry->meta = ProjectFileMeta::create(job.importOptions);
+
+			for(auto& entry : importedResources)
 			{
-				removeDependencies(fileEntry);
+				SPtr<ResourceMetaData> subMeta = entry.value->getMetaData();
+				UINT32 typeId = entry.value->getTypeId();
+				const String& UUID = entry.value.getUUID();
+
+				SPtr<ProjectResourceMeta> resMeta = ProjectResourceMeta::create(entry.name, UUID, typeId, subMeta);
+				fileEntry->meta->add(resMeta);
+			}
 
-				if (!isNativeResource)
+			if(importedResources.size() > 0)
+			{
+				HResource primary = importedResources[0].value;
+
+				mUUIDToPath[primary.getUUID()] = fileEntry->path;
+				for (UINT32 i = 1; i < (UINT32)importedResources.size(); i++)
 				{
-					Vector<SubResourceRaw> importedResourcesRaw = gImporter()._importAllRaw(fileEntry->path, curImportOptions);
-					Vector<SPtr<ProjectResourceMeta>> existingResourceMetas = fileEntry->meta->getAllResourceMetaData();
-					fileEntry->meta->clearResourceMetaData();
+					SubResource& entry = importedResources[i];
 
-					for(auto& resEntry : importedResourcesRaw)
-					{
-						bool foundMeta = false;
-						for (auto iter = existingResourceMetas.begin(); iter != existingResourceMetas.end(); ++iter)
-						{
-							SPtr<ProjectResourceMeta> metaEntry = *iter;
+					const String& UUID = entry.value.getUUID();
+					mUUIDToPath[UUID] = fileEntry->path + entry.name;
+				}
+			}
 
-							if(resEntry.name == metaEntry->getUniqueName())
-							{
-								HResource importedResource = gResources()._getResourceHandle(metaEntry->getUUID());
-								gResources().update(importedResource, resEntry.value);
+			FileEncoder fs(metaPath);
+			fs.encode(fileEntry->meta.get());
+		}
+		else
+		{
+			removeDependencies(fileEntry);
 
-								importedResources.push_back({ resEntry.name, importedResource });
-								fileEntry->meta->add(metaEntry);
+			if (!job.isNative)
+			{
+				Vector<SPtr<ProjectResourceMeta>> existingResourceMetas = fileEntry->meta->getAllResourceMetaData();
+				fileEntry->meta->clearResourceMetaData();
 
-								existingResourceMetas.erase(iter);
-								foundMeta = true;
-								break;
-							}
-						}
+				for(auto& resEntry : job.resources)
+				{
+					bool foundMeta = false;
+					for (auto iter = existingResourceMetas.begin(); iter != existingResourceMetas.end(); ++iter)
+					{
+						SPtr<ProjectResourceMeta> metaEntry = *iter;
 
-						if(!foundMeta)
+						if(resEntry.name == metaEntry->getUniqueName())
 						{
-							HResource importedResource = gResources()._createResourceHandle(resEntry.value);
-							importedResources.push_back({ resEntry.name, importedResource });
+							HResource importedResource = gResources()._getResourceHandle(metaEntry->getUUID());
+							gResources().update(importedResource, resEntry.value);
 
-							SPtr<ResourceMetaData> subMeta = resEntry.value->getMetaData();
-							UINT32 typeId = resEntry.value->getTypeId();
-							const String& UUID = importedResource.getUUID();
+							importedResources.push_back({ resEntry.name, importedResource });
+							fileEntry->meta->add(metaEntry);
 
-							SPtr<ProjectResourceMeta> resMeta = ProjectResourceMeta::create(resEntry.name, UUID, typeId, subMeta);
-							fileEntry->meta->add(resMeta);
+							existingResourceMetas.erase(iter);
+							foundMeta = true;
+							break;
 						}
 					}
 
-					// Keep resource metas that we are not currently using, in case they get restored so their references
-					// don't get broken
-					if(!pruneResourceMetas)
+					if(!foundMeta)
 					{
-						for (auto& entry : existingResourceMetas)
-							fileEntry->meta->addInactive(entry);
-					}
+						HResource importedResource = gResources()._createResourceHandle(resEntry.value);
+						importedResources.push_back({ resEntry.name, importedResource });
 
-					// Update UUID to path mapping
-					auto& resourceMetas = fileEntry->meta->getResourceMetaData();
-					if (resourceMetas.size() > 0)
-					{
-						mUUIDToPath[resourceMetas[0]->getUUID()] = fileEntry->path;
+						SPtr<ResourceMetaData> subMeta = resEntry.value->getMetaData();
+						UINT32 typeId = resEntry.value->getTypeId();
+						const String& UUID = importedResource.getUUID();
 
-						for (UINT32 i = 1; i < (UINT32)resourceMetas.size(); i++)
-						{
-							SPtr<ProjectResourceMeta> entry = resourceMetas[i];
-							mUUIDToPath[entry->getUUID()] = fileEntry->path + entry->getUniqueName();
-						}
+						SPtr<ProjectResourceMeta> resMeta = ProjectResourceMeta::create(resEntry.name, UUID, typeId, subMeta);
+						fileEntry->meta->add(resMeta);
 					}
 				}
 
-				fileEntry->meta->mImportOptions = curImportOptions;
+				// Keep resource metas that we are not currently using, in case they get restored so their references
+				// don't get broken
+				if(!pruneResourceMetas)
+				{
+					for (auto& entry : existingResourceMetas)
+						fileEntry->meta->addInactive(entry);
+				}
+
+				// Update UUID to path mapping
+				auto& resourceMetas = fileEntry->meta->getResourceMetaData();
+				if (resourceMetas.size() > 0)
+				{
+					mUUIDToPath[resourceMetas[0]->getUUID()] = fileEntry->path;
 
-				FileEncoder fs(metaPath);
-				fs.encode(fileEntry->meta.get());
+					for (UINT32 i = 1; i < (UINT32)resourceMetas.size(); i++)
+					{
+						SPtr<ProjectResourceMeta> entry = resourceMetas[i];
+						mUUIDToPath[entry->getUUID()] = fileEntry->path + entry->getUniqueName();
+					}
+				}
 			}
 
-			addDependencies(fileEntry);
+			fileEntry->meta->mImportOptions = job.importOptions;
 
-			if (importedResources.size() > 0)
-			{
-				Path internalResourcesPath = mProjectFolder;
-				internalResourcesPath.append(INTERNAL_RESOURCES_DIR);
+			FileEncoder fs(metaPath);
+			fs.encode(fileEntry->meta.get());
+		}
+
+		addDependencies(fileEntry);
+
+		Timer storeTimer;
+		Vector<Path> resourcePaths;
+		if (importedResources.size() > 0)
+		{
+			Path internalResourcesPath = mProjectFolder;
+			internalResourcesPath.append(INTERNAL_RESOURCES_DIR);
+
+			if (!FileSystem::isDirectory(internalResourcesPath))
+				FileSystem::createDir(internalResourcesPath);
 
-				if (!FileSystem::isDirectory(internalResourcesPath))
-					FileSystem::createDir(internalResourcesPath);
+			// Resources restored from the import cache under the same UUIDs they were stored with can be written out
+			// exactly as they were saved, without serializing them again
+			bool restoreFiles = job.isCached && job.cacheEntry.uuids.size() == importedResources.size();
+			for (UINT32 i = 0; restoreFiles && i < (UINT32)importedResources.size(); i++)
+				restoreFiles = importedResources[i].value.getUUID() == job.cacheEntry.uuids[i];
 
-				for (auto& entry : importedResources)
+			for (UINT32 i = 0; i < (UINT32)importedResources.size(); i++)
+			{
+				SubResource& entry = importedResources[i];
+
+				internalResourcesPath.setFilename(toWString(entry.value.getUUID()) + L".asset");
+				if (restoreFiles)
 				{
-					internalResourcesPath.setFilename(toWString(entry.value.getUUID()) + L".asset");
-					gResources().save(entry.value, internalResourcesPath, true);
+					const SPtr<MemoryDataStream>& file = job.cacheEntry.files[i];
 
-					String uuid = entry.value.getUUID();
-					mResourceManifest->registerResource(uuid, internalResourcesPath);
+					SPtr<DataStream> stream = FileSystem::createAndOpenFile(internalResourcesPath);
+					stream->write(file->getPtr(), file->size());
+					stream->close();
 				}
+				else
+					gResources().save(entry.value, internalResourcesPath, true);
+
+				String uuid = entry.value.getUUID();
+				mResourceManifest->registerResource(uuid, internalResourcesPath);
+
+				resourcePaths.push_back(internalResourcesPath);
 			}
+		}
 
-			fileEntry->lastUpdateTime = std::time(nullptr);
+		float storeTime = storeTimer.getMicroseconds() / 1000000.0f;
 
-			onEntryImported(fileEntry->path);
-			reimportDependants(fileEntry->path);
+		// Store the results so the importer doesn't need to run again the next time the same contents are imported
+		if (mImportCache != nullptr && !job.cacheKey.empty())
+		{
+			if (job.isCached)
+				mImportCache->notifyRestored(job.cacheEntry, storeTime);
+			else if (!importedResources.empty())
+			{
+				mImportCache->add(job.cacheKey, importedResources, resourcePaths, getImportDependencies(fileEntry),
+					job.importTime + storeTime);
+			}
 		}
+
+		fileEntry->lastUpdateTime = std::time(nullptr);
+
+		onEntryImported(fileEntry->path);
+		reimportDependants(fileEntry->path);
 	}
 
 	bool ProjectLibrary::isUpToDate(FileEntry* resource) const
@@ -1297,6 +1540,7 @@ namespace bs
 		mDependencies.clear();
 		gResources().unregisterResourceManifest(mResourceManifest);
 		mResourceManifest = nullptr;
+		mImportCache = nullptr;
 		mIsLoaded = false;
 	}
 
@@ -1406,6 +1650,12 @@ namespace bs
 
 		gResources().registerResourceManifest(mResourceManifest);
 
+		Path importCachePath = mProjectFolder;
+		importCachePath.append(IMPORT_CACHE_DIR);
+
+		mImportCache = bs_shared_ptr_new<ImportCache>(importCachePath);
+		mImportCache->prune();
+
 		// Load all meta files
 		Stack<DirectoryEntry*> todo;
 		todo.push(mRootEntry);
@@ -87,14 +87,14 @@ namespace bs
 
 		Matrix4 viewProjMatrix = cam->getProjectionMatrixRS() * cam->getViewMatrix();
 
-		const Map<Renderable*, SceneRenderableData>& renderables = SceneManager::instance().getAllRenderables();
+		const SlotMap<SceneRenderableData>& renderables = SceneManager::instance().getAllRenderables();
 		RenderableSet pickData(comparePickElement);
 		Map<UINT32, HSceneObject> idxToRenderable;
 
 		for (auto& renderableData : renderables)
 		{
-			SPtr<Renderable> renderable = renderableData.second.renderable;
-			HSceneObject so = renderableData.second.sceneObject;
+			SPtr<Renderable> renderable = renderableData.renderable;
+			HSceneObject so = renderableData.sceneObject;
 
 			if (!so->getActive())
 				continue;
@@ -104,10 +104,12 @@ set(BS_BANSHEEENGINE_SRC_2D
 	"Source/BsSpriteMaterial.cpp"
 	"Source/BsSpriteMaterials.cpp"
 	"Source/BsSpriteManager.cpp"
+	"Source/BsTextLayoutCache.cpp"
 )
 
 set(BS_BANSHEEENGINE_SRC_UTILITY
 	"Source/BsDrawHelper.cpp"
+	"Source/BsEngineBenchmarkSuite.cpp"
 	"Source/BsGameSettings.cpp"
 	"Source/BsHEString.cpp"
 	"Source/BsPaths.cpp"
@@ -123,6 +125,7 @@ set(BS_BANSHEEENGINE_INC_2D
 	"Include/BsSpriteMaterial.h"
 	"Include/BsSpriteMaterials.h"
 	"Include/BsSpriteManager.h"
+	"Include/BsTextLayoutCache.h"
 )
 
 set(BS_BANSHEEENGINE_INC_RTTI
@@ -162,6 +165,7 @@ set(BS_BANSHEEENGINE_INC_SCRIPT
 
 set(BS_BANSHEEENGINE_INC_UTILITY
 	"Include/BsDrawHelper.h"
+	"Include/BsEngineBenchmarkSuite.h"
 	"Include/BsEnums.h"
 	"Include/BsGameSettings.h"
 	"Include/BsHEString.h"
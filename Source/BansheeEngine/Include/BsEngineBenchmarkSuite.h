@@ -0,0 +1,27 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsPrerequisites.h"
+#include "BsBenchmarkSuite.h"
+
+namespace bs
+{
+	/** @addtogroup Utility-Engine-Internal
+	 *  @{
+	 */
+
+	/** Benchmarks for engine systems. Expects the application to be started up before the benchmarks run. */
+	class BS_EXPORT EngineBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		EngineBenchmarkSuite(const BenchmarkParams& params);
+
+	private:
+		void benchmarkGUIMeshUpdate();
+		void benchmarkPrefabInstances();
+		void benchmarkHandleResolve();
+	};
+
+	/** @} */
+}
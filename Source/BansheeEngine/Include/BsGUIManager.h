@@ -24,6 +24,20 @@ namespace bs
 
 	namespace ct { class GUIRenderer; }
 
+	/** Identifies a single render element of a GUI element. */
+	struct GUIGroupElement
+	{
+		GUIGroupElement()
+		{ }
+
+		GUIGroupElement(GUIElement* _element, UINT32 _renderElement)
+			:element(_element), renderElement(_renderElement)
+		{ }
+
+		GUIElement* element;
+		UINT32 renderElement;
+	};
+
 	/**
 	 * Manages the rendering and input of all GUI widgets in the scene. 
 	 * 			
@@ -48,14 +62,47 @@ namespace bs
 			Dragging
 		};
 
+		/** Location of a single GUI render element within the cached meshes. */
+		struct GUICachedRenderElement
+		{
+			UINT32 meshIdx = 0;
+			UINT32 vertexOffset = 0;
+			UINT32 indexOffset = 0;
+			UINT32 numVertices = 0;
+			UINT32 numIndices = 0;
+			UINT32 depth = 0;
+			UINT64 mergeHash = 0;
+		};
+
 		/** Data required for rendering a single GUI mesh. */
 		struct GUIMeshData
 		{
 			SPtr<TransientMesh> mesh;
+			SPtr<MeshData> meshData;
 			SpriteMaterial* material;
 			SpriteMaterialInfo matInfo;
 			GUIWidget* widget;
+			Vector<GUIGroupElement> elements;
 			bool isLine;
+
+			/** 
+			 * Mesh data uploaded before the current one, reused by the next partial update once the core thread is done 
+			 * with it. Null after a full rebuild.
+			 */
+			SPtr<MeshData> prevMeshData;
+
+			/** Render elements refilled by the last partial update, whose contents are out of date in prevMeshData. */
+			Vector<GUICachedRenderElement> refilledElements;
+		};
+
+		/** 
+		 * State of a GUI element at the time the cached meshes were built. Used for determining if changes to the element
+		 * can be applied without regrouping the meshes.
+		 */
+		struct GUICachedElement
+		{
+			Rect2I bounds;
+			Vector<GUICachedRenderElement> renderElements;
 		};
 
 		/**	GUI render data for a single viewport. */
@@ -66,6 +113,7 @@ namespace bs
 			{ }
 
 			Vector<GUIMeshData> cachedMeshes;
+			UnorderedMap<GUIElement*, GUICachedElement> cachedElements;
 			Vector<GUIWidget*> widgets;
 			bool isDirty;
 		};
@@ -227,6 +275,23 @@ namespace bs
 		/**	Recreates all dirty GUI meshes and makes them ready for rendering. */
 		void updateMeshes();
 
+		/** Groups all elements rendered to a viewport into meshes, and rebuilds all the meshes. */
+		void rebuildMeshes(GUIRenderData& renderData);
+
+		/**
+		 * Refills the parts of the viewport meshes that belong to the elements in mDirtyElements, and re-uploads only the
+		 * affected meshes. Returns false without modifying anything if the elements changed in a way that requires them
+		 * to be regrouped, in which case rebuildMeshes() must be called instead.
+		 */
+		bool updateDirtyMeshes(GUIRenderData& renderData);
+
+		/**
+		 * Returns mesh data with the same contents as the last data uploaded for the provided mesh, that can be refilled
+		 * and uploaded again. Reuses the previously uploaded mesh data if the core thread no longer references it, in
+		 * which case only the render elements refilled since need to be copied. Otherwise makes a full copy.
+		 */
+		static SPtr<MeshData> getMeshDataForUpdate(GUIMeshData& meshData);
+
 		/**	Recreates the input caret texture. */
 		void updateCaretTexture();
 
@@ -351,6 +416,7 @@ namespace bs
 
 		SPtr<ct::GUIRenderer> mRenderer;
 		bool mCoreDirty;
+		Vector<GUIElement*> mDirtyElements;
 
 		SPtr<VertexDataDesc> mTriangleVertexDesc;
 		SPtr<VertexDataDesc> mLineVertexDesc;
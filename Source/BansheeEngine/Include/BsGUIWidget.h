@@ -67,6 +67,15 @@ namespace bs
 		 */
 		bool isDirty(bool cleanIfDirty);
 
+		/** 
+		 * Checks if the widget's GUI meshes need to be regrouped (e.g. due to elements being added or removed, or the
+		 * widget moving). If false, any changes are limited to the elements returned by _getDirtyContents().
+		 */
+		bool _isMeshDirty() const { return mWidgetIsDirty; }
+
+		/** Returns elements whose contents will be updated on the next call to isDirty(true). */
+		const Set<GUIElement*>& _getDirtyContents() const { return mDirtyContents; }
+
 		/**	Returns the viewport that this widget will be rendered on. */
 		Viewport* getTarget() const;
 
@@ -24,6 +24,9 @@ namespace bs
 		/** @copydoc SpecificImporter::import */
 		SPtr<Resource> import(const Path& filePath, SPtr<const ImportOptions> importOptions) override;
 
+		/** @copydoc SpecificImporter::isThreadSafe */
+		bool isThreadSafe() const override { return true; }
+
 		static const WString DEFAULT_EXTENSION;
 	};
 
@@ -44,7 +44,7 @@ namespace bs { namespace ct
 		/**	Data used for renderable element sorting. Represents a single pass for a single mesh. */
 		struct SortableElement
 		{
-			UINT32 seqIdx;
+			UINT32 elementIdx;
 			INT32 priority;
 			float distFromCamera;
 			UINT32 shaderId;
@@ -79,17 +79,33 @@ namespace bs { namespace ct
 		void setStateReduction(StateReduction mode) { mStateReductionMode = mode; }
 
 	protected:
-		/**	Callback used for sorting elements with no material grouping. */
-		static bool elementSorterNoGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
+		/** 
+		 * Generates a sort key for every sortable element, packing its priority, material and quantized distance into a 
+		 * single integer whose ordering matches the current state reduction mode. Returns the number of bits used by the
+		 * keys.
+		 */
+		UINT32 generateSortKeys();
 
-		/**	Callback used for sorting elements with preferred material grouping. */
-		static bool elementSorterPreferGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
+		/** 
+		 * Sorts the sortable element indices by their keys using a least significant digit radix sort. The sort is 
+		 * stable, so elements with equal keys retain the order in which they were added.
+		 *
+		 * @param[in]	numKeyBits	Number of low bits used by the keys. Higher bits are assumed to be zero.
+		 */
+		void sortByKeys(UINT32 numKeyBits);
 
-		/**	Callback used for sorting elements with material grouping after sorting. */
-		static bool elementSorterPreferSort(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
+		/** Converts a floating point distance into an unsigned integer that sorts in the same order as the float. */
+		static UINT32 getSortableDistance(float distance);
+
+		/** Minimum number of bits reserved for distance in the sort keys, when sorting by distance. */
+		static const UINT32 MIN_DISTANCE_BITS = 16;
 
 		Vector<SortableElement> mSortableElements;
 		Vector<UINT32> mSortableElementIdx;
+		Vector<UINT64> mSortKeys;
+
+		Vector<UINT32> mSortableElementIdxTemp;
+		Vector<UINT64> mSortKeysTemp;
 		Vector<RenderableElement*> mElements;
 
 		Vector<RenderQueueElement> mSortedRenderElements;
@@ -30,6 +30,9 @@ namespace bs
 		/** @copydoc SpecificImporter::createImportOptions */
 		SPtr<ImportOptions> createImportOptions() const override;
 
+		/** @copydoc SpecificImporter::isThreadSafe */
+		bool isThreadSafe() const override { return true; }
+
 		static const WString DEFAULT_EXTENSION;
 	};
 
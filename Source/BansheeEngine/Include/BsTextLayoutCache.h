@@ -0,0 +1,111 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsPrerequisites.h"
+#include "BsModule.h"
+#include "BsTextSprite.h"
+
+namespace bs
+{
+	/** @addtogroup 2D-Internal
+	 *  @{
+	 */
+
+	/** 
+	 * Quads generated for text characters located on a single font page. The page's texture is not stored, and should
+	 * instead be retrieved from the font using the page's index.
+	 */
+	struct TextLayoutPage
+	{
+		Vector<Vector2> vertices;
+		Vector<Vector2> uvs;
+		Vector<UINT32> indices;
+		UINT32 numQuads = 0;
+	};
+
+	/**
+	 * Keeps text quads generated by text sprites, so text with the same font, bounds and alignment doesn't need to be laid
+	 * out again (for example labels in lists, or text set to the same value every frame). Once the cache is full the least
+	 * recently used layouts are evicted. Only short strings are cached.
+	 *
+	 * @note	Sim thread only.
+	 */
+	class BS_EXPORT TextLayoutCache : public Module<TextLayoutCache>
+	{
+		/** Parameters that uniquely determine the layout of a piece of text. */
+		struct Key
+		{
+			WString text;
+			UINT64 fontId;
+			UINT32 fontSize;
+			UINT32 width;
+			UINT32 height;
+			SpriteAnchor anchor;
+			TextHorzAlign horzAlign;
+			TextVertAlign vertAlign;
+			bool wordWrap;
+			bool wordBreak;
+		};
+
+		/** Cached layout of a piece of text. */
+		struct Entry
+		{
+			Key key;
+			Vector<TextLayoutPage> pages;
+		};
+
+		/** Hashes a key referenced by the lookup table. */
+		struct KeyHash
+		{
+			size_t operator()(const Key* key) const;
+		};
+
+		/** Compares keys referenced by the lookup table. */
+		struct KeyEqual
+		{
+			bool operator()(const Key* a, const Key* b) const;
+		};
+
+	public:
+		/** @param[in]	capacity	Maximum number of layouts to keep in the cache. */
+		TextLayoutCache(UINT32 capacity = 4096);
+
+		/**
+		 * Returns previously generated quads for the text described by @p desc, or null if they aren't cached. Returned
+		 * data remains valid until the next call to add().
+		 */
+		const Vector<TextLayoutPage>* find(const TEXT_SPRITE_DESC& desc);
+
+		/** Stores quads for the text described by @p desc, evicting the least recently used layout if the cache is full. */
+		void add(const TEXT_SPRITE_DESC& desc, Vector<TextLayoutPage> pages);
+
+		/** Removes all layouts from the cache. */
+		void clear();
+
+		/** Changes the maximum number of layouts to keep in the cache, evicting layouts if needed. */
+		void setCapacity(UINT32 capacity);
+
+		/** Returns the maximum number of layouts to keep in the cache. */
+		UINT32 getCapacity() const { return mCapacity; }
+
+		/** Checks can the layout of the text described by @p desc be stored in the cache. */
+		static bool isCacheable(const TEXT_SPRITE_DESC& desc);
+
+		/** Maximum number of characters in a string whose layout can be cached. */
+		static const UINT32 MAX_TEXT_LENGTH = 256;
+
+	private:
+		/** Builds a cache key from the text sprite description. */
+		static Key createKey(const TEXT_SPRITE_DESC& desc);
+
+		/** Evicts least recently used layouts until the number of layouts is within capacity. */
+		void trim();
+
+		List<Entry> mEntries; /**< Ordered from most to least recently used. */
+		UnorderedMap<const Key*, List<Entry>::iterator, KeyHash, KeyEqual> mLookup; /**< Keys point into mEntries. */
+		UINT32 mCapacity;
+	};
+
+	/** @} */
+}
@@ -130,10 +130,57 @@ namespace bs
 		static const int STATIC_CHARS_TO_BUFFER = 25;
 		static const int STATIC_BUFFER_SIZE = STATIC_CHARS_TO_BUFFER * (4 * (2 * sizeof(Vector2)) + (6 * sizeof(UINT32)));
 
+		/** Information about the text the sprite was last updated with, used for updating the sprite incrementally. */
+		struct AppendInfo
+		{
+			WString text;
+			HFont font;
+			UINT32 fontSize = 0;
+			UINT32 width = 0;
+			UINT32 height = 0;
+			SpriteAnchor anchor = SA_TopLeft;
+			bool wordBreak = true;
+			UINT32 lastLineStart = 0; /**< Index of the first character on the last line of the text. */
+			UINT32 lastLineIdx = 0; /**< Index of the last line of the text. */
+			bool isValid = false;
+		};
+
+		/**
+		 * Attempts to update the sprite when text was appended to the text it was last updated with. Only the last line of
+		 * the previous text and the appended text are laid out, while quads for other lines are kept as is. Only possible
+		 * for long, non-wrapped, top-left aligned text.
+		 *
+		 * @return	True if the sprite was updated, false if it needs to be rebuilt instead.
+		 */
+		bool updateAppended(const TEXT_SPRITE_DESC& desc, UINT64 groupId);
+
+		/** 
+		 * Records information required by updateAppended(), or invalidates it if the text doesn't support appending.
+		 * @p textData must be the layout of the entire text, created just before calling this method.
+		 */
+		void updateAppendInfo(const TEXT_SPRITE_DESC& desc, const TextDataBase& textData);
+
+		/** 
+		 * Returns the index of the first character on the last line of laid out text. @p numChars is the number of
+		 * characters in the text.
+		 */
+		static UINT32 getLastLineStart(const TextDataBase& textData, UINT32 numChars);
+
+		/** Allocates geometry buffers for the render element, large enough for the specified number of quads. */
+		void allocBuffers(SpriteRenderElement& renderElem, UINT32 numQuads);
+
+		/** Releases geometry buffers of all render elements. */
+		void freeBuffers();
+
+		/** Assigns a text material to the render element. */
+		static void setMaterial(SpriteRenderElement& renderElem, const HTexture& texture, const TEXT_SPRITE_DESC& desc,
+			UINT64 groupId);
+
 		/**	Clears internal geometry buffers. */
 		void clearMesh();
 
 		mutable StaticAlloc<STATIC_BUFFER_SIZE, STATIC_BUFFER_SIZE> mAlloc;
+		AppendInfo mAppendInfo;
 	};
 
 	/** @} */
@@ -3,6 +3,7 @@
 #include "BsApplication.h"
 #include "BsGUIManager.h"
 #include "BsSpriteManager.h"
+#include "BsTextLayoutCache.h"
 #include "BsBuiltinResources.h"
 #include "BsScriptManager.h"
 #include "BsProfilingManager.h"
@@ -42,6 +43,7 @@ namespace bs
 
 		ShortcutManager::shutDown();
 		GUIManager::shutDown();
+		TextLayoutCache::shutDown();
 		SpriteManager::shutDown();
 		ct::LightProbeCache::shutDown();
 		BuiltinResources::shutDown();
@@ -62,6 +64,7 @@ namespace bs
 		RendererMaterialManager::startUp();
 		RendererManager::instance().initialize();
 		SpriteManager::startUp();
+		TextLayoutCache::startUp();
 		GUIManager::startUp();
 		ShortcutManager::startUp();
 
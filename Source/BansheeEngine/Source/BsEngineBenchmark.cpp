@@ -0,0 +1,49 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsApplication.h"
+#include "BsEngineConfig.h"
+#include "BsEngineBenchmarkSuite.h"
+#include "BsConsoleTestOutput.h"
+#include "BsCrashHandler.h"
+
+using namespace bs;
+
+/**
+ * Runs the engine benchmarks. Workload sizes can be changed through "name=value" arguments:
+ *  - labels: Number of static labels drawn next to the animated GUI element (default 5000).
+ *  - frames: Number of frames measured by each GUI benchmark (default 100).
+ *  - instances: Number of prefab instances in the level used by the prefab benchmark (default 500).
+ *  - objects: Number of game objects deserialized by the handle resolve benchmark (default 200000).
+ *  - references: Number of handles referencing those game objects (default 1000000).
+ */
+int main(int argc, char* argv[])
+{
+	CrashHandler::startUp();
+
+	START_UP_DESC startUpDesc;
+	startUpDesc.renderAPI = BS_RENDER_API_MODULE;
+	startUpDesc.renderer = BS_RENDERER_MODULE;
+	startUpDesc.audio = BS_AUDIO_MODULE;
+	startUpDesc.physics = BS_PHYSICS_MODULE;
+	startUpDesc.input = BS_INPUT_MODULE;
+
+	startUpDesc.primaryWindowDesc.videoMode = VideoMode(1280, 720);
+	startUpDesc.primaryWindowDesc.title = "Banshee Engine Benchmark";
+	startUpDesc.primaryWindowDesc.fullscreen = false;
+	startUpDesc.primaryWindowDesc.depthBuffer = false;
+
+	Application::startUp(startUpDesc);
+	{
+		BenchmarkParams params(argc, argv);
+
+		SPtr<TestSuite> benchmarks = BenchmarkSuite::create<EngineBenchmarkSuite>(params);
+
+		ConsoleTestOutput testOutput;
+		benchmarks->run(testOutput);
+	}
+	Application::shutDown();
+
+	CrashHandler::shutDown();
+
+	return 0;
+}
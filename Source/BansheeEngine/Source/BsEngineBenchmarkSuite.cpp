@@ -0,0 +1,217 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsEngineBenchmarkSuite.h"
+#include "BsApplication.h"
+#include "BsCamera.h"
+#include "BsCoreThread.h"
+#include "BsGUIManager.h"
+#include "BsGUIWidget.h"
+#include "BsGUIPanel.h"
+#include "BsGUILabel.h"
+#include "BsGUIContent.h"
+#include "BsGUIOptions.h"
+#include "BsRenderWindow.h"
+#include "BsSceneObject.h"
+#include "BsPrefab.h"
+#include "BsPrefabDiff.h"
+#include "BsPrefabUtility.h"
+#include "BsCBone.h"
+#include "BsCLight.h"
+#include "BsGameObjectManager.h"
+
+namespace bs
+{
+	/** Game object with no data, used for measuring how handles to deserialized game objects are resolved. */
+	class BenchmarkGameObject : public GameObject
+	{
+	private:
+		void destroyInternal(GameObjectHandleBase& handle, bool immediate) override
+		{
+			GameObjectManager::instance().unregisterObject(handle);
+		}
+	};
+
+	EngineBenchmarkSuite::EngineBenchmarkSuite(const BenchmarkParams& params)
+		:BenchmarkSuite(params)
+	{
+		BS_ADD_TEST(EngineBenchmarkSuite::benchmarkGUIMeshUpdate);
+		BS_ADD_TEST(EngineBenchmarkSuite::benchmarkPrefabInstances);
+		BS_ADD_TEST(EngineBenchmarkSuite::benchmarkHandleResolve);
+	}
+
+	void EngineBenchmarkSuite::benchmarkGUIMeshUpdate()
+	{
+		UINT32 numLabels = mParams.get("labels", 5000);
+		UINT32 numFrames = mParams.get("frames", 100);
+
+		SPtr<RenderWindow> window = gApplication().getPrimaryWindow();
+		const RenderWindowProperties& windowProps = window->getProperties();
+
+		SPtr<Camera> camera = Camera::create(window);
+		SPtr<GUIWidget> widget = GUIWidget::create(camera);
+		GUIPanel* panel = widget->getPanel();
+
+		// Static labels, spread over the window so that none of them are clipped away
+		const UINT32 LABEL_WIDTH = 50;
+		const UINT32 LABEL_HEIGHT = 15;
+
+		UINT32 numColumns = std::max(1U, windowProps.getWidth() / LABEL_WIDTH);
+		UINT32 numRows = std::max(1U, windowProps.getHeight() / LABEL_HEIGHT - 1);
+		for (UINT32 i = 0; i < numLabels; i++)
+		{
+			GUILabel* label = panel->addNewElement<GUILabel>(HString(L"Label"),
+				GUIOptions(GUIOption::fixedWidth(LABEL_WIDTH), GUIOption::fixedHeight(LABEL_HEIGHT)));
+
+			label->setPosition((i % numColumns) * LABEL_WIDTH, ((i / numColumns) % numRows) * LABEL_HEIGHT);
+		}
+
+		// Animated label, with a fixed size so changing its text doesn't affect the layout
+		GUILabel* animatedLabel = panel->addNewElement<GUILabel>(HString(L"Frame 0"),
+			GUIOptions(GUIOption::fixedWidth(100), GUIOption::fixedHeight(LABEL_HEIGHT)));
+		animatedLabel->setPosition(0, numRows * LABEL_HEIGHT);
+
+		// Initial build of the meshes
+		GUIManager::instance().update();
+		gCoreThread().submitAll(true);
+
+		auto runFrames = [&](const std::function<void(UINT32)>& animate)
+		{
+			for (UINT32 i = 0; i < numFrames; i++)
+			{
+				animate(i);
+
+				GUIManager::instance().update();
+				gCoreThread().submitAll();
+			}
+		};
+
+		measure("Animated text", [&]()
+		{
+			runFrames([&](UINT32 frame)
+			{
+				animatedLabel->setContent(GUIContent(HString(L"Frame " + toWString(frame % 10))));
+			});
+		});
+
+		gCoreThread().submitAll(true);
+
+		measure("Animated size", [&]()
+		{
+			runFrames([&](UINT32 frame)
+			{
+				animatedLabel->setWidth(100 + frame % 2);
+			});
+		});
+
+		gCoreThread().submitAll(true);
+
+		widget->_destroy();
+		GUIManager::instance().update();
+		gCoreThread().submitAll(true);
+	}
+
+	void EngineBenchmarkSuite::benchmarkPrefabInstances()
+	{
+		UINT32 numInstances = mParams.get("instances", 500);
+		const UINT32 NUM_CHILDREN = 8;
+
+		// Prefab with a mix of components that track their own modifications (bones) and ones that don't (lights)
+		HSceneObject prefabSource = SceneObject::create("Prefab");
+		for (UINT32 i = 0; i < NUM_CHILDREN; i++)
+		{
+			HSceneObject child = SceneObject::create("Child" + toString(i));
+			child->setParent(prefabSource);
+
+			HBone bone = child->addComponent<CBone>();
+			bone->setBoneName("Bone" + toString(i));
+
+			child->addComponent<CLight>();
+		}
+
+		HPrefab prefab = Prefab::create(prefabSource, false);
+
+		// Level with many instances, each with some instance specific modifications
+		HSceneObject level = SceneObject::create("Level");
+		Vector<HSceneObject> instances(numInstances);
+		for (UINT32 i = 0; i < numInstances; i++)
+		{
+			HSceneObject instance = prefab->instantiate();
+			instance->setParent(level);
+			instance->setPosition(Vector3((float)i, 0.0f, 0.0f));
+
+			HBone bone = instance->getChild(0)->getComponent<CBone>();
+			bone->setBoneName("Modified" + toString(i));
+
+			instances[i] = instance;
+		}
+
+		measure("Diff without cache", [&]()
+		{
+			for (auto& instance : instances)
+				PrefabDiff::create(prefab->_getRoot(), instance);
+		});
+
+		measure("Record diffs, no previous diff", [&]() { PrefabUtility::recordPrefabDiff(level); });
+		measure("Record diffs, nothing modified", [&]() { PrefabUtility::recordPrefabDiff(level); });
+
+		HBone modifiedBone = instances[0]->getChild(1)->getComponent<CBone>();
+		modifiedBone->setBoneName("Modified");
+
+		measure("Record diffs, one instance modified", [&]() { PrefabUtility::recordPrefabDiff(level); });
+
+		// Modify the prefab so all of the instances need to be updated
+		prefabSource->getChild(0)->setName("ModifiedChild");
+		prefab->update(prefabSource);
+
+		measure("Update from prefab", [&]() { PrefabUtility::updateFromPrefab(level); });
+
+		level->destroy();
+		prefabSource->destroy();
+	}
+
+	void EngineBenchmarkSuite::benchmarkHandleResolve()
+	{
+		UINT32 numObjects = mParams.get("objects", 200000);
+		UINT32 numReferences = mParams.get("references", 1000000);
+
+		GameObjectManager& gom = GameObjectManager::instance();
+		UINT32 prevFlags = gom.getDeserializationFlags();
+
+		Vector<GameObjectHandleBase> objects;
+		objects.reserve(numObjects);
+
+		Vector<GameObjectHandleBase> references(numReferences);
+
+		// Registers objects and handles in the same order deserialization would, with each object followed by the
+		// handles it holds. Handles point to random objects, some of which are yet to be deserialized.
+		gom.setDeserializationMode(GODM_UseNewIds | GODM_BreakExternal);
+		gom.startDeserialization();
+
+		measure("Register objects and handles", [&]()
+		{
+			UINT32 seed = 1;
+			UINT32 refIdx = 0;
+			for (UINT32 i = 0; i < numObjects; i++)
+			{
+				SPtr<BenchmarkGameObject> object = bs_shared_ptr_new<BenchmarkGameObject>();
+				objects.push_back(gom.registerObject(object, i + 1));
+
+				UINT32 lastRefIdx = (UINT32)((UINT64)(i + 1) * numReferences / numObjects);
+				for (; refIdx < lastRefIdx; refIdx++)
+				{
+					seed = seed * 1103515245 + 12345;
+					UINT64 originalId = (seed >> 8) % numObjects + 1;
+
+					gom.registerUnresolvedHandle(originalId, references[refIdx]);
+				}
+			}
+		});
+
+		measure("Resolve handles", [&]() { gom.endDeserialization(); });
+
+		gom.setDeserializationMode(prevFlags);
+
+		for (auto& object : objects)
+			gom.unregisterObject(object);
+	}
+}
@@ -42,19 +42,6 @@ using namespace std::placeholders;
 
 namespace bs
 {
-	struct GUIGroupElement
-	{
-		GUIGroupElement()
-		{ }
-
-		GUIGroupElement(GUIElement* _element, UINT32 _renderElement)
-			:element(_element), renderElement(_renderElement)
-		{ }
-
-		GUIElement* element;
-		UINT32 renderElement;
-	};
-
 	struct GUIMaterialGroup
 	{
 		SpriteMaterial* material;
@@ -429,16 +416,29 @@ namespace bs
 		{
 			GUIRenderData& renderData = cachedMeshData.second;
 
-			// Check if anything is dirty. If nothing is we can skip the update
+			// Check if anything is dirty. If nothing is we can skip the update. If only contents of some elements changed
+			// we can try to update just the meshes they're part of, otherwise all meshes need to be rebuilt.
 			bool isDirty = renderData.isDirty;
+			bool rebuildAll = renderData.isDirty;
 			renderData.isDirty = false;
 
+			mDirtyElements.clear();
 			for(auto& widget : renderData.widgets)
 			{
-				if (widget->isDirty(true))
+				if (!widget->isDirty(false))
+					continue;
+
+				isDirty = true;
+
+				if (widget->_isMeshDirty())
+					rebuildAll = true;
+				else if (!rebuildAll)
 				{
-					isDirty = true;
+					const Set<GUIElement*>& dirtyContents = widget->_getDirtyContents();
+					mDirtyElements.insert(mDirtyElements.end(), dirtyContents.begin(), dirtyContents.end());
 				}
+
+				widget->isDirty(true);
 			}
 
 			if(!isDirty)
@@ -446,251 +446,447 @@ namespace bs
 
 			mCoreDirty = true;
 
-			bs_frame_mark();
+			if (rebuildAll || !updateDirtyMeshes(renderData))
+				rebuildMeshes(renderData);
+		}
+
+		mDirtyElements.clear();
+	}
+
+	void GUIManager::rebuildMeshes(GUIRenderData& renderData)
+	{
+		bs_frame_mark();
+		{
+			renderData.cachedElements.clear();
+
+			// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
+			auto elemComp = [](const GUIGroupElement& a, const GUIGroupElement& b)
 			{
-				// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
-				auto elemComp = [](const GUIGroupElement& a, const GUIGroupElement& b)
-				{
-					UINT32 aDepth = a.element->_getRenderElementDepth(a.renderElement);
-					UINT32 bDepth = b.element->_getRenderElementDepth(b.renderElement);
+				UINT32 aDepth = a.element->_getRenderElementDepth(a.renderElement);
+				UINT32 bDepth = b.element->_getRenderElementDepth(b.renderElement);
+
+				// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
+				// requires all elements to be unique
+				return (aDepth > bDepth) || 
+					(aDepth == bDepth && a.element > b.element) || 
+					(aDepth == bDepth && a.element == b.element && a.renderElement > b.renderElement); 
+			};
 
-					// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
-					// requires all elements to be unique
-					return (aDepth > bDepth) || 
-						(aDepth == bDepth && a.element > b.element) || 
-						(aDepth == bDepth && a.element == b.element && a.renderElement > b.renderElement); 
-				};
+			FrameSet<GUIGroupElement, std::function<bool(const GUIGroupElement&, const GUIGroupElement&)>> allElements(elemComp);
 
-				FrameSet<GUIGroupElement, std::function<bool(const GUIGroupElement&, const GUIGroupElement&)>> allElements(elemComp);
+			for (auto& widget : renderData.widgets)
+			{
+				const Vector<GUIElement*>& elements = widget->getElements();
 
-				for (auto& widget : renderData.widgets)
+				for (auto& element : elements)
 				{
-					const Vector<GUIElement*>& elements = widget->getElements();
+					if (!element->_isVisible())
+						continue;
 
-					for (auto& element : elements)
-					{
-						if (!element->_isVisible())
-							continue;
+					GUICachedElement& cachedElement = renderData.cachedElements[element];
+					cachedElement.bounds = element->_getClippedBounds();
 
-						UINT32 numRenderElems = element->_getNumRenderElements();
-						for (UINT32 i = 0; i < numRenderElems; i++)
-						{
-							allElements.insert(GUIGroupElement(element, i));
-						}
+					UINT32 numRenderElems = element->_getNumRenderElements();
+					cachedElement.renderElements.resize(numRenderElems);
+
+					for (UINT32 i = 0; i < numRenderElems; i++)
+					{
+						allElements.insert(GUIGroupElement(element, i));
 					}
 				}
+			}
 
-				// Group the elements in such a way so that we end up with a smallest amount of
-				// meshes, without breaking back to front rendering order
-				FrameUnorderedMap<UINT64, FrameVector<GUIMaterialGroup>> materialGroups;
-				for (auto& elem : allElements)
-				{
-					GUIElement* guiElem = elem.element;
-					UINT32 renderElemIdx = elem.renderElement;
-					UINT32 elemDepth = guiElem->_getRenderElementDepth(renderElemIdx);
+			// Group the elements in such a way so that we end up with a smallest amount of
+			// meshes, without breaking back to front rendering order
+			FrameUnorderedMap<UINT64, FrameVector<GUIMaterialGroup>> materialGroups;
+			for (auto& elem : allElements)
+			{
+				GUIElement* guiElem = elem.element;
+				UINT32 renderElemIdx = elem.renderElement;
+				UINT32 elemDepth = guiElem->_getRenderElementDepth(renderElemIdx);
 
-					Rect2I tfrmedBounds = guiElem->_getClippedBounds();
-					tfrmedBounds.transform(guiElem->_getParentWidget()->getWorldTfrm());
+				Rect2I tfrmedBounds = guiElem->_getClippedBounds();
+				tfrmedBounds.transform(guiElem->_getParentWidget()->getWorldTfrm());
 
-					SpriteMaterial* spriteMaterial = nullptr;
-					const SpriteMaterialInfo& matInfo = guiElem->_getMaterial(renderElemIdx, &spriteMaterial);
-					assert(spriteMaterial != nullptr);
+				SpriteMaterial* spriteMaterial = nullptr;
+				const SpriteMaterialInfo& matInfo = guiElem->_getMaterial(renderElemIdx, &spriteMaterial);
+				assert(spriteMaterial != nullptr);
 
-					UINT64 hash = spriteMaterial->getMergeHash(matInfo);
-					FrameVector<GUIMaterialGroup>& groupsPerMaterial = materialGroups[hash];
-					
-					// Try to find a group this material will fit in:
-					//  - Group that has a depth value same or one below elements depth will always be a match
-					//  - Otherwise, we search higher depth values as well, but we only use them if no elements in between those depth values
-					//    overlap the current elements bounds.
-					GUIMaterialGroup* foundGroup = nullptr;
+				UINT64 hash = spriteMaterial->getMergeHash(matInfo);
+				FrameVector<GUIMaterialGroup>& groupsPerMaterial = materialGroups[hash];
 
-					for (auto groupIter = groupsPerMaterial.rbegin(); groupIter != groupsPerMaterial.rend(); ++groupIter)
+				GUICachedRenderElement& cachedRenderElem = renderData.cachedElements[guiElem].renderElements[renderElemIdx];
+				cachedRenderElem.depth = elemDepth;
+				cachedRenderElem.mergeHash = hash;
+				
+				// Try to find a group this material will fit in:
+				//  - Group that has a depth value same or one below elements depth will always be a match
+				//  - Otherwise, we search higher depth values as well, but we only use them if no elements in between those depth values
+				//    overlap the current elements bounds.
+				GUIMaterialGroup* foundGroup = nullptr;
+
+				for (auto groupIter = groupsPerMaterial.rbegin(); groupIter != groupsPerMaterial.rend(); ++groupIter)
+				{
+					// If we separate meshes by widget, ignore any groups with widget parents other than mine
+					if (mSeparateMeshesByWidget)
 					{
-						// If we separate meshes by widget, ignore any groups with widget parents other than mine
-						if (mSeparateMeshesByWidget)
+						if (groupIter->elements.size() > 0)
 						{
-							if (groupIter->elements.size() > 0)
-							{
-								GUIElement* otherElem = groupIter->elements.begin()->element; // We only need to check the first element
-								if (otherElem->_getParentWidget() != guiElem->_getParentWidget())
-									continue;
-							}
+							GUIElement* otherElem = groupIter->elements.begin()->element; // We only need to check the first element
+							if (otherElem->_getParentWidget() != guiElem->_getParentWidget())
+								continue;
 						}
+					}
 
-						GUIMaterialGroup& group = *groupIter;
+					GUIMaterialGroup& group = *groupIter;
 
-						if (group.depth == elemDepth)
-						{
-							foundGroup = &group;
-							break;
-						}
-						else
-						{
-							UINT32 startDepth = elemDepth;
-							UINT32 endDepth = group.depth;
+					if (group.depth == elemDepth)
+					{
+						foundGroup = &group;
+						break;
+					}
+					else
+					{
+						UINT32 startDepth = elemDepth;
+						UINT32 endDepth = group.depth;
 
-							Rect2I potentialGroupBounds = group.bounds;
-							potentialGroupBounds.encapsulate(tfrmedBounds);
+						Rect2I potentialGroupBounds = group.bounds;
+						potentialGroupBounds.encapsulate(tfrmedBounds);
 
-							bool foundOverlap = false;
-							for (auto& material : materialGroups)
+						bool foundOverlap = false;
+						for (auto& material : materialGroups)
+						{
+							for (auto& matGroup : material.second)
 							{
-								for (auto& matGroup : material.second)
-								{
-									if (&matGroup == &group)
-										continue;
+								if (&matGroup == &group)
+									continue;
 
-									if ((matGroup.minDepth >= startDepth && matGroup.minDepth <= endDepth)
-										|| (matGroup.depth >= startDepth && matGroup.depth <= endDepth))
+								if ((matGroup.minDepth >= startDepth && matGroup.minDepth <= endDepth)
+									|| (matGroup.depth >= startDepth && matGroup.depth <= endDepth))
+								{
+									if (matGroup.bounds.overlaps(potentialGroupBounds))
 									{
-										if (matGroup.bounds.overlaps(potentialGroupBounds))
-										{
-											foundOverlap = true;
-											break;
-										}
+										foundOverlap = true;
+										break;
 									}
 								}
 							}
+						}
 
-							if (!foundOverlap)
-							{
-								foundGroup = &group;
-								break;
-							}
+						if (!foundOverlap)
+						{
+							foundGroup = &group;
+							break;
 						}
 					}
+				}
 
-					if (foundGroup == nullptr)
-					{
-						groupsPerMaterial.push_back(GUIMaterialGroup());
-						foundGroup = &groupsPerMaterial[groupsPerMaterial.size() - 1];
+				if (foundGroup == nullptr)
+				{
+					groupsPerMaterial.push_back(GUIMaterialGroup());
+					foundGroup = &groupsPerMaterial[groupsPerMaterial.size() - 1];
 
-						foundGroup->depth = elemDepth;
-						foundGroup->minDepth = elemDepth;
-						foundGroup->bounds = tfrmedBounds;
-						foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
-						foundGroup->matInfo = matInfo.clone();
-						foundGroup->material = spriteMaterial;
+					foundGroup->depth = elemDepth;
+					foundGroup->minDepth = elemDepth;
+					foundGroup->bounds = tfrmedBounds;
+					foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
+					foundGroup->matInfo = matInfo.clone();
+					foundGroup->material = spriteMaterial;
 
-						guiElem->_getMeshInfo(renderElemIdx, foundGroup->numVertices, foundGroup->numIndices, foundGroup->meshType);
-					}
-					else
-					{
-						foundGroup->bounds.encapsulate(tfrmedBounds);
-						foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
-						foundGroup->minDepth = std::min(foundGroup->minDepth, elemDepth);
-						
-						UINT32 numVertices;
-						UINT32 numIndices;
-						GUIMeshType meshType;
-						guiElem->_getMeshInfo(renderElemIdx, numVertices, numIndices, meshType);
-						assert(meshType == foundGroup->meshType); // It's expected that GUI element doesn't use same material for different mesh types so this should always be true
-
-						foundGroup->numVertices += numVertices;
-						foundGroup->numIndices += numIndices;
-
-						spriteMaterial->merge(foundGroup->matInfo, matInfo);
-					}
+					guiElem->_getMeshInfo(renderElemIdx, foundGroup->numVertices, foundGroup->numIndices, foundGroup->meshType);
+				}
+				else
+				{
+					foundGroup->bounds.encapsulate(tfrmedBounds);
+					foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
+					foundGroup->minDepth = std::min(foundGroup->minDepth, elemDepth);
+					
+					UINT32 numVertices;
+					UINT32 numIndices;
+					GUIMeshType meshType;
+					guiElem->_getMeshInfo(renderElemIdx, numVertices, numIndices, meshType);
+					assert(meshType == foundGroup->meshType); // It's expected that GUI element doesn't use same material for different mesh types so this should always be true
+
+					foundGroup->numVertices += numVertices;
+					foundGroup->numIndices += numIndices;
+
+					spriteMaterial->merge(foundGroup->matInfo, matInfo);
 				}
+			}
 
-				// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
-				auto groupComp = [](GUIMaterialGroup* a, GUIMaterialGroup* b)
+			// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
+			auto groupComp = [](GUIMaterialGroup* a, GUIMaterialGroup* b)
+			{
+				return (a->depth > b->depth) || (a->depth == b->depth && a > b);
+				// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
+				// requires all elements to be unique
+			};
+
+			UINT32 numMeshes = 0;
+			FrameSet<GUIMaterialGroup*, std::function<bool(GUIMaterialGroup*, GUIMaterialGroup*)>> sortedGroups(groupComp);
+			for(auto& material : materialGroups)
+			{
+				for(auto& group : material.second)
 				{
-					return (a->depth > b->depth) || (a->depth == b->depth && a > b);
-					// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
-					// requires all elements to be unique
-				};
-
-				UINT32 numMeshes = 0;
-				FrameSet<GUIMaterialGroup*, std::function<bool(GUIMaterialGroup*, GUIMaterialGroup*)>> sortedGroups(groupComp);
-				for(auto& material : materialGroups)
+					sortedGroups.insert(&group);
+					numMeshes++;
+				}
+			}
+
+			UINT32 oldNumMeshes = (UINT32)renderData.cachedMeshes.size();
+			for (UINT32 i = 0; i < oldNumMeshes; i++)
+			{
+				if(!renderData.cachedMeshes[i].isLine)
+					mTriangleMeshHeap->dealloc(renderData.cachedMeshes[i].mesh);
+				else
+					mLineMeshHeap->dealloc(renderData.cachedMeshes[i].mesh);
+			}
+
+			renderData.cachedMeshes.resize(numMeshes);
+			
+			// Fill buffers for each group and update their meshes
+			UINT32 meshIdx = 0;
+			for(auto& group : sortedGroups)
+			{
+				SPtr<MeshData> meshData;
+				GUIWidget* widget;
+
+				if (group->elements.size() == 0)
+					widget = nullptr;
+				else
 				{
-					for(auto& group : material.second)
-					{
-						sortedGroups.insert(&group);
-						numMeshes++;
-					}
+					GUIElement* elem = group->elements.begin()->element;
+					widget = elem->_getParentWidget();
 				}
 
-				UINT32 oldNumMeshes = (UINT32)renderData.cachedMeshes.size();
-				for (UINT32 i = 0; i < oldNumMeshes; i++)
+				GUIMeshData& guiMeshData = renderData.cachedMeshes[meshIdx];
+				guiMeshData.matInfo = group->matInfo;
+				guiMeshData.material = group->material;
+				guiMeshData.widget = widget;
+				guiMeshData.elements = group->elements;
+
+				if (group->meshType == GUIMeshType::Triangle)
 				{
-					if(!renderData.cachedMeshes[i].isLine)
-						mTriangleMeshHeap->dealloc(renderData.cachedMeshes[i].mesh);
-					else
-						mLineMeshHeap->dealloc(renderData.cachedMeshes[i].mesh);
+					meshData = bs_shared_ptr_new<MeshData>(group->numVertices, group->numIndices, mTriangleVertexDesc);
+					guiMeshData.isLine = false;
+				}
+				else // Line
+				{
+					meshData = bs_shared_ptr_new<MeshData>(group->numVertices, group->numIndices, mLineVertexDesc);
+					guiMeshData.isLine = true;
 				}
 
-				renderData.cachedMeshes.resize(numMeshes);
-				
-				// Fill buffers for each group and update their meshes
-				UINT32 meshIdx = 0;
-				for(auto& group : sortedGroups)
+				UINT8* vertices = meshData->getElementData(VES_POSITION);
+				UINT32* indices = meshData->getIndices32();
+
+				UINT32 indexOffset = 0;
+				UINT32 vertexOffset = 0;
+				for(auto& matElement : group->elements)
 				{
-					SPtr<MeshData> meshData;
-					GUIWidget* widget;
+					matElement.element->_fillBuffer(vertices, indices, vertexOffset, indexOffset, group->numVertices,
+						group->numIndices, matElement.renderElement);
+
+					UINT32 numVertices;
+					UINT32 numIndices;
+					GUIMeshType meshType;
+					matElement.element->_getMeshInfo(matElement.renderElement, numVertices, numIndices, meshType);
+
+					UINT32 indexStart = indexOffset;
+					UINT32 indexEnd = indexStart + numIndices;
+
+					for(UINT32 i = indexStart; i < indexEnd; i++)
+						indices[i] += vertexOffset;
+
+					GUICachedElement& cachedElement = renderData.cachedElements[matElement.element];
+					GUICachedRenderElement& cachedRenderElem = cachedElement.renderElements[matElement.renderElement];
+					cachedRenderElem.meshIdx = meshIdx;
+					cachedRenderElem.vertexOffset = vertexOffset;
+					cachedRenderElem.indexOffset = indexOffset;
+					cachedRenderElem.numVertices = numVertices;
+					cachedRenderElem.numIndices = numIndices;
+
+					indexOffset += numIndices;
+					vertexOffset += numVertices;
+				}
 
-					if (group->elements.size() == 0)
-						widget = nullptr;
-					else
-					{
-						GUIElement* elem = group->elements.begin()->element;
-						widget = elem->_getParentWidget();
-					}
+				guiMeshData.meshData = meshData;
+				guiMeshData.prevMeshData = nullptr;
+				guiMeshData.refilledElements.clear();
 
-					GUIMeshData& guiMeshData = renderData.cachedMeshes[meshIdx];
-					guiMeshData.matInfo = group->matInfo;
-					guiMeshData.material = group->material;
-					guiMeshData.widget = widget;
+				if (group->meshType == GUIMeshType::Triangle)
+					guiMeshData.mesh = mTriangleMeshHeap->alloc(meshData);
+				else // Line
+					guiMeshData.mesh = mLineMeshHeap->alloc(meshData, DOT_LINE_LIST);
 
-					if (group->meshType == GUIMeshType::Triangle)
-					{
-						meshData = bs_shared_ptr_new<MeshData>(group->numVertices, group->numIndices, mTriangleVertexDesc);
-						guiMeshData.isLine = false;
-					}
-					else // Line
+				meshIdx++;
+			}
+		}
+
+		bs_frame_clear();
+	}
+
+	bool GUIManager::updateDirtyMeshes(GUIRenderData& renderData)
+	{
+		// Make sure all dirty elements still fit in the same place in the same meshes. If anything that affects grouping
+		// changed the meshes need to be rebuilt.
+		for (auto& element : mDirtyElements)
+		{
+			auto iterFind = renderData.cachedElements.find(element);
+			if (iterFind == renderData.cachedElements.end())
+			{
+				if (element->_isVisible())
+					return false;
+
+				continue;
+			}
+
+			const GUICachedElement& cachedElement = iterFind->second;
+			if (!element->_isVisible() || element->_getClippedBounds() != cachedElement.bounds)
+				return false;
+
+			UINT32 numRenderElems = element->_getNumRenderElements();
+			if (numRenderElems != (UINT32)cachedElement.renderElements.size())
+				return false;
+
+			for (UINT32 i = 0; i < numRenderElems; i++)
+			{
+				const GUICachedRenderElement& cachedRenderElem = cachedElement.renderElements[i];
+
+				UINT32 numVertices;
+				UINT32 numIndices;
+				GUIMeshType meshType;
+				element->_getMeshInfo(i, numVertices, numIndices, meshType);
+
+				if (numVertices != cachedRenderElem.numVertices || numIndices != cachedRenderElem.numIndices)
+					return false;
+
+				if (element->_getRenderElementDepth(i) != cachedRenderElem.depth)
+					return false;
+
+				SpriteMaterial* spriteMaterial = nullptr;
+				const SpriteMaterialInfo& matInfo = element->_getMaterial(i, &spriteMaterial);
+				if (spriteMaterial->getMergeHash(matInfo) != cachedRenderElem.mergeHash)
+					return false;
+			}
+		}
+
+		bs_frame_mark();
+		{
+			// Refill the dirty render elements. Current mesh data might still be in use by the core thread so modified
+			// meshes are refilled into a different buffer.
+			UINT32 numMeshes = (UINT32)renderData.cachedMeshes.size();
+			FrameVector<SPtr<MeshData>> newMeshData(numMeshes);
+
+			for (auto& element : mDirtyElements)
+			{
+				auto iterFind = renderData.cachedElements.find(element);
+				if (iterFind == renderData.cachedElements.end())
+					continue;
+
+				const GUICachedElement& cachedElement = iterFind->second;
+				UINT32 numRenderElems = (UINT32)cachedElement.renderElements.size();
+				for (UINT32 i = 0; i < numRenderElems; i++)
+				{
+					const GUICachedRenderElement& cachedRenderElem = cachedElement.renderElements[i];
+
+					GUIMeshData& guiMeshData = renderData.cachedMeshes[cachedRenderElem.meshIdx];
+					SPtr<MeshData>& meshData = newMeshData[cachedRenderElem.meshIdx];
+					if (meshData == nullptr)
 					{
-						meshData = bs_shared_ptr_new<MeshData>(group->numVertices, group->numIndices, mLineVertexDesc);
-						guiMeshData.isLine = true;
+						meshData = getMeshDataForUpdate(guiMeshData);
+						guiMeshData.refilledElements.clear();
 					}
 
+					guiMeshData.refilledElements.push_back(cachedRenderElem);
+
 					UINT8* vertices = meshData->getElementData(VES_POSITION);
 					UINT32* indices = meshData->getIndices32();
 
-					UINT32 indexOffset = 0;
-					UINT32 vertexOffset = 0;
-					for(auto& matElement : group->elements)
-					{
-						matElement.element->_fillBuffer(vertices, indices, vertexOffset, indexOffset, group->numVertices,
-							group->numIndices, matElement.renderElement);
+					element->_fillBuffer(vertices, indices, cachedRenderElem.vertexOffset, cachedRenderElem.indexOffset,
+						meshData->getNumVertices(), meshData->getNumIndices(), i);
 
-						UINT32 numVertices;
-						UINT32 numIndices;
-						GUIMeshType meshType;
-						matElement.element->_getMeshInfo(matElement.renderElement, numVertices, numIndices, meshType);
+					UINT32 indexStart = cachedRenderElem.indexOffset;
+					UINT32 indexEnd = indexStart + cachedRenderElem.numIndices;
 
-						UINT32 indexStart = indexOffset;
-						UINT32 indexEnd = indexStart + numIndices;
+					for (UINT32 j = indexStart; j < indexEnd; j++)
+						indices[j] += cachedRenderElem.vertexOffset;
+				}
+			}
 
-						for(UINT32 i = indexStart; i < indexEnd; i++)
-							indices[i] += vertexOffset;
+			// Re-upload modified meshes
+			for (UINT32 i = 0; i < numMeshes; i++)
+			{
+				if (newMeshData[i] == nullptr)
+					continue;
 
-						indexOffset += numIndices;
-						vertexOffset += numVertices;
-					}
+				GUIMeshData& guiMeshData = renderData.cachedMeshes[i];
 
-					if (group->meshType == GUIMeshType::Triangle)
-						guiMeshData.mesh = mTriangleMeshHeap->alloc(meshData);
-					else // Line
-						guiMeshData.mesh = mLineMeshHeap->alloc(meshData, DOT_LINE_LIST);
+				// Material info of the elements might have changed, even if they're still mergeable
+				const GUIGroupElement& firstElem = guiMeshData.elements[0];
+				guiMeshData.matInfo = firstElem.element->_getMaterial(firstElem.renderElement, &guiMeshData.material).clone();
 
-					meshIdx++;
+				for (UINT32 j = 1; j < (UINT32)guiMeshData.elements.size(); j++)
+				{
+					const GUIGroupElement& groupElem = guiMeshData.elements[j];
+					SpriteMaterial* spriteMaterial = nullptr;
+					const SpriteMaterialInfo& matInfo = groupElem.element->_getMaterial(groupElem.renderElement, &spriteMaterial);
+
+					guiMeshData.material->merge(guiMeshData.matInfo, matInfo);
 				}
+
+				guiMeshData.prevMeshData = guiMeshData.meshData;
+				guiMeshData.meshData = newMeshData[i];
+
+				if (!guiMeshData.isLine)
+				{
+					mTriangleMeshHeap->dealloc(guiMeshData.mesh);
+					guiMeshData.mesh = mTriangleMeshHeap->alloc(guiMeshData.meshData);
+				}
+				else
+				{
+					mLineMeshHeap->dealloc(guiMeshData.mesh);
+					guiMeshData.mesh = mLineMeshHeap->alloc(guiMeshData.meshData, DOT_LINE_LIST);
+				}
+			}
+		}
+		bs_frame_clear();
+
+		return true;
+	}
+
+	SPtr<MeshData> GUIManager::getMeshDataForUpdate(GUIMeshData& meshData)
+	{
+		const SPtr<MeshData>& curMeshData = meshData.meshData;
+
+		// Queued mesh uploads hold a reference to the data, so if we're the only owner the core thread is done with it
+		SPtr<MeshData> output = meshData.prevMeshData;
+		meshData.prevMeshData = nullptr;
+
+		if (output != nullptr && output.use_count() == 1)
+		{
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			UINT32 vertexStride = curMeshData->getVertexDesc()->getVertexStride();
+			UINT8* srcVertices = curMeshData->getElementData(VES_POSITION);
+			UINT8* dstVertices = output->getElementData(VES_POSITION);
+			UINT32* srcIndices = curMeshData->getIndices32();
+			UINT32* dstIndices = output->getIndices32();
+
+			for (auto& entry : meshData.refilledElements)
+			{
+				memcpy(dstVertices + entry.vertexOffset * vertexStride, srcVertices + entry.vertexOffset * vertexStride,
+					entry.numVertices * vertexStride);
+				memcpy(dstIndices + entry.indexOffset, srcIndices + entry.indexOffset, entry.numIndices * sizeof(UINT32));
 			}
 
-			bs_frame_clear();			
+			return output;
 		}
+
+		output = bs_shared_ptr_new<MeshData>(curMeshData->getNumVertices(), curMeshData->getNumIndices(),
+			curMeshData->getVertexDesc());
+		memcpy(output->getData(), curMeshData->getData(), curMeshData->getSize());
+
+		return output;
 	}
 
 	void GUIManager::updateCaretTexture()
@@ -6,8 +6,7 @@
 #include "BsMesh.h"
 #include "BsMaterial.h"
 #include "BsRenderableElement.h"
-
-using namespace std::placeholders;
+#include "BsBitwise.h"
 
 namespace bs { namespace ct
 {
@@ -31,6 +30,7 @@ namespace bs { namespace ct
 		SPtr<Material> material = element->material;
 		SPtr<Shader> shader = material->getShader();
 
+		UINT32 elementIdx = (UINT32)mElements.size();
 		mElements.push_back(element);
 		
 		UINT32 queuePriority = shader->getQueuePriority();
@@ -62,7 +62,7 @@ namespace bs { namespace ct
 			mSortableElements.push_back(SortableElement());
 			SortableElement& sortableElem = mSortableElements.back();
 
-			sortableElem.seqIdx = idx;
+			sortableElem.elementIdx = elementIdx;
 			sortableElem.priority = queuePriority;
 			sortableElem.shaderId = shaderId;
 			sortableElem.passIdx = i;
@@ -72,43 +72,18 @@ namespace bs { namespace ct
 
 	void RenderQueue::sort()
 	{
-		std::function<bool(UINT32, UINT32, const Vector<SortableElement>&)> sortMethod;
-
-		switch (mStateReductionMode)
-		{
-		case StateReduction::None:
-			sortMethod = &elementSorterNoGroup;
-			break;
-		case StateReduction::Material:
-			sortMethod = &elementSorterPreferGroup;
-			break;
-		case StateReduction::Distance:
-			sortMethod = &elementSorterPreferSort;
-			break;
-		}
-
 		// Sort only indices since we generate an entirely new data set anyway, it doesn't make sense to move sortable elements
-		std::sort(mSortableElementIdx.begin(), mSortableElementIdx.end(), std::bind(sortMethod, _1, _2, mSortableElements));
+		UINT32 numKeyBits = generateSortKeys();
+		sortByKeys(numKeyBits);
 
 		UINT32 prevShaderId = (UINT32)-1;
 		UINT32 prevPassIdx = (UINT32)-1;
-		RenderableElement* renderElem = nullptr;
-		INT32 currentElementIdx = -1;
-		UINT32 numPassesInCurrentElement = 0;
-		bool separablePasses = true;
 		for (UINT32 i = 0; i < (UINT32)mSortableElementIdx.size(); i++)
 		{
-			UINT32 idx = mSortableElementIdx[i];
+			const SortableElement& elem = mSortableElements[mSortableElementIdx[i]];
+			RenderableElement* renderElem = mElements[elem.elementIdx];
 
-			while (numPassesInCurrentElement == 0)
-			{
-				currentElementIdx++;
-				renderElem = mElements[currentElementIdx];
-				numPassesInCurrentElement = renderElem->material->getNumPasses();
-				separablePasses = renderElem->material->getShader()->getAllowSeparablePasses();
-			}
-
-			const SortableElement& elem = mSortableElements[idx];
+			bool separablePasses = renderElem->material->getShader()->getAllowSeparablePasses();
 			if (separablePasses)
 			{
 				mSortedRenderElements.push_back(RenderQueueElement());
@@ -125,12 +100,11 @@ namespace bs { namespace ct
 				}
 				else
 					sortedElem.applyPass = false;
-
-				numPassesInCurrentElement--;
 			}
 			else
 			{
-				for (UINT32 j = 0; j < numPassesInCurrentElement; j++)
+				UINT32 numPasses = renderElem->material->getNumPasses();
+				for (UINT32 j = 0; j < numPasses; j++)
 				{
 					mSortedRenderElements.push_back(RenderQueueElement());
 
@@ -142,66 +116,174 @@ namespace bs { namespace ct
 					prevShaderId = elem.shaderId;
 					prevPassIdx = j;
 				}
-
-				numPassesInCurrentElement = 0;
-			}			
+			}
 		}
 	}
 
-	bool RenderQueue::elementSorterNoGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
+	UINT32 RenderQueue::generateSortKeys()
 	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
+		UINT32 numElements = (UINT32)mSortableElements.size();
+		mSortKeys.resize(numElements);
+
+		if (numElements == 0)
+			return 0;
+
+		INT32 minPriority = std::numeric_limits<INT32>::max();
+		INT32 maxPriority = std::numeric_limits<INT32>::min();
+		UINT32 minShaderId = std::numeric_limits<UINT32>::max();
+		UINT32 maxShaderId = 0;
+		UINT32 maxPassIdx = 0;
+		for (auto& elem : mSortableElements)
+		{
+			minPriority = std::min(minPriority, elem.priority);
+			maxPriority = std::max(maxPriority, elem.priority);
+			minShaderId = std::min(minShaderId, elem.shaderId);
+			maxShaderId = std::max(maxShaderId, elem.shaderId);
+			maxPassIdx = std::max(maxPassIdx, elem.passIdx);
+		}
+
+		auto getNumBits = [](UINT32 range) { return range > 0 ? Bitwise::mostSignificantBitSet(range) + 1 : 0; };
+
+		// Key fields only need to be wide enough to hold the range of values present in the queue
+		UINT32 priorityBits = getNumBits((UINT32)((INT64)maxPriority - (INT64)minPriority));
+		UINT32 shaderBits = 0;
+		UINT32 passBits = 0;
+		if (mStateReductionMode != StateReduction::None)
+		{
+			shaderBits = getNumBits(maxShaderId - minShaderId);
+			passBits = getNumBits(maxPassIdx);
+		}
+
+		// Shader IDs are allocated sequentially so their range is normally small, but if it ends up too large to leave
+		// enough room for the distance, remap them to consecutive values
+		UnorderedMap<UINT32, UINT32> shaderRemap;
+		if (priorityBits + shaderBits + passBits + MIN_DISTANCE_BITS > 64)
+		{
+			Vector<UINT32> shaderIds;
+			for (auto& elem : mSortableElements)
+			{
+				if (shaderIds.empty() || shaderIds.back() != elem.shaderId)
+					shaderIds.push_back(elem.shaderId);
+			}
+
+			std::sort(shaderIds.begin(), shaderIds.end());
+			shaderIds.erase(std::unique(shaderIds.begin(), shaderIds.end()), shaderIds.end());
+
+			for (UINT32 i = 0; i < (UINT32)shaderIds.size(); i++)
+				shaderRemap[shaderIds[i]] = i;
+
+			shaderBits = getNumBits((UINT32)shaderIds.size() - 1);
+		}
+
+		UINT32 groupBits = shaderBits + passBits;
+		UINT32 distanceBits = 0;
+		if (priorityBits + groupBits < 64)
+			distanceBits = std::min(32U, 64 - priorityBits - groupBits);
 
-		UINT8 isHigher = (a.priority > b.priority) << 2 |
-			(a.distFromCamera < b.distFromCamera) << 1 |
-			(a.seqIdx < b.seqIdx);
+		for (UINT32 i = 0; i < numElements; i++)
+		{
+			const SortableElement& elem = mSortableElements[i];
+
+			// Higher priorities are rendered first
+			UINT64 priorityKey = (UINT64)((INT64)maxPriority - (INT64)elem.priority);
+
+			UINT64 distanceKey = 0;
+			if (distanceBits > 0)
+				distanceKey = getSortableDistance(elem.distFromCamera) >> (32 - distanceBits);
+
+			UINT64 shaderKey;
+			if (shaderRemap.empty())
+				shaderKey = elem.shaderId - minShaderId;
+			else
+				shaderKey = shaderRemap[elem.shaderId];
+
+			UINT64 groupKey = (shaderKey << passBits) | elem.passIdx;
 
-		UINT8 isLower = (a.priority < b.priority) << 2 |
-			(a.distFromCamera > b.distFromCamera) << 1 |
-			(a.seqIdx > b.seqIdx);
+			UINT64 key = priorityKey;
+			switch (mStateReductionMode)
+			{
+			case StateReduction::None:
+				key = (key << distanceBits) | distanceKey;
+				break;
+			case StateReduction::Material:
+				key = (key << groupBits) | groupKey;
+				key = (key << distanceBits) | distanceKey;
+				break;
+			case StateReduction::Distance:
+				key = (key << distanceBits) | distanceKey;
+				key = (key << groupBits) | groupKey;
+				break;
+			}
 
-		return isHigher > isLower;
+			mSortKeys[i] = key;
+		}
+
+		return priorityBits + groupBits + distanceBits;
 	}
 
-	bool RenderQueue::elementSorterPreferGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
+	void RenderQueue::sortByKeys(UINT32 numKeyBits)
 	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-		
-		UINT8 isHigher = (a.priority > b.priority) << 4 |
-			(a.shaderId < b.shaderId) << 3 |
-			(a.passIdx < b.passIdx) << 2 |
-			(a.distFromCamera < b.distFromCamera) << 1 |
-			(a.seqIdx < b.seqIdx);
-
-		UINT8 isLower = (a.priority < b.priority) << 4 |
-			(a.shaderId > b.shaderId) << 3 |
-			(a.passIdx > b.passIdx) << 2 |
-			(a.distFromCamera > b.distFromCamera) << 1 |
-			(a.seqIdx > b.seqIdx);
-
-		return isHigher > isLower;
+		static const UINT32 RADIX_BITS = 8;
+		static const UINT32 RADIX_SIZE = 1 << RADIX_BITS;
+
+		UINT32 numElements = (UINT32)mSortKeys.size();
+		mSortKeysTemp.resize(numElements);
+		mSortableElementIdxTemp.resize(numElements);
+
+		UINT64* srcKeys = mSortKeys.data();
+		UINT64* dstKeys = mSortKeysTemp.data();
+		UINT32* srcIndices = mSortableElementIdx.data();
+		UINT32* dstIndices = mSortableElementIdxTemp.data();
+
+		UINT32 numDigits = (numKeyBits + RADIX_BITS - 1) / RADIX_BITS;
+		for (UINT32 digit = 0; digit < numDigits; digit++)
+		{
+			UINT32 shift = digit * RADIX_BITS;
+
+			UINT32 offsets[RADIX_SIZE];
+			memset(offsets, 0, sizeof(offsets));
+
+			for (UINT32 i = 0; i < numElements; i++)
+				offsets[(srcKeys[i] >> shift) & (RADIX_SIZE - 1)]++;
+
+			// Skip the pass if all the keys share the same digit, as it wouldn't change the order
+			if (offsets[(srcKeys[0] >> shift) & (RADIX_SIZE - 1)] == numElements)
+				continue;
+
+			UINT32 offset = 0;
+			for (UINT32 i = 0; i < RADIX_SIZE; i++)
+			{
+				UINT32 count = offsets[i];
+				offsets[i] = offset;
+				offset += count;
+			}
+
+			for (UINT32 i = 0; i < numElements; i++)
+			{
+				UINT32 dstIdx = offsets[(srcKeys[i] >> shift) & (RADIX_SIZE - 1)]++;
+
+				dstKeys[dstIdx] = srcKeys[i];
+				dstIndices[dstIdx] = srcIndices[i];
+			}
+
+			std::swap(srcKeys, dstKeys);
+			std::swap(srcIndices, dstIndices);
+		}
+
+		// Odd number of passes leaves the results in the temporary buffers
+		if (srcIndices != mSortableElementIdx.data())
+			mSortableElementIdx.swap(mSortableElementIdxTemp);
 	}
 
-	bool RenderQueue::elementSorterPreferSort(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
+	UINT32 RenderQueue::getSortableDistance(float distance)
 	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-
-		UINT8 isHigher = (a.priority > b.priority) << 4 | 
-			(a.distFromCamera < b.distFromCamera) << 3 | 
-			(a.shaderId < b.shaderId) << 2 | 
-			(a.passIdx < b.passIdx) << 1 | 
-			(a.seqIdx < b.seqIdx);
-
-		UINT8 isLower = (a.priority < b.priority) << 4 |
-			(a.distFromCamera > b.distFromCamera) << 3 |
-			(a.shaderId > b.shaderId) << 2 |
-			(a.passIdx > b.passIdx) << 1 |
-			(a.seqIdx > b.seqIdx);
-
-		return isHigher > isLower;
+		UINT32 bits;
+		memcpy(&bits, &distance, sizeof(bits));
+
+		// Flip all bits of negative values so they sort in reverse, and the sign bit of positive ones so they sort after
+		// negative values
+		UINT32 mask = (UINT32)(-(INT32)(bits >> 31)) | 0x80000000;
+		return bits ^ mask;
 	}
 
 	const Vector<RenderQueueElement>& RenderQueue::getSortedElements() const
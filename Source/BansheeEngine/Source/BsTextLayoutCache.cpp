@@ -0,0 +1,116 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsTextLayoutCache.h"
+#include "BsFont.h"
+
+namespace bs
+{
+	size_t TextLayoutCache::KeyHash::operator()(const Key* key) const
+	{
+		size_t hash = 0;
+		hash_combine(hash, key->text);
+		hash_combine(hash, key->fontId);
+		hash_combine(hash, key->fontSize);
+		hash_combine(hash, key->width);
+		hash_combine(hash, key->height);
+		hash_combine(hash, key->anchor);
+		hash_combine(hash, key->horzAlign);
+		hash_combine(hash, key->vertAlign);
+		hash_combine(hash, key->wordWrap);
+		hash_combine(hash, key->wordBreak);
+
+		return hash;
+	}
+
+	bool TextLayoutCache::KeyEqual::operator()(const Key* a, const Key* b) const
+	{
+		return a->fontId == b->fontId && a->fontSize == b->fontSize && a->width == b->width && a->height == b->height &&
+			a->anchor == b->anchor && a->horzAlign == b->horzAlign && a->vertAlign == b->vertAlign &&
+			a->wordWrap == b->wordWrap && a->wordBreak == b->wordBreak && a->text == b->text;
+	}
+
+	TextLayoutCache::TextLayoutCache(UINT32 capacity)
+		:mCapacity(capacity)
+	{ }
+
+	const Vector<TextLayoutPage>* TextLayoutCache::find(const TEXT_SPRITE_DESC& desc)
+	{
+		Key key = createKey(desc);
+
+		auto iterFind = mLookup.find(&key);
+		if (iterFind == mLookup.end())
+			return nullptr;
+
+		// Move to front, keeping the node (and the key referenced by the lookup table) in place
+		mEntries.splice(mEntries.begin(), mEntries, iterFind->second);
+		return &iterFind->second->pages;
+	}
+
+	void TextLayoutCache::add(const TEXT_SPRITE_DESC& desc, Vector<TextLayoutPage> pages)
+	{
+		if (mCapacity == 0)
+			return;
+
+		Key key = createKey(desc);
+
+		auto iterFind = mLookup.find(&key);
+		if (iterFind != mLookup.end())
+		{
+			iterFind->second->pages = std::move(pages);
+			mEntries.splice(mEntries.begin(), mEntries, iterFind->second);
+			return;
+		}
+
+		mEntries.push_front(Entry());
+
+		Entry& entry = mEntries.front();
+		entry.key = std::move(key);
+		entry.pages = std::move(pages);
+
+		mLookup[&entry.key] = mEntries.begin();
+		trim();
+	}
+
+	void TextLayoutCache::clear()
+	{
+		mLookup.clear();
+		mEntries.clear();
+	}
+
+	void TextLayoutCache::setCapacity(UINT32 capacity)
+	{
+		mCapacity = capacity;
+		trim();
+	}
+
+	bool TextLayoutCache::isCacheable(const TEXT_SPRITE_DESC& desc)
+	{
+		return desc.text.size() <= MAX_TEXT_LENGTH && desc.font.isLoaded();
+	}
+
+	TextLayoutCache::Key TextLayoutCache::createKey(const TEXT_SPRITE_DESC& desc)
+	{
+		Key key;
+		key.text = desc.text;
+		key.fontId = desc.font.isLoaded() ? desc.font->getInternalID() : 0;
+		key.fontSize = desc.fontSize;
+		key.width = desc.width;
+		key.height = desc.height;
+		key.anchor = desc.anchor;
+		key.horzAlign = desc.horzAlign;
+		key.vertAlign = desc.vertAlign;
+		key.wordWrap = desc.wordWrap;
+		key.wordBreak = desc.wordBreak;
+
+		return key;
+	}
+
+	void TextLayoutCache::trim()
+	{
+		while (mEntries.size() > mCapacity)
+		{
+			mLookup.erase(&mEntries.back().key);
+			mEntries.pop_back();
+		}
+	}
+}
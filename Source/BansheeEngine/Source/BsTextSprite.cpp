@@ -4,6 +4,8 @@
 #include "BsTextData.h"
 #include "BsVector2.h"
 #include "BsSpriteManager.h"
+#include "BsTextLayoutCache.h"
+#include "BsFont.h"
 
 namespace bs
 {
@@ -19,6 +21,53 @@ namespace bs
 
 	void TextSprite::update(const TEXT_SPRITE_DESC& desc, UINT64 groupId)
 	{
+		// Short strings are often laid out with the same parameters over and over, in which case we can reuse the quads
+		TextLayoutCache* layoutCache = nullptr;
+		if (TextLayoutCache::isStarted() && TextLayoutCache::isCacheable(desc))
+			layoutCache = TextLayoutCache::instancePtr();
+
+		if (layoutCache != nullptr)
+		{
+			// Layouts only store page indices, as the font's textures shouldn't be kept alive by the cache
+			const Vector<TextLayoutPage>* pages = layoutCache->find(desc);
+			SPtr<const FontBitmap> fontData = desc.font->getBitmap(desc.font->getClosestSize(desc.fontSize));
+
+			if (pages != nullptr && fontData != nullptr && pages->size() <= fontData->texturePages.size())
+			{
+				freeBuffers();
+
+				UINT32 numPages = (UINT32)pages->size();
+				mCachedRenderElements.resize(numPages);
+
+				for (UINT32 i = 0; i < numPages; i++)
+				{
+					const TextLayoutPage& page = (*pages)[i];
+					SpriteRenderElement& renderElem = mCachedRenderElements[i];
+
+					allocBuffers(renderElem, page.numQuads);
+					setMaterial(renderElem, fontData->texturePages[i], desc, groupId);
+
+					if (page.numQuads > 0)
+					{
+						memcpy(renderElem.vertices, page.vertices.data(), sizeof(Vector2) * page.numQuads * 4);
+						memcpy(renderElem.uvs, page.uvs.data(), sizeof(Vector2) * page.numQuads * 4);
+						memcpy(renderElem.indexes, page.indices.data(), sizeof(UINT32) * page.numQuads * 6);
+					}
+				}
+
+				// Cached text is never long enough to be appended to
+				mAppendInfo = AppendInfo();
+
+				updateBounds();
+				return;
+			}
+		}
+		else if (updateAppended(desc, groupId))
+		{
+			updateBounds();
+			return;
+		}
+
 		bs_frame_mark();
 		{
 			TextData<FrameAlloc> textData(desc.text, desc.font, desc.fontSize, desc.width, desc.height, desc.wordWrap, desc.wordBreak);
@@ -26,14 +75,7 @@ namespace bs
 			UINT32 numPages = textData.getNumPages();
 
 			// Free all previous memory
-			for (auto& cachedElem : mCachedRenderElements)
-			{
-				if (cachedElem.vertices != nullptr) mAlloc.free(cachedElem.vertices);
-				if (cachedElem.uvs != nullptr) mAlloc.free(cachedElem.uvs);
-				if (cachedElem.indexes != nullptr) mAlloc.free(cachedElem.indexes);
-			}
-
-			mAlloc.clear();
+			freeBuffers();
 
 			// Resize cached mesh array to needed size
 			if (mCachedRenderElements.size() != numPages)
@@ -43,21 +85,8 @@ namespace bs
 			UINT32 texPage = 0;
 			for (auto& cachedElem : mCachedRenderElements)
 			{
-				UINT32 newNumQuads = textData.getNumQuadsForPage(texPage);
-
-				cachedElem.vertices = (Vector2*)mAlloc.alloc(sizeof(Vector2) * newNumQuads * 4);
-				cachedElem.uvs = (Vector2*)mAlloc.alloc(sizeof(Vector2) * newNumQuads * 4);
-				cachedElem.indexes = (UINT32*)mAlloc.alloc(sizeof(UINT32) * newNumQuads * 6);
-				cachedElem.numQuads = newNumQuads;
-
-				const HTexture& tex = textData.getTextureForPage(texPage);
-
-				SpriteMaterialInfo& matInfo = cachedElem.matInfo;
-				matInfo.groupId = groupId;
-				matInfo.texture = tex;
-				matInfo.tint = desc.color;
-
-				cachedElem.material = SpriteManager::instance().getTextMaterial();
+				allocBuffers(cachedElem, textData.getNumQuadsForPage(texPage));
+				setMaterial(cachedElem, textData.getTextureForPage(texPage), desc, groupId);
 
 				texPage++;
 			}
@@ -70,6 +99,26 @@ namespace bs
 				genTextQuads(j, textData, desc.width, desc.height, desc.horzAlign, desc.vertAlign, desc.anchor,
 					renderElem.vertices, renderElem.uvs, renderElem.indexes, renderElem.numQuads);
 			}
+
+			if (layoutCache != nullptr)
+			{
+				Vector<TextLayoutPage> pages(numPages);
+				for (UINT32 j = 0; j < numPages; j++)
+				{
+					const SpriteRenderElement& renderElem = mCachedRenderElements[j];
+					UINT32 numQuads = renderElem.numQuads;
+
+					TextLayoutPage& page = pages[j];
+					page.numQuads = numQuads;
+					page.vertices.assign(renderElem.vertices, renderElem.vertices + numQuads * 4);
+					page.uvs.assign(renderElem.uvs, renderElem.uvs + numQuads * 4);
+					page.indices.assign(renderElem.indexes, renderElem.indexes + numQuads * 6);
+				}
+
+				layoutCache->add(desc, std::move(pages));
+			}
+
+			updateAppendInfo(desc, textData);
 		}
 
 		bs_frame_clear();
@@ -77,6 +126,230 @@ namespace bs
 		updateBounds();
 	}
 
+	bool TextSprite::updateAppended(const TEXT_SPRITE_DESC& desc, UINT64 groupId)
+	{
+		if (!mAppendInfo.isValid || desc.wordWrap || desc.horzAlign != THA_Left || desc.vertAlign != TVA_Top)
+			return false;
+
+		if (desc.font != mAppendInfo.font || desc.fontSize != mAppendInfo.fontSize || desc.width != mAppendInfo.width ||
+			desc.height != mAppendInfo.height || desc.anchor != mAppendInfo.anchor || desc.wordBreak != mAppendInfo.wordBreak)
+			return false;
+
+		// New text must start with the old text
+		const WString& oldText = mAppendInfo.text;
+		if (desc.text.size() <= oldText.size() || desc.text.compare(0, oldText.size(), oldText) != 0)
+			return false;
+
+		// A line break followed by \n is treated as a single line break, so if the old text ends with one the appended
+		// text could merge into it
+		UINT32 lastLineStart = mAppendInfo.lastLineStart;
+		if (lastLineStart > 0 && lastLineStart == (UINT32)oldText.size() && desc.text[lastLineStart] == L'\n')
+			return false;
+
+		if (!desc.font.isLoaded())
+			return false;
+
+		SPtr<const FontBitmap> fontData = desc.font->getBitmap(desc.font->getClosestSize(desc.fontSize));
+		if (fontData == nullptr)
+			return false;
+
+		bool updated = false;
+		UINT32 newLastLineStart = 0;
+		UINT32 newLastLineIdx = 0;
+		UINT32 oldNumPages = (UINT32)mCachedRenderElements.size();
+
+		bs_frame_mark();
+		{
+			// Find how many quads on each page belong to the lines before the last one. Every character on the last line
+			// outputs one quad, with whitespace quads being stored on the first page.
+			FrameVector<UINT32> numPrefixQuads(oldNumPages);
+			for (UINT32 i = 0; i < oldNumPages; i++)
+				numPrefixQuads[i] = mCachedRenderElements[i].numQuads;
+
+			bool isValid = true;
+			for (UINT32 i = lastLineStart; i < (UINT32)oldText.size(); i++)
+			{
+				UINT32 charId = oldText[i];
+
+				UINT32 page = 0;
+				if (charId != ' ' && charId != '\t')
+					page = fontData->getCharDesc(charId).page;
+
+				if (page >= oldNumPages || numPrefixQuads[page] == 0)
+				{
+					isValid = false;
+					break;
+				}
+
+				numPrefixQuads[page]--;
+			}
+
+			if (isValid)
+			{
+				// Lines before the last one remain as is, so only lay out the text starting with the last line
+				WString appendedText = desc.text.substr(lastLineStart);
+				TextData<FrameAlloc> textData(appendedText, desc.font, desc.fontSize, desc.width, desc.height, false,
+					desc.wordBreak);
+
+				UINT32 numAppendedPages = textData.getNumPages();
+				UINT32 numPages = std::max(oldNumPages, numAppendedPages);
+				float lineOffset = (float)(mAppendInfo.lastLineIdx * textData.getLineHeight());
+
+				// Geometry buffers can only be freed all at once, so move the quads we're keeping out of them first
+				FrameVector<SpriteRenderElement> prefixElems(oldNumPages);
+				for (UINT32 i = 0; i < oldNumPages; i++)
+				{
+					const SpriteRenderElement& renderElem = mCachedRenderElements[i];
+					UINT32 numQuads = numPrefixQuads[i];
+
+					SpriteRenderElement& prefixElem = prefixElems[i];
+					prefixElem.numQuads = numQuads;
+					prefixElem.matInfo.texture = renderElem.matInfo.texture;
+
+					if (numQuads > 0)
+					{
+						prefixElem.vertices = (Vector2*)bs_frame_alloc(sizeof(Vector2) * numQuads * 4);
+						prefixElem.uvs = (Vector2*)bs_frame_alloc(sizeof(Vector2) * numQuads * 4);
+						prefixElem.indexes = (UINT32*)bs_frame_alloc(sizeof(UINT32) * numQuads * 6);
+
+						memcpy(prefixElem.vertices, renderElem.vertices, sizeof(Vector2) * numQuads * 4);
+						memcpy(prefixElem.uvs, renderElem.uvs, sizeof(Vector2) * numQuads * 4);
+						memcpy(prefixElem.indexes, renderElem.indexes, sizeof(UINT32) * numQuads * 6);
+					}
+				}
+
+				freeBuffers();
+				mCachedRenderElements.resize(numPages);
+
+				for (UINT32 i = 0; i < numPages; i++)
+				{
+					SpriteRenderElement& renderElem = mCachedRenderElements[i];
+
+					UINT32 numPrefix = i < oldNumPages ? numPrefixQuads[i] : 0;
+					UINT32 numAppended = i < numAppendedPages ? textData.getNumQuadsForPage(i) : 0;
+
+					allocBuffers(renderElem, numPrefix + numAppended);
+
+					if (i < numAppendedPages)
+						setMaterial(renderElem, textData.getTextureForPage(i), desc, groupId);
+					else
+						setMaterial(renderElem, prefixElems[i].matInfo.texture, desc, groupId);
+
+					if (numPrefix > 0)
+					{
+						const SpriteRenderElement& prefixElem = prefixElems[i];
+
+						memcpy(renderElem.vertices, prefixElem.vertices, sizeof(Vector2) * numPrefix * 4);
+						memcpy(renderElem.uvs, prefixElem.uvs, sizeof(Vector2) * numPrefix * 4);
+						memcpy(renderElem.indexes, prefixElem.indexes, sizeof(UINT32) * numPrefix * 6);
+					}
+
+					if (numAppended > 0)
+					{
+						Vector2* vertices = renderElem.vertices + numPrefix * 4;
+						UINT32* indices = renderElem.indexes + numPrefix * 6;
+
+						genTextQuads(i, textData, desc.width, desc.height, desc.horzAlign, desc.vertAlign, desc.anchor,
+							vertices, renderElem.uvs + numPrefix * 4, indices, numAppended);
+
+						// Quads were generated as if the text started at the first line, and at the start of the buffer
+						for (UINT32 j = 0; j < numAppended * 4; j++)
+							vertices[j].y += lineOffset;
+
+						for (UINT32 j = 0; j < numAppended * 6; j++)
+							indices[j] += numPrefix * 4;
+					}
+				}
+
+				for (auto& prefixElem : prefixElems)
+				{
+					if (prefixElem.vertices != nullptr) bs_frame_free(prefixElem.vertices);
+					if (prefixElem.uvs != nullptr) bs_frame_free(prefixElem.uvs);
+					if (prefixElem.indexes != nullptr) bs_frame_free(prefixElem.indexes);
+				}
+
+				newLastLineStart = lastLineStart + getLastLineStart(textData, (UINT32)appendedText.size());
+				newLastLineIdx = mAppendInfo.lastLineIdx + textData.getNumLines() - 1;
+
+				updated = true;
+			}
+		}
+		bs_frame_clear();
+
+		if (!updated)
+			return false;
+
+		mAppendInfo.text = desc.text;
+		mAppendInfo.lastLineStart = newLastLineStart;
+		mAppendInfo.lastLineIdx = newLastLineIdx;
+
+		return true;
+	}
+
+	void TextSprite::updateAppendInfo(const TEXT_SPRITE_DESC& desc, const TextDataBase& textData)
+	{
+		// Only long strings benefit from incremental updates, while short ones are handled by the layout cache
+		bool canAppend = !desc.wordWrap && desc.horzAlign == THA_Left && desc.vertAlign == TVA_Top &&
+			desc.text.size() > TextLayoutCache::MAX_TEXT_LENGTH;
+
+		if (!canAppend)
+		{
+			if (mAppendInfo.isValid)
+				mAppendInfo = AppendInfo();
+
+			return;
+		}
+
+		mAppendInfo.text = desc.text;
+		mAppendInfo.font = desc.font;
+		mAppendInfo.fontSize = desc.fontSize;
+		mAppendInfo.width = desc.width;
+		mAppendInfo.height = desc.height;
+		mAppendInfo.anchor = desc.anchor;
+		mAppendInfo.wordBreak = desc.wordBreak;
+		mAppendInfo.lastLineStart = getLastLineStart(textData, (UINT32)desc.text.size());
+		mAppendInfo.lastLineIdx = textData.getNumLines() - 1;
+		mAppendInfo.isValid = true;
+	}
+
+	UINT32 TextSprite::getLastLineStart(const TextDataBase& textData, UINT32 numChars)
+	{
+		// The last line is never followed by a line break, so it holds all the characters at the end of the text
+		const TextDataBase::TextLine& lastLine = textData.getLine(textData.getNumLines() - 1);
+		return numChars - lastLine.getNumChars();
+	}
+
+	void TextSprite::allocBuffers(SpriteRenderElement& renderElem, UINT32 numQuads)
+	{
+		renderElem.vertices = (Vector2*)mAlloc.alloc(sizeof(Vector2) * numQuads * 4);
+		renderElem.uvs = (Vector2*)mAlloc.alloc(sizeof(Vector2) * numQuads * 4);
+		renderElem.indexes = (UINT32*)mAlloc.alloc(sizeof(UINT32) * numQuads * 6);
+		renderElem.numQuads = numQuads;
+	}
+
+	void TextSprite::freeBuffers()
+	{
+		for (auto& cachedElem : mCachedRenderElements)
+		{
+			if (cachedElem.vertices != nullptr) mAlloc.free(cachedElem.vertices);
+			if (cachedElem.uvs != nullptr) mAlloc.free(cachedElem.uvs);
+			if (cachedElem.indexes != nullptr) mAlloc.free(cachedElem.indexes);
+		}
+
+		mAlloc.clear();
+	}
+
+	void TextSprite::setMaterial(SpriteRenderElement& renderElem, const HTexture& texture, const TEXT_SPRITE_DESC& desc,
+		UINT64 groupId)
+	{
+		SpriteMaterialInfo& matInfo = renderElem.matInfo;
+		matInfo.groupId = groupId;
+		matInfo.texture = texture;
+		matInfo.tint = desc.color;
+
+		renderElem.material = SpriteManager::instance().getTextMaterial();
+	}
+
 	UINT32 TextSprite::genTextQuads(UINT32 page, const TextDataBase& textData, UINT32 width, UINT32 height,
 		TextHorzAlign horzAlign, TextVertAlign vertAlign, SpriteAnchor anchor, Vector2* vertices, Vector2* uv, UINT32* indices, UINT32 bufferSizeQuads)
 	{
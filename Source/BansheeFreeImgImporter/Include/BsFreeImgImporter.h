@@ -32,6 +32,9 @@ namespace bs
 
 		/** @copydoc SpecificImporter::createImportOptions */
 		SPtr<ImportOptions> createImportOptions() const override;
+
+		/** @copydoc SpecificImporter::isThreadSafe */
+		bool isThreadSafe() const override { return true; }
 	private:
 		/**	Converts a magic number into an extension name. */
 		WString magicNumToExtension(const UINT8* magic, UINT32 maxBytes) const;
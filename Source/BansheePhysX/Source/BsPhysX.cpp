@@ -287,10 +287,7 @@ namespace bs
 	public:
 		void submitTask(PxBaseTask& physxTask) override
 		{
-			// Note: Banshee's task scheduler is pretty low granularity. Consider a better task manager in case PhysX ends
-			// up submitting many tasks.
-			// - PhysX's task manager doesn't seem much lighter either. But perhaps I can at least create a task pool to 
-			//   avoid allocating them constantly.
+			// Note: Consider a task pool to avoid allocating tasks constantly, in case PhysX ends up submitting many of them.
 
 			auto runTask = [&]() { physxTask.run(); physxTask.release(); };
 			SPtr<Task> task = Task::create("PhysX", runTask);
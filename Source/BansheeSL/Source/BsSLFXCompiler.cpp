@@ -13,6 +13,10 @@
 #include "BsShaderInclude.h"
 #include "BsMatrix4.h"
 #include "BsBuiltinResources.h"
+#include "BsFileSystem.h"
+#include "BsDataStream.h"
+#include "BsTaskScheduler.h"
+#include "BsPaths.h"
 
 #define XSC_ENABLE_LANGUAGE_EXT 1
 #include "Xsc/Xsc.h"
@@ -522,8 +526,15 @@ namespace bs
 		}
 	}
 
+	/** 
+	 * Guards calls into XShaderCompiler. Programs are cross-compiled from multiple task scheduler workers, but the 
+	 * compiler makes no guarantees about being reentrant, so only the work around it (hashing, cache lookups) is done in
+	 * parallel.
+	 */
+	static Mutex sXscMutex;
+
 	String crossCompile(const String& hlsl, GpuProgramType type, bool vulkan, bool optionalEntry, UINT32& startBindingSlot,
-		SHADER_DESC* shaderDesc = nullptr, Vector<GpuProgramType>* detectedTypes = nullptr)
+		Xsc::Reflection::ReflectionData* reflection = nullptr, Vector<GpuProgramType>* detectedTypes = nullptr)
 	{
 		SPtr<StringStream> input = bs_shared_ptr_new<StringStream>();
 
@@ -586,7 +597,12 @@ namespace bs
 
 		XscLog log;
 		Xsc::Reflection::ReflectionData reflectionData;
-		bool compileSuccess = Xsc::CompileShader(inputDesc, outputDesc, &log, &reflectionData);
+		bool compileSuccess;
+		{
+			Lock lock(sXscMutex);
+			compileSuccess = Xsc::CompileShader(inputDesc, outputDesc, &log, &reflectionData);
+		}
+
 		if (!compileSuccess)
 		{
 			// If enabled, don't fail if entry point isn't found
@@ -655,22 +671,248 @@ namespace bs
 			}
 		}
 
-		if (shaderDesc != nullptr)
-			parseParameters(reflectionData, *shaderDesc);
+		if (reflection != nullptr)
+			*reflection = std::move(reflectionData);
 
 		return output.str();
 	}
 
-	// Convert HLSL code to GLSL
-	String HLSLtoGLSL(const String& hlsl, GpuProgramType type, bool vulkan, UINT32& startBindingSlot)
+	/** Code generated by a single cross-compile operation, as stored in the CrossCompileCache. */
+	struct CrossCompileOutput
 	{
-		return crossCompile(hlsl, type, vulkan, false, startBindingSlot);
+		String code;
+		UINT32 endBindingSlot = 0;
+	};
+
+	/**
+	 * Persistent on-disk cache of GLSL/VKSL code generated by cross-compiling HLSL, so shaders that didn't change since
+	 * they were last imported skip cross-compilation. Entries are keyed by the hash of the preprocessed HLSL source (which
+	 * already has the shader defines applied), the program type, the target language, the first binding slot and the
+	 * version of the cross-compiler.
+	 *
+	 * The first time the cache is accessed in a session, entries created by other versions of the cross-compiler or of
+	 * the cache format are deleted. Remaining entries are then deleted oldest first until the cache fits within
+	 * MAX_CACHE_SIZE.
+	 *
+	 * @note	Thread safe.
+	 */
+	class CrossCompileCache
+	{
+	public:
+		/** Looks up previously generated code. Returns false if the code isn't in the cache. */
+		static bool find(const String& sourceHash, GpuProgramType type, bool vulkan, UINT32 startBindingSlot,
+			CrossCompileOutput& output)
+		{
+			prune();
+
+			Path path = getEntryPath(sourceHash, type, vulkan, startBindingSlot);
+			if (!FileSystem::isFile(path))
+				return false;
+
+			SPtr<DataStream> stream = FileSystem::openFile(path);
+			if (stream == nullptr)
+				return false;
+
+			UINT32 header[3];
+			if (stream->read(header, sizeof(header)) != sizeof(header) || header[0] != VERSION)
+				return false;
+
+			output.endBindingSlot = header[1];
+			output.code.resize(header[2]);
+
+			if (header[2] > 0 && stream->read(&output.code[0], header[2]) != header[2])
+				return false;
+
+			return true;
+		}
+
+		/** Stores generated code in the cache. */
+		static void add(const String& sourceHash, GpuProgramType type, bool vulkan, UINT32 startBindingSlot,
+			const CrossCompileOutput& output)
+		{
+			prune();
+
+			Path path = getEntryPath(sourceHash, type, vulkan, startBindingSlot);
+
+			// Write to a temporary file first, so readers on other threads never see a partially written entry
+			Path tempPath = path;
+			tempPath.setExtension(".tmp");
+
+			Lock lock(sMutex);
+
+			Path folder = getCacheFolder();
+			if (!FileSystem::exists(folder))
+				FileSystem::createDir(folder);
+
+			{
+				SPtr<DataStream> stream = FileSystem::createAndOpenFile(tempPath);
+
+				UINT32 header[3] = { VERSION, output.endBindingSlot, (UINT32)output.code.size() };
+				stream->write(header, sizeof(header));
+				stream->write(output.code.data(), output.code.size());
+				stream->close();
+			}
+
+			FileSystem::move(tempPath, path, true);
+		}
+
+	private:
+		/** 
+		 * Deletes stale entries and entries over the size limit, as described in the class documentation. Only performs
+		 * work on the first call, subsequent calls return immediately.
+		 */
+		static void prune()
+		{
+			Lock lock(sMutex);
+
+			if (sIsPruned)
+				return;
+
+			sIsPruned = true;
+
+			Path folder = getCacheFolder();
+			if (!FileSystem::exists(folder))
+				return;
+
+			struct Entry
+			{
+				Path path;
+				std::time_t modifiedTime;
+				UINT64 size;
+			};
+
+			Vector<Path> files;
+			Vector<Path> directories;
+			FileSystem::getChildren(folder, files, directories);
+
+			String suffix = getEntrySuffix();
+
+			Vector<Entry> entries;
+			UINT64 totalSize = 0;
+			for (auto& file : files)
+			{
+				// Anything not matching the current suffix is a stale entry, or a temporary file left over by an
+				// interrupted write
+				String filename = file.getFilename();
+				bool isCurrent = filename.size() >= suffix.size() &&
+					filename.compare(filename.size() - suffix.size(), suffix.size(), suffix) == 0;
+
+				if (!isCurrent)
+				{
+					FileSystem::remove(file);
+					continue;
+				}
+
+				UINT64 size = FileSystem::getFileSize(file);
+				entries.push_back({ file, FileSystem::getLastModifiedTime(file), size });
+
+				totalSize += size;
+			}
+
+			if (totalSize <= MAX_CACHE_SIZE)
+				return;
+
+			std::sort(entries.begin(), entries.end(),
+				[](const Entry& a, const Entry& b) { return a.modifiedTime < b.modifiedTime; });
+
+			for (auto& entry : entries)
+			{
+				if (totalSize <= MAX_CACHE_SIZE)
+					break;
+
+				FileSystem::remove(entry.path);
+				totalSize -= entry.size;
+			}
+		}
+
+		/** Returns the folder the cache entries are stored in. */
+		static const Path& getCacheFolder()
+		{
+			static Path path = Paths::getRuntimeDataPath() + "ShaderCache\\";
+			return path;
+		}
+
+		/** Returns the path to the file storing the cache entry with the specified key. */
+		static Path getEntryPath(const String& sourceHash, GpuProgramType type, bool vulkan, UINT32 startBindingSlot)
+		{
+			Path path = getCacheFolder();
+			path.setFilename(sourceHash + "_" + toString((UINT32)type) + (vulkan ? "_vksl_" : "_glsl_") + 
+				toString(startBindingSlot) + getEntrySuffix());
+
+			return path;
+		}
+
+		/** 
+		 * Returns the end of the file name shared by all entries created by the current version of the cross-compiler
+		 * and the current cache format.
+		 */
+		static String getEntrySuffix()
+		{
+			return "_" + getCompilerVersion() + "_" + toString(VERSION) + ".bsc";
+		}
+
+		/** 
+		 * Returns the version of the cross-compiler, in a form usable in a file name. Code generated by other versions of
+		 * the cross-compiler is never used.
+		 */
+		static const String& getCompilerVersion()
+		{
+			static String version = createCompilerVersion();
+			return version;
+		}
+
+		/** Converts the cross-compiler version string into a form usable in a file name. */
+		static String createCompilerVersion()
+		{
+			String version = XSC_VERSION_STRING;
+			for (auto& entry : version)
+			{
+				if (!isalnum((unsigned char)entry))
+					entry = '_';
+			}
+
+			return version;
+		}
+
+		/** Version of the cache entry format. Increment to invalidate all existing entries. */
+		static const UINT32 VERSION = 1;
+
+		/** Maximum total size of the cache entries, in bytes. */
+		static const UINT64 MAX_CACHE_SIZE = 64 * 1024 * 1024;
+
+		static Mutex sMutex;
+		static bool sIsPruned;
+	};
+
+	Mutex CrossCompileCache::sMutex;
+	bool CrossCompileCache::sIsPruned = false;
+
+	// Convert HLSL code to GLSL, or retrieve the previously converted code from the cache
+	String HLSLtoGLSL(const String& hlsl, const String& hlslHash, GpuProgramType type, bool vulkan, 
+		UINT32& startBindingSlot)
+	{
+		CrossCompileOutput cached;
+		if (CrossCompileCache::find(hlslHash, type, vulkan, startBindingSlot, cached))
+		{
+			startBindingSlot = cached.endBindingSlot;
+			return cached.code;
+		}
+
+		UINT32 firstBindingSlot = startBindingSlot;
+		String output = crossCompile(hlsl, type, vulkan, false, startBindingSlot);
+
+		// Don't cache failures, so the error is reported every time the shader is imported
+		if (!output.empty())
+			CrossCompileCache::add(hlslHash, type, vulkan, firstBindingSlot, { output, startBindingSlot });
+
+		return output;
 	}
 
-	void reflectHLSL(const String& hlsl, SHADER_DESC& shaderDesc, Vector<GpuProgramType>& entryPoints)
+	void reflectHLSL(const String& hlsl, Xsc::Reflection::ReflectionData& reflection, 
+		Vector<GpuProgramType>& entryPoints)
 	{
 		UINT32 dummy = 0;
-		crossCompile(hlsl, GPT_VERTEX_PROGRAM, false, true, dummy, &shaderDesc, &entryPoints);
+		crossCompile(hlsl, GPT_VERTEX_PROGRAM, false, true, dummy, &reflection, &entryPoints);
 	}
 
 	BSLFXCompileResult BSLFXCompiler::compile(const String& name, const String& source, 
@@ -1604,88 +1846,155 @@ namespace bs
 		bs_stack_free(techniqueWasParsed);
 
 		// Parse extended HLSL code and generate per-program code, also convert to GLSL/VKSL
-		UINT32 end = (UINT32)techniqueData.size();
-		for(UINT32 i = 0; i < end; i++)
+		Vector<pair<ASTFXNode*, TechniqueData>> crossCompiledTechniques;
+		UINT32 numPasses = 0;
+		for (auto& entry : techniqueData)
 		{
-			const TechniqueMetaData& metaData = techniqueData[i].second.metaData;
-			if (metaData.isMixin)
+			if (entry.second.metaData.isMixin)
 				continue;
 
-			TechniqueData& hlslTechnique = techniqueData[i].second;
+			TechniqueData& hlslTechnique = entry.second;
 
-			TechniqueData glslTechnique = techniqueData[i].second;
+			TechniqueData glslTechnique = hlslTechnique;
 			glslTechnique.metaData.language = "glsl";
 
-			TechniqueData vkslTechnique = techniqueData[i].second;
+			TechniqueData vkslTechnique = hlslTechnique;
 			vkslTechnique.metaData.language = "vksl";
 
-			UINT32 numPasses = (UINT32)hlslTechnique.passes.size();
+			// Clean non-standard HLSL 
+			static const std::regex regex("\\[\\s*layout\\s*\\(.*\\)\\s*\\]|\\[\\s*internal\\s*\\]|\\[\\s*color\\s*\\]");
+			for (auto& passData : hlslTechnique.passes)
+				passData.code = regex_replace(passData.code, regex, "");
+
+			crossCompiledTechniques.push_back(std::make_pair(entry.first, glslTechnique));
+			crossCompiledTechniques.push_back(std::make_pair(entry.first, vkslTechnique));
+
+			numPasses += (UINT32)hlslTechnique.passes.size();
+		}
+
+		// Per-pass cross-compilation state. Passes are independent of each other, so they are processed in parallel.
+		struct PassCompileData
+		{
+			PassData* hlsl;
+			PassData* glsl;
+			PassData* vksl;
+
+			String sourceHash;
+			Xsc::Reflection::ReflectionData reflection;
+			Vector<GpuProgramType> types;
+		};
+
+		Vector<PassCompileData> passCompileData;
+		passCompileData.reserve(numPasses);
+
+		UINT32 crossCompiledIdx = 0;
+		for (auto& entry : techniqueData)
+		{
+			if (entry.second.metaData.isMixin)
+				continue;
+
+			TechniqueData& hlslTechnique = entry.second;
+			TechniqueData& glslTechnique = crossCompiledTechniques[crossCompiledIdx++].second;
+			TechniqueData& vkslTechnique = crossCompiledTechniques[crossCompiledIdx++].second;
+
+			for (UINT32 i = 0; i < (UINT32)hlslTechnique.passes.size(); i++)
+			{
+				PassCompileData data;
+				data.hlsl = &hlslTechnique.passes[i];
+				data.glsl = &glslTechnique.passes[i];
+				data.vksl = &vkslTechnique.passes[i];
+
+				passCompileData.push_back(std::move(data));
+			}
+		}
+
+		auto getProgramCode = [](PassData& passData, GpuProgramType type) -> String&
+		{
+			switch (type)
+			{
+			case GPT_FRAGMENT_PROGRAM: return passData.fragmentCode;
+			case GPT_GEOMETRY_PROGRAM: return passData.geometryCode;
+			case GPT_HULL_PROGRAM: return passData.hullCode;
+			case GPT_DOMAIN_PROGRAM: return passData.domainCode;
+			case GPT_COMPUTE_PROGRAM: return passData.computeCode;
+			default: return passData.vertexCode;
+			}
+		};
+
+		// Find valid entry points and parameters
+		// Note: XShaderCompiler needs to do a full pass when doing reflection, and for each individual program
+		// type. If performance is ever important here it could be good to update XShaderCompiler so it can
+		// somehow save the AST and then re-use it for multiple actions.
+		// Note: Calls into XShaderCompiler are serialized (see sXscMutex), so only source hashing runs in parallel here.
+		TaskScheduler::instance().parallelFor("BSLReflect", 0, (UINT32)passCompileData.size(), 1, 
+			[&passCompileData](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+			{
+				PassCompileData& data = passCompileData[i];
+
+				data.sourceHash = md5(data.glsl->code);
+				reflectHLSL(data.glsl->code, data.reflection, data.types);
+			}
+		});
+
+		// Parameters must be applied in pass order, as later passes can override parameters of earlier ones. Also
+		// determine which programs need to be cross-compiled.
+		// Note: I'm just copying HLSL code as-is. This code will contain all entry points which could have an effect on 
+		// compile time. It would be ideal to remove dead code depending on program type. This would involve adding a HLSL
+		// code generator to XShaderCompiler.
+		struct ProgramCompileData
+		{
+			PassCompileData* pass;
+			GpuProgramType type; /**< Type of the program to compile, ignored for VKSL. */
+			bool vulkan;
+		};
+
+		Vector<ProgramCompileData> programCompileData;
+		for (auto& data : passCompileData)
+		{
+			parseParameters(data.reflection, shaderDesc);
+
+			for (auto& type : data.types)
+			{
+				getProgramCode(*data.hlsl, type) = data.hlsl->code;
+				programCompileData.push_back({ &data, type, false });
+			}
+
+			// VKSL bindings are assigned sequentially across all programs in a pass, so they must be compiled in order
+			if (!data.types.empty())
+				programCompileData.push_back({ &data, GPT_VERTEX_PROGRAM, true });
+		}
 
-			for(UINT32 j = 0; j < numPasses; j++)
+		TaskScheduler::instance().parallelFor("BSLCrossCompile", 0, (UINT32)programCompileData.size(), 1,
+			[&programCompileData, &getProgramCode](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
 			{
-				PassData& hlslPassData = hlslTechnique.passes[j];
-				PassData& glslPassData = glslTechnique.passes[j];
-				PassData& vkslPassData = vkslTechnique.passes[j];
-
-				// Clean non-standard HLSL 
-				static const std::regex regex("\\[\\s*layout\\s*\\(.*\\)\\s*\\]|\\[\\s*internal\\s*\\]|\\[\\s*color\\s*\\]");
-				hlslPassData.code = regex_replace(hlslPassData.code, regex, "");
-
-				// Find valid entry points and parameters
-				// Note: XShaderCompiler needs to do a full pass when doing reflection, and for each individual program
-				// type. If performance is ever important here it could be good to update XShaderCompiler so it can
-				// somehow save the AST and then re-use it for multiple actions.
-				Vector<GpuProgramType> types;
-				reflectHLSL(glslPassData.code, shaderDesc, types);
-
-				UINT32 glslBinding = 0;
-				UINT32 vkslBinding = 0;
-
-				// Cross-compile for all detected shader types
-				// Note: I'm just copying HLSL code as-is. This code will contain all entry points which could have
-				// an effect on compile time. It would be ideal to remove dead code depending on program type. This would
-				// involve adding a HLSL code generator to XShaderCompiler.
-				for(auto& type : types)
+				ProgramCompileData& data = programCompileData[i];
+				const String& source = data.pass->glsl->code;
+
+				if (!data.vulkan)
 				{
-					switch(type)
+					// GLSL doesn't use automatic binding, so there's no need to track binding slots
+					UINT32 bindingSlot = 0;
+					getProgramCode(*data.pass->glsl, data.type) = 
+						HLSLtoGLSL(source, data.pass->sourceHash, data.type, false, bindingSlot);
+				}
+				else
+				{
+					UINT32 bindingSlot = 0;
+					for (auto& type : data.pass->types)
 					{
-					case GPT_VERTEX_PROGRAM:
-						hlslPassData.vertexCode = hlslPassData.code;
-						glslPassData.vertexCode = HLSLtoGLSL(glslPassData.code, GPT_VERTEX_PROGRAM, false, glslBinding);
-						vkslPassData.vertexCode = HLSLtoGLSL(glslPassData.code, GPT_VERTEX_PROGRAM, true, vkslBinding);
-						break;
-					case GPT_FRAGMENT_PROGRAM:
-						hlslPassData.fragmentCode = hlslPassData.code;
-						glslPassData.fragmentCode = HLSLtoGLSL(glslPassData.code, GPT_FRAGMENT_PROGRAM, false, glslBinding);
-						vkslPassData.fragmentCode = HLSLtoGLSL(glslPassData.code, GPT_FRAGMENT_PROGRAM, true, vkslBinding);
-						break;
-					case GPT_GEOMETRY_PROGRAM:
-						hlslPassData.geometryCode = hlslPassData.code;
-						glslPassData.geometryCode = HLSLtoGLSL(glslPassData.code, GPT_GEOMETRY_PROGRAM, false, glslBinding);
-						vkslPassData.geometryCode = HLSLtoGLSL(glslPassData.code, GPT_GEOMETRY_PROGRAM, true, vkslBinding);
-						break;
-					case GPT_HULL_PROGRAM:
-						hlslPassData.hullCode = hlslPassData.code;
-						glslPassData.hullCode = HLSLtoGLSL(glslPassData.code, GPT_HULL_PROGRAM, false, glslBinding);
-						vkslPassData.hullCode = HLSLtoGLSL(glslPassData.code, GPT_HULL_PROGRAM, true, vkslBinding);
-						break;
-					case GPT_DOMAIN_PROGRAM:
-						hlslPassData.domainCode = hlslPassData.code;
-						glslPassData.domainCode = HLSLtoGLSL(glslPassData.code, GPT_DOMAIN_PROGRAM, false, glslBinding);
-						vkslPassData.domainCode = HLSLtoGLSL(glslPassData.code, GPT_DOMAIN_PROGRAM, true, vkslBinding);
-						break;
-					case GPT_COMPUTE_PROGRAM:
-						hlslPassData.computeCode = hlslPassData.code;
-						glslPassData.computeCode = HLSLtoGLSL(glslPassData.code, GPT_COMPUTE_PROGRAM, false, glslBinding);
-						vkslPassData.computeCode = HLSLtoGLSL(glslPassData.code, GPT_COMPUTE_PROGRAM, true, vkslBinding);
-						break;
+						getProgramCode(*data.pass->vksl, type) = 
+							HLSLtoGLSL(source, data.pass->sourceHash, type, true, bindingSlot);
 					}
 				}
 			}
+		});
 
-			techniqueData.push_back(std::make_pair(techniqueData[i].first, glslTechnique));
-			techniqueData.push_back(std::make_pair(techniqueData[i].first, vkslTechnique));
-		}
+		for (auto& entry : crossCompiledTechniques)
+			techniqueData.push_back(std::move(entry));
 
 		Vector<SPtr<Technique>> techniques;
 		for(auto& entry : techniqueData)
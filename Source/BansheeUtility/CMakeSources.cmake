@@ -105,6 +105,7 @@ set(BS_BANSHEEUTILITY_SRC_ALLOCATORS
 	"Source/BsGlobalFrameAlloc.cpp"
 	"Source/BsMemStack.cpp"
 	"Source/BsMemoryAllocator.cpp"
+	"Source/BsPooledAlloc.cpp"
 )
 
 set(BS_BANSHEEUTILITY_SRC_RTTI
@@ -132,6 +133,7 @@ set(BS_BANSHEEUTILITY_INC_ALLOCATORS
 	"Include/BsMemStack.h"
 	"Include/BsStaticAlloc.h"
 	"Include/BsGroupAlloc.h"
+	"Include/BsPooledAlloc.h"
 )
 
 set(BS_BANSHEEUTILITY_INC_THIRDPARTY
@@ -168,18 +170,33 @@ set(BS_BANSHEEUTILITY_SRC_MATH
 	"Source/BsLineSegment3.cpp"
 	"Source/BsCapsule.cpp"
 	"Source/BsLine2.cpp"
+	"Source/BsAABBTree.cpp"
 )
 
 set(BS_BANSHEEUTILITY_INC_TESTING
 	"Include/BsFileSystemTestSuite.h"
+	"Include/BsAABBTreeTestSuite.h"
+	"Include/BsSlotMapTestSuite.h"
+	"Include/BsCompressionTestSuite.h"
+	"Include/BsSerializationTestSuite.h"
+	"Include/BsTaskSchedulerTestSuite.h"
 	"Include/BsTestSuite.h"
+	"Include/BsBenchmarkSuite.h"
+	"Include/BsAllocatorBenchmarkSuite.h"
 	"Include/BsTestOutput.h"
 	"Include/BsConsoleTestOutput.h"
 )
 
 set(BS_BANSHEEUTILITY_SRC_TESTING
 	"Source/BsFileSystemTestSuite.cpp"
+	"Source/BsAABBTreeTestSuite.cpp"
+	"Source/BsSlotMapTestSuite.cpp"
+	"Source/BsCompressionTestSuite.cpp"
+	"Source/BsSerializationTestSuite.cpp"
+	"Source/BsTaskSchedulerTestSuite.cpp"
 	"Source/BsTestSuite.cpp"
+	"Source/BsBenchmarkSuite.cpp"
+	"Source/BsAllocatorBenchmarkSuite.cpp"
 	"Source/BsTestOutput.cpp"
 	"Source/BsConsoleTestOutput.cpp"
 )
@@ -219,6 +236,7 @@ set(BS_BANSHEEUTILITY_INC_MATH
 	"Include/BsMatrixNxM.h"
 	"Include/BsVectorNI.h"
 	"Include/BsLine2.h"
+	"Include/BsAABBTree.h"
 )
 
 set(BS_BANSHEEUTILITY_SRC_ERROR
@@ -233,6 +251,7 @@ set(BS_BANSHEEUTILITY_INC_SERIALIZATION
 	"Include/BsBinaryDiff.h"
 	"Include/BsSerializedObject.h"
 	"Include/BsBinaryCloner.h"
+	"Include/BsSlotMap.h"
 )
 
 set(BS_BANSHEEUTILITY_SRC_STRING
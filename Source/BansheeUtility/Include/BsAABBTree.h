@@ -0,0 +1,271 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+#include "BsAABox.h"
+#include "BsConvexVolume.h"
+#include "BsMath.h"
+
+namespace bs
+{
+	/** @addtogroup Math
+	 *  @{
+	 */
+
+	/**
+	 * Dynamic bounding volume hierarchy built out of axis aligned boxes. Each leaf of the tree represents a single object
+	 * and its bounds, enlarged by a small margin. Objects can be added, removed and moved incrementally, and the tree
+	 * can be queried for objects intersecting a volume without needing to test each object individually.
+	 */
+	class BS_UTILITY_EXPORT AABBTree
+	{
+	public:
+		/** Value used for identifiers of nodes that don't exist. */
+		static const UINT32 INVALID_ID = (UINT32)-1;
+
+		/**
+		 * Creates a new empty tree.
+		 *
+		 * @param[in]	margin	Distance by which to enlarge the bounds of every leaf. Leaves are only re-inserted when
+		 *						their bounds move outside of their enlarged bounds, so larger values make updates of moving
+		 *						objects cheaper, at the cost of less precise queries.
+		 */
+		AABBTree(float margin = 0.1f);
+
+		/**
+		 * Adds a new leaf to the tree.
+		 *
+		 * @param[in]	bounds		Bounds of the object represented by the leaf.
+		 * @param[in]	userData	Value that will be reported by queries for this leaf.
+		 * @return					Identifier of the leaf, to be used with update() and remove().
+		 */
+		UINT32 add(const AABox& bounds, UINT32 userData);
+
+		/**
+		 * Updates the bounds of an existing leaf. The leaf is only moved within the tree if the new bounds no longer fit
+		 * within the enlarged bounds of the leaf.
+		 *
+		 * @param[in]	leafId	Identifier of the leaf returned by add().
+		 * @param[in]	bounds	New bounds of the object represented by the leaf.
+		 * @return				True if the leaf was moved within the tree.
+		 */
+		bool update(UINT32 leafId, const AABox& bounds);
+
+		/** Removes a leaf from the tree. */
+		void remove(UINT32 leafId);
+
+		/** Removes all leaves from the tree. */
+		void clear();
+
+		/** Returns the value assigned to the leaf when it was added, or with the last call to setUserData(). */
+		UINT32 getUserData(UINT32 leafId) const { return mNodes[leafId].children[1]; }
+
+		/** Changes the value that will be reported by queries for the specified leaf. */
+		void setUserData(UINT32 leafId, UINT32 userData) { mNodes[leafId].children[1] = userData; }
+
+		/** Returns the enlarged bounds stored in the specified leaf. */
+		const AABox& getBounds(UINT32 leafId) const { return mNodes[leafId].bounds; }
+
+		/** Returns the number of leaves in the tree. */
+		UINT32 getNumLeaves() const { return mNumLeaves; }
+
+		/** Returns the height of the tree. Empty trees and trees with a single leaf have height zero. */
+		UINT32 getHeight() const { return mRoot != INVALID_ID ? (UINT32)mLinks[mRoot].height : 0; }
+
+		/**
+		 * Finds all leaves whose bounds intersect the provided volume.
+		 *
+		 * @param[in]	volume		Volume to test the leaves against.
+		 * @param[in]	callback	Callable with signature void(UINT32 userData, bool fullyInside), triggered for every
+		 *							intersecting leaf. @p fullyInside is true if the enlarged bounds of the leaf are
+		 *							fully contained in the volume, in which case any bounds contained in them don't need
+		 *							to be tested further.
+		 */
+		template<class T>
+		void query(const ConvexVolume& volume, T callback) const;
+
+		/**
+		 * Finds all leaves whose bounds intersect the provided box.
+		 *
+		 * @param[in]	box			Box to test the leaves against.
+		 * @param[in]	callback	Callable with signature void(UINT32 userData), triggered for every intersecting leaf.
+		 */
+		template<class T>
+		void query(const AABox& box, T callback) const;
+
+	private:
+		/** Part of a tree node accessed when querying the tree. */
+		struct Node
+		{
+			bool isLeaf() const { return children[0] == INVALID_ID; }
+
+			AABox bounds;
+
+			/** Indices of the child nodes. Leaves have no children and store their user data in the second entry. */
+			UINT32 children[2];
+		};
+
+		/** 
+		 * Part of a tree node only accessed when modifying the tree. Kept separate from Node so that queries touch as
+		 * little memory as possible.
+		 */
+		struct NodeLinks
+		{
+			UINT32 parent; /**< Parent of the node, or the next node in the free list for unused nodes. */
+			INT32 height; /**< Zero for leaves, -1 for unused nodes. */
+		};
+
+		/** Entry in the traversal stack used when querying the tree with a convex volume. */
+		struct VolumeQueryEntry
+		{
+			UINT32 node;
+			UINT32 planeMask;
+		};
+
+		/** Returns an index of an unused node, creating a new one if needed. */
+		UINT32 allocateNode();
+
+		/** Returns the node to the free list. */
+		void freeNode(UINT32 nodeIdx);
+
+		/** Inserts a leaf node into the tree, at the location that results in the smallest increase in bounds area. */
+		void insertLeaf(UINT32 leafIdx);
+
+		/** Detaches a leaf node from the tree, and removes its parent node. */
+		void removeLeaf(UINT32 leafIdx);
+
+		/**
+		 * Performs a rotation around the provided node if its children heights are not balanced. Returns the index of the
+		 * node now placed at the provided node's position in the hierarchy.
+		 */
+		UINT32 balance(UINT32 nodeIdx);
+
+		/** Recalculates bounds and heights of all nodes starting with the provided one and going up to the root. */
+		void refit(UINT32 nodeIdx);
+
+		/** Returns the provided bounds enlarged by the tree margin. */
+		AABox getEnlargedBounds(const AABox& bounds) const;
+
+		/** Returns a box encompassing both provided boxes. */
+		static AABox merge(const AABox& a, const AABox& b);
+
+		/** Returns the surface area of the box. Used as the cost metric when building the tree. */
+		static float getArea(const AABox& box);
+
+		Vector<Node> mNodes;
+		Vector<NodeLinks> mLinks;
+		UINT32 mRoot = INVALID_ID;
+		UINT32 mFreeList = INVALID_ID;
+		UINT32 mNumLeaves = 0;
+		float mMargin;
+	};
+
+	template<class T>
+	void AABBTree::query(const ConvexVolume& volume, T callback) const
+	{
+		if (mRoot == INVALID_ID)
+			return;
+
+		// Each node tracks which planes its children still need to be tested against. Planes that fully contain a node
+		// are removed from the mask, and once no planes remain the entire sub-tree is known to be within the volume.
+		// Planes that don't fit in the mask are always tested.
+		const Vector<Plane>& planes = volume.getPlanes();
+		UINT32 numPlanes = (UINT32)planes.size();
+		UINT32 numMaskedPlanes = std::min(numPlanes, 32U);
+		UINT32 planeMask = numMaskedPlanes < 32 ? ((1U << numMaskedPlanes) - 1) : 0xFFFFFFFF;
+
+		SmallVector<VolumeQueryEntry, 64> stack;
+		stack.push_back({ mRoot, planeMask });
+
+		while (!stack.empty())
+		{
+			VolumeQueryEntry entry = stack.back();
+			stack.pop_back();
+
+			const Node& node = mNodes[entry.node];
+			if (entry.planeMask != 0 || numPlanes > numMaskedPlanes)
+			{
+				const Vector3& nodeMin = node.bounds.getMin();
+				const Vector3& nodeMax = node.bounds.getMax();
+				Vector3 center = (nodeMin + nodeMax) * 0.5f;
+				Vector3 extents = (nodeMax - nodeMin) * 0.5f;
+
+				bool outside = false;
+				for (UINT32 i = 0; i < numPlanes; i++)
+				{
+					bool isMasked = i < numMaskedPlanes;
+					if (isMasked && (entry.planeMask & (1U << i)) == 0)
+						continue;
+
+					const Plane& plane = planes[i];
+					float dist = center.dot(plane.normal) - plane.d;
+
+					float effectiveRadius = extents.x * Math::abs(plane.normal.x);
+					effectiveRadius += extents.y * Math::abs(plane.normal.y);
+					effectiveRadius += extents.z * Math::abs(plane.normal.z);
+
+					if (dist < -effectiveRadius)
+					{
+						outside = true;
+						break;
+					}
+
+					if (isMasked && dist >= effectiveRadius)
+						entry.planeMask &= ~(1U << i);
+				}
+
+				if (outside)
+					continue;
+			}
+
+			if (node.isLeaf())
+			{
+				bool fullyInside = entry.planeMask == 0 && numPlanes == numMaskedPlanes;
+				callback(node.children[1], fullyInside);
+			}
+			else
+			{
+				stack.push_back({ node.children[0], entry.planeMask });
+				stack.push_back({ node.children[1], entry.planeMask });
+			}
+		}
+	}
+
+	template<class T>
+	void AABBTree::query(const AABox& box, T callback) const
+	{
+		if (mRoot == INVALID_ID)
+			return;
+
+		const Vector3& min = box.getMin();
+		const Vector3& max = box.getMax();
+
+		SmallVector<UINT32, 64> stack;
+		stack.push_back(mRoot);
+
+		while (!stack.empty())
+		{
+			UINT32 nodeIdx = stack.back();
+			stack.pop_back();
+
+			const Node& node = mNodes[nodeIdx];
+			const Vector3& nodeMin = node.bounds.getMin();
+			const Vector3& nodeMax = node.bounds.getMax();
+
+			if (nodeMax.x < min.x || nodeMax.y < min.y || nodeMax.z < min.z ||
+				nodeMin.x > max.x || nodeMin.y > max.y || nodeMin.z > max.z)
+				continue;
+
+			if (node.isLeaf())
+				callback(node.children[1]);
+			else
+			{
+				stack.push_back(node.children[0]);
+				stack.push_back(node.children[1]);
+			}
+		}
+	}
+
+	/** @} */
+}
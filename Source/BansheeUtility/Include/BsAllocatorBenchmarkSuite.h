@@ -0,0 +1,20 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsBenchmarkSuite.h"
+
+namespace bs
+{
+	class BS_UTILITY_EXPORT AllocatorBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		AllocatorBenchmarkSuite(const BenchmarkParams& params);
+
+	private:
+		void benchmarkSharedPtrCreation();
+		void benchmarkContainerGrowth();
+		void benchmarkCrossThreadFree();
+		void reportSizeClassStats();
+	};
+}
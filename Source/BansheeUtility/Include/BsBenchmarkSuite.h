@@ -0,0 +1,63 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+#include "BsTestSuite.h"
+
+namespace bs
+{
+	/** @addtogroup Testing
+	 *  @{
+	 */
+
+	/** Workload sizes used by benchmark suites, provided as "name=value" command line arguments. */
+	class BS_UTILITY_EXPORT BenchmarkParams
+	{
+	public:
+		BenchmarkParams() { }
+
+		/** Parses the parameters from command line arguments. Arguments not in the "name=value" format are ignored. */
+		BenchmarkParams(int argc, char* argv[]);
+
+		/** Returns the value of the parameter with the provided name, or @p defaultValue if it wasn't specified. */
+		UINT32 get(const String& name, UINT32 defaultValue) const;
+
+	private:
+		UnorderedMap<String, UINT32> mValues;
+	};
+
+	/**
+	 * Test suite whose tests measure performance of a system, usually by comparing it against an alternative way of
+	 * performing the same work. Benchmarks are not a part of the unit tests, and are instead ran from separate executables
+	 * that are only built when the BUILD_BENCHMARKS build option is enabled.
+	 */
+	class BS_UTILITY_EXPORT BenchmarkSuite : public TestSuite
+	{
+	public:
+		/**	Creates a new benchmark suite of a particular type. */
+		template <class T>
+		static SPtr<TestSuite> create(const BenchmarkParams& params)
+		{
+			static_assert((std::is_base_of<BenchmarkSuite, T>::value), "Invalid benchmark suite type. It needs to derive from bs::BenchmarkSuite.");
+
+			return std::static_pointer_cast<TestSuite>(bs_shared_ptr_new<T>(params));
+		}
+
+	protected:
+		BenchmarkSuite(const BenchmarkParams& params);
+
+		/**
+		 * Executes the provided function and logs the time it took, along with the number of allocations it made on the
+		 * calling thread.
+		 *
+		 * @param[in]	name	Name of the measured operation, used for identifying it in the log.
+		 * @param[in]	func	Function performing the operation.
+		 */
+		void measure(const String& name, const std::function<void()>& func);
+
+		BenchmarkParams mParams;
+	};
+
+	/** @} */
+}
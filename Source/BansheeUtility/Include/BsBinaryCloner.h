@@ -10,7 +10,12 @@ namespace bs
 	 *  @{
 	 */
 
-	/** Helper class that performs cloning of an object that implements RTTI. */
+	/**
+	 * Helper class that performs cloning of an object that implements RTTI. Field values are copied directly from the
+	 * original object into the clone through their RTTI fields, without serializing them into an intermediate buffer.
+	 * Serialization and deserialization callbacks are triggered in the same manner as if the object was serialized and
+	 * then deserialized.
+	 */
 	class BS_UTILITY_EXPORT BinaryCloner
 	{
 	public:
@@ -19,60 +24,51 @@ namespace bs
 		 * Returns a copy of the provided object with identical data.
 		 *
 		 * @param[in]	object		Object to clone.
-		 * @param[in]	shallow		If false then all referenced objects will be cloned as well, otherwise the references 
+		 * @param[in]	shallow		If false then all referenced objects will be cloned as well, otherwise the references
 		 *							to the original objects will be kept.
 		 */
 		static SPtr<IReflectable> clone(IReflectable* object, bool shallow = false);
 
 	private:
-		struct ObjectReferenceData;
-
-		/** Identifier representing a single field or an array entry in an object. */
-		struct FieldId
+		/** Information about an object referenced by the cloned hierarchy, and its clone. */
+		struct ClonedObject
 		{
-			RTTIField* field;
-			INT32 arrayIdx;
+			SPtr<IReflectable> original;
+			SPtr<IReflectable> clone;
+			bool isCopied;
+			bool copyInProgress;
 		};
 
-		/** A saved reference to an object with a field identifier that owns it. */
-		struct ObjectReference
-		{
-			FieldId fieldId;
-			SPtr<IReflectable> object;
-		};
+		BinaryCloner(bool shallow);
 
 		/**
-		 * Contains all object references in a portion of an object belonging to a specific class (base and derived 
-		 * classes count as separate sub-objects).
+		 * Copies the field values of the @p original object into the @p clone object, cloning any referenced objects
+		 * as needed. Both objects must be of the same type.
 		 */
-		struct SubObjectReferenceData
-		{
-			RTTITypeBase* rtti;
-			Vector<ObjectReference> references;
-			Vector<ObjectReferenceData> children;
-		};
+		void copyObject(IReflectable* original, IReflectable* clone);
 
-		/**
-		 * Contains all object references in an entire object, as well as the identifier of the field owning this object.
-		 */
-		struct ObjectReferenceData
-		{
-			FieldId fieldId;
-			Vector<SubObjectReferenceData> subObjectData;
-		};
+		/** Copies the field values belonging to a specific class in the object's inheritance hierarchy. */
+		void copyFields(IReflectable* original, IReflectable* clone, RTTITypeBase* rtti);
 
-		/**
-		 * Iterates over the provided object hierarchy and retrieves all object references which are returned in 
-		 * @p referenceData output parameter, also in a hierarchical format for easier parsing.
-		 */
-		static void gatherReferences(IReflectable* object, ObjectReferenceData& referenceData);
+		/** Copies the field values of an object referenced through a pointer, unless already copied. */
+		void copyObject(ClonedObject& entry);
 
 		/**
-		 * Restores a set of references retrieved by gatherReferences() and applies them toa specific object. Type of the 
-		 * object must be the same as the type that was used when calling gatherReferences().
+		 * Returns a clone of an object referenced through a pointer field. If the object was already cloned the existing
+		 * clone is returned. If @p weakRef is true the clone's fields might not be populated until the rest of the
+		 * hierarchy is cloned.
 		 */
-		static void restoreReferences(IReflectable* object, const ObjectReferenceData& referenceData);
+		SPtr<IReflectable> resolveObject(const SPtr<IReflectable>& original, bool weakRef);
+
+		/** Creates a copy of an object stored directly within a field of another object. */
+		SPtr<IReflectable> cloneEmbeddedObject(IReflectable& original);
+
+		UnorderedMap<IReflectable*, ClonedObject> mClonedObjects;
+		Vector<IReflectable*> mPendingObjects;
+		Vector<RTTITypeBase*> mCopiedTypes;
+		Vector<UINT8> mFieldBuffer;
+		bool mShallow;
 	};
 
 	/** @} */
-}
\ No newline at end of file
+}
@@ -67,7 +67,8 @@ namespace bs
 			bool shallow = false, const UnorderedMap<String, UINT64>& params = UnorderedMap<String, UINT64>());
 
 		/**
-		 * Decodes an object from binary data.
+		 * Decodes an object from binary data. Fields are read directly from the stream into the objects being decoded,
+		 * without building the intermediate representation.
 		 *
 		 * @param[in]	data  		Binary data to decode.
 		 * @param[in]	dataLength	Length of the data in bytes.
@@ -140,6 +141,23 @@ namespace bs
 			bool decodeInProgress; // Used for error reporting circular references
 		};
 
+		/** Top level object found in the data being decoded by decode(). */
+		struct DecodedObject
+		{
+			size_t offset = 0; // Offset of the object's meta-data in the source stream
+			RTTITypeBase* rtti = nullptr;
+			SPtr<IReflectable> object;
+			bool isDecoded = false;
+			bool decodeInProgress = false; // Used for error reporting circular references
+		};
+
+		/** Part of an object's data belonging to a single class in the object's class hierarchy. */
+		struct DecodedSection
+		{
+			RTTITypeBase* rtti;
+			size_t offset; // Offset of the section's first field in the source stream
+		};
+
 		/** Encodes a single IReflectable object. */
 		UINT8* encodeEntry(IReflectable* object, UINT32 objectId, UINT8* buffer, UINT32& bufferLength, UINT32* bytesWritten,
 			std::function<UINT8*(UINT8* buffer, UINT32 bytesWritten, UINT32& newBufferSize)> flushBufferCallback, bool shallow);
@@ -151,6 +169,49 @@ namespace bs
 		bool decodeEntry(const SPtr<DataStream>& data, UINT32 dataLength, UINT32& bytesRead, SPtr<SerializedObject>& output, 
 			bool copyData, bool streamDataBlock);
 
+		/**
+		 * Decodes all fields of an object directly from the stream. The stream must be positioned after the object's
+		 * meta-data, and is left positioned at the end of the object's data.
+		 */
+		void decodeObject(const SPtr<DataStream>& data, IReflectable* object, RTTITypeBase* rtti);
+
+		/** Decodes fields of a single class in an object's class hierarchy, until the end of its section is reached. */
+		void decodeFields(const SPtr<DataStream>& data, IReflectable* object, RTTITypeBase* rtti);
+
+		/** Decodes a top level object (and objects it references) from the stream, if not already decoded. */
+		void decodeObject(const SPtr<DataStream>& data, DecodedObject& entry);
+
+		/** Decodes an object embedded in the stream as a field value. Returns null if the object's type is unknown. */
+		SPtr<IReflectable> decodeEmbeddedObject(const SPtr<DataStream>& data);
+
+		/**
+		 * Returns a top level object with the specified ID, creating it if needed. Unless @p weakRef is true the object is
+		 * also decoded before being returned.
+		 */
+		SPtr<IReflectable> resolveObject(const SPtr<DataStream>& data, UINT32 objectId, bool weakRef);
+
+		/**
+		 * Skips over the remaining fields of an object. If @p rtti is provided, sections belonging to base classes of
+		 * @p rtti are recorded in mDecodedSections.
+		 *
+		 * @return	True if the object was followed by another top level object.
+		 */
+		bool skipObject(const SPtr<DataStream>& data, RTTITypeBase* rtti = nullptr);
+
+		/** Skips over data of a single field, positioned right after the field's meta-data. */
+		void skipField(const SPtr<DataStream>& data, SerializableFieldType type, bool isArray, UINT32 fieldSize, 
+			bool hasDynamicSize);
+
+		/** 
+		 * Returns a pointer to @p size bytes of field data at the current position in the stream, and advances the 
+		 * stream. The pointer is valid until the next call.
+		 */
+		UINT8* readFieldData(const SPtr<DataStream>& data, UINT32 size);
+
+		/** Throws an exception if the type of the field stored in the data doesn't match the type of the RTTI field. */
+		static void checkFieldType(RTTIField* field, UINT8 fieldSize, bool isArray, SerializableFieldType fieldType,
+			bool hasDynamicSize);
+
 		/**	Helper method for encoding a complex object and copying its data to a buffer. */
 		UINT8* complexTypeToBuffer(IReflectable* object, UINT8* buffer, UINT32& bufferLength, UINT32* bytesWritten,
 			std::function<UINT8*(UINT8* buffer, UINT32 bytesWritten, UINT32& newBufferSize)> flushBufferCallback, bool shallow);
@@ -201,6 +262,13 @@ namespace bs
 		UnorderedMap<SPtr<SerializedObject>, ObjectToDecode> mObjectMap;
 		UnorderedMap<UINT32, SPtr<SerializedObject>> mInterimObjectMap;
 
+		UnorderedMap<UINT32, DecodedObject> mDecodedObjects;
+		Vector<UINT32> mPendingObjects;
+		Vector<DecodedSection> mDecodedSections;
+		Vector<UINT8> mFieldBuffer;
+		MemoryDataStream* mDecodeMemStream;
+		size_t mDecodeEnd;
+
 		UnorderedMap<String, UINT64> mParams;
 
 		static const int META_SIZE = 4; // Meta field size
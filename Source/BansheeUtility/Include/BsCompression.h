@@ -19,6 +19,102 @@ namespace bs
 
 		/** Decompresses the data from the provided data stream and outputs the new stream with decompressed data. */
 		static SPtr<MemoryDataStream> decompress(SPtr<DataStream>& input);
+
+		/**
+		 * Compresses the data from the provided data stream using the chunked format. Data is split into chunks that are
+		 * compressed independently (in parallel, if the task scheduler is running), and the output starts with an index of
+		 * all the chunks. This allows the data to be decompressed in parallel, streamed chunk by chunk, or partially read
+		 * using CompressedChunkReader.
+		 *
+		 * @param[in]	input		Stream to compress, from its current position to its end. File streams are read a
+		 *							number of chunks at a time, rather than all at once.
+		 * @param[in]	chunkSize	Size of a single chunk of uncompressed data, in bytes. Smaller chunks allow for more
+		 *							parallelism and finer grained random access, at the cost of compression ratio.
+		 * @return					Stream containing the compressed data, or null if the input or the compressed
+		 *							output is 4 GB or larger.
+		 */
+		static SPtr<MemoryDataStream> compressChunked(const SPtr<DataStream>& input, 
+			UINT32 chunkSize = DEFAULT_CHUNK_SIZE);
+
+		/**
+		 * Decompresses data compressed with compressChunked() and outputs the new stream with decompressed data. Chunks
+		 * are decompressed in parallel if the task scheduler is running. Returns null if the data is corrupt.
+		 */
+		static SPtr<MemoryDataStream> decompressChunked(const SPtr<DataStream>& input);
+
+		/** Default size of uncompressed data in a single chunk used by compressChunked(), in bytes. */
+		static const UINT32 DEFAULT_CHUNK_SIZE = 256 * 1024;
+	};
+
+	/**
+	 * Provides access to data compressed with Compression::compressChunked(), without needing to decompress all of it.
+	 * Only the header and the chunk index are read on construction, after which individual chunks or byte ranges can be
+	 * decompressed on demand.
+	 *
+	 * @note	
+	 * Thread safe. Chunks can be read from multiple threads at once. If the source is a file stream, reading of the 
+	 * compressed data is serialized but decompression is not.
+	 */
+	class BS_UTILITY_EXPORT CompressedChunkReader
+	{
+		/** Location of a single chunk in the source stream. */
+		struct Chunk
+		{
+			size_t offset;
+			UINT32 compressedSize;
+		};
+
+	public:
+		/** 
+		 * Reads the header and chunk index, starting at the current position of the provided stream. Check isValid() to
+		 * see if the stream contains valid chunked data. Data whose uncompressed size is 4 GB or larger is reported as
+		 * invalid.
+		 */
+		CompressedChunkReader(const SPtr<DataStream>& input);
+
+		/** Checks does the source stream contain a valid header and chunk index. */
+		bool isValid() const { return mIsValid; }
+
+		/** Returns the total size of the uncompressed data, in bytes. */
+		UINT64 getSize() const { return mSize; }
+
+		/** Returns the number of chunks the data is split into. */
+		UINT32 getNumChunks() const { return (UINT32)mChunks.size(); }
+
+		/** Returns the size of uncompressed data in all chunks except possibly the last one, in bytes. */
+		UINT32 getChunkSize() const { return mChunkSize; }
+
+		/** Returns the size of uncompressed data in the specified chunk, in bytes. */
+		UINT32 getChunkSize(UINT32 idx) const;
+
+		/** Returns the offset in the source stream at which the compressed data ends. */
+		size_t getEndOffset() const { return mEndOffset; }
+
+		/** 
+		 * Decompresses a single chunk. @p output must be large enough to hold getChunkSize(idx) bytes. Returns false if
+		 * the chunk data is corrupt.
+		 */
+		bool readChunk(UINT32 idx, UINT8* output) const;
+
+		/**
+		 * Decompresses a range of the uncompressed data, decompressing only the chunks overlapping the range. Returns 
+		 * false if the range is out of bounds, or if the chunk data is corrupt.
+		 *
+		 * @param[in]	offset	Offset into the uncompressed data, in bytes.
+		 * @param[in]	size	Number of bytes to read.
+		 * @param[out]	output	Buffer large enough to hold @p size bytes.
+		 */
+		bool read(UINT64 offset, UINT64 size, UINT8* output) const;
+
+	private:
+		SPtr<DataStream> mInput;
+		Vector<Chunk> mChunks;
+		UINT64 mSize = 0;
+		UINT32 mChunkSize = 0;
+		size_t mEndOffset = 0;
+		bool mIsValid = false;
+
+		mutable Mutex mReadMutex;
 	};
 
 	/** @} */
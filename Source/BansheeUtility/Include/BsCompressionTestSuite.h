@@ -0,0 +1,20 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsTestSuite.h"
+
+namespace bs
+{
+	class BS_UTILITY_EXPORT CompressionTestSuite : public TestSuite
+	{
+	public:
+		CompressionTestSuite();
+
+	private:
+		void testChunkedRoundTrip();
+		void testChunkedRandomAccess();
+		void testChunkedCorruptData();
+		void testChunkedOversizedHeader();
+	};
+}
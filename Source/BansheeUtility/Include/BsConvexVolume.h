@@ -54,7 +54,7 @@ namespace bs
 		bool contains(const Vector3& p, float expand = 0.0f) const;
 
 		/** Returns the internal set of planes that represent the volume. */
-		Vector<Plane> getPlanes() const { return mPlanes; }
+		const Vector<Plane>& getPlanes() const { return mPlanes; }
 
 	private:
 		Vector<Plane> mPlanes;
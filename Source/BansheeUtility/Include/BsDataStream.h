@@ -50,6 +50,12 @@ namespace bs
 		virtual bool isWriteable() const { return (mAccess & WRITE) != 0; }
 		virtual bool isFile() const = 0;
 
+		/**
+		 * Checks is the stream data a file mapped into memory. Memory of such streams remains valid for as long as the
+		 * stream is alive, and can be referenced directly instead of being copied.
+		 */
+		virtual bool isMapped() const { return false; }
+
         /** Reads data from the buffer and copies it to the specified value. */
         template<typename T> DataStream& operator>>(T& val);
 
@@ -281,6 +287,40 @@ namespace bs
 		bool mFreeOnClose;	
 	};
 
+#if BS_PLATFORM != BS_PLATFORM_WIN32
+	/**
+	 * Data stream for reading a file mapped into memory. File contents are paged in by the OS as they are accessed,
+	 * rather than being read into a separate buffer. The mapping is private, so any writes to the mapped memory are never
+	 * written back to the file.
+	 *
+	 * @note	
+	 * Not available on Windows, since mapped files cannot be deleted there while in use. See FileSystem::openFileMapped().
+	 */
+	class BS_UTILITY_EXPORT MappedFileDataStream : public MemoryDataStream
+	{
+	public:
+		/**
+		 * Maps the file at the provided path into memory. If the mapping fails the stream will be empty.
+		 *
+		 * @param[in]	filePath	Path of the file to map.
+		 */
+		MappedFileDataStream(const Path& filePath);
+		~MappedFileDataStream();
+
+		/** @copydoc DataStream::isMapped */
+		bool isMapped() const override { return mData != nullptr; }
+
+		/** @copydoc DataStream::close */
+		void close() override;
+
+		/** Returns the path of the mapped file. */
+		const Path& getPath() const { return mPath; }
+
+	protected:
+		Path mPath;
+	};
+#endif
+
 	/** @} */
 }
 
@@ -22,6 +22,15 @@ namespace bs
 		 */
 		static SPtr<DataStream> openFile(const Path& fullPath, bool readOnly = true);
 
+		/**
+		 * Opens a file for reading by mapping it into memory. Data blocks read from the returned stream can reference the
+		 * mapped memory directly instead of copying it. If the file cannot be mapped, or on platforms where mapped
+		 * files cannot be deleted while in use (Windows), this falls back to openFile().
+		 *
+		 * @param[in]	fullPath	Full path to a file.
+		 */
+		static SPtr<DataStream> openFileMapped(const Path& fullPath);
+
 		/**
 		 * Opens a file and returns a data stream capable of reading and writing to that file. If file doesn't exist new
 		 * one will be created.
@@ -119,6 +119,9 @@ namespace bs
 		TID_UnorderedSet = 66,
 		TID_SerializedDataBlock = 67,
 		TID_Flags = 68,
-		TID_IReflectable = 69
+		TID_IReflectable = 69,
+		TID_SerializationTestPlainArray = 70,
+		TID_SerializationTestBulkArray = 71,
+		TID_SerializationTestClonerObject = 72
 	};
 }
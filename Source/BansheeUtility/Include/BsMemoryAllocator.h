@@ -5,6 +5,7 @@
 #undef max
 
 #include "BsTypes.h"	        // for UINT64
+#include "BsPooledAlloc.h"
 
 #include <atomic>
 #include <limits>
@@ -137,7 +138,8 @@ namespace bs
 	 * Memory allocator providing a generic implementation. Specialize for specific categories as needed.
 	 * 			
 	 * @note	For example you might implement a pool allocator for specific types in order
-	 * 			to reduce allocation overhead. By default standard malloc/free are used.
+	 * 			to reduce allocation overhead. By default standard malloc/free are used, unless the engine is built
+	 *			with BS_POOLED_ALLOCATOR, in which case allocate() and free() use PooledAlloc.
 	 */
 	template<class T>
 	class MemoryAllocator : public MemoryAllocatorBase
@@ -150,7 +152,11 @@ namespace bs
 			incAllocCount();
 #endif
 
+#if BS_POOLED_ALLOCATOR
+			return PooledAlloc::allocate(bytes);
+#else
 			return malloc(bytes);
+#endif
 		}
 
 		/** 
@@ -183,7 +189,11 @@ namespace bs
 			incFreeCount();
 #endif
 
+#if BS_POOLED_ALLOCATOR
+			PooledAlloc::free(ptr);
+#else
 			::free(ptr);
+#endif
 		}
 
 		/** Frees memory allocated with allocateAligned() */
@@ -0,0 +1,69 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsTypes.h"
+#include <cstddef>
+
+namespace bs
+{
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Memory-Internal
+	 *  @{
+	 */
+
+	/** Allocation statistics for a single size class of the pooled allocator. */
+	struct PooledAllocStats
+	{
+		/** Size of blocks allocated by the size class, in bytes. Zero for huge allocations. */
+		UINT32 blockSize = 0;
+
+		/** Total number of allocations made from the size class. */
+		UINT64 numAllocs = 0;
+
+		/** Total number of allocations returned to the size class. */
+		UINT64 numFrees = 0;
+
+		/** Number of memory regions currently allocated from the OS by the size class. */
+		UINT64 numSpans = 0;
+	};
+
+	/**
+	 * General purpose allocator that groups allocations into size classes, each served from larger regions of memory
+	 * allocated from the OS. Every thread allocates from its own set of regions, avoiding any synchronization when the
+	 * memory is allocated and freed on the same thread. Memory freed on a different thread is placed on a lock-free list
+	 * and reclaimed by the owning thread once it needs more memory. Allocations too large for any size class are
+	 * allocated directly from the OS.
+	 *
+	 * Used as the backend for GenAlloc when the engine is built with BS_POOLED_ALLOCATOR enabled.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_UTILITY_EXPORT PooledAlloc
+	{
+	public:
+		/** Allocates @p bytes bytes. Returned memory is aligned to 16 bytes. */
+		static void* allocate(size_t bytes);
+
+		/** Frees memory previously allocated with allocate(). */
+		static void free(void* ptr);
+
+		/** Returns the number of size classes used by the allocator, not including huge allocations. */
+		static UINT32 getNumSizeClasses();
+
+		/**
+		 * Returns allocation statistics for the specified size class, accumulated across all threads. Statistics are only
+		 * gathered when BS_PROFILING_ENABLED is on.
+		 */
+		static PooledAllocStats getSizeClassStats(UINT32 sizeClass);
+
+		/** Returns statistics for allocations too large for any size class, which are allocated directly from the OS. */
+		static PooledAllocStats getHugeAllocStats();
+	};
+
+	/** @} */
+	/** @} */
+}
@@ -95,6 +95,8 @@ namespace bs
 		SerializableFieldType mType;
 		UINT64 mFlags;
 
+		virtual ~RTTIField() { }
+
 		/** Checks is the field plain type and castable to RTTIPlainFieldBase. */
 		bool isPlainType() const { return mType == SerializableFT_Plain; }
 
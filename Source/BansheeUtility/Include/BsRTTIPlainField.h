@@ -94,6 +94,28 @@ namespace bs
 		 * location and contains the proper type.
 		 */
 		virtual void arrayElemFromBuffer(void* object, int index, void* buffer) = 0;
+
+		/** 
+		 * Checks if all elements of the array field can be copied at once, using arrayToBuffer() and arrayFromBuffer(). 
+		 * This is the case for arrays whose elements are stored contiguously and are serialized using just a memcpy.
+		 */
+		virtual bool hasBulkAccess()
+		{
+			return false;
+		}
+
+		/**
+		 * Copies all elements of the array field of the provided object into the buffer. Buffer must be at least 
+		 * getArraySize() * getTypeSize() bytes large. Only valid if hasBulkAccess() returns true.
+		 */
+		virtual void arrayToBuffer(void* object, void* buffer) { }
+
+		/**
+		 * Copies @p numElements elements from the buffer into the array field of the provided object. The array must
+		 * have been resized to (at least) @p numElements elements by calling setArraySize(). Only valid if 
+		 * hasBulkAccess() returns true.
+		 */
+		virtual void arrayFromBuffer(void* object, UINT32 numElements, void* buffer) { }
 	};
 
 	/** Represents a plain class field containing a specific type. */
@@ -289,6 +311,84 @@ namespace bs
 		}
 	};
 
+	/**
+	 * Represents a plain class field containing an array of elements which are stored contiguously in memory and serialized
+	 * using just a memcpy (see RTTIPlainTypeIsMemcpy). Such arrays can be serialized in bulk using a single memcpy, 
+	 * instead of going through the per-element accessors. The serialized format is identical to a normal plain array 
+	 * field, meaning a field can be switched between the two without breaking previously serialized data.
+	 */
+	template <class DataType, class ObjectType>
+	struct RTTIPlainBulkArrayField : public RTTIPlainField<DataType, ObjectType>
+	{
+		/**
+		 * Initializes a plain field containing multiple values in a contiguous array. 
+		 *
+		 * @param[in]	name		Name of the field.
+		 * @param[in]	uniqueId	Unique identifier for this field. Although name is also a unique identifier we want a 
+		 *							small data type that can be used for efficiently serializing data to disk and similar. 
+		 *							It is primarily used for compatibility between different versions of serialized data.
+		 * @param[in]	getter  	The getter method for the field. Must be a specific signature: DataType(ObjectType*, UINT32)
+		 * @param[in]	getSize 	Getter method that returns the size of an array. Must be a specific signature: UINT32(ObjectType*)
+		 * @param[in]	setter  	The setter method for the field. Must be a specific signature: void(ObjectType*, UINT32, DataType)
+		 * @param[in]	setSize 	Setter method that allows you to resize an array. Can be null. Must be a specific signature: void(ObjectType*, UINT32)
+		 * @param[in]	getData		Getter method that returns a pointer to the first element of the array. All other 
+		 *							elements must directly follow it in memory. Must be a specific signature: 
+		 *							DataType*(ObjectType*)
+		 * @param[in]	flags		Various flags you can use to specialize how outside systems handle this field. See "RTTIFieldFlag".
+		 */
+		void initBulkArray(const String& name, UINT16 uniqueId, Any getter, Any getSize, Any setter, Any setSize, 
+			Any getData, UINT64 flags)
+		{
+			static_assert(RTTIPlainTypeIsMemcpy<DataType>::value != 0, 
+				"Bulk plain array fields require a type that is serialized using just a memcpy. Use a normal plain array "\
+				"field, or call BS_ALLOW_MEMCPY_SERIALIZATION(type) macro if you are sure the type can be properly "\
+				"serialized using just memcpy.");
+
+			static_assert(RTTIPlainType<DataType>::hasDynamicSize == 0, 
+				"Bulk plain array fields require a type with static size.");
+
+			this->initArray(name, uniqueId, getter, getSize, setter, setSize, flags);
+			arrayDataGetter = getData;
+		}
+
+		/** @copydoc RTTIPlainFieldBase::hasBulkAccess */
+		bool hasBulkAccess() override
+		{
+			return true;
+		}
+
+		/** @copydoc RTTIPlainFieldBase::arrayToBuffer */
+		void arrayToBuffer(void* object, void* buffer) override
+		{
+			this->checkIsArray(true);
+
+			ObjectType* castObject = static_cast<ObjectType*>(object);
+
+			UINT32 numElements = this->getArraySize(object);
+			if(numElements == 0)
+				return;
+
+			std::function<DataType*(ObjectType*)> f = any_cast<std::function<DataType*(ObjectType*)>>(arrayDataGetter);
+			memcpy(buffer, f(castObject), numElements * sizeof(DataType));
+		}
+
+		/** @copydoc RTTIPlainFieldBase::arrayFromBuffer */
+		void arrayFromBuffer(void* object, UINT32 numElements, void* buffer) override
+		{
+			this->checkIsArray(true);
+
+			ObjectType* castObject = static_cast<ObjectType*>(object);
+
+			if(numElements == 0)
+				return;
+
+			std::function<DataType*(ObjectType*)> f = any_cast<std::function<DataType*(ObjectType*)>>(arrayDataGetter);
+			memcpy(f(castObject), buffer, numElements * sizeof(DataType));
+		}
+
+		Any arrayDataGetter;
+	};
+
 	/** @} */
 	/** @} */
 }
\ No newline at end of file
@@ -46,6 +46,7 @@ namespace bs
 
 		enum { id = 0 /**< Unique id for the serializable type. */ };
 		enum { hasDynamicSize = 0 /**< 0 (Object has static size less than 255 bytes, for example int) or 1 (Dynamic size with no size restriction, for example string) */ };
+		enum { isMemcpy = 1 /**< 1 if toMemory() and fromMemory() perform a plain memcpy of the object, 0 (or not defined) otherwise. */ };
 
 		/** Serializes the provided object into the provided pre-allocated memory buffer. */
 		static void toMemory(const T& data, char* memory)
@@ -155,6 +156,25 @@ namespace bs
 		return memory + elemSize;
 	}
 
+	/**
+	 * Checks if the RTTIPlainType specialization of the provided type serializes it using just a memcpy. Arrays of such
+	 * types can be serialized in bulk, using a single memcpy for the entire array. Specializations signal this by
+	 * defining the isMemcpy enum as 1.
+	 */
+	template<class T, class Enable = void>
+	struct RTTIPlainTypeIsMemcpy
+	{
+		enum { value = 0 };
+	};
+
+	/** @cond SPECIALIZATIONS */
+	template<class T>
+	struct RTTIPlainTypeIsMemcpy<T, typename std::enable_if<RTTIPlainType<T>::isMemcpy != 0>::type>
+	{
+		enum { value = 1 };
+	};
+	/** @endcond */
+
 	/**
 	 * Notify the RTTI system that the specified type may be serialized just by using a memcpy.
 	 *
@@ -164,7 +184,7 @@ namespace bs
 	 */
 #define BS_ALLOW_MEMCPY_SERIALIZATION(type)					\
 	template<> struct RTTIPlainType<type>					\
-	{	enum { id=0 }; enum { hasDynamicSize = 0 };			\
+	{	enum { id=0 }; enum { hasDynamicSize = 0 }; enum { isMemcpy = 1 };	\
 	static void toMemory(const type& data, char* memory)	\
 	{ memcpy(memory, &data, sizeof(type)); }				\
 	static UINT32 fromMemory(type& data, char* memory)		\
@@ -196,14 +216,7 @@ namespace bs
 			memory += sizeof(UINT32);
 			size += sizeof(UINT32);
 
-			for(auto iter = data.begin(); iter != data.end(); ++iter)
-			{
-				UINT32 elementSize = rttiGetElemSize(*iter);
-				RTTIPlainType<T>::toMemory(*iter, memory);
-
-				memory += elementSize;
-				size += elementSize;
-			}
+			size += elementsToMemory(data, memory, IsBulk());
 
 			memcpy(memoryStart, &size, sizeof(UINT32));
 		}
@@ -219,14 +232,7 @@ namespace bs
 			memcpy(&numElements, memory, sizeof(UINT32)); 
 			memory += sizeof(UINT32);
 
-			for(UINT32 i = 0; i < numElements; i++)
-			{
-				T element;
-				UINT32 elementSize = RTTIPlainType<T>::fromMemory(element, memory);
-				data.push_back(element);
-
-				memory += elementSize;
-			}
+			elementsFromMemory(data, numElements, memory, IsBulk());
 
 			return size;
 		}
@@ -235,14 +241,84 @@ namespace bs
 		static UINT32 getDynamicSize(const std::vector<T, StdAlloc<T>>& data)	
 		{ 
 			UINT64 dataSize = sizeof(UINT32) * 2;
-
-			for (auto iter = data.begin(); iter != data.end(); ++iter)
-				dataSize += rttiGetElemSize(*iter);
+			dataSize += getElementsSize(data, IsBulk());
 
 			assert(dataSize <= std::numeric_limits<UINT32>::max());
 
 			return (UINT32)dataSize;
 		}	
+
+	private:
+		/** 
+		 * True if elements are stored in the same format as they are laid out in memory, in which case the entire array
+		 * can be copied at once. (std::vector<bool> is excluded as it doesn't store its elements contiguously.)
+		 */
+		typedef std::integral_constant<bool, RTTIPlainTypeIsMemcpy<T>::value != 0 && !std::is_same<T, bool>::value> IsBulk;
+
+		/** Writes all elements of the vector into memory using a single memcpy. Returns the number of bytes written. */
+		static UINT32 elementsToMemory(const std::vector<T, StdAlloc<T>>& data, char* memory, std::true_type)
+		{
+			UINT32 size = (UINT32)(data.size() * sizeof(T));
+			if(size > 0)
+				memcpy(memory, data.data(), size);
+
+			return size;
+		}
+
+		/** Writes all elements of the vector into memory one by one. Returns the number of bytes written. */
+		static UINT32 elementsToMemory(const std::vector<T, StdAlloc<T>>& data, char* memory, std::false_type)
+		{
+			UINT32 size = 0;
+			for(auto iter = data.begin(); iter != data.end(); ++iter)
+			{
+				UINT32 elementSize = rttiGetElemSize(*iter);
+				RTTIPlainType<T>::toMemory(*iter, memory);
+
+				memory += elementSize;
+				size += elementSize;
+			}
+
+			return size;
+		}
+
+		/** Appends elements read from memory to the vector, using a single memcpy. */
+		static void elementsFromMemory(std::vector<T, StdAlloc<T>>& data, UINT32 numElements, char* memory, std::true_type)
+		{
+			size_t offset = data.size();
+			data.resize(offset + numElements);
+
+			if(numElements > 0)
+				memcpy(&data[offset], memory, numElements * sizeof(T));
+		}
+
+		/** Appends elements read from memory to the vector, one by one. */
+		static void elementsFromMemory(std::vector<T, StdAlloc<T>>& data, UINT32 numElements, char* memory, std::false_type)
+		{
+			for(UINT32 i = 0; i < numElements; i++)
+			{
+				T element;
+				UINT32 elementSize = RTTIPlainType<T>::fromMemory(element, memory);
+				data.push_back(element);
+
+				memory += elementSize;
+			}
+		}
+
+		/** Returns the number of bytes required for storing all elements of the vector. */
+		static UINT64 getElementsSize(const std::vector<T, StdAlloc<T>>& data, std::true_type)
+		{
+			return data.size() * sizeof(T);
+		}
+
+		/** Returns the number of bytes required for storing all elements of the vector. */
+		static UINT64 getElementsSize(const std::vector<T, StdAlloc<T>>& data, std::false_type)
+		{
+			UINT64 size = 0;
+			for (auto iter = data.begin(); iter != data.end(); ++iter)
+				size += rttiGetElemSize(*iter);
+
+			return size;
+		}
 	}; 
 
 	/**
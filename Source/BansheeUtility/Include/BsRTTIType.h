@@ -107,6 +107,51 @@ namespace bs
 																								\
 	typedef META_NextEntry_##name
 
+/**
+ * Same as BS_RTTI_MEMBER_PLAIN_ARRAY, but the array is serialized in bulk, using a single memcpy for all of its elements.
+ * The member must be an array storing its elements contiguously (e.g. Vector), and the element type must be serialized
+ * using just a memcpy (see BS_ALLOW_MEMCPY_SERIALIZATION). Serialized data is compatible with BS_RTTI_MEMBER_PLAIN_ARRAY.
+ */
+#define BS_RTTI_MEMBER_PLAIN_ARRAY_BULK(name, id)												\
+	META_Entry_##name;																			\
+																								\
+	std::common_type<decltype(OwnerType::name)>::type::value_type& get##name(OwnerType* obj, UINT32 idx) { return obj->name[idx]; }					\
+	void set##name(OwnerType* obj, UINT32 idx, std::common_type<decltype(OwnerType::name)>::type::value_type& val) { obj->name[idx] = val; }		\
+	UINT32 getSize##name(OwnerType* obj) { return (UINT32)obj->name.size(); }																		\
+	void setSize##name(OwnerType* obj, UINT32 val) { obj->name.resize(val); }																		\
+	std::common_type<decltype(OwnerType::name)>::type::value_type* getData##name(OwnerType* obj) { return obj->name.data(); }						\
+																								\
+	struct META_NextEntry_##name{};																\
+	void META_InitPrevEntry(META_NextEntry_##name typeId)										\
+	{																							\
+		addPlainBulkArrayField(#name, id, &MyType::get##name, &MyType::getSize##name, &MyType::set##name, &MyType::setSize##name, &MyType::getData##name);	\
+		META_InitPrevEntry(META_Entry_##name());												\
+	}																							\
+																								\
+	typedef META_NextEntry_##name
+
+ /** 
+  * Same as BS_RTTI_MEMBER_PLAIN_ARRAY_BULK, but allows you to specify separate names for the field name and the member 
+  * variable.
+  */
+#define BS_RTTI_MEMBER_PLAIN_ARRAY_BULK_NAMED(name, field, id)									\
+	META_Entry_##name;																			\
+																								\
+	std::common_type<decltype(OwnerType::field)>::type::value_type& get##name(OwnerType* obj, UINT32 idx) { return obj->field[idx]; }					\
+	void set##name(OwnerType* obj, UINT32 idx, std::common_type<decltype(OwnerType::field)>::type::value_type& val) { obj->field[idx] = val; }		\
+	UINT32 getSize##name(OwnerType* obj) { return (UINT32)obj->field.size(); }																		\
+	void setSize##name(OwnerType* obj, UINT32 val) { obj->field.resize(val); }																		\
+	std::common_type<decltype(OwnerType::field)>::type::value_type* getData##name(OwnerType* obj) { return obj->field.data(); }						\
+																								\
+	struct META_NextEntry_##name{};																\
+	void META_InitPrevEntry(META_NextEntry_##name typeId)										\
+	{																							\
+		addPlainBulkArrayField(#name, id, &MyType::get##name, &MyType::getSize##name, &MyType::set##name, &MyType::setSize##name, &MyType::getData##name);	\
+		META_InitPrevEntry(META_Entry_##name());												\
+	}																							\
+																								\
+	typedef META_NextEntry_##name
+
 /**
  * Registers a new member field in the RTTI type. The field references the @p name member in the owner class. 
  * The type of the member must be a valid reflectable (non-pointer) type. Each field must specify a unique ID for @p id.
@@ -1078,6 +1123,47 @@ namespace bs
 				std::function<void(ObjectType*, UINT32)>(std::bind(setSize, static_cast<InterfaceType*>(this), _1, _2)), flags);
 		}	
 
+		/**
+		 * Registers a new field containing an array of plain values that are stored contiguously in memory and serialized
+		 * using just a memcpy. Unlike addPlainArrayField(), the entire array is serialized using a single memcpy. 
+		 * Serialized data is compatible with fields registered through addPlainArrayField().
+		 *
+		 * @param[in]	name		Name of the field.
+		 * @param[in]	uniqueId	Unique identifier for this field. Although name is also a unique identifier we want a 
+		 *							small data type that can be used for efficiently serializing data to disk and similar. 
+		 *							It is primarily used for compatibility between different versions of serialized data.
+		 * @param[in]	getter  	Method used for retrieving a single element of the array.
+		 * @param[in]	getSize 	Getter method that returns the size of the array.
+		 * @param[in]	setter  	Method used for setting the a single element of the field.
+		 * @param[in]	setSize 	Setter method that allows you to resize the array. 
+		 * @param[in]	getData		Method returning a pointer to the first element of the array, followed by all other
+		 *							elements.
+		 * @param[in]	flags		Various flags you can use to specialize how systems handle this field. See RTTIFieldFlag.
+		 */
+		template<class InterfaceType, class ObjectType, class DataType>
+		void addPlainBulkArrayField(const String& name, UINT32 uniqueId, 
+			DataType& (InterfaceType::*getter)(ObjectType*, UINT32), 
+			UINT32 (InterfaceType::*getSize)(ObjectType*), 
+			void (InterfaceType::*setter)(ObjectType*, UINT32, DataType&), 
+			void(InterfaceType::*setSize)(ObjectType*, UINT32), 
+			DataType* (InterfaceType::*getData)(ObjectType*), UINT64 flags = 0)
+		{
+			using namespace std::placeholders;
+
+			static_assert((std::is_base_of<bs::RTTIType<Type, BaseType, MyRTTIType>, InterfaceType>::value), 
+				"Class with the get/set methods must derive from bs::RTTIType.");
+
+			static_assert(!(std::is_base_of<bs::IReflectable, DataType>::value), 
+				"Data type derives from IReflectable but it is being added as a plain field.");
+
+			addPlainBulkArrayField<ObjectType, DataType>(name, uniqueId, 
+				std::function<DataType&(ObjectType*, UINT32)>(std::bind(getter, static_cast<InterfaceType*>(this), _1, _2)), 
+				std::function<UINT32(ObjectType*)>(std::bind(getSize, static_cast<InterfaceType*>(this), _1)), 
+				std::function<void(ObjectType*, UINT32, DataType&)>(std::bind(setter, static_cast<InterfaceType*>(this), _1, _2, _3)), 
+				std::function<void(ObjectType*, UINT32)>(std::bind(setSize, static_cast<InterfaceType*>(this), _1, _2)), 
+				std::function<DataType*(ObjectType*)>(std::bind(getData, static_cast<InterfaceType*>(this), _1)), flags);
+		}
+
 		template<class InterfaceType, class ObjectType, class DataType>
 		void addReflectableArrayField(const String& name, UINT32 uniqueId, 
 			DataType& (InterfaceType::*getter)(ObjectType*, UINT32), 
@@ -1165,6 +1251,16 @@ namespace bs
 			addNewField(newField);
 		}	
 
+		template<class ObjectType, class DataType>
+		void addPlainBulkArrayField(const String& name, UINT32 uniqueId, Any getter, Any getSize,
+			Any setter, Any setSize, Any getData, UINT64 flags)
+		{
+			RTTIPlainBulkArrayField<DataType, ObjectType>* newField = 
+				bs_new<RTTIPlainBulkArrayField<DataType, ObjectType>>();
+			newField->initBulkArray(name, uniqueId, getter, getSize, setter, setSize, getData, flags);
+			addNewField(newField);
+		}
+
 		template<class ObjectType, class DataType>
 		void addReflectableArrayField(const String& name, UINT32 uniqueId, Any getter, Any getSize,
 			Any setter, Any setSize, UINT64 flags)
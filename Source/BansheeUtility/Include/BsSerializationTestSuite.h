@@ -0,0 +1,36 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsTestSuite.h"
+#include "BsBenchmarkSuite.h"
+
+namespace bs
+{
+	class BS_UTILITY_EXPORT SerializationTestSuite : public TestSuite
+	{
+	public:
+		SerializationTestSuite();
+
+	private:
+		void testBulkArrayMatchesPlainArray();
+		void testBulkArrayCrossDecode();
+		void testPlainVectorBulkEncoding();
+		void testClonerSharedReferences();
+		void testClonerWeakReferenceCycle();
+		void testClonerShallow();
+		void testClonerDataBlock();
+		void testClonerBulkArray();
+	};
+
+	class BS_UTILITY_EXPORT SerializationBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		SerializationBenchmarkSuite(const BenchmarkParams& params);
+
+	private:
+		void benchmarkDirectDecode();
+		void benchmarkBulkArray();
+		void benchmarkCloner();
+	};
+}
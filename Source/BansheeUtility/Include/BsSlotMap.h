@@ -0,0 +1,220 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup General
+	 *  @{
+	 */
+
+	/** Handle referencing an element in a SlotMap. */
+	struct SlotHandle
+	{
+		SlotHandle() = default;
+		SlotHandle(UINT32 index, UINT32 generation)
+			:index(index), generation(generation)
+		{ }
+
+		/** Checks if the handle was ever assigned to an element. Does not check if the element is still alive. */
+		bool isValid() const { return index != INVALID_INDEX; }
+
+		bool operator==(const SlotHandle& rhs) const { return index == rhs.index && generation == rhs.generation; }
+		bool operator!=(const SlotHandle& rhs) const { return !(*this == rhs); }
+
+		static const UINT32 INVALID_INDEX = (UINT32)-1;
+
+		UINT32 index = INVALID_INDEX;
+		UINT32 generation = 0;
+	};
+
+	/**
+	 * Container that stores its elements contiguously in memory, while providing handles to them that remain stable as
+	 * other elements are added or removed. Insertion, removal and lookup by handle are constant time, and iteration is a
+	 * linear walk over a tightly packed array. Each slot keeps a generation counter that is incremented whenever its
+	 * element is removed, so handles to removed elements can be detected even once the slot is reused.
+	 *
+	 * @note
+	 * Removing an element moves the last element in its place, so element order is not preserved, and pointers or
+	 * iterators to elements are invalidated by any insertion or removal. Store handles instead.
+	 */
+	template<class T>
+	class SlotMap
+	{
+		/** Entry mapping a handle to a position in the element array. */
+		struct Slot
+		{
+			UINT32 valueIdx; /**< Index of the element, or of the next free slot if the slot is unused. */
+			UINT32 generation;
+		};
+
+	public:
+		typedef typename Vector<T>::iterator iterator;
+		typedef typename Vector<T>::const_iterator const_iterator;
+
+		/** Adds a new element and returns a handle to it. */
+		SlotHandle insert(const T& value)
+		{
+			SlotHandle handle = allocateSlot();
+			mValues.push_back(value);
+
+			return handle;
+		}
+
+		/** @copydoc insert(const T&) */
+		SlotHandle insert(T&& value)
+		{
+			SlotHandle handle = allocateSlot();
+			mValues.push_back(std::move(value));
+
+			return handle;
+		}
+
+		/** Removes the element referenced by the handle. Returns false if the handle doesn't reference a live element. */
+		bool remove(const SlotHandle& handle)
+		{
+			if (!contains(handle))
+				return false;
+
+			Slot& slot = mSlots[handle.index];
+			UINT32 valueIdx = slot.valueIdx;
+			UINT32 lastIdx = (UINT32)mValues.size() - 1;
+
+			// Move the last element into the hole
+			if (valueIdx != lastIdx)
+			{
+				mValues[valueIdx] = std::move(mValues[lastIdx]);
+				mValueSlots[valueIdx] = mValueSlots[lastIdx];
+				mSlots[mValueSlots[valueIdx]].valueIdx = valueIdx;
+			}
+
+			mValues.pop_back();
+			mValueSlots.pop_back();
+
+			slot.generation++;
+			slot.valueIdx = mFreeSlot;
+			mFreeSlot = handle.index;
+
+			return true;
+		}
+
+		/** Checks does the handle reference a live element. */
+		bool contains(const SlotHandle& handle) const
+		{
+			return handle.index < (UINT32)mSlots.size() && mSlots[handle.index].generation == handle.generation &&
+				mSlots[handle.index].valueIdx < (UINT32)mValues.size() &&
+				mValueSlots[mSlots[handle.index].valueIdx] == handle.index;
+		}
+
+		/** Returns the element referenced by the handle, or null if the handle doesn't reference a live element. */
+		T* find(const SlotHandle& handle)
+		{
+			if (!contains(handle))
+				return nullptr;
+
+			return &mValues[mSlots[handle.index].valueIdx];
+		}
+
+		/** @copydoc find */
+		const T* find(const SlotHandle& handle) const
+		{
+			if (!contains(handle))
+				return nullptr;
+
+			return &mValues[mSlots[handle.index].valueIdx];
+		}
+
+		/** Returns the element referenced by the handle. Caller must ensure the handle references a live element. */
+		T& operator[](const SlotHandle& handle)
+		{
+			assert(contains(handle));
+			return mValues[mSlots[handle.index].valueIdx];
+		}
+
+		/** @copydoc operator[] */
+		const T& operator[](const SlotHandle& handle) const
+		{
+			assert(contains(handle));
+			return mValues[mSlots[handle.index].valueIdx];
+		}
+
+		/** Returns a handle to the element at the specified position in the element array (as iterated over). */
+		SlotHandle getHandle(UINT32 idx) const
+		{
+			UINT32 slotIdx = mValueSlots[idx];
+			return SlotHandle(slotIdx, mSlots[slotIdx].generation);
+		}
+
+		/** Removes all elements. Handles to any existing elements become invalid. */
+		void clear()
+		{
+			for (UINT32 i = 0; i < (UINT32)mValueSlots.size(); i++)
+			{
+				Slot& slot = mSlots[mValueSlots[i]];
+				slot.generation++;
+				slot.valueIdx = mFreeSlot;
+				mFreeSlot = mValueSlots[i];
+			}
+
+			mValues.clear();
+			mValueSlots.clear();
+		}
+
+		/** Pre-allocates storage for the specified number of elements. */
+		void reserve(UINT32 count)
+		{
+			mValues.reserve(count);
+			mValueSlots.reserve(count);
+			mSlots.reserve(count);
+		}
+
+		/** Returns the number of live elements. */
+		UINT32 size() const { return (UINT32)mValues.size(); }
+
+		/** Checks are there any live elements. */
+		bool empty() const { return mValues.empty(); }
+
+		/** Returns a pointer to the contiguous array of all live elements. */
+		T* data() { return mValues.data(); }
+
+		/** @copydoc data */
+		const T* data() const { return mValues.data(); }
+
+		iterator begin() { return mValues.begin(); }
+		iterator end() { return mValues.end(); }
+		const_iterator begin() const { return mValues.begin(); }
+		const_iterator end() const { return mValues.end(); }
+
+	private:
+		/** Finds a free slot, or creates a new one, and points it to the end of the element array. */
+		SlotHandle allocateSlot()
+		{
+			UINT32 slotIdx;
+			if (mFreeSlot != SlotHandle::INVALID_INDEX)
+			{
+				slotIdx = mFreeSlot;
+				mFreeSlot = mSlots[slotIdx].valueIdx;
+			}
+			else
+			{
+				slotIdx = (UINT32)mSlots.size();
+				mSlots.push_back({ 0, 0 });
+			}
+
+			Slot& slot = mSlots[slotIdx];
+			slot.valueIdx = (UINT32)mValues.size();
+			mValueSlots.push_back(slotIdx);
+
+			return SlotHandle(slotIdx, slot.generation);
+		}
+
+		Vector<T> mValues;
+		Vector<UINT32> mValueSlots; /**< Index of the slot referencing each element. */
+		Vector<Slot> mSlots;
+		UINT32 mFreeSlot = SlotHandle::INVALID_INDEX;
+	};
+
+	/** @} */
+}
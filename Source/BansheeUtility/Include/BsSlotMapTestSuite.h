@@ -0,0 +1,19 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsTestSuite.h"
+
+namespace bs
+{
+	class BS_UTILITY_EXPORT SlotMapTestSuite : public TestSuite
+	{
+	public:
+		SlotMapTestSuite();
+
+	private:
+		void testInsertRemove();
+		void testStaleHandles();
+		void testRandomOperations();
+	};
+}
@@ -12,6 +12,7 @@ namespace bs
 	 *  @{
 	 */
 	class TaskScheduler;
+	class TaskGroup;
 
 	/** Task priority. Tasks with higher priority will get executed sooner. */
 	enum class TaskPriority
@@ -57,7 +58,9 @@ namespace bs
 		/**
 		 * Blocks the current thread until the task has completed. 
 		 * 
-		 * @note	While waiting adds a new worker thread, so that the blocking threads core can be utilized.
+		 * @note	
+		 * If called from a task scheduler worker the worker will execute other queued tasks while it waits. Otherwise
+		 * a new worker thread is added while waiting, so that the blocking threads core can be utilized.
 		 */
 		void wait();
 
@@ -66,6 +69,7 @@ namespace bs
 
 	private:
 		friend class TaskScheduler;
+		friend class TaskGroup;
 
 		String mName;
 		TaskPriority mPriority;
@@ -74,6 +78,57 @@ namespace bs
 		SPtr<Task> mTaskDependency;
 		std::atomic<UINT32> mState; /**< 0 - Inactive, 1 - In progress, 2 - Completed, 3 - Canceled */
 
+		TaskScheduler* mParent;
+		TaskGroup* mGroup;
+
+		SPtr<Task> mQueuedRef; /**< Keeps the task alive while it is referenced from a scheduler queue. */
+		Vector<SPtr<Task>> mDependants;
+		SpinLock mDependantsLock;
+	};
+
+	/**
+	 * Group of tasks that can be waited on as a whole. Tasks may be added to the group from any thread, including from
+	 * tasks already running on the scheduler, allowing a task to spawn child tasks and wait for them to finish.
+	 *
+	 * @note	
+	 * Thread safe.
+	 * @note
+	 * Waiting on the group from a task scheduler worker will not block the worker, instead it will execute other queued
+	 * tasks until the group completes. The group must not be destroyed before all of its tasks complete, and the
+	 * destructor will wait for them if needed.
+	 */
+	class BS_UTILITY_EXPORT TaskGroup
+	{
+		struct PrivatelyConstruct {};
+
+	public:
+		TaskGroup(const PrivatelyConstruct& dummy, const String& name, TaskPriority priority);
+		~TaskGroup();
+
+		/**
+		 * Creates a new task group. Tasks added to the group are immediately queued on the active TaskScheduler.
+		 *
+		 * @param[in]	name		Name you can use to more easily identify the tasks in the group.
+		 * @param[in]	priority  	(optional) Priority that will be assigned to all tasks in the group.
+		 */
+		static SPtr<TaskGroup> create(const String& name, TaskPriority priority = TaskPriority::Normal);
+
+		/** Creates a new task executing the provided worker method, adds it to the group and queues it for execution. */
+		void run(std::function<void()> taskWorker);
+
+		/** Returns true if all the tasks in the group have completed (or have been canceled). */
+		bool isComplete() const;
+
+		/** Blocks the current thread until all the tasks in the group have completed. */
+		void wait();
+
+	private:
+		friend class TaskScheduler;
+
+		String mName;
+		TaskPriority mPriority;
+		std::atomic<UINT32> mNumPending;
+
 		TaskScheduler* mParent;
 	};
 
@@ -84,12 +139,13 @@ namespace bs
 	 * @note	
 	 * Thread safe.
 	 * @note
-	 * This type of task scheduler uses a global queue and is best used for coarse granularity of tasks. (Number of tasks 
-	 * in the order of hundreds. Higher number of tasks might require different queuing and locking mechanism, potentially 
-	 * at the cost of flexibility.)
+	 * Each worker thread has its own set of task queues (one per priority). Tasks queued from within a worker are pushed
+	 * to the workers own queue, while tasks queued from other threads go to a shared queue. Idle workers steal tasks from
+	 * the queues of other workers. Priority is respected per queue, so a worker will always prefer higher priority tasks
+	 * it can find, but the execution order between tasks on different workers is not guaranteed.
 	 * @note
-	 * By default the task scheduler will create as many threads as there are physical CPU cores. You may add or remove
-	 * threads using addWorker()/removeWorker() methods.
+	 * By default the task scheduler will allow as many threads as there are logical CPU cores. You may add or remove
+	 * threads using addWorker()/removeWorker() methods. Worker threads are created on demand, as tasks are queued.
 	 */
 	class BS_UTILITY_EXPORT TaskScheduler : public Module<TaskScheduler>
 	{
@@ -97,9 +153,27 @@ namespace bs
 		TaskScheduler();
 		~TaskScheduler();
 
-		/** Queues a new task. */
+		/** 
+		 * Queues a new task. If the task depends on a task that was canceled, the task (along with any tasks depending
+		 * on it) is canceled instead of being queued.
+		 */
 		void addTask(const SPtr<Task>& task);
 
+		/**
+		 * Splits the range [@p begin, @p end) into chunks of at most @p grainSize elements, and executes @p worker on each
+		 * chunk in parallel. The calling thread executes one of the chunks itself and then blocks until all others
+		 * complete (in the same manner as TaskGroup::wait()).
+		 *
+		 * @param[in]	name		Name you can use to more easily identify the tasks.
+		 * @param[in]	begin		Index of the first element in the range.
+		 * @param[in]	end			Index one past the last element in the range.
+		 * @param[in]	grainSize	Maximum number of elements processed by a single task.
+		 * @param[in]	worker		Worker method receiving the start and end (exclusive) indices of a chunk.
+		 * @param[in]	priority	(optional) Priority of the queued tasks.
+		 */
+		void parallelFor(const String& name, UINT32 begin, UINT32 end, UINT32 grainSize, 
+			const std::function<void(UINT32, UINT32)>& worker, TaskPriority priority = TaskPriority::Normal);
+
 		/**	Adds a new worker thread which will be used for executing queued tasks. */
 		void addWorker();
 
@@ -107,29 +181,79 @@ namespace bs
 		void removeWorker();
 
 		/** Returns the maximum available worker threads (maximum number of tasks that can be executed simultaneously). */
-		UINT32 getNumWorkers() const { return mMaxActiveTasks; }
+		UINT32 getNumWorkers() const { return mMaxActiveTasks.load(); }
+
+		/** 
+		 * Sets a callback that is executed on the worker thread after each task's worker method returns, before the task
+		 * is marked as complete. Allows other systems to flush per-thread state the task left behind. Provide null to
+		 * remove the callback.
+		 */
+		void setTaskEndCallback(void(*callback)()) { mTaskEndCallback.store(callback); }
 	protected:
 		friend class Task;
+		friend class TaskGroup;
+
+		struct Worker;
 
-		/**	Main task scheduler method that dispatches tasks to other threads. */
-		void runMain();
+		/** Maximum number of worker threads the scheduler will create. */
+		static const UINT32 MAX_WORKERS = 64;
 
-		/**	Worker method that runs a single task. */
-		void runTask(SPtr<Task> task);
+		/** Number of different task priorities, each of which gets its own queue. */
+		static const UINT32 NUM_PRIORITIES = 5;
+
+		/**	Main loop of a single worker thread. */
+		void runWorker(Worker* worker);
+
+		/** Creates a new worker thread if there are less workers than allowed. Caller must hold mReadyMutex. */
+		void spawnWorker();
+
+		/** Pushes a task (with no pending dependencies) to a task queue and wakes up a worker to execute it. */
+		void queueTask(const SPtr<Task>& task);
+
+		/** Finds the highest priority task available to the provided worker, stealing it from other workers if needed. */
+		SPtr<Task> findTask(Worker* worker);
+
+		/**	Executes the provided task on the calling thread. */
+		void runTask(const SPtr<Task>& task);
+
+		/** 
+		 * Marks the task as finished with the provided state (completed or canceled), queues or cancels its dependants
+		 * and notifies any waiting threads.
+		 */
+		void finishTask(const SPtr<Task>& task, UINT32 state);
+
+		/** Wakes up any threads waiting for a task or a task group to complete. */
+		void notifyComplete();
 
 		/**	Blocks the calling thread until the specified task has completed. */
 		void waitUntilComplete(const Task* task);
 
-		/**	Method used for sorting tasks. */
-		static bool taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs);
+		/**	Blocks the calling thread until all the tasks in the specified group have completed. */
+		void waitUntilComplete(const TaskGroup* group);
+
+		/** 
+		 * Blocks the calling thread until the provided condition is met. If called from a worker it will execute other
+		 * tasks while waiting.
+		 */
+		void waitUntil(const std::function<bool()>& condition);
+
+		/** Maps task priority to the index of the queue it should be stored in. */
+		static UINT32 getQueueIdx(TaskPriority priority);
+
+		Worker* mWorkers[MAX_WORKERS];
+		std::atomic<UINT32> mNumWorkers;
+		std::atomic<UINT32> mMaxActiveTasks;
+		std::atomic<UINT32> mNextTaskId;
+		std::atomic<bool> mShutdown;
+		std::atomic<void(*)()> mTaskEndCallback;
 
-		HThread mTaskSchedulerThread;
-		Set<SPtr<Task>, std::function<bool(const SPtr<Task>&, const SPtr<Task>&)>> mTaskQueue;
-		Vector<SPtr<Task>> mActiveTasks;
-		UINT32 mMaxActiveTasks;
-		UINT32 mNextTaskId;
-		bool mShutdown;
+		Queue<Task*> mSharedQueues[NUM_PRIORITIES];
+		std::atomic<INT32> mNumQueued;
+		std::atomic<UINT32> mNumShared;
+		std::atomic<UINT32> mNumSleeping;
+		std::atomic<UINT32> mNumWaiting;
 
+		Mutex mSharedQueueMutex;
 		Mutex mReadyMutex;
 		Mutex mCompleteMutex;
 		Signal mTaskReadyCond;
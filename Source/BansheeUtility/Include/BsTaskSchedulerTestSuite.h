@@ -0,0 +1,22 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsTestSuite.h"
+
+namespace bs
+{
+	class BS_UTILITY_EXPORT TaskSchedulerTestSuite : public TestSuite
+	{
+	public:
+		TaskSchedulerTestSuite();
+
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void testCanceledDependency();
+
+		bool mOwnsModules;
+	};
+}
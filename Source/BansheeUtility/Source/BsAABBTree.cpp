@@ -0,0 +1,305 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsAABBTree.h"
+
+namespace bs
+{
+	const UINT32 AABBTree::INVALID_ID;
+
+	AABBTree::AABBTree(float margin)
+		:mMargin(margin)
+	{ }
+
+	UINT32 AABBTree::add(const AABox& bounds, UINT32 userData)
+	{
+		UINT32 leafIdx = allocateNode();
+
+		Node& leaf = mNodes[leafIdx];
+		leaf.bounds = getEnlargedBounds(bounds);
+		leaf.children[1] = userData;
+
+		insertLeaf(leafIdx);
+		mNumLeaves++;
+
+		return leafIdx;
+	}
+
+	bool AABBTree::update(UINT32 leafId, const AABox& bounds)
+	{
+		assert(mNodes[leafId].isLeaf() && mLinks[leafId].height == 0);
+
+		AABox enlargedBounds = getEnlargedBounds(bounds);
+
+		// Keep the leaf where it is as long as the new bounds still fit, unless the leaf has shrunk significantly, in
+		// which case re-inserting it results in better queries
+		const AABox& currentBounds = mNodes[leafId].bounds;
+		if (currentBounds.contains(bounds) && getArea(currentBounds) <= getArea(enlargedBounds) * 4.0f)
+			return false;
+
+		removeLeaf(leafId);
+		mNodes[leafId].bounds = enlargedBounds;
+		insertLeaf(leafId);
+
+		return true;
+	}
+
+	void AABBTree::remove(UINT32 leafId)
+	{
+		assert(mNodes[leafId].isLeaf() && mLinks[leafId].height == 0);
+
+		removeLeaf(leafId);
+		freeNode(leafId);
+
+		mNumLeaves--;
+	}
+
+	void AABBTree::clear()
+	{
+		mNodes.clear();
+		mLinks.clear();
+		mRoot = INVALID_ID;
+		mFreeList = INVALID_ID;
+		mNumLeaves = 0;
+	}
+
+	UINT32 AABBTree::allocateNode()
+	{
+		UINT32 nodeIdx;
+		if (mFreeList != INVALID_ID)
+		{
+			nodeIdx = mFreeList;
+			mFreeList = mLinks[nodeIdx].parent;
+		}
+		else
+		{
+			nodeIdx = (UINT32)mNodes.size();
+			mNodes.push_back(Node());
+			mLinks.push_back(NodeLinks());
+		}
+
+		Node& node = mNodes[nodeIdx];
+		node.children[0] = INVALID_ID;
+		node.children[1] = INVALID_ID;
+
+		NodeLinks& links = mLinks[nodeIdx];
+		links.parent = INVALID_ID;
+		links.height = 0;
+
+		return nodeIdx;
+	}
+
+	void AABBTree::freeNode(UINT32 nodeIdx)
+	{
+		NodeLinks& links = mLinks[nodeIdx];
+		links.parent = mFreeList;
+		links.height = -1;
+
+		mFreeList = nodeIdx;
+	}
+
+	void AABBTree::insertLeaf(UINT32 leafIdx)
+	{
+		if (mRoot == INVALID_ID)
+		{
+			mRoot = leafIdx;
+			mLinks[leafIdx].parent = INVALID_ID;
+			return;
+		}
+
+		// Find the best sibling for the leaf, by descending into the child that results in the least increase in area
+		AABox leafBounds = mNodes[leafIdx].bounds;
+
+		UINT32 nodeIdx = mRoot;
+		while (!mNodes[nodeIdx].isLeaf())
+		{
+			const Node& node = mNodes[nodeIdx];
+
+			float area = getArea(node.bounds);
+			float combinedArea = getArea(merge(node.bounds, leafBounds));
+
+			// Cost of creating a new parent for this node and the new leaf
+			float cost = 2.0f * combinedArea;
+
+			// Minimum cost of pushing the leaf further down the tree
+			float inheritanceCost = 2.0f * (combinedArea - area);
+
+			float childCosts[2];
+			for (UINT32 i = 0; i < 2; i++)
+			{
+				const Node& child = mNodes[node.children[i]];
+
+				float childCombinedArea = getArea(merge(child.bounds, leafBounds));
+				if (child.isLeaf())
+					childCosts[i] = childCombinedArea + inheritanceCost;
+				else
+					childCosts[i] = (childCombinedArea - getArea(child.bounds)) + inheritanceCost;
+			}
+
+			if (cost < childCosts[0] && cost < childCosts[1])
+				break;
+
+			nodeIdx = childCosts[0] < childCosts[1] ? node.children[0] : node.children[1];
+		}
+
+		UINT32 siblingIdx = nodeIdx;
+
+		// Create a new parent for the sibling and the leaf
+		UINT32 oldParentIdx = mLinks[siblingIdx].parent;
+		UINT32 newParentIdx = allocateNode();
+
+		Node& newParent = mNodes[newParentIdx];
+		newParent.bounds = merge(leafBounds, mNodes[siblingIdx].bounds);
+		newParent.children[0] = siblingIdx;
+		newParent.children[1] = leafIdx;
+
+		mLinks[newParentIdx].parent = oldParentIdx;
+		mLinks[newParentIdx].height = mLinks[siblingIdx].height + 1;
+
+		if (oldParentIdx != INVALID_ID)
+		{
+			Node& oldParent = mNodes[oldParentIdx];
+			if (oldParent.children[0] == siblingIdx)
+				oldParent.children[0] = newParentIdx;
+			else
+				oldParent.children[1] = newParentIdx;
+		}
+		else
+			mRoot = newParentIdx;
+
+		mLinks[siblingIdx].parent = newParentIdx;
+		mLinks[leafIdx].parent = newParentIdx;
+
+		refit(newParentIdx);
+	}
+
+	void AABBTree::removeLeaf(UINT32 leafIdx)
+	{
+		if (leafIdx == mRoot)
+		{
+			mRoot = INVALID_ID;
+			return;
+		}
+
+		UINT32 parentIdx = mLinks[leafIdx].parent;
+		UINT32 grandParentIdx = mLinks[parentIdx].parent;
+
+		const Node& parent = mNodes[parentIdx];
+		UINT32 siblingIdx = parent.children[0] == leafIdx ? parent.children[1] : parent.children[0];
+
+		// Replace the parent with the sibling
+		if (grandParentIdx != INVALID_ID)
+		{
+			Node& grandParent = mNodes[grandParentIdx];
+			if (grandParent.children[0] == parentIdx)
+				grandParent.children[0] = siblingIdx;
+			else
+				grandParent.children[1] = siblingIdx;
+
+			mLinks[siblingIdx].parent = grandParentIdx;
+			freeNode(parentIdx);
+
+			refit(grandParentIdx);
+		}
+		else
+		{
+			mRoot = siblingIdx;
+			mLinks[siblingIdx].parent = INVALID_ID;
+			freeNode(parentIdx);
+		}
+
+		mLinks[leafIdx].parent = INVALID_ID;
+	}
+
+	void AABBTree::refit(UINT32 nodeIdx)
+	{
+		while (nodeIdx != INVALID_ID)
+		{
+			nodeIdx = balance(nodeIdx);
+
+			Node& node = mNodes[nodeIdx];
+			UINT32 child0 = node.children[0];
+			UINT32 child1 = node.children[1];
+
+			node.bounds = merge(mNodes[child0].bounds, mNodes[child1].bounds);
+			mLinks[nodeIdx].height = 1 + std::max(mLinks[child0].height, mLinks[child1].height);
+
+			nodeIdx = mLinks[nodeIdx].parent;
+		}
+	}
+
+	UINT32 AABBTree::balance(UINT32 nodeIdx)
+	{
+		Node& a = mNodes[nodeIdx];
+		NodeLinks& aLinks = mLinks[nodeIdx];
+		if (a.isLeaf() || aLinks.height < 2)
+			return nodeIdx;
+
+		UINT32 bIdx = a.children[0];
+		UINT32 cIdx = a.children[1];
+
+		INT32 heightDiff = mLinks[cIdx].height - mLinks[bIdx].height;
+		if (heightDiff >= -1 && heightDiff <= 1)
+			return nodeIdx;
+
+		// Rotate the taller child up, placing the node in its position, and re-attaching its taller child to the node
+		UINT32 upIdx = heightDiff > 1 ? cIdx : bIdx;
+		UINT32 otherIdx = heightDiff > 1 ? bIdx : cIdx;
+		UINT32 otherSlot = heightDiff > 1 ? 0 : 1;
+
+		Node& up = mNodes[upIdx];
+		NodeLinks& upLinks = mLinks[upIdx];
+
+		UINT32 fIdx = up.children[0];
+		UINT32 gIdx = up.children[1];
+
+		up.children[0] = nodeIdx;
+		upLinks.parent = aLinks.parent;
+		aLinks.parent = upIdx;
+
+		if (upLinks.parent != INVALID_ID)
+		{
+			Node& parent = mNodes[upLinks.parent];
+			if (parent.children[0] == nodeIdx)
+				parent.children[0] = upIdx;
+			else
+				parent.children[1] = upIdx;
+		}
+		else
+			mRoot = upIdx;
+
+		// Keep the taller grandchild with the child moved up, move the shorter one to the original node
+		UINT32 tallIdx = fIdx;
+		UINT32 shortIdx = gIdx;
+		if (mLinks[gIdx].height > mLinks[fIdx].height)
+			std::swap(tallIdx, shortIdx);
+
+		up.children[1] = tallIdx;
+		a.children[1 - otherSlot] = shortIdx;
+		mLinks[shortIdx].parent = nodeIdx;
+
+		a.bounds = merge(mNodes[otherIdx].bounds, mNodes[shortIdx].bounds);
+		up.bounds = merge(a.bounds, mNodes[tallIdx].bounds);
+
+		aLinks.height = 1 + std::max(mLinks[otherIdx].height, mLinks[shortIdx].height);
+		upLinks.height = 1 + std::max(aLinks.height, mLinks[tallIdx].height);
+
+		return upIdx;
+	}
+
+	AABox AABBTree::getEnlargedBounds(const AABox& bounds) const
+	{
+		Vector3 margin(mMargin, mMargin, mMargin);
+		return AABox(bounds.getMin() - margin, bounds.getMax() + margin);
+	}
+
+	AABox AABBTree::merge(const AABox& a, const AABox& b)
+	{
+		return AABox(Vector3::min(a.getMin(), b.getMin()), Vector3::max(a.getMax(), b.getMax()));
+	}
+
+	float AABBTree::getArea(const AABox& box)
+	{
+		Vector3 size = box.getMax() - box.getMin();
+		return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+	}
+}
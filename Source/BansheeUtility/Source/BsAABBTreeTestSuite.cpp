@@ -0,0 +1,202 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsAABBTreeTestSuite.h"
+
+#include "BsAABBTree.h"
+#include "BsDebug.h"
+#include "BsTimer.h"
+
+#include <random>
+
+namespace bs
+{
+	const UINT32 testNumObjects = 200000;
+	const UINT32 testNumQueries = 32;
+	const float testWorldSize = 1000.0f;
+
+	AABox createRandomBox(std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> positionDist(-testWorldSize * 0.5f, testWorldSize * 0.5f);
+		std::uniform_real_distribution<float> sizeDist(0.5f, 5.0f);
+
+		Vector3 center(positionDist(rng), positionDist(rng), positionDist(rng));
+		Vector3 halfSize(sizeDist(rng), sizeDist(rng), sizeDist(rng));
+
+		return AABox(center - halfSize, center + halfSize);
+	}
+
+	ConvexVolume createRandomVolume(std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> positionDist(-testWorldSize * 0.5f, testWorldSize * 0.5f);
+		std::uniform_real_distribution<float> directionDist(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> radiusDist(20.0f, 150.0f);
+
+		Vector3 center(positionDist(rng), positionDist(rng), positionDist(rng));
+
+		// Six inward facing planes at a random distance from the center, roughly the size and shape of a view frustum
+		Vector<Plane> planes;
+		for (UINT32 i = 0; i < 6; i++)
+		{
+			Vector3 normal(directionDist(rng), directionDist(rng), directionDist(rng));
+			if (normal.squaredLength() < 0.01f)
+				normal = Vector3::UNIT_X;
+
+			normal.normalize();
+			planes.push_back(Plane(normal, normal.dot(center) - radiusDist(rng)));
+		}
+
+		return ConvexVolume(planes);
+	}
+
+	/** Compares the results of a tree query with the results of testing every box against the volume. */
+	bool compareWithBruteForce(const AABBTree& tree, const Vector<AABox>& boxes, const Vector<bool>& alive,
+		const ConvexVolume& volume, UINT64& treeTime, UINT64& bruteForceTime)
+	{
+		Vector<bool> treeResult(boxes.size(), false);
+		Vector<bool> bruteForceResult(boxes.size(), false);
+
+		Timer timer;
+		tree.query(volume, [&](UINT32 idx, bool fullyInside)
+		{
+			if (fullyInside || volume.intersects(boxes[idx]))
+				treeResult[idx] = true;
+		});
+		treeTime += timer.getMicroseconds();
+
+		timer.reset();
+		for (UINT32 i = 0; i < (UINT32)boxes.size(); i++)
+		{
+			if (alive[i] && volume.intersects(boxes[i]))
+				bruteForceResult[i] = true;
+		}
+		bruteForceTime += timer.getMicroseconds();
+
+		return treeResult == bruteForceResult;
+	}
+
+	AABBTreeTestSuite::AABBTreeTestSuite()
+	{
+		BS_ADD_TEST(AABBTreeTestSuite::testQueryVolume);
+		BS_ADD_TEST(AABBTreeTestSuite::testQueryBox);
+		BS_ADD_TEST(AABBTreeTestSuite::testUpdateRemove);
+	}
+
+	void AABBTreeTestSuite::testQueryVolume()
+	{
+		std::mt19937 rng(1234);
+
+		Vector<AABox> boxes;
+		Vector<bool> alive(testNumObjects, true);
+		AABBTree tree;
+		for (UINT32 i = 0; i < testNumObjects; i++)
+		{
+			boxes.push_back(createRandomBox(rng));
+			tree.add(boxes.back(), i);
+		}
+
+		BS_TEST_ASSERT(tree.getNumLeaves() == testNumObjects);
+
+		// Balanced tree should be within a small factor of log2(200k) ~= 18
+		BS_TEST_ASSERT(tree.getHeight() < 40);
+
+		UINT64 treeTime = 0;
+		UINT64 bruteForceTime = 0;
+		for (UINT32 i = 0; i < testNumQueries; i++)
+		{
+			ConvexVolume volume = createRandomVolume(rng);
+			BS_TEST_ASSERT(compareWithBruteForce(tree, boxes, alive, volume, treeTime, bruteForceTime));
+		}
+
+		LOGDBG("AABBTree culling of " + toString(testNumObjects) + " objects, " + toString(testNumQueries) +
+			" queries. Tree: " + toString(treeTime) + "us, brute force: " + toString(bruteForceTime) + "us.");
+	}
+
+	void AABBTreeTestSuite::testQueryBox()
+	{
+		std::mt19937 rng(4321);
+
+		Vector<AABox> boxes;
+		AABBTree tree(0.0f);
+		for (UINT32 i = 0; i < 10000; i++)
+		{
+			boxes.push_back(createRandomBox(rng));
+			tree.add(boxes.back(), i);
+		}
+
+		for (UINT32 i = 0; i < testNumQueries; i++)
+		{
+			AABox queryBox = createRandomBox(rng);
+			queryBox.scale(Vector3(20.0f, 20.0f, 20.0f));
+
+			Vector<bool> treeResult(boxes.size(), false);
+			tree.query(queryBox, [&](UINT32 idx)
+			{
+				treeResult[idx] = true;
+			});
+
+			Vector<bool> bruteForceResult(boxes.size(), false);
+			for (UINT32 j = 0; j < (UINT32)boxes.size(); j++)
+				bruteForceResult[j] = queryBox.intersects(boxes[j]);
+
+			BS_TEST_ASSERT(treeResult == bruteForceResult);
+		}
+	}
+
+	void AABBTreeTestSuite::testUpdateRemove()
+	{
+		std::mt19937 rng(5678);
+		std::uniform_real_distribution<float> offsetDist(-10.0f, 10.0f);
+
+		const UINT32 numObjects = 20000;
+
+		Vector<AABox> boxes;
+		Vector<UINT32> leafIds;
+		Vector<bool> alive(numObjects, true);
+		AABBTree tree;
+		for (UINT32 i = 0; i < numObjects; i++)
+		{
+			boxes.push_back(createRandomBox(rng));
+			leafIds.push_back(tree.add(boxes.back(), i));
+		}
+
+		// Move a portion of the objects, both by small amounts (within the margin) and large amounts
+		for (UINT32 i = 0; i < numObjects; i += 3)
+		{
+			float scale = (i % 2) == 0 ? 0.01f : 1.0f;
+			Vector3 offset(offsetDist(rng) * scale, offsetDist(rng) * scale, offsetDist(rng) * scale);
+
+			boxes[i] = AABox(boxes[i].getMin() + offset, boxes[i].getMax() + offset);
+			tree.update(leafIds[i], boxes[i]);
+		}
+
+		// Remove some objects, and re-add a few of them
+		for (UINT32 i = 0; i < numObjects; i += 5)
+		{
+			tree.remove(leafIds[i]);
+			alive[i] = false;
+		}
+
+		for (UINT32 i = 0; i < numObjects; i += 10)
+		{
+			leafIds[i] = tree.add(boxes[i], i);
+			alive[i] = true;
+		}
+
+		UINT32 numAlive = 0;
+		for (auto entry : alive)
+			numAlive += entry ? 1 : 0;
+
+		BS_TEST_ASSERT(tree.getNumLeaves() == numAlive);
+
+		UINT64 treeTime = 0;
+		UINT64 bruteForceTime = 0;
+		for (UINT32 i = 0; i < testNumQueries; i++)
+		{
+			ConvexVolume volume = createRandomVolume(rng);
+			BS_TEST_ASSERT(compareWithBruteForce(tree, boxes, alive, volume, treeTime, bruteForceTime));
+		}
+
+		tree.clear();
+		BS_TEST_ASSERT(tree.getNumLeaves() == 0);
+	}
+}
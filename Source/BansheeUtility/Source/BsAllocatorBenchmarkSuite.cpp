@@ -0,0 +1,149 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsAllocatorBenchmarkSuite.h"
+
+#include "BsPooledAlloc.h"
+#include "BsDebug.h"
+
+namespace bs
+{
+	/** Allocator using the system heap directly, used as a baseline for the pooled allocator. */
+	struct SystemHeapAlloc
+	{
+		static void* allocate(size_t bytes) { return malloc(bytes); }
+		static void free(void* ptr) { ::free(ptr); }
+	};
+
+	/** Standard library compatible allocator forwarding to one of the benchmarked allocators. */
+	template<class T, class Alloc>
+	class BenchmarkStdAlloc
+	{
+	public:
+		typedef T value_type;
+
+		BenchmarkStdAlloc() { }
+		template<class U> BenchmarkStdAlloc(const BenchmarkStdAlloc<U, Alloc>& other) { }
+
+		template<class U> struct rebind { typedef BenchmarkStdAlloc<U, Alloc> other; };
+
+		T* allocate(size_t num) { return (T*)Alloc::allocate(num * sizeof(T)); }
+		void deallocate(T* ptr, size_t num) { Alloc::free(ptr); }
+
+		bool operator==(const BenchmarkStdAlloc& other) const { return true; }
+		bool operator!=(const BenchmarkStdAlloc& other) const { return false; }
+	};
+
+	/** Small object similar in size to typical engine objects held by shared pointers. */
+	struct BenchmarkObject
+	{
+		UINT64 data[6];
+	};
+
+	/** Creates and then releases the specified number of shared pointers. */
+	template<class Alloc>
+	static void createSharedPointers(UINT32 count)
+	{
+		Vector<std::shared_ptr<BenchmarkObject>> objects;
+		objects.reserve(count);
+
+		for (UINT32 i = 0; i < count; i++)
+			objects.push_back(std::allocate_shared<BenchmarkObject>(BenchmarkStdAlloc<BenchmarkObject, Alloc>()));
+	}
+
+	/** Grows short lived strings and vectors one element at a time, for a total of @p count elements. */
+	template<class Alloc>
+	static void growContainers(UINT32 count)
+	{
+		typedef std::basic_string<char, std::char_traits<char>, BenchmarkStdAlloc<char, Alloc>> BenchmarkString;
+		typedef std::vector<UINT32, BenchmarkStdAlloc<UINT32, Alloc>> BenchmarkVector;
+
+		static const UINT32 NUM_ELEMENTS = 64;
+		for (UINT32 i = 0; i < count / NUM_ELEMENTS; i++)
+		{
+			BenchmarkString string;
+			BenchmarkVector vector;
+
+			for (UINT32 j = 0; j < NUM_ELEMENTS; j++)
+			{
+				string += (char)('a' + j % 26);
+				vector.push_back(j);
+			}
+		}
+	}
+
+	/** Allocates @p count small blocks of varying size on this thread and frees them on another. */
+	template<class Alloc>
+	static void freeOnOtherThread(UINT32 count)
+	{
+		Vector<void*> blocks(count);
+		for (UINT32 i = 0; i < count; i++)
+			blocks[i] = Alloc::allocate(16 + (i % 8) * 16);
+
+		Thread thread([&blocks]()
+		{
+			for (auto& entry : blocks)
+				Alloc::free(entry);
+		});
+
+		thread.join();
+	}
+
+	AllocatorBenchmarkSuite::AllocatorBenchmarkSuite(const BenchmarkParams& params)
+		:BenchmarkSuite(params)
+	{
+		BS_ADD_TEST(AllocatorBenchmarkSuite::benchmarkSharedPtrCreation);
+		BS_ADD_TEST(AllocatorBenchmarkSuite::benchmarkContainerGrowth);
+		BS_ADD_TEST(AllocatorBenchmarkSuite::benchmarkCrossThreadFree);
+		BS_ADD_TEST(AllocatorBenchmarkSuite::reportSizeClassStats);
+	}
+
+	void AllocatorBenchmarkSuite::benchmarkSharedPtrCreation()
+	{
+		UINT32 count = mParams.get("allocations", 1000000);
+
+		measure("System heap", [count]() { createSharedPointers<SystemHeapAlloc>(count); });
+		measure("Pooled", [count]() { createSharedPointers<PooledAlloc>(count); });
+	}
+
+	void AllocatorBenchmarkSuite::benchmarkContainerGrowth()
+	{
+		UINT32 count = mParams.get("allocations", 1000000);
+
+		measure("System heap", [count]() { growContainers<SystemHeapAlloc>(count); });
+		measure("Pooled", [count]() { growContainers<PooledAlloc>(count); });
+	}
+
+	void AllocatorBenchmarkSuite::benchmarkCrossThreadFree()
+	{
+		UINT32 count = mParams.get("allocations", 1000000);
+
+		measure("System heap", [count]() { freeOnOtherThread<SystemHeapAlloc>(count); });
+		measure("Pooled", [count]() { freeOnOtherThread<PooledAlloc>(count); });
+	}
+
+	void AllocatorBenchmarkSuite::reportSizeClassStats()
+	{
+		// Blocks freed on other threads are only counted once their owning thread collects them on a later allocation
+		StringStream output;
+		output << "Pooled allocator size classes used by the benchmarks:";
+
+		auto printStats = [&output](const String& name, const PooledAllocStats& stats)
+		{
+			output << std::endl << "  " << name << ": " << stats.numAllocs << " allocations, " << stats.numFrees <<
+				" frees, " << stats.numSpans << " spans.";
+		};
+
+		for (UINT32 i = 0; i < PooledAlloc::getNumSizeClasses(); i++)
+		{
+			PooledAllocStats stats = PooledAlloc::getSizeClassStats(i);
+			if (stats.numAllocs > 0)
+				printStats(toString(stats.blockSize) + " byte blocks", stats);
+		}
+
+		PooledAllocStats hugeStats = PooledAlloc::getHugeAllocStats();
+		if (hugeStats.numAllocs > 0)
+			printStats("Huge allocations", hugeStats);
+
+		LOGDBG(output.str());
+	}
+}
@@ -0,0 +1,49 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsBenchmarkSuite.h"
+#include "BsTimer.h"
+#include "BsDebug.h"
+
+namespace bs
+{
+	BenchmarkParams::BenchmarkParams(int argc, char* argv[])
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			String argument = argv[i];
+
+			size_t separatorIdx = argument.find('=');
+			if (separatorIdx == String::npos)
+				continue;
+
+			String name = argument.substr(0, separatorIdx);
+			mValues[name] = parseUINT32(argument.substr(separatorIdx + 1));
+		}
+	}
+
+	UINT32 BenchmarkParams::get(const String& name, UINT32 defaultValue) const
+	{
+		auto iterFind = mValues.find(name);
+		if (iterFind == mValues.end())
+			return defaultValue;
+
+		return iterFind->second;
+	}
+
+	BenchmarkSuite::BenchmarkSuite(const BenchmarkParams& params)
+		:mParams(params)
+	{ }
+
+	void BenchmarkSuite::measure(const String& name, const std::function<void()>& func)
+	{
+		UINT64 startAllocs = MemoryCounter::getNumAllocs();
+		Timer timer;
+
+		func();
+
+		UINT64 time = timer.getMicroseconds();
+		UINT64 numAllocs = MemoryCounter::getNumAllocs() - startAllocs;
+
+		LOGDBG(mActiveTestName + " - " + name + ": " + toString(time) + "us, " + toString(numAllocs) + " allocations.");
+	}
+}
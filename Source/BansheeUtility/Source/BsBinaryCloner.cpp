@@ -1,6 +1,8 @@
 //********************************** Banshee Engine (www.banshee3d.com) **************************************************//
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "BsBinaryCloner.h"
+#include "BsException.h"
+#include "BsDebug.h"
 #include "BsIReflectable.h"
 #include "BsRTTIType.h"
 #include "BsRTTIField.h"
@@ -8,206 +10,267 @@
 #include "BsRTTIReflectableField.h"
 #include "BsRTTIReflectablePtrField.h"
 #include "BsRTTIManagedDataBlockField.h"
-#include "BsMemorySerializer.h"
+#include "BsDataStream.h"
 
 namespace bs
 {
+	static const UnorderedMap<String, UINT64> dummyParams;
+
+	BinaryCloner::BinaryCloner(bool shallow)
+		:mShallow(shallow)
+	{ }
+
 	SPtr<IReflectable> BinaryCloner::clone(IReflectable* object, bool shallow)
 	{
 		if (object == nullptr)
 			return nullptr;
 
-		ObjectReferenceData referenceData;
-		if (shallow)
-			gatherReferences(object, referenceData);
+		BinaryCloner cloner(shallow);
+
+		SPtr<IReflectable> clonedObj = object->getRTTI()->newRTTIObject();
 
-		std::function<void*(UINT32)> allocator = &MemoryAllocator<GenAlloc>::allocate;
+		// Register the root object so any references back to it resolve to the clone
+		ClonedObject& rootEntry = cloner.mClonedObjects[object];
+		rootEntry.clone = clonedObj;
+		rootEntry.isCopied = false;
+		rootEntry.copyInProgress = true;
 
-		MemorySerializer ms;
-		UINT32 dataSize = 0;
-		UINT8* data = ms.encode(object, dataSize, allocator, shallow);
-		SPtr<IReflectable> clonedObj = ms.decode(data, dataSize);
+		cloner.copyObject(object, clonedObj.get());
 
-		if (shallow)
-			restoreReferences(clonedObj.get(), referenceData);
+		rootEntry.copyInProgress = false;
+		rootEntry.isCopied = true;
+
+		// Copy the remaining objects (should be only ones referenced through weak refs)
+		for (UINT32 i = 0; i < (UINT32)cloner.mPendingObjects.size(); i++)
+			cloner.copyObject(cloner.mClonedObjects[cloner.mPendingObjects[i]]);
 
-		bs_free(data);
 		return clonedObj;
 	}
 
-	void BinaryCloner::gatherReferences(IReflectable* object, ObjectReferenceData& referenceData)
+	void BinaryCloner::copyObject(IReflectable* original, IReflectable* clone)
 	{
-		static const UnorderedMap<String, UINT64> dummyParams;
-
-		if (object == nullptr)
-			return;
+		// Base classes are populated first, same as during deserialization. This means serialization callbacks on the
+		// original object also run base class first, while BinarySerializer runs them derived class first. Note: Copying
+		// fields might add more entries to the end of the list, so don't keep references to the elements.
+		UINT32 firstType = (UINT32)mCopiedTypes.size();
 
-		RTTITypeBase* rtti = object->getRTTI();
-		Stack<RTTITypeBase*> rttiTypes;
+		RTTITypeBase* rtti = original->getRTTI();
 		while (rtti != nullptr)
 		{
-			rtti->onSerializationStarted(object, dummyParams);
-			SubObjectReferenceData* subObjectData = nullptr;
+			mCopiedTypes.push_back(rtti);
+			rtti = rtti->getBaseClass();
+		}
 
-			UINT32 numFields = rtti->getNumFields();
-			for (UINT32 i = 0; i < numFields; i++)
+		UINT32 lastType = (UINT32)mCopiedTypes.size();
+		for (UINT32 i = lastType; i > firstType; i--)
+		{
+			RTTITypeBase* curRtti = mCopiedTypes[i - 1];
+
+			curRtti->onSerializationStarted(original, dummyParams);
+			curRtti->onDeserializationStarted(clone, dummyParams);
+
+			copyFields(original, clone, curRtti);
+
+			curRtti->onSerializationEnded(original, dummyParams);
+		}
+
+		for (UINT32 i = lastType; i > firstType; i--)
+			mCopiedTypes[i - 1]->onDeserializationEnded(clone, dummyParams);
+
+		mCopiedTypes.resize(firstType);
+	}
+
+	void BinaryCloner::copyFields(IReflectable* original, IReflectable* clone, RTTITypeBase* rtti)
+	{
+		UINT32 numFields = rtti->getNumFields();
+		for (UINT32 i = 0; i < numFields; i++)
+		{
+			RTTIField* curGenericField = rtti->getField(i);
+
+			if (curGenericField->isArray())
 			{
-				RTTIField* field = rtti->getField(i);
-				FieldId fieldId;
-				fieldId.field = field;
-				fieldId.arrayIdx = -1;
+				UINT32 arrayNumElems = curGenericField->getArraySize(original);
+				curGenericField->setArraySize(clone, arrayNumElems);
 
-				if (field->isArray())
+				switch (curGenericField->mType)
+				{
+				case SerializableFT_ReflectablePtr:
 				{
-					UINT32 numElements = field->getArraySize(object);
+					RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(curGenericField);
+					bool weakRef = (curField->getFlags() & RTTI_Flag_WeakRef) != 0;
 
-					for (UINT32 j = 0; j < numElements; j++)
+					for (UINT32 j = 0; j < arrayNumElems; j++)
 					{
-						fieldId.arrayIdx = j;
-
-						if (field->mType == SerializableFT_ReflectablePtr)
-						{
-							RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(field);
-							SPtr<IReflectable> childObj = curField->getArrayValue(object, j);
-
-							if (childObj != nullptr)
-							{
-								if (subObjectData == nullptr)
-								{
-									referenceData.subObjectData.push_back(SubObjectReferenceData());
-									subObjectData = &referenceData.subObjectData[referenceData.subObjectData.size() - 1];
-									subObjectData->rtti = rtti;
-								}
-
-								subObjectData->references.push_back(ObjectReference());
-								ObjectReference& reference = subObjectData->references.back();
-								reference.fieldId = fieldId;
-								reference.object = childObj;
-							}
-						}
-						else if (field->mType == SerializableFT_Reflectable)
-						{
-							RTTIReflectableFieldBase* curField = static_cast<RTTIReflectableFieldBase*>(field);
-							IReflectable* childObj = &curField->getArrayValue(object, j);
-							
-							if (subObjectData == nullptr)
-							{
-								referenceData.subObjectData.push_back(SubObjectReferenceData());
-								subObjectData = &referenceData.subObjectData[referenceData.subObjectData.size() - 1];
-								subObjectData->rtti = rtti;
-							}
-
-							subObjectData->children.push_back(ObjectReferenceData());
-							ObjectReferenceData& childData = subObjectData->children.back();
-							childData.fieldId = fieldId;
-
-							gatherReferences(childObj, childData);
-						}
+						SPtr<IReflectable> childObject = resolveObject(curField->getArrayValue(original, j), weakRef);
+						curField->setArrayValue(clone, j, childObject);
 					}
+					break;
 				}
-				else
+				case SerializableFT_Reflectable:
 				{
-					if (field->mType == SerializableFT_ReflectablePtr)
+					RTTIReflectableFieldBase* curField = static_cast<RTTIReflectableFieldBase*>(curGenericField);
+
+					for (UINT32 j = 0; j < arrayNumElems; j++)
 					{
-						RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(field);
-						SPtr<IReflectable> childObj = curField->getValue(object);
-
-						if (childObj != nullptr)
-						{
-							if (subObjectData == nullptr)
-							{
-								referenceData.subObjectData.push_back(SubObjectReferenceData());
-								subObjectData = &referenceData.subObjectData[referenceData.subObjectData.size() - 1];
-								subObjectData->rtti = rtti;
-							}
-
-							subObjectData->references.push_back(ObjectReference());
-							ObjectReference& reference = subObjectData->references.back();
-							reference.fieldId = fieldId;
-							reference.object = childObj;
-						}
+						SPtr<IReflectable> childObject = cloneEmbeddedObject(curField->getArrayValue(original, j));
+						curField->setArrayValue(clone, j, *childObject);
 					}
-					else if (field->mType == SerializableFT_Reflectable)
+					break;
+				}
+				case SerializableFT_Plain:
+				{
+					RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
+
+					if (curField->hasBulkAccess())
 					{
-						RTTIReflectableFieldBase* curField = static_cast<RTTIReflectableFieldBase*>(field);
-						IReflectable* childObj = &curField->getValue(object);
+						UINT32 dataSize = arrayNumElems * curField->getTypeSize();
+						if (mFieldBuffer.size() < dataSize)
+							mFieldBuffer.resize(dataSize);
+
+						curField->arrayToBuffer(original, mFieldBuffer.data());
+						curField->arrayFromBuffer(clone, arrayNumElems, mFieldBuffer.data());
+						break;
+					}
 
-						if (subObjectData == nullptr)
-						{
-							referenceData.subObjectData.push_back(SubObjectReferenceData());
-							subObjectData = &referenceData.subObjectData[referenceData.subObjectData.size() - 1];
-							subObjectData->rtti = rtti;
-						}
+					for (UINT32 j = 0; j < arrayNumElems; j++)
+					{
+						UINT32 typeSize = 0;
+						if (curField->hasDynamicSize())
+							typeSize = curField->getArrayElemDynamicSize(original, j);
+						else
+							typeSize = curField->getTypeSize();
 
-						subObjectData->children.push_back(ObjectReferenceData());
-						ObjectReferenceData& childData = subObjectData->children.back();
-						childData.fieldId = fieldId;
+						if (mFieldBuffer.size() < typeSize)
+							mFieldBuffer.resize(typeSize);
 
-						gatherReferences(childObj, childData);
+						curField->arrayElemToBuffer(original, j, mFieldBuffer.data());
+						curField->arrayElemFromBuffer(clone, j, mFieldBuffer.data());
 					}
+					break;
+				}
+				default:
+					BS_EXCEPT(InternalErrorException,
+						"Error cloning data. Encountered a type I don't know how to clone. Type: " + 
+						toString(UINT32(curGenericField->mType)) + ", Is array: " + toString(curGenericField->mIsVectorType));
 				}
 			}
+			else
+			{
+				switch (curGenericField->mType)
+				{
+				case SerializableFT_ReflectablePtr:
+				{
+					RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(curGenericField);
+					bool weakRef = (curField->getFlags() & RTTI_Flag_WeakRef) != 0;
 
-			rttiTypes.push(rtti);
-			rtti = rtti->getBaseClass();
-		}
+					curField->setValue(clone, resolveObject(curField->getValue(original), weakRef));
+					break;
+				}
+				case SerializableFT_Reflectable:
+				{
+					RTTIReflectableFieldBase* curField = static_cast<RTTIReflectableFieldBase*>(curGenericField);
 
-		while (!rttiTypes.empty())
-		{
-			rtti = rttiTypes.top();
-			rttiTypes.pop();
+					SPtr<IReflectable> childObject = cloneEmbeddedObject(curField->getValue(original));
+					curField->setValue(clone, *childObject);
+					break;
+				}
+				case SerializableFT_Plain:
+				{
+					RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
 
-			rtti->onSerializationEnded(object, dummyParams);
-		}
-	}
+					UINT32 typeSize = 0;
+					if (curField->hasDynamicSize())
+						typeSize = curField->getDynamicSize(original);
+					else
+						typeSize = curField->getTypeSize();
 
-	void BinaryCloner::restoreReferences(IReflectable* object, const ObjectReferenceData& referenceData)
-	{
-		static const UnorderedMap<String, UINT64> dummyParams;
+					if (mFieldBuffer.size() < typeSize)
+						mFieldBuffer.resize(typeSize);
 
-		for(auto iter = referenceData.subObjectData.rbegin(); iter != referenceData.subObjectData.rend(); ++iter)
-		{
-			const SubObjectReferenceData& subObject = *iter;
+					curField->toBuffer(original, mFieldBuffer.data());
+					curField->fromBuffer(clone, mFieldBuffer.data());
+					break;
+				}
+				case SerializableFT_DataBlock:
+				{
+					RTTIManagedDataBlockFieldBase* curField = static_cast<RTTIManagedDataBlockFieldBase*>(curGenericField);
 
-			if (subObject.references.size() > 0)
-			{
-				subObject.rtti->onDeserializationStarted(object, dummyParams);
+					UINT32 dataBlockSize = 0;
+					SPtr<DataStream> blockStream = curField->getValue(original, dataBlockSize);
 
-				for (auto& reference : subObject.references)
-				{
-					RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(reference.fieldId.field);
+					// The original stream might reference memory owned by the original object, so make a copy
+					SPtr<MemoryDataStream> clonedStream = bs_shared_ptr_new<MemoryDataStream>(dataBlockSize);
+					if (dataBlockSize > 0)
+						blockStream->read(clonedStream->getPtr(), dataBlockSize);
 
-					if (curField->isArray())
-						curField->setArrayValue(object, reference.fieldId.arrayIdx, reference.object);
-					else
-						curField->setValue(object, reference.object);
+					curField->setValue(clone, clonedStream, dataBlockSize);
+					break;
+				}
+				default:
+					BS_EXCEPT(InternalErrorException,
+						"Error cloning data. Encountered a type I don't know how to clone. Type: " + 
+						toString(UINT32(curGenericField->mType)) + ", Is array: " + toString(curGenericField->mIsVectorType));
 				}
-
-				subObject.rtti->onDeserializationEnded(object, dummyParams);
 			}
 		}
+	}
 
-		for (auto& subObject : referenceData.subObjectData)
-		{
-			if (subObject.children.size() > 0)
-			{
-				subObject.rtti->onSerializationStarted(object, dummyParams);
+	void BinaryCloner::copyObject(ClonedObject& entry)
+	{
+		if (entry.isCopied)
+			return;
 
-				for (auto& childObjectData : subObject.children)
-				{
-					RTTIReflectableFieldBase* curField = static_cast<RTTIReflectableFieldBase*>(childObjectData.fieldId.field);
+		entry.copyInProgress = true;
+		copyObject(entry.original.get(), entry.clone.get());
+		entry.copyInProgress = false;
+		entry.isCopied = true;
+	}
 
-					IReflectable* childObj = nullptr;
-					if (curField->isArray())
-						childObj = &curField->getArrayValue(object, childObjectData.fieldId.arrayIdx);
-					else
-						childObj = &curField->getValue(object);
+	SPtr<IReflectable> BinaryCloner::resolveObject(const SPtr<IReflectable>& original, bool weakRef)
+	{
+		if (original == nullptr)
+			return nullptr;
 
-					restoreReferences(childObj, childObjectData);
-				}
+		// Shallow clones keep referencing the original objects
+		if (mShallow)
+			return original;
+
+		auto iterFind = mClonedObjects.find(original.get());
+		if (iterFind == mClonedObjects.end())
+		{
+			ClonedObject entry;
+			entry.original = original;
+			entry.clone = original->getRTTI()->newRTTIObject();
+			entry.isCopied = false;
+			entry.copyInProgress = false;
+
+			iterFind = mClonedObjects.insert(std::make_pair(original.get(), entry)).first;
+			mPendingObjects.push_back(original.get());
+		}
 
-				subObject.rtti->onSerializationEnded(object, dummyParams);
+		ClonedObject& entry = iterFind->second;
+		if (!weakRef && !entry.isCopied)
+		{
+			if (entry.copyInProgress)
+			{
+				LOGWRN("Detected a circular reference when cloning. Referenced object's fields " \
+					"will be resolved in an undefined order (i.e. one of the objects will not " \
+					"be fully cloned when assigned to its field). Use RTTI_Flag_WeakRef to " \
+					"get rid of this warning and tell the system which of the objects is allowed " \
+					"to be cloned after it is assigned to its field.");
 			}
+			else
+				copyObject(entry);
 		}
+
+		return entry.clone;
+	}
+
+	SPtr<IReflectable> BinaryCloner::cloneEmbeddedObject(IReflectable& original)
+	{
+		SPtr<IReflectable> clonedObj = original.getRTTI()->newRTTIObject();
+		copyObject(&original, clonedObj.get());
+
+		return clonedObj;
 	}
-}
\ No newline at end of file
+}
@@ -41,7 +41,7 @@ buffer += size;															\
 namespace bs
 {
 	BinarySerializer::BinarySerializer()
-		:mLastUsedObjectId(1)
+		:mLastUsedObjectId(1), mDecodeMemStream(nullptr), mDecodeEnd(0)
 	{
 	}
 
@@ -129,11 +129,77 @@ namespace bs
 		if (dataLength == 0)
 			return nullptr;
 
-		SPtr<SerializedObject> intermediateObject = _decodeToIntermediate(data, dataLength);
-		if (intermediateObject == nullptr)
-			return nullptr;
+		mDecodedObjects.clear();
+		mPendingObjects.clear();
+		mDecodedSections.clear();
+
+		mDecodeEnd = data->tell() + dataLength;
+
+		// Field data in memory streams can be passed to the fields directly, without copying
+		if (!data->isFile())
+			mDecodeMemStream = static_cast<MemoryDataStream*>(data.get());
+		else
+			mDecodeMemStream = nullptr;
+
+		// Objects are encoded in the order they are first referenced, but need to be decoded before the objects referencing
+		// them. So find where all the top level objects start first.
+		UINT32 rootObjectId = 0;
+		bool hasMore = true;
+		while (hasMore && data->tell() < mDecodeEnd)
+		{
+			size_t offset = data->tell();
+
+			ObjectMetaData objectMetaData;
+			objectMetaData.objectMeta = 0;
+			objectMetaData.typeId = 0;
+
+			if (data->read(&objectMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
+			{
+				BS_EXCEPT(InternalErrorException, "Error decoding data.");
+			}
+
+			UINT32 objectId = 0;
+			UINT32 objectTypeId = 0;
+			bool objectIsBaseClass = false;
+			decodeObjectMetaData(objectMetaData, objectId, objectTypeId, objectIsBaseClass);
+
+			if (objectIsBaseClass)
+			{
+				BS_EXCEPT(InternalErrorException, "Encountered a base-class object while looking for a new object. " \
+					"Base class objects are only supposed to be parts of a larger object.");
+			}
+
+			if (mDecodedObjects.empty())
+				rootObjectId = objectId;
+
+			DecodedObject& entry = mDecodedObjects[objectId];
+			entry.offset = offset;
+			entry.rtti = IReflectable::_getRTTIfromTypeId(objectTypeId);
+
+			hasMore = skipObject(data);
+		}
+
+		SPtr<IReflectable> output;
+
+		DecodedObject& root = mDecodedObjects[rootObjectId];
+		if (root.rtti != nullptr)
+		{
+			root.object = root.rtti->newRTTIObject();
+			decodeObject(data, root);
 
-		return _decodeFromIntermediate(intermediateObject);
+			output = root.object;
+		}
+
+		// Decode the remaining objects (should be only ones referenced through weak refs)
+		for (UINT32 i = 0; i < (UINT32)mPendingObjects.size(); i++)
+			decodeObject(data, mDecodedObjects[mPendingObjects[i]]);
+
+		mDecodedObjects.clear();
+		mPendingObjects.clear();
+		mDecodeMemStream = nullptr;
+
+		data->seek(mDecodeEnd);
+		return output;
 	}
 
 	SPtr<IReflectable> BinarySerializer::_decodeFromIntermediate(const SPtr<SerializedObject>& serializedObject)
@@ -289,6 +355,36 @@ namespace bs
 						{
 							RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
 
+							if(curField->hasBulkAccess())
+							{
+								// Elements are stored contiguously in the same format as they are serialized in, so 
+								// the entire array can be copied at once
+								UINT32 dataSize = arrayNumElems * curField->getTypeSize();
+
+								if ((*bytesWritten + dataSize) > bufferLength)
+								{
+									UINT8* tempBuffer = (UINT8*)bs_alloc(dataSize);
+									curField->arrayToBuffer(object, tempBuffer);
+
+									buffer = dataBlockToBuffer(tempBuffer, dataSize, buffer, bufferLength, bytesWritten, flushBufferCallback);
+									bs_free(tempBuffer);
+
+									if (buffer == nullptr || bufferLength == 0)
+									{
+										si->onSerializationEnded(object, mParams);
+										return nullptr;
+									}
+								}
+								else
+								{
+									curField->arrayToBuffer(object, buffer);
+									buffer += dataSize;
+									*bytesWritten += dataSize;
+								}
+
+								break;
+							}
+
 							for(UINT32 arrIdx = 0; arrIdx < arrayNumElems; arrIdx++)
 							{
 								UINT32 typeSize = 0;
@@ -565,26 +661,7 @@ namespace bs
 				curGenericField = rtti->findField(fieldId);
 
 			if (curGenericField != nullptr)
-			{
-				if (!hasDynamicSize && curGenericField->getTypeSize() != fieldSize)
-				{
-					BS_EXCEPT(InternalErrorException,
-						"Data type mismatch. Type size stored in file and actual type size don't match. ("
-						+ toString(curGenericField->getTypeSize()) + " vs. " + toString(fieldSize) + ")");
-				}
-
-				if (curGenericField->mIsVectorType != isArray)
-				{
-					BS_EXCEPT(InternalErrorException,
-						"Data type mismatch. One is array, other is a single type.");
-				}
-
-				if (curGenericField->mType != fieldType)
-				{
-					BS_EXCEPT(InternalErrorException,
-						"Data type mismatch. Field types don't match. " + toString(UINT32(curGenericField->mType)) + " vs. " + toString(UINT32(fieldType)));
-				}
-			}
+				checkFieldType(curGenericField, fieldSize, isArray, fieldType, hasDynamicSize);
 
 			SPtr<SerializedInstance> serializedEntry;
 			bool hasModification = false;
@@ -1115,6 +1192,473 @@ namespace bs
 		}
 	}
 
+	void BinarySerializer::decodeObject(const SPtr<DataStream>& data, DecodedObject& entry)
+	{
+		if (entry.isDecoded)
+			return;
+
+		size_t offset = data->tell();
+		data->seek(entry.offset + sizeof(ObjectMetaData));
+
+		entry.decodeInProgress = true;
+		decodeObject(data, entry.object.get(), entry.rtti);
+		entry.decodeInProgress = false;
+		entry.isDecoded = true;
+
+		data->seek(offset);
+	}
+
+	void BinarySerializer::decodeObject(const SPtr<DataStream>& data, IReflectable* object, RTTITypeBase* rtti)
+	{
+		// Data of the most derived class is stored first, followed by its base classes. Base classes need to be decoded
+		// first, so find where all the sections start before decoding.
+		UINT32 firstSection = (UINT32)mDecodedSections.size();
+		mDecodedSections.push_back({ rtti, data->tell() });
+
+		skipObject(data, rtti);
+		size_t endOffset = data->tell();
+
+		// Note: Decoding fields might add more sections to the end of the list, so don't keep references to the elements
+		UINT32 lastSection = (UINT32)mDecodedSections.size();
+		for (UINT32 i = lastSection; i > firstSection; i--)
+		{
+			DecodedSection section = mDecodedSections[i - 1];
+
+			section.rtti->onDeserializationStarted(object, mParams);
+
+			data->seek(section.offset);
+			decodeFields(data, object, section.rtti);
+		}
+
+		for (UINT32 i = lastSection; i > firstSection; i--)
+			mDecodedSections[i - 1].rtti->onDeserializationEnded(object, mParams);
+
+		mDecodedSections.resize(firstSection);
+		data->seek(endOffset);
+	}
+
+	void BinarySerializer::decodeFields(const SPtr<DataStream>& data, IReflectable* object, RTTITypeBase* rtti)
+	{
+		while (data->tell() < mDecodeEnd)
+		{
+			UINT32 metaData = 0;
+			if (data->read(&metaData, META_SIZE) != META_SIZE)
+			{
+				BS_EXCEPT(InternalErrorException, "Error decoding data.");
+			}
+
+			// Reached a base class, or the next object
+			if (isObjectMetaData(metaData))
+				return;
+
+			bool isArray;
+			SerializableFieldType fieldType;
+			UINT16 fieldId;
+			UINT8 fieldSize;
+			bool hasDynamicSize;
+			bool terminator;
+			decodeFieldMetaData(metaData, fieldId, fieldSize, isArray, fieldType, hasDynamicSize, terminator);
+
+			if (terminator)
+				return;
+
+			RTTIField* curGenericField = rtti->findField(fieldId);
+			if (curGenericField == nullptr)
+			{
+				skipField(data, fieldType, isArray, fieldSize, hasDynamicSize);
+				continue;
+			}
+
+			checkFieldType(curGenericField, fieldSize, isArray, fieldType, hasDynamicSize);
+
+			if (isArray)
+			{
+				UINT32 arrayNumElems = 0;
+				if (data->read(&arrayNumElems, NUM_ELEM_FIELD_SIZE) != NUM_ELEM_FIELD_SIZE)
+				{
+					BS_EXCEPT(InternalErrorException, "Error decoding data.");
+				}
+
+				curGenericField->setArraySize(object, arrayNumElems);
+
+				switch (fieldType)
+				{
+				case SerializableFT_ReflectablePtr:
+				{
+					RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(curGenericField);
+					bool weakRef = (curField->getFlags() & RTTI_Flag_WeakRef) != 0;
+
+					for (UINT32 i = 0; i < arrayNumElems; i++)
+					{
+						UINT32 childObjectId = 0;
+						if (data->read(&childObjectId, COMPLEX_TYPE_FIELD_SIZE) != COMPLEX_TYPE_FIELD_SIZE)
+						{
+							BS_EXCEPT(InternalErrorException, "Error decoding data.");
+						}
+
+						curField->setArrayValue(object, i, resolveObject(data, childObjectId, weakRef));
+					}
+					break;
+				}
+				case SerializableFT_Reflectable:
+				{
+					RTTIReflectableFieldBase* curField = static_cast<RTTIReflectableFieldBase*>(curGenericField);
+
+					for (UINT32 i = 0; i < arrayNumElems; i++)
+					{
+						SPtr<IReflectable> childObject = decodeEmbeddedObject(data);
+						if (childObject != nullptr)
+							curField->setArrayValue(object, i, *childObject);
+					}
+					break;
+				}
+				case SerializableFT_Plain:
+				{
+					RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
+
+					if (curField->hasBulkAccess() && !hasDynamicSize)
+					{
+						UINT64 dataSize = (UINT64)arrayNumElems * fieldSize;
+						if (dataSize > mDecodeEnd - data->tell())
+						{
+							BS_EXCEPT(InternalErrorException, "Error decoding data.");
+						}
+
+						curField->arrayFromBuffer(object, arrayNumElems, readFieldData(data, (UINT32)dataSize));
+						break;
+					}
+
+					for (UINT32 i = 0; i < arrayNumElems; i++)
+					{
+						UINT32 typeSize = fieldSize;
+						if (hasDynamicSize)
+						{
+							data->read(&typeSize, sizeof(UINT32));
+							data->seek(data->tell() - sizeof(UINT32));
+						}
+
+						curField->arrayElemFromBuffer(object, i, readFieldData(data, typeSize));
+					}
+					break;
+				}
+				default:
+					BS_EXCEPT(InternalErrorException,
+						"Error decoding data. Encountered a type I don't know how to decode. Type: " + toString(UINT32(fieldType)) +
+						", Is array: " + toString(isArray));
+				}
+			}
+			else
+			{
+				switch (fieldType)
+				{
+				case SerializableFT_ReflectablePtr:
+				{
+					RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(curGenericField);
+					bool weakRef = (curField->getFlags() & RTTI_Flag_WeakRef) != 0;
+
+					UINT32 childObjectId = 0;
+					if (data->read(&childObjectId, COMPLEX_TYPE_FIELD_SIZE) != COMPLEX_TYPE_FIELD_SIZE)
+					{
+						BS_EXCEPT(InternalErrorException, "Error decoding data.");
+					}
+
+					curField->setValue(object, resolveObject(data, childObjectId, weakRef));
+					break;
+				}
+				case SerializableFT_Reflectable:
+				{
+					RTTIReflectableFieldBase* curField = static_cast<RTTIReflectableFieldBase*>(curGenericField);
+
+					SPtr<IReflectable> childObject = decodeEmbeddedObject(data);
+					if (childObject != nullptr)
+						curField->setValue(object, *childObject);
+
+					break;
+				}
+				case SerializableFT_Plain:
+				{
+					RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
+
+					UINT32 typeSize = fieldSize;
+					if (hasDynamicSize)
+					{
+						data->read(&typeSize, sizeof(UINT32));
+						data->seek(data->tell() - sizeof(UINT32));
+					}
+
+					curField->fromBuffer(object, readFieldData(data, typeSize));
+					break;
+				}
+				case SerializableFT_DataBlock:
+				{
+					RTTIManagedDataBlockFieldBase* curField = static_cast<RTTIManagedDataBlockFieldBase*>(curGenericField);
+
+					UINT32 dataBlockSize = 0;
+					if (data->read(&dataBlockSize, DATA_BLOCK_TYPE_FIELD_SIZE) != DATA_BLOCK_TYPE_FIELD_SIZE ||
+						dataBlockSize > mDecodeEnd - data->tell())
+					{
+						BS_EXCEPT(InternalErrorException, "Error decoding data.");
+					}
+
+					// The field reads the data from the source stream, either now or later if it keeps the stream
+					size_t dataBlockOffset = data->tell();
+					curField->setValue(object, data, dataBlockSize);
+
+					data->seek(dataBlockOffset + dataBlockSize);
+					break;
+				}
+				default:
+					BS_EXCEPT(InternalErrorException,
+						"Error decoding data. Encountered a type I don't know how to decode. Type: " + toString(UINT32(fieldType)) +
+						", Is array: " + toString(isArray));
+				}
+			}
+		}
+	}
+
+	SPtr<IReflectable> BinarySerializer::decodeEmbeddedObject(const SPtr<DataStream>& data)
+	{
+		ObjectMetaData objectMetaData;
+		objectMetaData.objectMeta = 0;
+		objectMetaData.typeId = 0;
+
+		if (data->read(&objectMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
+		{
+			BS_EXCEPT(InternalErrorException, "Error decoding data.");
+		}
+
+		UINT32 objectId = 0;
+		UINT32 objectTypeId = 0;
+		bool objectIsBaseClass = false;
+		decodeObjectMetaData(objectMetaData, objectId, objectTypeId, objectIsBaseClass);
+
+		if (objectIsBaseClass)
+		{
+			BS_EXCEPT(InternalErrorException, "Encountered a base-class object while looking for a new object. " \
+				"Base class objects are only supposed to be parts of a larger object.");
+		}
+
+		RTTITypeBase* rtti = IReflectable::_getRTTIfromTypeId(objectTypeId);
+		if (rtti == nullptr)
+		{
+			skipObject(data);
+			return nullptr;
+		}
+
+		SPtr<IReflectable> object = rtti->newRTTIObject();
+		decodeObject(data, object.get(), rtti);
+
+		return object;
+	}
+
+	SPtr<IReflectable> BinarySerializer::resolveObject(const SPtr<DataStream>& data, UINT32 objectId, bool weakRef)
+	{
+		if (objectId == 0)
+			return nullptr;
+
+		auto iterFind = mDecodedObjects.find(objectId);
+		if (iterFind == mDecodedObjects.end() || iterFind->second.rtti == nullptr)
+			return nullptr;
+
+		DecodedObject& entry = iterFind->second;
+		if (entry.object == nullptr)
+		{
+			entry.object = entry.rtti->newRTTIObject();
+			mPendingObjects.push_back(objectId);
+		}
+
+		if (!weakRef && !entry.isDecoded)
+		{
+			if (entry.decodeInProgress)
+			{
+				LOGWRN("Detected a circular reference when decoding. Referenced object's fields " \
+					"will be resolved in an undefined order (i.e. one of the objects will not " \
+					"be fully deserialized when assigned to its field). Use RTTI_Flag_WeakRef to " \
+					"get rid of this warning and tell the system which of the objects is allowed " \
+					"to be deserialized after it is assigned to its field.");
+			}
+			else
+				decodeObject(data, entry);
+		}
+
+		return entry.object;
+	}
+
+	bool BinarySerializer::skipObject(const SPtr<DataStream>& data, RTTITypeBase* rtti)
+	{
+		while (data->tell() < mDecodeEnd)
+		{
+			UINT32 metaData = 0;
+			if (data->read(&metaData, META_SIZE) != META_SIZE)
+			{
+				BS_EXCEPT(InternalErrorException, "Error decoding data.");
+			}
+
+			if (isObjectMetaData(metaData))
+			{
+				ObjectMetaData objMetaData;
+				objMetaData.objectMeta = 0;
+				objMetaData.typeId = 0;
+
+				data->seek(data->tell() - META_SIZE);
+				if (data->read(&objMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
+				{
+					BS_EXCEPT(InternalErrorException, "Error decoding data.");
+				}
+
+				UINT32 objId = 0;
+				UINT32 objTypeId = 0;
+				bool objIsBaseClass = false;
+				decodeObjectMetaData(objMetaData, objId, objTypeId, objIsBaseClass);
+
+				// Found new object, we're done
+				if (!objIsBaseClass)
+				{
+					data->seek(data->tell() - sizeof(ObjectMetaData));
+					return true;
+				}
+
+				// Saved and current base classes don't match, so ignore all the base class data
+				if (rtti != nullptr)
+				{
+					rtti = rtti->getBaseClass();
+
+					if (rtti != nullptr && rtti->getRTTIId() == objTypeId)
+						mDecodedSections.push_back({ rtti, data->tell() });
+					else
+						rtti = nullptr;
+				}
+
+				continue;
+			}
+
+			bool isArray;
+			SerializableFieldType fieldType;
+			UINT16 fieldId;
+			UINT8 fieldSize;
+			bool hasDynamicSize;
+			bool terminator;
+			decodeFieldMetaData(metaData, fieldId, fieldSize, isArray, fieldType, hasDynamicSize, terminator);
+
+			if (terminator)
+				return false;
+
+			skipField(data, fieldType, isArray, fieldSize, hasDynamicSize);
+		}
+
+		return false;
+	}
+
+	void BinarySerializer::skipField(const SPtr<DataStream>& data, SerializableFieldType type, bool isArray, 
+		UINT32 fieldSize, bool hasDynamicSize)
+	{
+		UINT32 numElements = 1;
+		if (isArray)
+		{
+			if (data->read(&numElements, NUM_ELEM_FIELD_SIZE) != NUM_ELEM_FIELD_SIZE)
+			{
+				BS_EXCEPT(InternalErrorException, "Error decoding data.");
+			}
+		}
+
+		switch (type)
+		{
+		case SerializableFT_ReflectablePtr:
+			data->skip(numElements * COMPLEX_TYPE_FIELD_SIZE);
+			break;
+		case SerializableFT_Reflectable:
+			for (UINT32 i = 0; i < numElements; i++)
+			{
+				ObjectMetaData objectMetaData;
+				if (data->read(&objectMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
+				{
+					BS_EXCEPT(InternalErrorException, "Error decoding data.");
+				}
+
+				skipObject(data);
+			}
+			break;
+		case SerializableFT_Plain:
+			if (hasDynamicSize)
+			{
+				for (UINT32 i = 0; i < numElements; i++)
+				{
+					UINT32 typeSize = 0;
+					data->read(&typeSize, sizeof(UINT32));
+					data->seek(data->tell() - sizeof(UINT32));
+
+					data->skip(typeSize);
+				}
+			}
+			else
+				data->skip(numElements * fieldSize);
+			break;
+		case SerializableFT_DataBlock:
+			if (!isArray)
+			{
+				UINT32 dataBlockSize = 0;
+				if (data->read(&dataBlockSize, DATA_BLOCK_TYPE_FIELD_SIZE) != DATA_BLOCK_TYPE_FIELD_SIZE)
+				{
+					BS_EXCEPT(InternalErrorException, "Error decoding data.");
+				}
+
+				data->skip(dataBlockSize);
+				break;
+			}
+
+			// Arrays of data blocks aren't supported, fall through
+		default:
+			BS_EXCEPT(InternalErrorException,
+				"Error decoding data. Encountered a type I don't know how to decode. Type: " + toString(UINT32(type)) +
+				", Is array: " + toString(isArray));
+		}
+	}
+
+	UINT8* BinarySerializer::readFieldData(const SPtr<DataStream>& data, UINT32 size)
+	{
+		if (size > mDecodeEnd - data->tell())
+		{
+			BS_EXCEPT(InternalErrorException, "Error decoding data.");
+		}
+
+		if (mDecodeMemStream != nullptr)
+		{
+			UINT8* fieldData = mDecodeMemStream->getCurrentPtr();
+			data->skip(size);
+
+			return fieldData;
+		}
+
+		if (mFieldBuffer.size() < size)
+			mFieldBuffer.resize(size);
+
+		data->read(mFieldBuffer.data(), size);
+		return mFieldBuffer.data();
+	}
+
+	void BinarySerializer::checkFieldType(RTTIField* field, UINT8 fieldSize, bool isArray, 
+		SerializableFieldType fieldType, bool hasDynamicSize)
+	{
+		if (!hasDynamicSize && field->getTypeSize() != fieldSize)
+		{
+			BS_EXCEPT(InternalErrorException,
+				"Data type mismatch. Type size stored in file and actual type size don't match. ("
+				+ toString(field->getTypeSize()) + " vs. " + toString(fieldSize) + ")");
+		}
+
+		if (field->mIsVectorType != isArray)
+		{
+			BS_EXCEPT(InternalErrorException,
+				"Data type mismatch. One is array, other is a single type.");
+		}
+
+		if (field->mType != fieldType)
+		{
+			BS_EXCEPT(InternalErrorException,
+				"Data type mismatch. Field types don't match. " + toString(UINT32(field->mType)) + " vs. " + toString(UINT32(fieldType)));
+		}
+	}
+
 	UINT32 BinarySerializer::encodeFieldMetaData(UINT16 id, UINT8 size, bool array, 
 		SerializableFieldType type, bool hasDynamicSize, bool terminator)
 	{
@@ -2,6 +2,7 @@
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "BsCompression.h"
 #include "BsDataStream.h"
+#include "BsTaskScheduler.h"
 
 // Third party
 #include "snappy.h"
@@ -166,6 +167,31 @@ namespace bs
 		Vector<BufferPiece> mBufferPieces;
 	};
 
+	/** Identifies data compressed with Compression::compressChunked(). */
+	static const UINT32 CHUNKED_MAGIC = 0x43435342; // "BSCC"
+
+	/** Maximum number of chunks read from a file stream at once, when compressing. */
+	static const UINT32 CHUNKED_BATCH_SIZE = 64;
+
+	/** Executes the worker for every chunk in range [begin, end), in parallel if the task scheduler is running. */
+	static void forEachChunk(UINT32 begin, UINT32 end, const std::function<void(UINT32)>& worker)
+	{
+		if ((end - begin) > 1 && TaskScheduler::isStarted())
+		{
+			TaskScheduler::instance().parallelFor("Compression", begin, end, 1, 
+				[&worker](UINT32 chunkBegin, UINT32 chunkEnd)
+			{
+				for (UINT32 i = chunkBegin; i < chunkEnd; i++)
+					worker(i);
+			});
+		}
+		else
+		{
+			for (UINT32 i = begin; i < end; i++)
+				worker(i);
+		}
+	}
+
 	SPtr<MemoryDataStream> Compression::compress(SPtr<DataStream>& input)
 	{
 		DataStreamSource src(input);
@@ -191,4 +217,288 @@ namespace bs
 
 		return dst.GetOutput();
 	}
+
+	SPtr<MemoryDataStream> Compression::compressChunked(const SPtr<DataStream>& input, UINT32 chunkSize)
+	{
+		assert(chunkSize > 0);
+
+		struct CompressedChunk
+		{
+			char* data = nullptr;
+			size_t size = 0;
+		};
+
+		UINT64 size = input->size() - input->tell();
+
+		// Decompressed data must fit into a single allocation
+		if (size > std::numeric_limits<UINT32>::max())
+		{
+			LOGERR("Compression failed, input data too large.");
+			return nullptr;
+		}
+
+		UINT32 numChunks = (UINT32)((size + chunkSize - 1) / chunkSize);
+
+		Vector<CompressedChunk> chunks(numChunks);
+
+		// Memory streams are compressed in place, while file streams are read a batch of chunks at a time
+		UINT32 batchSize = numChunks;
+		UINT8* inputData = nullptr;
+		UINT8* readBuffer = nullptr;
+		if (input->isFile())
+		{
+			batchSize = std::min(numChunks, CHUNKED_BATCH_SIZE);
+			readBuffer = (UINT8*)bs_alloc(batchSize * chunkSize);
+		}
+		else
+			inputData = std::static_pointer_cast<MemoryDataStream>(input)->getCurrentPtr();
+
+		for (UINT32 batchStart = 0; batchStart < numChunks; batchStart += batchSize)
+		{
+			UINT32 batchEnd = std::min(batchStart + batchSize, numChunks);
+			UINT64 batchOffset = (UINT64)batchStart * chunkSize;
+
+			if (readBuffer != nullptr)
+			{
+				UINT64 batchBytes = std::min((UINT64)batchEnd * chunkSize, size) - batchOffset;
+				input->read(readBuffer, (size_t)batchBytes);
+			}
+
+			forEachChunk(batchStart, batchEnd, [&](UINT32 idx)
+			{
+				UINT64 offset = (UINT64)idx * chunkSize;
+				size_t length = (size_t)std::min((UINT64)chunkSize, size - offset);
+
+				const char* source;
+				if (readBuffer != nullptr)
+					source = (const char*)readBuffer + (offset - batchOffset);
+				else
+					source = (const char*)inputData + offset;
+
+				CompressedChunk& chunk = chunks[idx];
+				chunk.data = (char*)bs_alloc((UINT32)snappy::MaxCompressedLength(length));
+				snappy::RawCompress(source, length, chunk.data, &chunk.size);
+			});
+		}
+
+		if (readBuffer != nullptr)
+			bs_free(readBuffer);
+		else
+			input->skip((size_t)size);
+
+		// Output the header, followed by the chunk index and then by the chunks
+		size_t outputSize = sizeof(UINT32) * 3 + sizeof(UINT64) + numChunks * sizeof(UINT32);
+		for (auto& chunk : chunks)
+			outputSize += chunk.size;
+
+		if (outputSize > std::numeric_limits<UINT32>::max())
+		{
+			for (auto& chunk : chunks)
+				bs_free(chunk.data);
+
+			LOGERR("Compression failed, output data too large.");
+			return nullptr;
+		}
+
+		UINT8* outputData = (UINT8*)bs_alloc((UINT32)outputSize);
+		SPtr<MemoryDataStream> output = bs_shared_ptr_new<MemoryDataStream>(outputData, outputSize);
+
+		output->write(&CHUNKED_MAGIC, sizeof(CHUNKED_MAGIC));
+		output->write(&chunkSize, sizeof(chunkSize));
+		output->write(&numChunks, sizeof(numChunks));
+		output->write(&size, sizeof(size));
+
+		for (auto& chunk : chunks)
+		{
+			UINT32 compressedSize = (UINT32)chunk.size;
+			output->write(&compressedSize, sizeof(compressedSize));
+		}
+
+		for (auto& chunk : chunks)
+		{
+			output->write(chunk.data, chunk.size);
+			bs_free(chunk.data);
+		}
+
+		output->seek(0);
+		return output;
+	}
+
+	SPtr<MemoryDataStream> Compression::decompressChunked(const SPtr<DataStream>& input)
+	{
+		CompressedChunkReader reader(input);
+		if (!reader.isValid())
+		{
+			LOGERR("Decompression failed, corrupt data.");
+			return nullptr;
+		}
+
+		UINT64 size = reader.getSize();
+		UINT32 chunkSize = reader.getChunkSize();
+
+		UINT8* outputData = (UINT8*)bs_alloc((UINT32)size);
+
+		std::atomic<bool> failed(false);
+		forEachChunk(0, reader.getNumChunks(), [&](UINT32 idx)
+		{
+			if (!reader.readChunk(idx, outputData + (size_t)idx * chunkSize))
+				failed = true;
+		});
+
+		if (failed)
+		{
+			bs_free(outputData);
+
+			LOGERR("Decompression failed, corrupt data.");
+			return nullptr;
+		}
+
+		input->seek(reader.getEndOffset());
+		return bs_shared_ptr_new<MemoryDataStream>(outputData, (size_t)size);
+	}
+
+	CompressedChunkReader::CompressedChunkReader(const SPtr<DataStream>& input)
+		:mInput(input)
+	{
+		UINT32 magic = 0;
+		UINT32 numChunks = 0;
+		if (input->read(&magic, sizeof(magic)) != sizeof(magic) || magic != CHUNKED_MAGIC)
+			return;
+
+		if (input->read(&mChunkSize, sizeof(mChunkSize)) != sizeof(mChunkSize) ||
+			input->read(&numChunks, sizeof(numChunks)) != sizeof(numChunks) ||
+			input->read(&mSize, sizeof(mSize)) != sizeof(mSize))
+			return;
+
+		if (mChunkSize == 0 || numChunks != (mSize + mChunkSize - 1) / mChunkSize)
+			return;
+
+		// Decompressed data must fit into a single allocation (see Compression::compressChunked())
+		if (mSize > std::numeric_limits<UINT32>::max())
+			return;
+
+		size_t indexSize = numChunks * sizeof(UINT32);
+		if (indexSize > input->size() - input->tell())
+			return;
+
+		Vector<UINT32> compressedSizes(numChunks);
+		if (numChunks > 0 && input->read(compressedSizes.data(), indexSize) != indexSize)
+			return;
+
+		size_t offset = input->tell();
+
+		mChunks.resize(numChunks);
+		for (UINT32 i = 0; i < numChunks; i++)
+		{
+			mChunks[i].offset = offset;
+			mChunks[i].compressedSize = compressedSizes[i];
+
+			offset += compressedSizes[i];
+		}
+
+		if (offset > input->size())
+			return;
+
+		mEndOffset = offset;
+		mIsValid = true;
+	}
+
+	UINT32 CompressedChunkReader::getChunkSize(UINT32 idx) const
+	{
+		UINT64 offset = (UINT64)idx * mChunkSize;
+		return (UINT32)std::min((UINT64)mChunkSize, mSize - offset);
+	}
+
+	bool CompressedChunkReader::readChunk(UINT32 idx, UINT8* output) const
+	{
+		if (!mIsValid || idx >= (UINT32)mChunks.size())
+			return false;
+
+		const Chunk& chunk = mChunks[idx];
+
+		const char* compressedData;
+		char* readBuffer = nullptr;
+		if (!mInput->isFile())
+		{
+			SPtr<MemoryDataStream> memStream = std::static_pointer_cast<MemoryDataStream>(mInput);
+			compressedData = (const char*)memStream->getPtr() + chunk.offset;
+		}
+		else
+		{
+			readBuffer = (char*)bs_alloc(chunk.compressedSize);
+
+			Lock lock(mReadMutex);
+			mInput->seek(chunk.offset);
+			if (mInput->read(readBuffer, chunk.compressedSize) != chunk.compressedSize)
+			{
+				bs_free(readBuffer);
+				return false;
+			}
+
+			compressedData = readBuffer;
+		}
+
+		size_t uncompressedSize = 0;
+		bool success = snappy::GetUncompressedLength(compressedData, chunk.compressedSize, &uncompressedSize) &&
+			uncompressedSize == getChunkSize(idx) &&
+			snappy::RawUncompress(compressedData, chunk.compressedSize, (char*)output);
+
+		if (readBuffer != nullptr)
+			bs_free(readBuffer);
+
+		return success;
+	}
+
+	bool CompressedChunkReader::read(UINT64 offset, UINT64 size, UINT8* output) const
+	{
+		if (!mIsValid || offset > mSize || size > mSize - offset)
+			return false;
+
+		if (size == 0)
+			return true;
+
+		UINT32 firstChunk = (UINT32)(offset / mChunkSize);
+		UINT32 lastChunk = (UINT32)((offset + size - 1) / mChunkSize);
+
+		UINT8* chunkBuffer = nullptr;
+		for (UINT32 i = firstChunk; i <= lastChunk; i++)
+		{
+			UINT64 chunkStart = (UINT64)i * mChunkSize;
+			UINT32 chunkSize = getChunkSize(i);
+
+			UINT64 readStart = std::max(offset, chunkStart);
+			UINT64 readEnd = std::min(offset + size, chunkStart + chunkSize);
+			UINT8* dst = output + (readStart - offset);
+
+			// Decompress directly to the output if the whole chunk is requested, otherwise go through a temporary buffer
+			if (readStart == chunkStart && readEnd == chunkStart + chunkSize)
+			{
+				if (!readChunk(i, dst))
+				{
+					if (chunkBuffer != nullptr)
+						bs_free(chunkBuffer);
+
+					return false;
+				}
+			}
+			else
+			{
+				if (chunkBuffer == nullptr)
+					chunkBuffer = (UINT8*)bs_alloc(mChunkSize);
+
+				if (!readChunk(i, chunkBuffer))
+				{
+					bs_free(chunkBuffer);
+					return false;
+				}
+
+				memcpy(dst, chunkBuffer + (readStart - chunkStart), (size_t)(readEnd - readStart));
+			}
+		}
+
+		if (chunkBuffer != nullptr)
+			bs_free(chunkBuffer);
+
+		return true;
+	}
 }
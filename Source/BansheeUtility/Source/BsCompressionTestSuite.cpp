@@ -0,0 +1,147 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsCompressionTestSuite.h"
+
+#include "BsCompression.h"
+#include "BsDataStream.h"
+
+namespace bs
+{
+	/** Chunk size used by the tests, small enough for the data to span multiple chunks. */
+	static const UINT32 TEST_CHUNK_SIZE = 1024;
+
+	/** Creates a memory stream with a repeatable pattern of bytes that compresses reasonably, but not trivially. */
+	static SPtr<MemoryDataStream> createTestData(UINT32 size)
+	{
+		UINT8* data = (UINT8*)bs_alloc(std::max(size, 1U));
+		for (UINT32 i = 0; i < size; i++)
+			data[i] = (UINT8)((i * 31) ^ (i >> 7));
+
+		return bs_shared_ptr_new<MemoryDataStream>(data, size);
+	}
+
+	CompressionTestSuite::CompressionTestSuite()
+	{
+		BS_ADD_TEST(CompressionTestSuite::testChunkedRoundTrip);
+		BS_ADD_TEST(CompressionTestSuite::testChunkedRandomAccess);
+		BS_ADD_TEST(CompressionTestSuite::testChunkedCorruptData);
+		BS_ADD_TEST(CompressionTestSuite::testChunkedOversizedHeader);
+	}
+
+	void CompressionTestSuite::testChunkedRoundTrip()
+	{
+		UINT32 sizes[] = { 0, 1, TEST_CHUNK_SIZE - 1, TEST_CHUNK_SIZE, TEST_CHUNK_SIZE * 3 + 17 };
+		for (auto& size : sizes)
+		{
+			SPtr<MemoryDataStream> source = createTestData(size);
+			SPtr<MemoryDataStream> compressed = Compression::compressChunked(source, TEST_CHUNK_SIZE);
+
+			// Entire input must be consumed
+			BS_TEST_ASSERT(source->eof());
+
+			SPtr<MemoryDataStream> decompressed = Compression::decompressChunked(compressed);
+			BS_TEST_ASSERT(decompressed != nullptr);
+			if (decompressed == nullptr)
+				continue;
+
+			BS_TEST_ASSERT(decompressed->size() == size);
+			BS_TEST_ASSERT(memcmp(decompressed->getPtr(), source->getPtr(), size) == 0);
+
+			// Input must be left positioned after the compressed data
+			BS_TEST_ASSERT(compressed->eof());
+		}
+	}
+
+	void CompressionTestSuite::testChunkedRandomAccess()
+	{
+		UINT32 size = TEST_CHUNK_SIZE * 5 + 100;
+		SPtr<MemoryDataStream> source = createTestData(size);
+		SPtr<MemoryDataStream> compressed = Compression::compressChunked(source, TEST_CHUNK_SIZE);
+
+		CompressedChunkReader reader(compressed);
+		BS_TEST_ASSERT(reader.isValid());
+		BS_TEST_ASSERT(reader.getSize() == size);
+		BS_TEST_ASSERT(reader.getNumChunks() == 6);
+		BS_TEST_ASSERT(reader.getChunkSize(5) == 100);
+
+		Vector<UINT8> output(TEST_CHUNK_SIZE * 3);
+
+		// Single whole chunk
+		BS_TEST_ASSERT(reader.readChunk(2, output.data()));
+		BS_TEST_ASSERT(memcmp(output.data(), source->getPtr() + TEST_CHUNK_SIZE * 2, TEST_CHUNK_SIZE) == 0);
+
+		// Range within a single chunk, range spanning chunk boundaries, and range ending at the end of the data
+		UINT64 ranges[][2] =
+		{
+			{ 10, 20 },
+			{ TEST_CHUNK_SIZE - 5, TEST_CHUNK_SIZE * 2 + 10 },
+			{ size - 150, 150 }
+		};
+
+		for (auto& range : ranges)
+		{
+			BS_TEST_ASSERT(reader.read(range[0], range[1], output.data()));
+			BS_TEST_ASSERT(memcmp(output.data(), source->getPtr() + range[0], (size_t)range[1]) == 0);
+		}
+
+		// Out of bounds
+		BS_TEST_ASSERT(!reader.read(size - 1, 2, output.data()));
+		BS_TEST_ASSERT(!reader.readChunk(6, output.data()));
+	}
+
+	void CompressionTestSuite::testChunkedCorruptData()
+	{
+		// Not chunked data at all
+		SPtr<MemoryDataStream> source = createTestData(TEST_CHUNK_SIZE * 2);
+		BS_TEST_ASSERT(!CompressedChunkReader(source).isValid());
+
+		source->seek(0);
+		SPtr<MemoryDataStream> compressed = Compression::compressChunked(source, TEST_CHUNK_SIZE);
+
+		// Truncated data
+		SPtr<MemoryDataStream> truncated = bs_shared_ptr_new<MemoryDataStream>(compressed->getPtr(), 
+			compressed->size() - 1, false);
+		BS_TEST_ASSERT(Compression::decompressChunked(truncated) == nullptr);
+
+		// Corrupt chunk index, causing chunk sizes not to match
+		UINT32 firstChunkSizeOffset = sizeof(UINT32) * 3 + sizeof(UINT64);
+		UINT32* firstChunkSize = (UINT32*)(compressed->getPtr() + firstChunkSizeOffset);
+		(*firstChunkSize)--;
+
+		BS_TEST_ASSERT(Compression::decompressChunked(compressed) == nullptr);
+	}
+
+	void CompressionTestSuite::testChunkedOversizedHeader()
+	{
+		// Borrow the magic number from valid chunked data
+		SPtr<MemoryDataStream> source = createTestData(TEST_CHUNK_SIZE);
+		SPtr<MemoryDataStream> compressed = Compression::compressChunked(source, TEST_CHUNK_SIZE);
+
+		UINT32 magic = 0;
+		compressed->read(&magic, sizeof(magic));
+
+		// Header claiming 5 GB of uncompressed data, with a consistent chunk count and a chunk index of empty chunks
+		UINT32 chunkSize = 0x80000000;
+		UINT64 size = 5ULL * 1024 * 1024 * 1024;
+		UINT32 numChunks = (UINT32)((size + chunkSize - 1) / chunkSize);
+
+		UINT32 headerSize = sizeof(UINT32) * 3 + sizeof(UINT64) + numChunks * sizeof(UINT32);
+		SPtr<MemoryDataStream> header = bs_shared_ptr_new<MemoryDataStream>(headerSize);
+		header->write(&magic, sizeof(magic));
+		header->write(&chunkSize, sizeof(chunkSize));
+		header->write(&numChunks, sizeof(numChunks));
+		header->write(&size, sizeof(size));
+
+		for (UINT32 i = 0; i < numChunks; i++)
+		{
+			UINT32 compressedSize = 0;
+			header->write(&compressedSize, sizeof(compressedSize));
+		}
+
+		header->seek(0);
+		BS_TEST_ASSERT(!CompressedChunkReader(header).isValid());
+
+		header->seek(0);
+		BS_TEST_ASSERT(Compression::decompressChunked(header) == nullptr);
+	}
+}
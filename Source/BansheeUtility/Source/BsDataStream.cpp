@@ -4,6 +4,13 @@
 #include "BsDebug.h"
 #include <codecvt>
 
+#if BS_PLATFORM != BS_PLATFORM_WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace bs 
 {
 	const UINT32 DataStream::StreamTempSize = 128;
@@ -487,4 +494,63 @@ namespace bs
 			}
 		}
 	}
+
+#if BS_PLATFORM != BS_PLATFORM_WIN32
+	MappedFileDataStream::MappedFileDataStream(const Path& filePath)
+		:MemoryDataStream(nullptr, 0, false), mPath(filePath)
+	{
+		mAccess = READ;
+
+		void* memory = nullptr;
+		size_t size = 0;
+
+		int file = open(filePath.toString().c_str(), O_RDONLY);
+		if (file == -1)
+		{
+			LOGWRN("Cannot open file: " + filePath.toString());
+			return;
+		}
+
+		struct stat fileStat;
+		if (fstat(file, &fileStat) == 0 && fileStat.st_size > 0)
+		{
+			// The mapping holds its own reference to the file, so the descriptor can be closed once it is created
+			memory = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+			if (memory == MAP_FAILED)
+				memory = nullptr;
+			else
+			{
+				size = (size_t)fileStat.st_size;
+
+				// Resources are usually read front to back
+				madvise(memory, size, MADV_SEQUENTIAL);
+			}
+		}
+
+		::close(file);
+
+		if (memory == nullptr)
+			return;
+
+		mData = mPos = (UINT8*)memory;
+		mSize = size;
+		mEnd = mData + mSize;
+	}
+
+	MappedFileDataStream::~MappedFileDataStream()
+	{
+		close();
+	}
+
+	void MappedFileDataStream::close()
+	{
+		if (mData == nullptr)
+			return;
+
+		munmap(mData, mSize);
+
+		mData = mPos = mEnd = nullptr;
+		mSize = 0;
+	}
+#endif
 }
@@ -2,10 +2,26 @@
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 
 #include "BsFileSystem.h"
+#include "BsDataStream.h"
 #include "BsDebug.h"
 
 namespace bs
 {
+	SPtr<DataStream> FileSystem::openFileMapped(const Path& fullPath)
+	{
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+		// Windows doesn't allow mapped files to be deleted, which would prevent resources referencing the mapping from
+		// being re-saved to the same location
+		return openFile(fullPath, true);
+#else
+		SPtr<MappedFileDataStream> stream = bs_shared_ptr_new<MappedFileDataStream>(fullPath);
+		if (stream->isMapped())
+			return stream;
+
+		return openFile(fullPath, true);
+#endif
+	}
+
 	void FileSystem::copy(const Path& oldPath, const Path& newPath, bool overwriteExisting)
 	{
 		Stack<std::tuple<Path, Path>> todo;
@@ -0,0 +1,638 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsPooledAlloc.h"
+#include "BsPrerequisitesUtil.h"
+
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+#include "windows.h"
+#include <intrin.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace bs
+{
+	namespace
+	{
+		/** Size and alignment of every memory region allocated from the OS. */
+		const size_t SPAN_SIZE = 256 * 1024;
+		const uintptr_t SPAN_MASK = ~(uintptr_t)(SPAN_SIZE - 1);
+
+		/** Size of the header at the start of every region. Blocks within the region start after it. */
+		const size_t SPAN_HEADER_SIZE = 128;
+
+		/** Granularity at which regions are allocated from the OS. A multiple of page size on all supported platforms. */
+		const size_t OS_ALLOC_GRANULARITY = 64 * 1024;
+
+		/**
+		 * Number of size classes. First 8 classes are spaced 16 bytes apart, while the rest are split into four classes
+		 * per power of two.
+		 */
+		const UINT32 NUM_SIZE_CLASSES = 40;
+
+		/** Largest size served from a size class. Anything larger is allocated directly from the OS. */
+		const size_t MAX_SMALL_SIZE = 32768;
+
+		/** Size class stored in headers of regions containing a single huge allocation. */
+		const UINT32 HUGE_SIZE_CLASS = (UINT32)-1;
+
+		/** Maximum number of empty spans each thread keeps around for reuse, instead of returning them to the OS. */
+		const UINT32 MAX_CACHED_SPANS = 16;
+
+		/** Maximum number of freed huge allocations each thread keeps around for reuse. */
+		const UINT32 MAX_CACHED_HUGE_ALLOCS = 8;
+
+		/** Largest huge allocation that will be kept around for reuse once freed, in bytes. */
+		const size_t MAX_CACHED_HUGE_SIZE = 4 * 1024 * 1024;
+
+		struct ThreadHeap;
+
+		/** Free block within a region, pointing to the next free block. */
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		/** Header placed at the start of every region allocated from the OS. */
+		struct Span
+		{
+			Span(UINT32 sizeClass, UINT32 blockSize, size_t mappingSize, ThreadHeap* owner)
+				: sizeClass(sizeClass), blockSize(blockSize), mappingSize(mappingSize), owner(owner)
+				, bumpPtr((UINT8*)this + SPAN_HEADER_SIZE), remoteFreeList(nullptr)
+			{ }
+
+			/** Returns a free block from the span, or null if the span is full. Owner thread only. */
+			void* allocate()
+			{
+				if (freeList != nullptr)
+				{
+					FreeBlock* block = freeList;
+					freeList = block->next;
+					numUsed++;
+
+					return block;
+				}
+
+				if (bumpPtr + blockSize <= (UINT8*)this + SPAN_SIZE)
+				{
+					void* block = bumpPtr;
+					bumpPtr += blockSize;
+					numUsed++;
+
+					return block;
+				}
+
+				return nullptr;
+			}
+
+			/**
+			 * Moves blocks freed by other threads to the local free list. Returns the number of moved blocks. Owner thread
+			 * only.
+			 */
+			UINT32 collectRemoteFrees()
+			{
+				// Release ensures any thread that frees the next block sees the span as no longer being processed
+				FreeBlock* block = remoteFreeList.exchange(nullptr, std::memory_order_acq_rel);
+
+				UINT32 numCollected = 0;
+				while (block != nullptr)
+				{
+					FreeBlock* next = block->next;
+					block->next = freeList;
+					freeList = block;
+
+					numCollected++;
+					block = next;
+				}
+
+				numUsed -= numCollected;
+				return numCollected;
+			}
+
+			UINT32 sizeClass;
+			UINT32 blockSize;
+			size_t mappingSize;
+			ThreadHeap* owner;
+
+			FreeBlock* freeList = nullptr;
+			UINT8* bumpPtr;
+			UINT32 numUsed = 0;
+
+			// Links in the list of spans with free blocks, valid if isPartial is true
+			Span* prev = nullptr;
+			Span* next = nullptr;
+			bool isPartial = false;
+
+			std::atomic<FreeBlock*> remoteFreeList;
+
+			// Link in the owner's list of spans with blocks freed by other threads
+			Span* nextRemote = nullptr;
+		};
+
+		static_assert(sizeof(Span) <= SPAN_HEADER_SIZE, "Span header doesn't fit in the space reserved for it.");
+
+		/** Spans and statistics of a single size class, owned by a single thread. */
+		struct SizeClassCache
+		{
+			Span* current = nullptr;
+
+			// Spans that might have free blocks. Spans are only removed once an allocation from them fails, so some
+			// might be full.
+			Span* partialSpans = nullptr;
+
+			// Only written by the owner thread, atomic so the statistics can be read from other threads
+			std::atomic<UINT64> numAllocs { 0 };
+			std::atomic<UINT64> numFrees { 0 };
+			std::atomic<UINT64> numSpans { 0 };
+		};
+
+		/** Per-thread allocator state. Never destroyed, but returned for reuse once its thread exits. */
+		struct ThreadHeap
+		{
+			SizeClassCache classes[NUM_SIZE_CLASSES];
+
+			// Memory freed by this thread, kept for reuse to avoid constantly going through the OS
+			Span* cachedSpans[MAX_CACHED_SPANS];
+			UINT32 numCachedSpans = 0;
+
+			Span* cachedHugeAllocs[MAX_CACHED_HUGE_ALLOCS];
+			UINT32 numCachedHugeAllocs = 0;
+
+			// Spans that received blocks freed by other threads since the last time the list was processed. A span is
+			// added by the thread that frees the first block onto its empty remote free list.
+			std::atomic<Span*> remoteSpans { nullptr };
+
+			ThreadHeap* nextHeap = nullptr;
+			ThreadHeap* nextOrphan = nullptr;
+		};
+
+		/** Returns the heap of the current thread to the list of orphaned heaps when the thread exits. */
+		struct ThreadHeapReleaser
+		{
+			~ThreadHeapReleaser();
+
+			bool active = false;
+		};
+
+		std::atomic<ThreadHeap*> gAllHeaps { nullptr };
+		Mutex gOrphanedHeapsMutex;
+		ThreadHeap* gOrphanedHeaps = nullptr;
+
+		std::atomic<UINT64> gNumHugeAllocs { 0 };
+		std::atomic<UINT64> gNumHugeFrees { 0 };
+
+		BS_THREADLOCAL ThreadHeap* gCurrentHeap = nullptr;
+		thread_local ThreadHeapReleaser gHeapReleaser;
+
+		/** Increments a statistics counter only ever written to by a single thread. */
+		void incrementStat(std::atomic<UINT64>& counter, UINT64 amount = 1)
+		{
+#if BS_PROFILING_ENABLED
+			counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+#endif
+		}
+
+		/** Returns the index of the most significant bit set in a non-zero value. */
+		UINT32 getMostSignificantBit(UINT32 value)
+		{
+#if BS_COMPILER == BS_COMPILER_MSVC
+			unsigned long index;
+			_BitScanReverse(&index, value);
+			return (UINT32)index;
+#else
+			return 31 - (UINT32)__builtin_clz(value);
+#endif
+		}
+
+		/** Returns the size class to use for an allocation of the specified size. Size must not exceed MAX_SMALL_SIZE. */
+		UINT32 getSizeClass(size_t bytes)
+		{
+			if (bytes <= 128)
+				return bytes > 0 ? (UINT32)((bytes - 1) >> 4) : 0;
+
+			UINT32 value = (UINT32)bytes - 1;
+			UINT32 msb = getMostSignificantBit(value);
+
+			return 8 + (msb - 7) * 4 + (value >> (msb - 2)) - 4;
+		}
+
+		/** Returns the size of blocks allocated by the specified size class. */
+		UINT32 getBlockSize(UINT32 sizeClass)
+		{
+			if (sizeClass < 8)
+				return (sizeClass + 1) * 16;
+
+			UINT32 base = 128U << ((sizeClass - 8) / 4);
+			return base + ((sizeClass - 8) % 4 + 1) * (base / 4);
+		}
+
+		/** Allocates memory from the OS, aligned to SPAN_SIZE. */
+		void* allocatePages(size_t size)
+		{
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+			while (true)
+			{
+				// Reserve enough to find an aligned address within, then release and allocate exactly at that address
+				UINT8* data = (UINT8*)VirtualAlloc(nullptr, size + SPAN_SIZE, MEM_RESERVE, PAGE_NOACCESS);
+				if (data == nullptr)
+					return nullptr;
+
+				UINT8* alignedData = (UINT8*)(((uintptr_t)data + SPAN_SIZE - 1) & SPAN_MASK);
+				VirtualFree(data, 0, MEM_RELEASE);
+
+				void* output = VirtualAlloc(alignedData, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+				if (output != nullptr)
+					return output;
+
+				// Another thread took the address range in the meantime, try again
+			}
+#else
+			// Over-allocate and trim the unaligned parts
+			size_t reservedSize = size + SPAN_SIZE;
+			UINT8* data = (UINT8*)mmap(nullptr, reservedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (data == (UINT8*)MAP_FAILED)
+				return nullptr;
+
+			UINT8* alignedData = (UINT8*)(((uintptr_t)data + SPAN_SIZE - 1) & SPAN_MASK);
+
+			size_t headSize = alignedData - data;
+			if (headSize > 0)
+				munmap(data, headSize);
+
+			size_t tailSize = reservedSize - headSize - size;
+			if (tailSize > 0)
+				munmap(alignedData + size, tailSize);
+
+			return alignedData;
+#endif
+		}
+
+		/** Frees memory allocated with allocatePages(). */
+		void freePages(void* data, size_t size)
+		{
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+			VirtualFree(data, 0, MEM_RELEASE);
+#else
+			munmap(data, size);
+#endif
+		}
+
+		/** Returns the heap for the current thread, reusing a heap of an exited thread if available. */
+		ThreadHeap* acquireHeap()
+		{
+			ThreadHeap* heap = nullptr;
+			{
+				Lock lock(gOrphanedHeapsMutex);
+				if (gOrphanedHeaps != nullptr)
+				{
+					heap = gOrphanedHeaps;
+					gOrphanedHeaps = heap->nextOrphan;
+					heap->nextOrphan = nullptr;
+				}
+			}
+
+			if (heap == nullptr)
+			{
+				// Can't use the engine allocator, as we are the engine allocator
+				heap = new (::malloc(sizeof(ThreadHeap))) ThreadHeap();
+
+				ThreadHeap* head = gAllHeaps.load(std::memory_order_relaxed);
+				do
+				{
+					heap->nextHeap = head;
+				} while (!gAllHeaps.compare_exchange_weak(head, heap, std::memory_order_release, std::memory_order_relaxed));
+			}
+
+			gCurrentHeap = heap;
+			gHeapReleaser.active = true;
+
+			return heap;
+		}
+
+		ThreadHeapReleaser::~ThreadHeapReleaser()
+		{
+			ThreadHeap* heap = gCurrentHeap;
+			if (!active || heap == nullptr)
+				return;
+
+			// Any memory allocated after this point (e.g. by other thread-local destructors) will acquire a new heap that
+			// will never be released, but remains valid
+			gCurrentHeap = nullptr;
+
+			Lock lock(gOrphanedHeapsMutex);
+			heap->nextOrphan = gOrphanedHeaps;
+			gOrphanedHeaps = heap;
+		}
+
+		/** Adds a span to the list of spans with free blocks of its size class. */
+		void addPartialSpan(SizeClassCache& cache, Span* span)
+		{
+			span->prev = nullptr;
+			span->next = cache.partialSpans;
+			if (cache.partialSpans != nullptr)
+				cache.partialSpans->prev = span;
+
+			cache.partialSpans = span;
+			span->isPartial = true;
+		}
+
+		/** Removes a span from the list of spans with free blocks of its size class. */
+		void removePartialSpan(SizeClassCache& cache, Span* span)
+		{
+			if (span->prev != nullptr)
+				span->prev->next = span->next;
+			else
+				cache.partialSpans = span->next;
+
+			if (span->next != nullptr)
+				span->next->prev = span->prev;
+
+			span->prev = nullptr;
+			span->next = nullptr;
+			span->isPartial = false;
+		}
+
+		/** Creates a new span for the specified size class, and makes it the current span of the size class. */
+		Span* createSpan(ThreadHeap* heap, UINT32 sizeClass)
+		{
+			void* data;
+			if (heap->numCachedSpans > 0)
+				data = heap->cachedSpans[--heap->numCachedSpans];
+			else
+			{
+				data = allocatePages(SPAN_SIZE);
+				if (data == nullptr)
+					return nullptr;
+			}
+
+			Span* span = new (data) Span(sizeClass, getBlockSize(sizeClass), SPAN_SIZE, heap);
+
+			SizeClassCache& cache = heap->classes[sizeClass];
+			addPartialSpan(cache, span);
+
+			cache.current = span;
+			incrementStat(cache.numSpans);
+
+			return span;
+		}
+
+		/** Releases a span that no longer has any allocated blocks, either to the span cache or back to the OS. */
+		void releaseSpan(ThreadHeap* heap, SizeClassCache& cache, Span* span)
+		{
+			if (span->isPartial)
+				removePartialSpan(cache, span);
+
+			incrementStat(cache.numSpans, (UINT64)-1);
+
+			span->~Span();
+
+			if (heap->numCachedSpans < MAX_CACHED_SPANS)
+				heap->cachedSpans[heap->numCachedSpans++] = span;
+			else
+				freePages(span, SPAN_SIZE);
+		}
+
+		/**
+		 * Reclaims blocks freed by other threads, in spans of all size classes. Spans that end up with no allocated blocks
+		 * are released.
+		 */
+		void collectRemoteFrees(ThreadHeap* heap)
+		{
+			Span* span = heap->remoteSpans.exchange(nullptr, std::memory_order_acquire);
+			while (span != nullptr)
+			{
+				// Read the link before collecting, after which another thread might add the span to the list again. The
+				// span might also be released below.
+				Span* next = span->nextRemote;
+
+				SizeClassCache& cache = heap->classes[span->sizeClass];
+				incrementStat(cache.numFrees, span->collectRemoteFrees());
+
+				if (span->numUsed == 0 && span != cache.current)
+					releaseSpan(heap, cache, span);
+				else if (!span->isPartial)
+					addPartialSpan(cache, span);
+
+				span = next;
+			}
+		}
+
+		/** Allocates a block when the current span of the size class is full. */
+		void* allocateSlow(ThreadHeap* heap, UINT32 sizeClass)
+		{
+			SizeClassCache& cache = heap->classes[sizeClass];
+
+			if (heap->remoteSpans.load(std::memory_order_relaxed) != nullptr)
+				collectRemoteFrees(heap);
+
+			// Find a span with free blocks, dropping any full spans from the list along the way
+			while (cache.partialSpans != nullptr)
+			{
+				Span* span = cache.partialSpans;
+
+				void* block = span->allocate();
+				if (block != nullptr)
+				{
+					cache.current = span;
+					return block;
+				}
+
+				removePartialSpan(cache, span);
+			}
+
+			Span* span = createSpan(heap, sizeClass);
+			if (span == nullptr)
+				return nullptr;
+
+			return span->allocate();
+		}
+
+		/** Allocates memory too large for any size class directly from the OS, or from the cache of freed allocations. */
+		void* allocateHuge(ThreadHeap* heap, size_t bytes)
+		{
+			size_t mappingSize = (bytes + SPAN_HEADER_SIZE + OS_ALLOC_GRANULARITY - 1) & ~(OS_ALLOC_GRANULARITY - 1);
+
+			// Find the smallest cached allocation that fits, as long as it doesn't waste too much memory
+			void* data = nullptr;
+			UINT32 bestIdx = (UINT32)-1;
+			for (UINT32 i = 0; i < heap->numCachedHugeAllocs; i++)
+			{
+				size_t cachedSize = heap->cachedHugeAllocs[i]->mappingSize;
+				if (cachedSize < mappingSize || cachedSize > mappingSize * 2)
+					continue;
+
+				if (bestIdx == (UINT32)-1 || cachedSize < heap->cachedHugeAllocs[bestIdx]->mappingSize)
+					bestIdx = i;
+			}
+
+			if (bestIdx != (UINT32)-1)
+			{
+				Span* cached = heap->cachedHugeAllocs[bestIdx];
+				heap->cachedHugeAllocs[bestIdx] = heap->cachedHugeAllocs[--heap->numCachedHugeAllocs];
+
+				data = cached;
+				mappingSize = cached->mappingSize;
+				cached->~Span();
+			}
+			else
+			{
+				data = allocatePages(mappingSize);
+				if (data == nullptr)
+					return nullptr;
+			}
+
+			new (data) Span(HUGE_SIZE_CLASS, 0, mappingSize, nullptr);
+
+#if BS_PROFILING_ENABLED
+			gNumHugeAllocs.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+			return (UINT8*)data + SPAN_HEADER_SIZE;
+		}
+
+		/** Frees memory allocated with allocateHuge(), either to the cache of freed allocations or back to the OS. */
+		void freeHuge(ThreadHeap* heap, Span* span)
+		{
+			size_t mappingSize = span->mappingSize;
+			if (heap != nullptr && mappingSize <= MAX_CACHED_HUGE_SIZE)
+			{
+				// Evict the oldest entry if full
+				if (heap->numCachedHugeAllocs == MAX_CACHED_HUGE_ALLOCS)
+				{
+					Span* evicted = heap->cachedHugeAllocs[0];
+					for (UINT32 i = 1; i < MAX_CACHED_HUGE_ALLOCS; i++)
+						heap->cachedHugeAllocs[i - 1] = heap->cachedHugeAllocs[i];
+
+					heap->numCachedHugeAllocs--;
+					freePages(evicted, evicted->mappingSize);
+				}
+
+				heap->cachedHugeAllocs[heap->numCachedHugeAllocs++] = span;
+			}
+			else
+			{
+				span->~Span();
+				freePages(span, mappingSize);
+			}
+
+#if BS_PROFILING_ENABLED
+			gNumHugeFrees.fetch_add(1, std::memory_order_relaxed);
+#endif
+		}
+	}
+
+	void* PooledAlloc::allocate(size_t bytes)
+	{
+		ThreadHeap* heap = gCurrentHeap;
+		if (heap == nullptr)
+			heap = acquireHeap();
+
+		if (bytes > MAX_SMALL_SIZE)
+			return allocateHuge(heap, bytes);
+
+		UINT32 sizeClass = getSizeClass(bytes);
+		SizeClassCache& cache = heap->classes[sizeClass];
+		incrementStat(cache.numAllocs);
+
+		if (cache.current != nullptr)
+		{
+			void* block = cache.current->allocate();
+			if (block != nullptr)
+				return block;
+		}
+
+		return allocateSlow(heap, sizeClass);
+	}
+
+	void PooledAlloc::free(void* ptr)
+	{
+		if (ptr == nullptr)
+			return;
+
+		// Every region allocated from the OS is aligned to the span size and starts with a header
+		Span* span = (Span*)((uintptr_t)ptr & SPAN_MASK);
+		ThreadHeap* heap = gCurrentHeap;
+		if (span->sizeClass == HUGE_SIZE_CLASS)
+		{
+			freeHuge(heap, span);
+			return;
+		}
+
+		FreeBlock* block = (FreeBlock*)ptr;
+		if (span->owner == heap)
+		{
+			block->next = span->freeList;
+			span->freeList = block;
+			span->numUsed--;
+
+			SizeClassCache& cache = heap->classes[span->sizeClass];
+			incrementStat(cache.numFrees);
+
+			// Keep the current span around even if empty, to avoid repeatedly allocating spans from the OS
+			if (span->numUsed == 0 && span != cache.current)
+				releaseSpan(heap, cache, span);
+			else if (!span->isPartial)
+				addPartialSpan(cache, span);
+		}
+		else
+		{
+			// Freed on a thread other than the one that allocated it, let the owner reclaim it when it needs memory
+			FreeBlock* head = span->remoteFreeList.load(std::memory_order_relaxed);
+			do
+			{
+				block->next = head;
+			} while (!span->remoteFreeList.compare_exchange_weak(head, block, std::memory_order_acq_rel,
+				std::memory_order_relaxed));
+
+			// First remote free since the owner last collected them, let the owner know it should check the span. The
+			// span cannot be released before the owner collects this block, so it remains valid.
+			if (head == nullptr)
+			{
+				ThreadHeap* owner = span->owner;
+				Span* headSpan = owner->remoteSpans.load(std::memory_order_relaxed);
+				do
+				{
+					span->nextRemote = headSpan;
+				} while (!owner->remoteSpans.compare_exchange_weak(headSpan, span, std::memory_order_release,
+					std::memory_order_relaxed));
+			}
+		}
+	}
+
+	UINT32 PooledAlloc::getNumSizeClasses()
+	{
+		return NUM_SIZE_CLASSES;
+	}
+
+	PooledAllocStats PooledAlloc::getSizeClassStats(UINT32 sizeClass)
+	{
+		PooledAllocStats stats;
+		if (sizeClass >= NUM_SIZE_CLASSES)
+			return stats;
+
+		stats.blockSize = getBlockSize(sizeClass);
+
+		ThreadHeap* heap = gAllHeaps.load(std::memory_order_acquire);
+		while (heap != nullptr)
+		{
+			const SizeClassCache& cache = heap->classes[sizeClass];
+			stats.numAllocs += cache.numAllocs.load(std::memory_order_relaxed);
+			stats.numFrees += cache.numFrees.load(std::memory_order_relaxed);
+			stats.numSpans += cache.numSpans.load(std::memory_order_relaxed);
+
+			heap = heap->nextHeap;
+		}
+
+		return stats;
+	}
+
+	PooledAllocStats PooledAlloc::getHugeAllocStats()
+	{
+		PooledAllocStats stats;
+		stats.numAllocs = gNumHugeAllocs.load(std::memory_order_relaxed);
+		stats.numFrees = gNumHugeFrees.load(std::memory_order_relaxed);
+		stats.numSpans = stats.numAllocs - stats.numFrees;
+
+		return stats;
+	}
+}
@@ -0,0 +1,621 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsSerializationTestSuite.h"
+
+#include "BsIReflectable.h"
+#include "BsRTTIType.h"
+#include "BsMemorySerializer.h"
+#include "BsBinarySerializer.h"
+#include "BsBinaryCloner.h"
+#include "BsDataStream.h"
+#include "BsVector3.h"
+
+namespace bs
+{
+	/** Memcpy-able element type used by the array tests. */
+	struct TestArrayElement
+	{
+		Vector3 position;
+		Vector3 normal;
+		UINT32 index;
+	};
+
+	BS_ALLOW_MEMCPY_SERIALIZATION(TestArrayElement);
+
+	/** Object whose array is serialized one element at a time. */
+	class TestPlainArrayObject : public IReflectable
+	{
+	public:
+		Vector<TestArrayElement> elements;
+		UINT32 trailing = 0;
+
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override { return getRTTIStatic(); }
+	};
+
+	/** Object with the same contents as TestPlainArrayObject, but whose array is serialized in bulk. */
+	class TestBulkArrayObject : public IReflectable
+	{
+	public:
+		Vector<TestArrayElement> elements;
+		UINT32 trailing = 0;
+
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override { return getRTTIStatic(); }
+	};
+
+	class TestPlainArrayObjectRTTI : public RTTIType<TestPlainArrayObject, IReflectable, TestPlainArrayObjectRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN_ARRAY(elements, 0)
+			BS_RTTI_MEMBER_PLAIN(trailing, 1)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		TestPlainArrayObjectRTTI()
+			:mInitMembers(this)
+		{ }
+
+		const String& getRTTIName() override
+		{
+			static String name = "TestPlainArrayObject";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_SerializationTestPlainArray;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<TestPlainArrayObject>();
+		}
+	};
+
+	class TestBulkArrayObjectRTTI : public RTTIType<TestBulkArrayObject, IReflectable, TestBulkArrayObjectRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN_ARRAY_BULK(elements, 0)
+			BS_RTTI_MEMBER_PLAIN(trailing, 1)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		TestBulkArrayObjectRTTI()
+			:mInitMembers(this)
+		{ }
+
+		const String& getRTTIName() override
+		{
+			static String name = "TestBulkArrayObject";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_SerializationTestBulkArray;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<TestBulkArrayObject>();
+		}
+	};
+
+	RTTITypeBase* TestPlainArrayObject::getRTTIStatic()
+	{
+		return TestPlainArrayObjectRTTI::instance();
+	}
+
+	RTTITypeBase* TestBulkArrayObject::getRTTIStatic()
+	{
+		return TestBulkArrayObjectRTTI::instance();
+	}
+
+	/** Object referencing other objects of the same type, used by the cloner tests. */
+	class TestClonerObject : public IReflectable
+	{
+	public:
+		INT32 value = 0;
+		SPtr<TestClonerObject> refA;
+		SPtr<TestClonerObject> refB;
+		SPtr<TestClonerObject> weakRef;
+		SPtr<MemoryDataStream> data;
+
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override { return getRTTIStatic(); }
+	};
+
+	class TestClonerObjectRTTI : public RTTIType<TestClonerObject, IReflectable, TestClonerObjectRTTI>
+	{
+	private:
+		INT32& getValue(TestClonerObject* obj) { return obj->value; }
+		void setValue(TestClonerObject* obj, INT32& value) { obj->value = value; }
+
+		SPtr<TestClonerObject> getRefA(TestClonerObject* obj) { return obj->refA; }
+		void setRefA(TestClonerObject* obj, SPtr<TestClonerObject> value) { obj->refA = value; }
+
+		SPtr<TestClonerObject> getRefB(TestClonerObject* obj) { return obj->refB; }
+		void setRefB(TestClonerObject* obj, SPtr<TestClonerObject> value) { obj->refB = value; }
+
+		SPtr<TestClonerObject> getWeakRef(TestClonerObject* obj) { return obj->weakRef; }
+		void setWeakRef(TestClonerObject* obj, SPtr<TestClonerObject> value) { obj->weakRef = value; }
+
+		SPtr<DataStream> getData(TestClonerObject* obj, UINT32& size)
+		{
+			if (obj->data == nullptr)
+			{
+				size = 0;
+				return bs_shared_ptr_new<MemoryDataStream>(0);
+			}
+
+			obj->data->seek(0);
+			size = (UINT32)obj->data->size();
+
+			return obj->data;
+		}
+
+		void setData(TestClonerObject* obj, const SPtr<DataStream>& value, UINT32 size)
+		{
+			// Memory streams are referenced directly instead of being copied, so any memory shared between the
+			// original object and its clone is detected by the tests
+			if (!value->isFile())
+			{
+				obj->data = std::static_pointer_cast<MemoryDataStream>(value);
+				return;
+			}
+
+			obj->data = bs_shared_ptr_new<MemoryDataStream>(size);
+			value->read(obj->data->getPtr(), size);
+		}
+
+	public:
+		TestClonerObjectRTTI()
+		{
+			addPlainField("value", 0, &TestClonerObjectRTTI::getValue, &TestClonerObjectRTTI::setValue);
+			addReflectablePtrField("refA", 1, &TestClonerObjectRTTI::getRefA, &TestClonerObjectRTTI::setRefA);
+			addReflectablePtrField("refB", 2, &TestClonerObjectRTTI::getRefB, &TestClonerObjectRTTI::setRefB);
+			addReflectablePtrField("weakRef", 3, &TestClonerObjectRTTI::getWeakRef, &TestClonerObjectRTTI::setWeakRef,
+				RTTI_Flag_WeakRef);
+			addDataBlockField("data", 4, &TestClonerObjectRTTI::getData, &TestClonerObjectRTTI::setData, 0);
+		}
+
+		const String& getRTTIName() override
+		{
+			static String name = "TestClonerObject";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_SerializationTestClonerObject;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<TestClonerObject>();
+		}
+	};
+
+	RTTITypeBase* TestClonerObject::getRTTIStatic()
+	{
+		return TestClonerObjectRTTI::instance();
+	}
+
+	/** Creates a new cloner test object with the specified value. */
+	static SPtr<TestClonerObject> createClonerObject(INT32 value)
+	{
+		SPtr<TestClonerObject> output = bs_shared_ptr_new<TestClonerObject>();
+		output->value = value;
+
+		return output;
+	}
+
+	/** 
+	 * Creates a balanced binary tree of cloner test objects, linked through their strong references. Each object is given
+	 * a data block of the specified size.
+	 */
+	static SPtr<TestClonerObject> createClonerTree(UINT32 numObjects, UINT32 dataSize)
+	{
+		Vector<SPtr<TestClonerObject>> objects(numObjects);
+		for (UINT32 i = 0; i < numObjects; i++)
+		{
+			objects[i] = createClonerObject((INT32)i);
+
+			if (dataSize > 0)
+			{
+				objects[i]->data = bs_shared_ptr_new<MemoryDataStream>(dataSize);
+				memset(objects[i]->data->getPtr(), (int)(i & 0xFF), dataSize);
+			}
+		}
+
+		for (UINT32 i = 1; i < numObjects; i++)
+		{
+			SPtr<TestClonerObject>& parent = objects[(i - 1) / 2];
+			if ((i & 1) != 0)
+				parent->refA = objects[i];
+			else
+				parent->refB = objects[i];
+		}
+
+		return numObjects > 0 ? objects[0] : nullptr;
+	}
+
+	/** 
+	 * Element counts used by the array tests. Includes an empty array, and an array large enough to exceed the 
+	 * serializer's write buffer. 
+	 */
+	static const UINT32 TEST_ARRAY_SIZES[] = { 0, 1, 17, 100000 };
+
+	/** Fills the object with a repeatable pattern of elements. */
+	template<class T>
+	static void fillTestObject(T& object, UINT32 numElements)
+	{
+		object.elements.resize(numElements);
+		for (UINT32 i = 0; i < numElements; i++)
+		{
+			TestArrayElement& element = object.elements[i];
+			element.position = Vector3((float)i, (float)i * 0.5f, -(float)i);
+			element.normal = Vector3(0.0f, 1.0f, (float)(i % 13));
+			element.index = i * 7 + 3;
+		}
+
+		object.trailing = 0xABCD1234;
+	}
+
+	/** Checks that the object contains exactly the contents written by fillTestObject(). */
+	template<class T>
+	static bool checkTestObject(const T& object, UINT32 numElements)
+	{
+		if (object.elements.size() != numElements || object.trailing != 0xABCD1234)
+			return false;
+
+		for (UINT32 i = 0; i < numElements; i++)
+		{
+			const TestArrayElement& element = object.elements[i];
+			if (element.position != Vector3((float)i, (float)i * 0.5f, -(float)i) ||
+				element.normal != Vector3(0.0f, 1.0f, (float)(i % 13)) ||
+				element.index != i * 7 + 3)
+				return false;
+		}
+
+		return true;
+	}
+
+	/** 
+	 * Changes the type of the root object in data encoded by the binary serializer. Used for decoding data written by
+	 * one of the test types as the other, since both have identical fields.
+	 */
+	static void setRootTypeId(UINT8* data, UINT32 size, UINT32 typeId)
+	{
+		// Root object meta-data is written first, consisting of a UINT32 object meta-data and a UINT32 type id
+		assert(size >= sizeof(UINT32) * 2);
+		memcpy(data + sizeof(UINT32), &typeId, sizeof(UINT32));
+	}
+
+	SerializationTestSuite::SerializationTestSuite()
+	{
+		BS_ADD_TEST(SerializationTestSuite::testBulkArrayMatchesPlainArray);
+		BS_ADD_TEST(SerializationTestSuite::testBulkArrayCrossDecode);
+		BS_ADD_TEST(SerializationTestSuite::testPlainVectorBulkEncoding);
+		BS_ADD_TEST(SerializationTestSuite::testClonerSharedReferences);
+		BS_ADD_TEST(SerializationTestSuite::testClonerWeakReferenceCycle);
+		BS_ADD_TEST(SerializationTestSuite::testClonerShallow);
+		BS_ADD_TEST(SerializationTestSuite::testClonerDataBlock);
+		BS_ADD_TEST(SerializationTestSuite::testClonerBulkArray);
+	}
+
+	void SerializationTestSuite::testBulkArrayMatchesPlainArray()
+	{
+		MemorySerializer serializer;
+		for (auto& numElements : TEST_ARRAY_SIZES)
+		{
+			TestPlainArrayObject plainObject;
+			fillTestObject(plainObject, numElements);
+
+			TestBulkArrayObject bulkObject;
+			fillTestObject(bulkObject, numElements);
+
+			UINT32 plainSize = 0;
+			UINT8* plainData = serializer.encode(&plainObject, plainSize);
+
+			UINT32 bulkSize = 0;
+			UINT8* bulkData = serializer.encode(&bulkObject, bulkSize);
+
+			// Only the root type id is allowed to differ
+			setRootTypeId(bulkData, bulkSize, TID_SerializationTestPlainArray);
+
+			BS_TEST_ASSERT(plainSize == bulkSize);
+			BS_TEST_ASSERT(plainSize == bulkSize && memcmp(plainData, bulkData, plainSize) == 0);
+
+			bs_free(plainData);
+			bs_free(bulkData);
+		}
+	}
+
+	void SerializationTestSuite::testBulkArrayCrossDecode()
+	{
+		MemorySerializer serializer;
+		for (auto& numElements : TEST_ARRAY_SIZES)
+		{
+			// Data written per-element, read in bulk
+			TestPlainArrayObject plainObject;
+			fillTestObject(plainObject, numElements);
+
+			UINT32 plainSize = 0;
+			UINT8* plainData = serializer.encode(&plainObject, plainSize);
+			setRootTypeId(plainData, plainSize, TID_SerializationTestBulkArray);
+
+			SPtr<IReflectable> decodedBulk = serializer.decode(plainData, plainSize);
+			BS_TEST_ASSERT(decodedBulk != nullptr && decodedBulk->getTypeId() == TID_SerializationTestBulkArray);
+			if (decodedBulk != nullptr && decodedBulk->getTypeId() == TID_SerializationTestBulkArray)
+				BS_TEST_ASSERT(checkTestObject(static_cast<TestBulkArrayObject&>(*decodedBulk), numElements));
+
+			// Data written in bulk, read per-element
+			TestBulkArrayObject bulkObject;
+			fillTestObject(bulkObject, numElements);
+
+			UINT32 bulkSize = 0;
+			UINT8* bulkData = serializer.encode(&bulkObject, bulkSize);
+			setRootTypeId(bulkData, bulkSize, TID_SerializationTestPlainArray);
+
+			SPtr<IReflectable> decodedPlain = serializer.decode(bulkData, bulkSize);
+			BS_TEST_ASSERT(decodedPlain != nullptr && decodedPlain->getTypeId() == TID_SerializationTestPlainArray);
+			if (decodedPlain != nullptr && decodedPlain->getTypeId() == TID_SerializationTestPlainArray)
+				BS_TEST_ASSERT(checkTestObject(static_cast<TestPlainArrayObject&>(*decodedPlain), numElements));
+
+			bs_free(plainData);
+			bs_free(bulkData);
+		}
+	}
+
+	void SerializationTestSuite::testPlainVectorBulkEncoding()
+	{
+		static_assert(RTTIPlainTypeIsMemcpy<TestArrayElement>::value != 0, "Test elements are expected to be serialized in bulk.");
+
+		for (auto& numElements : TEST_ARRAY_SIZES)
+		{
+			TestPlainArrayObject object;
+			fillTestObject(object, numElements);
+
+			const Vector<TestArrayElement>& elements = object.elements;
+
+			// Encode the vector in bulk, as done by the vector plain type
+			UINT32 size = rttiGetElemSize(elements);
+			BS_TEST_ASSERT(size == sizeof(UINT32) * 2 + numElements * sizeof(TestArrayElement));
+
+			Vector<char> bulkData(size, 0);
+			char* bulkEnd = rttiWriteElem(elements, bulkData.data());
+			BS_TEST_ASSERT(bulkEnd == bulkData.data() + size);
+
+			// Encode the same vector one element at a time
+			Vector<char> perElementData(size, 0);
+			char* memory = perElementData.data();
+			memcpy(memory, &size, sizeof(UINT32));
+			memory += sizeof(UINT32);
+
+			memcpy(memory, &numElements, sizeof(UINT32));
+			memory += sizeof(UINT32);
+
+			for (auto& element : elements)
+				memory = rttiWriteElem(element, memory);
+
+			BS_TEST_ASSERT(memory == perElementData.data() + size);
+			BS_TEST_ASSERT(memcmp(bulkData.data(), perElementData.data(), size) == 0);
+
+			// Encoded data must decode back to the original elements
+			TestPlainArrayObject decodedObject;
+			decodedObject.trailing = object.trailing;
+			rttiReadElem(decodedObject.elements, perElementData.data());
+
+			BS_TEST_ASSERT(checkTestObject(decodedObject, numElements));
+		}
+	}
+
+	void SerializationTestSuite::testClonerSharedReferences()
+	{
+		SPtr<TestClonerObject> root = createClonerObject(1);
+		SPtr<TestClonerObject> child = createClonerObject(2);
+		root->refA = child;
+		root->refB = child;
+
+		SPtr<TestClonerObject> clone = std::static_pointer_cast<TestClonerObject>(BinaryCloner::clone(root.get()));
+		BS_TEST_ASSERT(clone != nullptr && clone != root);
+		BS_TEST_ASSERT(clone->value == 1);
+
+		// An object referenced from multiple fields must be cloned only once
+		BS_TEST_ASSERT(clone->refA != nullptr && clone->refA != child);
+		BS_TEST_ASSERT(clone->refA == clone->refB);
+		BS_TEST_ASSERT(clone->refA != nullptr && clone->refA->value == 2);
+	}
+
+	void SerializationTestSuite::testClonerWeakReferenceCycle()
+	{
+		SPtr<TestClonerObject> root = createClonerObject(1);
+		SPtr<TestClonerObject> child = createClonerObject(2);
+		SPtr<TestClonerObject> weakOnly = createClonerObject(3);
+
+		root->refA = child;
+		child->weakRef = root;
+
+		// Object referenced only through a weak reference, cloned after the rest of the hierarchy
+		root->weakRef = weakOnly;
+
+		SPtr<TestClonerObject> clone = std::static_pointer_cast<TestClonerObject>(BinaryCloner::clone(root.get()));
+		BS_TEST_ASSERT(clone->refA != nullptr && clone->refA != child);
+		BS_TEST_ASSERT(clone->refA != nullptr && clone->refA->value == 2);
+
+		// Reference back to the root must point to the cloned root, not the original
+		BS_TEST_ASSERT(clone->refA != nullptr && clone->refA->weakRef.get() == clone.get());
+
+		BS_TEST_ASSERT(clone->weakRef != nullptr && clone->weakRef != weakOnly);
+		BS_TEST_ASSERT(clone->weakRef != nullptr && clone->weakRef->value == 3);
+
+		// Break the reference cycles so the objects can be freed
+		child->weakRef = nullptr;
+		if (clone->refA != nullptr)
+			clone->refA->weakRef = nullptr;
+	}
+
+	void SerializationTestSuite::testClonerShallow()
+	{
+		SPtr<TestClonerObject> root = createClonerObject(1);
+		SPtr<TestClonerObject> child = createClonerObject(2);
+		SPtr<TestClonerObject> weakOnly = createClonerObject(3);
+
+		root->refA = child;
+		root->weakRef = weakOnly;
+
+		SPtr<TestClonerObject> clone = std::static_pointer_cast<TestClonerObject>(
+			BinaryCloner::clone(root.get(), true));
+
+		BS_TEST_ASSERT(clone != root);
+		BS_TEST_ASSERT(clone->value == 1);
+		BS_TEST_ASSERT(clone->refA == child);
+		BS_TEST_ASSERT(clone->refB == nullptr);
+		BS_TEST_ASSERT(clone->weakRef == weakOnly);
+	}
+
+	void SerializationTestSuite::testClonerDataBlock()
+	{
+		const UINT32 DATA_SIZE = 1024;
+
+		SPtr<TestClonerObject> root = createClonerObject(1);
+		root->data = bs_shared_ptr_new<MemoryDataStream>(DATA_SIZE);
+		for (UINT32 i = 0; i < DATA_SIZE; i++)
+			root->data->getPtr()[i] = (UINT8)(i * 7);
+
+		SPtr<TestClonerObject> clone = std::static_pointer_cast<TestClonerObject>(BinaryCloner::clone(root.get()));
+		BS_TEST_ASSERT(clone->data != nullptr && clone->data != root->data);
+		if (clone->data == nullptr)
+			return;
+
+		BS_TEST_ASSERT(clone->data->size() == DATA_SIZE);
+		BS_TEST_ASSERT(clone->data->getPtr() != root->data->getPtr());
+		BS_TEST_ASSERT(memcmp(clone->data->getPtr(), root->data->getPtr(), DATA_SIZE) == 0);
+
+		// Modifying the original must not affect the clone
+		root->data->getPtr()[0] = 0xFF;
+		BS_TEST_ASSERT(clone->data->getPtr()[0] == 0);
+	}
+
+	void SerializationTestSuite::testClonerBulkArray()
+	{
+		for (auto& numElements : TEST_ARRAY_SIZES)
+		{
+			TestBulkArrayObject bulkObject;
+			fillTestObject(bulkObject, numElements);
+
+			SPtr<IReflectable> clone = BinaryCloner::clone(&bulkObject);
+			BS_TEST_ASSERT(clone != nullptr && clone->getTypeId() == TID_SerializationTestBulkArray);
+			if (clone == nullptr || clone->getTypeId() != TID_SerializationTestBulkArray)
+				continue;
+
+			TestBulkArrayObject& clonedObject = static_cast<TestBulkArrayObject&>(*clone);
+			BS_TEST_ASSERT(checkTestObject(clonedObject, numElements));
+			BS_TEST_ASSERT(numElements == 0 || clonedObject.elements.data() != bulkObject.elements.data());
+		}
+	}
+
+	SerializationBenchmarkSuite::SerializationBenchmarkSuite(const BenchmarkParams& params)
+		:BenchmarkSuite(params)
+	{
+		BS_ADD_TEST(SerializationBenchmarkSuite::benchmarkDirectDecode);
+		BS_ADD_TEST(SerializationBenchmarkSuite::benchmarkBulkArray);
+		BS_ADD_TEST(SerializationBenchmarkSuite::benchmarkCloner);
+	}
+
+	void SerializationBenchmarkSuite::benchmarkDirectDecode()
+	{
+		UINT32 numObjects = mParams.get("objects", 100000);
+		UINT32 dataSize = mParams.get("dataSize", 128);
+
+		SPtr<TestClonerObject> root = createClonerTree(numObjects, dataSize);
+
+		MemorySerializer ms;
+		UINT32 size = 0;
+		UINT8* data = ms.encode(root.get(), size);
+		root = nullptr;
+
+		SPtr<MemoryDataStream> stream = bs_shared_ptr_new<MemoryDataStream>(data, size);
+		BinarySerializer bs;
+
+		SPtr<IReflectable> directObj;
+		measure("Direct decode", [&]() { directObj = bs.decode(stream, size); });
+
+		BS_TEST_ASSERT(directObj != nullptr && directObj->getTypeId() == TID_SerializationTestClonerObject);
+		directObj = nullptr;
+
+		stream->seek(0);
+
+		SPtr<IReflectable> intermediateObj;
+		measure("Decode through SerializedObject", [&]()
+		{
+			SPtr<SerializedObject> intermediate = bs._decodeToIntermediate(stream, size);
+			intermediateObj = bs._decodeFromIntermediate(intermediate);
+		});
+
+		BS_TEST_ASSERT(intermediateObj != nullptr && intermediateObj->getTypeId() == TID_SerializationTestClonerObject);
+	}
+
+	void SerializationBenchmarkSuite::benchmarkBulkArray()
+	{
+		UINT32 numElements = mParams.get("elements", 1000000);
+
+		TestPlainArrayObject plainObject;
+		fillTestObject(plainObject, numElements);
+
+		TestBulkArrayObject bulkObject;
+		fillTestObject(bulkObject, numElements);
+
+		MemorySerializer serializer;
+
+		UINT32 plainSize = 0;
+		UINT8* plainData = nullptr;
+		measure("Per-element encode", [&]() { plainData = serializer.encode(&plainObject, plainSize); });
+
+		UINT32 bulkSize = 0;
+		UINT8* bulkData = nullptr;
+		measure("Bulk encode", [&]() { bulkData = serializer.encode(&bulkObject, bulkSize); });
+
+		SPtr<IReflectable> decodedPlain;
+		measure("Per-element decode", [&]() { decodedPlain = serializer.decode(plainData, plainSize); });
+
+		SPtr<IReflectable> decodedBulk;
+		measure("Bulk decode", [&]() { decodedBulk = serializer.decode(bulkData, bulkSize); });
+
+		BS_TEST_ASSERT(decodedPlain != nullptr && decodedPlain->getTypeId() == TID_SerializationTestPlainArray);
+		BS_TEST_ASSERT(decodedBulk != nullptr && decodedBulk->getTypeId() == TID_SerializationTestBulkArray);
+
+		bs_free(plainData);
+		bs_free(bulkData);
+	}
+
+	void SerializationBenchmarkSuite::benchmarkCloner()
+	{
+		UINT32 numObjects = mParams.get("objects", 100000);
+
+		SPtr<TestClonerObject> root = createClonerTree(numObjects, 0);
+
+		SPtr<IReflectable> clone;
+		measure("Direct copy", [&]() { clone = BinaryCloner::clone(root.get()); });
+
+		BS_TEST_ASSERT(clone != nullptr && clone->getTypeId() == TID_SerializationTestClonerObject);
+		clone = nullptr;
+
+		// Serialize round trip, as previously done by the cloner
+		measure("Serialize round trip", [&]()
+		{
+			MemorySerializer ms;
+			UINT32 size = 0;
+			UINT8* data = ms.encode(root.get(), size);
+			clone = ms.decode(data, size);
+
+			bs_free(data);
+		});
+
+		BS_TEST_ASSERT(clone != nullptr && clone->getTypeId() == TID_SerializationTestClonerObject);
+	}
+}
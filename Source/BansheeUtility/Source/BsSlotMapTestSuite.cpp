@@ -0,0 +1,108 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsSlotMapTestSuite.h"
+
+#include "BsSlotMap.h"
+
+#include <random>
+
+namespace bs
+{
+	SlotMapTestSuite::SlotMapTestSuite()
+	{
+		BS_ADD_TEST(SlotMapTestSuite::testInsertRemove);
+		BS_ADD_TEST(SlotMapTestSuite::testStaleHandles);
+		BS_ADD_TEST(SlotMapTestSuite::testRandomOperations);
+	}
+
+	void SlotMapTestSuite::testInsertRemove()
+	{
+		SlotMap<UINT32> map;
+
+		Vector<SlotHandle> handles;
+		for (UINT32 i = 0; i < 100; i++)
+			handles.push_back(map.insert(i));
+
+		BS_TEST_ASSERT(map.size() == 100);
+
+		for (UINT32 i = 0; i < 100; i++)
+			BS_TEST_ASSERT(map[handles[i]] == i);
+
+		// Remove every odd element, remaining ones must still be reachable through their handles
+		for (UINT32 i = 1; i < 100; i += 2)
+			BS_TEST_ASSERT(map.remove(handles[i]));
+
+		BS_TEST_ASSERT(map.size() == 50);
+
+		for (UINT32 i = 0; i < 100; i += 2)
+			BS_TEST_ASSERT(map[handles[i]] == i);
+
+		// Iteration must visit exactly the live elements
+		UINT32 sum = 0;
+		for (auto& entry : map)
+			sum += entry;
+
+		BS_TEST_ASSERT(sum == 2450);
+
+		for (UINT32 i = 0; i < map.size(); i++)
+			BS_TEST_ASSERT(map[map.getHandle(i)] == map.data()[i]);
+
+		map.clear();
+		BS_TEST_ASSERT(map.empty());
+		BS_TEST_ASSERT(!map.contains(handles[0]));
+	}
+
+	void SlotMapTestSuite::testStaleHandles()
+	{
+		SlotMap<UINT32> map;
+
+		SlotHandle first = map.insert(1);
+		BS_TEST_ASSERT(map.remove(first));
+		BS_TEST_ASSERT(!map.remove(first));
+
+		// New element reuses the slot, but the old handle must not reference it
+		SlotHandle second = map.insert(2);
+		BS_TEST_ASSERT(second.index == first.index);
+		BS_TEST_ASSERT(!map.contains(first));
+		BS_TEST_ASSERT(map.find(first) == nullptr);
+		BS_TEST_ASSERT(map.find(second) != nullptr && *map.find(second) == 2);
+
+		BS_TEST_ASSERT(!map.contains(SlotHandle()));
+	}
+
+	void SlotMapTestSuite::testRandomOperations()
+	{
+		std::mt19937 rng(12345);
+
+		SlotMap<UINT32> map;
+		Vector<std::pair<SlotHandle, UINT32>> live;
+		Vector<SlotHandle> removed;
+
+		UINT32 nextValue = 0;
+		for (UINT32 i = 0; i < 100000; i++)
+		{
+			if (live.empty() || (rng() % 3) != 0)
+			{
+				live.push_back(std::make_pair(map.insert(nextValue), nextValue));
+				nextValue++;
+			}
+			else
+			{
+				UINT32 idx = rng() % (UINT32)live.size();
+				BS_TEST_ASSERT(map.remove(live[idx].first));
+
+				removed.push_back(live[idx].first);
+				live[idx] = live.back();
+				live.pop_back();
+			}
+		}
+
+		BS_TEST_ASSERT(map.size() == (UINT32)live.size());
+
+		for (auto& entry : live)
+			BS_TEST_ASSERT(map.contains(entry.first) && map[entry.first] == entry.second);
+
+		for (auto& entry : removed)
+			BS_TEST_ASSERT(!map.contains(entry));
+	}
+}
@@ -5,10 +5,109 @@
 
 namespace bs
 {
-	Task::Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker, 
+	/**
+	 * Fixed size work-stealing deque (Chase-Lev). Only the owning worker may push to or pop from the bottom of the deque,
+	 * while any thread may steal from its top.
+	 */
+	class TaskDeque
+	{
+	public:
+		static const INT64 CAPACITY = 2048;
+
+		TaskDeque()
+			:mTop(0), mBottom(0)
+		{
+			for (INT64 i = 0; i < CAPACITY; i++)
+				mBuffer[i].store(nullptr, std::memory_order_relaxed);
+		}
+
+		/** Pushes a task to the bottom of the deque. Returns false if the deque is full. Owner thread only. */
+		bool push(Task* task)
+		{
+			INT64 bottom = mBottom.load(std::memory_order_relaxed);
+			INT64 top = mTop.load(std::memory_order_acquire);
+
+			if (bottom - top >= CAPACITY)
+				return false;
+
+			mBuffer[bottom & (CAPACITY - 1)].store(task, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			mBottom.store(bottom + 1, std::memory_order_relaxed);
+
+			return true;
+		}
+
+		/** Pops a task from the bottom of the deque. Returns null if the deque is empty. Owner thread only. */
+		Task* pop()
+		{
+			INT64 bottom = mBottom.load(std::memory_order_relaxed) - 1;
+			mBottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			INT64 top = mTop.load(std::memory_order_relaxed);
+
+			if (top > bottom)
+			{
+				mBottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			Task* task = mBuffer[bottom & (CAPACITY - 1)].load(std::memory_order_relaxed);
+			if (top == bottom)
+			{
+				// Last element, race against stealers
+				if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					task = nullptr;
+
+				mBottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+
+			return task;
+		}
+
+		/** Steals a task from the top of the deque. Returns null if the deque is empty or the steal failed. */
+		Task* steal()
+		{
+			INT64 top = mTop.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			INT64 bottom = mBottom.load(std::memory_order_acquire);
+
+			if (top >= bottom)
+				return nullptr;
+
+			Task* task = mBuffer[top & (CAPACITY - 1)].load(std::memory_order_relaxed);
+			if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+
+			return task;
+		}
+
+	private:
+		std::atomic<INT64> mTop;
+		std::atomic<INT64> mBottom;
+		std::atomic<Task*> mBuffer[CAPACITY];
+	};
+
+	/** Information about a single worker thread. */
+	struct TaskScheduler::Worker
+	{
+		Worker(TaskScheduler* owner, UINT32 idx)
+			:owner(owner), idx(idx)
+		{ }
+
+		TaskScheduler* owner;
+		UINT32 idx;
+		HThread thread;
+		TaskDeque queues[NUM_PRIORITIES];
+
+		static BS_THREADLOCAL Worker* current;
+	};
+
+	BS_THREADLOCAL TaskScheduler::Worker* TaskScheduler::Worker::current = nullptr;
+
+	Task::Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker,
 		TaskPriority priority, SPtr<Task> dependency)
-		:mName(name), mPriority(priority), mTaskId(0), mTaskWorker(taskWorker), mTaskDependency(dependency),
-		mParent(nullptr)
+		:mName(name), mPriority(priority), mTaskId(0), mTaskWorker(taskWorker), mTaskDependency(dependency), mState(0),
+		mParent(nullptr), mGroup(nullptr)
 	{
 
 	}
@@ -39,66 +138,139 @@ namespace bs
 		mState.store(3);
 	}
 
-	TaskScheduler::TaskScheduler()
-		:mTaskQueue(&TaskScheduler::taskCompare), mMaxActiveTasks(0), mNextTaskId(0), mShutdown(false)
+	TaskGroup::TaskGroup(const PrivatelyConstruct& dummy, const String& name, TaskPriority priority)
+		:mName(name), mPriority(priority), mNumPending(0), mParent(TaskScheduler::instancePtr())
+	{ }
+
+	TaskGroup::~TaskGroup()
 	{
-		mMaxActiveTasks = BS_THREAD_HARDWARE_CONCURRENCY;
+		wait();
+	}
 
-		mTaskSchedulerThread = ThreadPool::instance().run("TaskScheduler", std::bind(&TaskScheduler::runMain, this));
+	SPtr<TaskGroup> TaskGroup::create(const String& name, TaskPriority priority)
+	{
+		return bs_shared_ptr_new<TaskGroup>(PrivatelyConstruct(), name, priority);
 	}
 
-	TaskScheduler::~TaskScheduler()
+	void TaskGroup::run(std::function<void()> taskWorker)
 	{
-		// Wait until all tasks complete
-		{
-			Lock activeTaskLock(mReadyMutex);
+		SPtr<Task> task = Task::create(mName, std::move(taskWorker), mPriority);
+		task->mGroup = this;
 
-			while (mActiveTasks.size() > 0)
-			{
-				SPtr<Task> task = mActiveTasks[0];
-				activeTaskLock.unlock();
+		mNumPending.fetch_add(1);
+		mParent->addTask(task);
+	}
 
-				task->wait();
-				activeTaskLock.lock();
-			}
-		}
+	bool TaskGroup::isComplete() const
+	{
+		return mNumPending.load() == 0;
+	}
 
-		// Start shutdown of the main queue worker and wait until it exits
+	void TaskGroup::wait()
+	{
+		if(mParent != nullptr)
+			mParent->waitUntilComplete(this);
+	}
+
+	TaskScheduler::TaskScheduler()
+		: mNumWorkers(0), mMaxActiveTasks(BS_THREAD_HARDWARE_CONCURRENCY), mNextTaskId(0), mShutdown(false)
+		, mTaskEndCallback(nullptr)
+		, mNumQueued(0), mNumShared(0), mNumSleeping(0), mNumWaiting(0)
+	{
+		for (UINT32 i = 0; i < MAX_WORKERS; i++)
+			mWorkers[i] = nullptr;
+	}
+
+	TaskScheduler::~TaskScheduler()
+	{
+		// Workers will exit as soon as there are no more queued tasks
 		{
 			Lock lock(mReadyMutex);
-
 			mShutdown = true;
 		}
 
-		mTaskReadyCond.notify_one();
+		mTaskReadyCond.notify_all();
 
-		mTaskSchedulerThread.blockUntilComplete();
+		// Other workers might still be stealing from a workers queues, so only delete them once all are done
+		UINT32 numWorkers = mNumWorkers.load();
+		for (UINT32 i = 0; i < numWorkers; i++)
+			mWorkers[i]->thread.blockUntilComplete();
+
+		for (UINT32 i = 0; i < numWorkers; i++)
+			bs_delete(mWorkers[i]);
 	}
 
 	void TaskScheduler::addTask(const SPtr<Task>& task)
 	{
-		Lock lock(mReadyMutex);
-
 		assert(task->mState != 1 && "Task is already executing, it cannot be executed again until it finishes.");
 
 		task->mParent = this;
-		task->mTaskId = mNextTaskId++;
+		task->mTaskId = mNextTaskId.fetch_add(1);
 		task->mState.store(0); // Reset state in case the task is getting re-queued
 
-		mTaskQueue.insert(task);
+		// If the dependency hasn't finished yet, the task will get queued once it does
+		const SPtr<Task>& dependency = task->mTaskDependency;
+		if(dependency != nullptr)
+		{
+			UINT32 state;
+			{
+				ScopedSpinLock lock(dependency->mDependantsLock);
+
+				state = dependency->mState.load();
+				if(state != 2 && state != 3)
+				{
+					dependency->mDependants.push_back(task);
+					return;
+				}
+			}
+
+			// Tasks depending on a canceled task will never be able to run
+			if(state == 3)
+			{
+				finishTask(task, 3);
+				return;
+			}
+		}
 
-		// Wake main scheduler thread
-		mTaskReadyCond.notify_one();
+		queueTask(task);
+	}
+
+	void TaskScheduler::parallelFor(const String& name, UINT32 begin, UINT32 end, UINT32 grainSize,
+		const std::function<void(UINT32, UINT32)>& worker, TaskPriority priority)
+	{
+		if(begin >= end)
+			return;
+
+		grainSize = std::max(grainSize, 1U);
+
+		SPtr<TaskGroup> group = TaskGroup::create(name, priority);
+		UINT32 start = begin;
+		while((end - start) > grainSize)
+		{
+			UINT32 chunkEnd = start + grainSize;
+			group->run([&worker, start, chunkEnd]() { worker(start, chunkEnd); });
+
+			start = chunkEnd;
+		}
+
+		// Process the last chunk on this thread instead of idling
+		worker(start, end);
+		group->wait();
 	}
 
 	void TaskScheduler::addWorker()
 	{
-		Lock lock(mReadyMutex);
+		{
+			Lock lock(mReadyMutex);
 
-		mMaxActiveTasks++;
+			mMaxActiveTasks++;
 
-		// A spot freed up, queue new tasks on main scheduler thread if they exist
-		mTaskReadyCond.notify_one();
+			if(mNumQueued.load() > 0)
+				spawnWorker();
+		}
+
+		// A spot freed up, wake a worker that might have been disabled by removeWorker()
+		mTaskReadyCond.notify_all();
 	}
 
 	void TaskScheduler::removeWorker()
@@ -109,84 +281,257 @@ namespace bs
 			mMaxActiveTasks--;
 	}
 
-	void TaskScheduler::runMain()
+	void TaskScheduler::spawnWorker()
+	{
+		UINT32 numWorkers = mNumWorkers.load();
+		if(mShutdown || numWorkers >= mMaxActiveTasks.load() || numWorkers >= MAX_WORKERS)
+			return;
+
+		Worker* worker = bs_new<Worker>(this, numWorkers);
+		mWorkers[numWorkers] = worker;
+		mNumWorkers.store(numWorkers + 1);
+
+		worker->thread = ThreadPool::instance().run("TaskWorker", std::bind(&TaskScheduler::runWorker, this, worker));
+	}
+
+	void TaskScheduler::runWorker(Worker* worker)
 	{
+		Worker::current = worker;
+
 		while(true)
 		{
+			if(worker->idx < mMaxActiveTasks.load())
+			{
+				SPtr<Task> task = findTask(worker);
+				if(task != nullptr)
+				{
+					runTask(task);
+					continue;
+				}
+			}
+
 			Lock lock(mReadyMutex);
+			mNumSleeping++;
+
+			bool exit = false;
+			while(true)
+			{
+				bool isActive = worker->idx < mMaxActiveTasks.load();
+				bool hasTasks = mNumQueued.load() > 0;
+
+				if(mShutdown && (!isActive || !hasTasks))
+				{
+					exit = true;
+					break;
+				}
+
+				if(isActive && hasTasks)
+					break;
 
-			while((mTaskQueue.size() == 0 || (UINT32)mActiveTasks.size() >= mMaxActiveTasks) && !mShutdown)
 				mTaskReadyCond.wait(lock);
+			}
+
+			mNumSleeping--;
 
-			if(mShutdown)
+			if(exit)
 				break;
+		}
+
+		Worker::current = nullptr;
+	}
+
+	void TaskScheduler::queueTask(const SPtr<Task>& task)
+	{
+		Task* taskPtr = task.get();
+		taskPtr->mQueuedRef = task;
+
+		UINT32 queueIdx = getQueueIdx(task->mPriority);
 
-			for(UINT32 i = 0; (i < mTaskQueue.size()) && ((UINT32)mActiveTasks.size() < mMaxActiveTasks); i++)
+		// Count the task before it becomes visible, so that a worker never sees the counter go below zero
+		mNumQueued.fetch_add(1);
+
+		Worker* worker = Worker::current;
+		if(worker == nullptr || worker->owner != this || !worker->queues[queueIdx].push(taskPtr))
+		{
+			Lock lock(mSharedQueueMutex);
+			mSharedQueues[queueIdx].push(taskPtr);
+			mNumShared++;
+		}
+
+		if(mNumSleeping.load() > 0)
+		{
+			// Notify all since some of the sleeping workers might be disabled by removeWorker()
+			Lock lock(mReadyMutex);
+			mTaskReadyCond.notify_all();
+		}
+		else if(mNumWorkers.load() < std::min(mMaxActiveTasks.load(), (UINT32)MAX_WORKERS))
+		{
+			Lock lock(mReadyMutex);
+			spawnWorker();
+		}
+	}
+
+	SPtr<Task> TaskScheduler::findTask(Worker* worker)
+	{
+		UINT32 numWorkers = mNumWorkers.load();
+
+		for(INT32 queueIdx = NUM_PRIORITIES - 1; queueIdx >= 0; queueIdx--)
+		{
+			// Own tasks first, most recently queued ones are most likely to still be in cache
+			Task* task = worker->queues[queueIdx].pop();
+
+			// Then the tasks queued from outside of the scheduler
+			if(task == nullptr && mNumShared.load() > 0)
 			{
-				SPtr<Task> curTask = *mTaskQueue.begin();
-				mTaskQueue.erase(mTaskQueue.begin());
+				Lock lock(mSharedQueueMutex);
+
+				Queue<Task*>& sharedQueue = mSharedQueues[queueIdx];
+				if(!sharedQueue.empty())
+				{
+					task = sharedQueue.front();
+					sharedQueue.pop();
+					mNumShared--;
+				}
+			}
 
-				if(curTask->isCanceled())
-					continue;
+			// Finally try to steal from other workers, starting with the worker next to us to spread out contention
+			for(UINT32 i = 1; task == nullptr && i < numWorkers; i++)
+			{
+				Worker* victim = mWorkers[(worker->idx + i) % numWorkers];
+				task = victim->queues[queueIdx].steal();
+			}
 
-				if(curTask->mTaskDependency != nullptr && !curTask->mTaskDependency->isComplete())
-					continue;
+			if(task != nullptr)
+			{
+				mNumQueued.fetch_sub(1);
 
-				curTask->mState.store(1);
-				mActiveTasks.push_back(curTask);
+				SPtr<Task> output = std::move(task->mQueuedRef);
+				task->mQueuedRef = nullptr;
 
-				ThreadPool::instance().run(curTask->mName, std::bind(&TaskScheduler::runTask, this, curTask));
+				return output;
 			}
 		}
+
+		return nullptr;
 	}
 
-	void TaskScheduler::runTask(SPtr<Task> task)
+	void TaskScheduler::runTask(const SPtr<Task>& task)
 	{
+		if(task->isCanceled())
+		{
+			finishTask(task, 3);
+			return;
+		}
+
+		task->mState.store(1);
 		task->mTaskWorker();
 
+		void(*taskEndCallback)() = mTaskEndCallback.load();
+		if(taskEndCallback != nullptr)
+			taskEndCallback();
+
+		finishTask(task, 2);
+	}
+
+	void TaskScheduler::finishTask(const SPtr<Task>& task, UINT32 state)
+	{
+		Vector<SPtr<Task>> dependants;
 		{
-			Lock lock(mReadyMutex);
+			ScopedSpinLock lock(task->mDependantsLock);
+			task->mState.store(state);
 
-			auto findIter = std::find(mActiveTasks.begin(), mActiveTasks.end(), task);
-			if (findIter != mActiveTasks.end())
-				mActiveTasks.erase(findIter);
+			std::swap(dependants, task->mDependants);
 		}
 
+		for(auto& entry : dependants)
 		{
-			Lock lock(mCompleteMutex);
-			task->mState.store(2);
+			// Tasks depending on a canceled task will never be able to run
+			if(state == 3)
+				finishTask(entry, 3);
+			else
+				queueTask(entry);
+		}
 
-			mTaskCompleteCond.notify_all();
+		if(task->mGroup != nullptr)
+		{
+			TaskGroup* group = task->mGroup;
+			task->mGroup = nullptr;
+
+			group->mNumPending.fetch_sub(1);
 		}
 
-		// Possibly this task was someones dependency, so wake the main scheduler thread
-		mTaskReadyCond.notify_one();
+		notifyComplete();
+	}
+
+	void TaskScheduler::notifyComplete()
+	{
+		// Waiters register themselves before checking their condition, so if we don't see any here they are guaranteed
+		// to see the updated task state
+		if(mNumWaiting.load() > 0)
+		{
+			Lock lock(mCompleteMutex);
+			mTaskCompleteCond.notify_all();
+		}
 	}
 
 	void TaskScheduler::waitUntilComplete(const Task* task)
 	{
-		if(task->isCanceled())
+		waitUntil([task]() { return task->isComplete() || task->isCanceled(); });
+	}
+
+	void TaskScheduler::waitUntilComplete(const TaskGroup* group)
+	{
+		waitUntil([group]() { return group->isComplete(); });
+	}
+
+	void TaskScheduler::waitUntil(const std::function<bool()>& condition)
+	{
+		static const UINT32 NUM_IDLE_SPINS = 64;
+
+		if(condition())
 			return;
 
+		// If called from a worker, keep executing other tasks instead of blocking (the task we're waiting on might even
+		// be in our own queue)
+		Worker* worker = Worker::current;
+		if(worker != nullptr && worker->owner == this)
+		{
+			UINT32 numIdleSpins = 0;
+			while(!condition() && numIdleSpins < NUM_IDLE_SPINS)
+			{
+				SPtr<Task> task = findTask(worker);
+				if(task != nullptr)
+				{
+					runTask(task);
+					numIdleSpins = 0;
+				}
+				else
+				{
+					numIdleSpins++;
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		mNumWaiting.fetch_add(1);
 		{
 			Lock lock(mCompleteMutex);
-			
-			while(!task->isComplete())
+
+			if(!condition())
 			{
-				addWorker();
-				mTaskCompleteCond.wait(lock);
+				addWorker(); // Allow another thread to use this core while we wait
+
+				while(!condition())
+					mTaskCompleteCond.wait(lock);
+
 				removeWorker();
 			}
 		}
+		mNumWaiting.fetch_sub(1);
 	}
 
-	bool TaskScheduler::taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs)
+	UINT32 TaskScheduler::getQueueIdx(TaskPriority priority)
 	{
-		// If one tasks priority is higher, that one goes first
-		if(lhs->mPriority > rhs->mPriority)
-			return true;
-
-		// Otherwise we go by smaller id, as that task was queued earlier than the other
-		return lhs->mTaskId < rhs->mTaskId;
+		return (UINT32)priority - (UINT32)TaskPriority::VeryLow;
 	}
-}
\ No newline at end of file
+}
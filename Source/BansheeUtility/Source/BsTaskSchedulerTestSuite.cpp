@@ -0,0 +1,84 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsTaskSchedulerTestSuite.h"
+
+#include "BsTaskScheduler.h"
+#include "BsThreadPool.h"
+
+namespace bs
+{
+	TaskSchedulerTestSuite::TaskSchedulerTestSuite()
+		:mOwnsModules(false)
+	{
+		BS_ADD_TEST(TaskSchedulerTestSuite::testCanceledDependency);
+	}
+
+	void TaskSchedulerTestSuite::startUp()
+	{
+		// Use the application's scheduler if one is running
+		if (TaskScheduler::isStarted())
+			return;
+
+		ThreadPool::startUp<TThreadPool<>>(BS_THREAD_HARDWARE_CONCURRENCY);
+		TaskScheduler::startUp();
+		mOwnsModules = true;
+	}
+
+	void TaskSchedulerTestSuite::shutDown()
+	{
+		if (!mOwnsModules)
+			return;
+
+		TaskScheduler::shutDown();
+		ThreadPool::shutDown();
+		mOwnsModules = false;
+	}
+
+	void TaskSchedulerTestSuite::testCanceledDependency()
+	{
+		// Holds the tasks below in the dependency list of a running task, until the test decides to let them continue
+		std::atomic<bool> releaseGate(false);
+		SPtr<Task> gate = Task::create("TestGate", [&releaseGate]()
+		{
+			while (!releaseGate.load())
+				std::this_thread::yield();
+		});
+
+		std::atomic<UINT32> numExecuted(0);
+		auto worker = [&numExecuted]() { numExecuted.fetch_add(1); };
+
+		// Dependency canceled while its dependants are waiting on it
+		SPtr<Task> canceled = Task::create("TestCanceled", worker, TaskPriority::Normal, gate);
+		SPtr<Task> waitingDependant = Task::create("TestWaitingDependant", worker, TaskPriority::Normal, canceled);
+
+		TaskScheduler::instance().addTask(gate);
+		TaskScheduler::instance().addTask(canceled);
+		TaskScheduler::instance().addTask(waitingDependant);
+
+		canceled->cancel();
+		releaseGate.store(true);
+
+		gate->wait();
+		canceled->wait();
+		waitingDependant->wait();
+
+		BS_TEST_ASSERT(gate->isComplete());
+		BS_TEST_ASSERT(canceled->isCanceled());
+		BS_TEST_ASSERT(waitingDependant->isCanceled());
+
+		// Dependency already canceled by the time its dependant is queued. Dependants of the dependant must be canceled
+		// along with it.
+		SPtr<Task> lateDependant = Task::create("TestLateDependant", worker, TaskPriority::Normal, canceled);
+		SPtr<Task> chainedDependant = Task::create("TestChainedDependant", worker, TaskPriority::Normal, lateDependant);
+
+		TaskScheduler::instance().addTask(chainedDependant);
+		TaskScheduler::instance().addTask(lateDependant);
+
+		lateDependant->wait();
+		chainedDependant->wait();
+
+		BS_TEST_ASSERT(lateDependant->isCanceled());
+		BS_TEST_ASSERT(chainedDependant->isCanceled());
+		BS_TEST_ASSERT(numExecuted.load() == 0);
+	}
+}
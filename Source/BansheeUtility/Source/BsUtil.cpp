@@ -1,6 +1,7 @@
 //********************************** Banshee Engine (www.banshee3d.com) **************************************************//
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "BsPrerequisitesUtil.h"
+#include "BsDataStream.h"
 #include "ThirdParty/md5.h"
 
 namespace bs
@@ -38,4 +39,31 @@ namespace bs
 
 		return String(buf);
 	}
+
+	String md5(const SPtr<DataStream>& source)
+	{
+		MD5 md5;
+
+		UINT8 buffer[16 * 1024];
+		while (!source->eof())
+		{
+			size_t numRead = source->read(buffer, sizeof(buffer));
+			if (numRead == 0)
+				break;
+
+			md5.update(buffer, (UINT32)numRead);
+		}
+
+		md5.finalize();
+
+		UINT8 digest[16];
+		md5.decdigest(digest, sizeof(digest));
+
+		char buf[33];
+		for (int i = 0; i < 16; i++)
+			sprintf(buf + i * 2, "%02x", digest[i]);
+		buf[32] = 0;
+
+		return String(buf);
+	}
 }
\ No newline at end of file
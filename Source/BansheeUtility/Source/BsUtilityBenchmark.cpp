@@ -0,0 +1,33 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsSerializationTestSuite.h"
+#include "BsAllocatorBenchmarkSuite.h"
+#include "BsConsoleTestOutput.h"
+#include "BsMemStack.h"
+
+using namespace bs;
+
+/**
+ * Runs the utility benchmarks. Workload sizes can be changed through "name=value" arguments:
+ *  - objects: Number of objects in the serialized and cloned object hierarchies (default 100000).
+ *  - dataSize: Size of the data block attached to each serialized object, in bytes (default 128).
+ *  - elements: Number of elements in the serialized plain array (default 1000000).
+ *  - allocations: Number of allocations made by each allocator benchmark (default 1000000).
+ */
+int main(int argc, char* argv[])
+{
+	// Serialization uses stack allocations
+	MemStack::beginThread();
+
+	BenchmarkParams params(argc, argv);
+
+	SPtr<TestSuite> benchmarks = BenchmarkSuite::create<SerializationBenchmarkSuite>(params);
+	benchmarks->add(BenchmarkSuite::create<AllocatorBenchmarkSuite>(params));
+
+	ConsoleTestOutput testOutput;
+	benchmarks->run(testOutput);
+
+	MemStack::endThread();
+
+	return 0;
+}
@@ -1,15 +1,32 @@
 //********************************** Banshee Engine (www.banshee3d.com) **************************************************//
 //**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
 #include "BsFileSystemTestSuite.h"
+#include "BsAABBTreeTestSuite.h"
+#include "BsSlotMapTestSuite.h"
+#include "BsCompressionTestSuite.h"
+#include "BsSerializationTestSuite.h"
+#include "BsTaskSchedulerTestSuite.h"
 #include "BsConsoleTestOutput.h"
+#include "BsMemStack.h"
 
 using namespace bs;
 
 int main()
 {
+	// Serialization uses stack allocations
+	MemStack::beginThread();
+
 	SPtr<TestSuite> tests = FileSystemTestSuite::create<FileSystemTestSuite>();
+	tests->add(TestSuite::create<AABBTreeTestSuite>());
+	tests->add(TestSuite::create<SlotMapTestSuite>());
+	tests->add(TestSuite::create<CompressionTestSuite>());
+	tests->add(TestSuite::create<SerializationTestSuite>());
+	tests->add(TestSuite::create<TaskSchedulerTestSuite>());
+
 	ConsoleTestOutput testOutput;
 	tests->run(testOutput);
 
+	MemStack::endThread();
+
 	return 0;
 }
@@ -307,6 +307,7 @@ namespace BansheeEditor
                 monitor.OnAdded += OnAssetModified;
                 monitor.OnRemoved += OnAssetModified;
                 monitor.OnModified += OnAssetModified;
+                monitor.OnRenamed += OnAssetRenamed;
             }
         }
 
@@ -319,6 +320,17 @@ namespace BansheeEditor
             ProjectLibrary.Refresh(path);
         }
 
+        /// <summary>
+        /// Triggered when the folder monitor detects an asset in the monitored folder was renamed.
+        /// </summary>
+        /// <param name="from">Path to the file or folder before it was renamed.</param>
+        /// <param name="to">Path to the file or folder after it was renamed.</param>
+        private static void OnAssetRenamed(string from, string to)
+        {
+            ProjectLibrary.Refresh(from);
+            ProjectLibrary.Refresh(to);
+        }
+
         /// <summary>
         /// Called every frame by the runtime.
         /// </summary>
@@ -953,6 +965,7 @@ namespace BansheeEditor
             monitor.OnAdded += OnAssetModified;
             monitor.OnRemoved += OnAssetModified;
             monitor.OnModified += OnAssetModified;
+            monitor.OnRenamed += OnAssetRenamed;
 
             if (!string.IsNullOrWhiteSpace(ProjectSettings.LastOpenScene))
             {
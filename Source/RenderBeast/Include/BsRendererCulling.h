@@ -0,0 +1,123 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#pragma once
+
+#include "BsRenderBeastPrerequisites.h"
+#include "BsBounds.h"
+#include "BsConvexVolume.h"
+#include "BsAABBTree.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup RenderBeast
+	 *  @{
+	 */
+
+	/**
+	 * Contains a set of bounding spheres stored in structure-of-arrays form, allowing multiple spheres to be culled at
+	 * once using SIMD instructions. Larger sets are also kept in a bounding volume hierarchy, so that culling doesn't
+	 * need to visit every sphere.
+	 */
+	class CullSphereArray
+	{
+	public:
+		/** Appends a new sphere to the end of the array. */
+		void add(const Sphere& sphere);
+
+		/** Replaces the sphere at the specified index. */
+		void set(UINT32 idx, const Sphere& sphere);
+
+		/** Returns the sphere at the specified index. */
+		Sphere get(UINT32 idx) const;
+
+		/** Swaps the spheres at the two provided indices. */
+		void swap(UINT32 idxA, UINT32 idxB);
+
+		/** Removes the last sphere in the array. */
+		void removeLast();
+
+		/** Returns the number of spheres in the array. */
+		UINT32 size() const { return (UINT32)mRadius.size(); }
+
+		/**
+		 * Culls all the spheres in the array against the provided volume. For every sphere intersecting the volume the
+		 * entry in @p visibility at the same index is set to true. Other entries are left unmodified.
+		 */
+		void cull(const ConvexVolume& volume, Vector<bool>& visibility) const;
+
+	private:
+		friend class CullBoundsArray;
+
+		/** 
+		 * Appends a new sphere to the end of the array, using the provided box to represent it in the hierarchy. The box
+		 * must fully contain the sphere.
+		 */
+		void add(const Sphere& sphere, const AABox& treeBounds);
+
+		/** 
+		 * Replaces the sphere at the specified index, using the provided box to represent it in the hierarchy. The box
+		 * must fully contain the sphere.
+		 */
+		void set(UINT32 idx, const Sphere& sphere, const AABox& treeBounds);
+
+		Vector<float> mCenterX;
+		Vector<float> mCenterY;
+		Vector<float> mCenterZ;
+		Vector<float> mRadius;
+
+		AABBTree mTree;
+		Vector<UINT32> mTreeIds;
+	};
+
+	/**
+	 * Contains a set of bounds (sphere and box) along with their layers, stored in structure-of-arrays form, allowing
+	 * multiple bounds to be culled at once using SIMD instructions. Larger sets are also kept in a bounding volume
+	 * hierarchy, so that culling doesn't need to visit every entry.
+	 */
+	class CullBoundsArray
+	{
+	public:
+		/** Appends new bounds to the end of the array. */
+		void add(const Bounds& bounds, UINT64 layer);
+
+		/** Replaces the bounds at the specified index. Layer is left unmodified. */
+		void set(UINT32 idx, const Bounds& bounds);
+
+		/** Swaps the bounds at the two provided indices. */
+		void swap(UINT32 idxA, UINT32 idxB);
+
+		/** Removes the last bounds entry in the array. */
+		void removeLast();
+
+		/** Returns the number of entries in the array. */
+		UINT32 size() const { return (UINT32)mLayers.size(); }
+
+		/**
+		 * Culls all the bounds in the array against the provided volume. Bounds are first tested using their spheres, and
+		 * if they pass the test, with their boxes. For every entry that intersects the volume, and has a layer contained
+		 * in the @p layers mask, the entry in @p visibility at the same index is set to true. Other entries are left
+		 * unmodified.
+		 */
+		void cull(const ConvexVolume& volume, UINT64 layers, Vector<bool>& visibility) const;
+
+		/**
+		 * Finds all entries whose bounding spheres intersect the provided volume, ignoring their layers. Indices of the
+		 * entries are appended to @p output in increasing order.
+		 */
+		void findIntersecting(const ConvexVolume& volume, Vector<UINT32>& output) const;
+
+	private:
+		/** Spheres of all entries. Their hierarchy is built using boxes that encompass both the sphere and the box. */
+		CullSphereArray mSpheres;
+
+		Vector<float> mBoxCenterX;
+		Vector<float> mBoxCenterY;
+		Vector<float> mBoxCenterZ;
+		Vector<float> mBoxExtentX;
+		Vector<float> mBoxExtentY;
+		Vector<float> mBoxExtentZ;
+		Vector<UINT64> mLayers;
+	};
+
+	/** @} */
+}}
@@ -32,17 +32,18 @@ namespace bs
 		// Renderables
 		Vector<RendererObject*> renderables;
 		Vector<CullInfo> renderableCullInfos;
+		CullBoundsArray renderableCullBounds; // Same as renderableCullInfos, in a format suitable for batched culling
 
 		// Lights
 		Vector<RendererLight> directionalLights;
 		Vector<RendererLight> radialLights;
 		Vector<RendererLight> spotLights;
-		Vector<Sphere> radialLightWorldBounds;
-		Vector<Sphere> spotLightWorldBounds;
+		CullSphereArray radialLightWorldBounds;
+		CullSphereArray spotLightWorldBounds;
 
 		// Reflection probes
 		Vector<RendererReflectionProbe> reflProbes;
-		Vector<Sphere> reflProbeWorldBounds;
+		CullSphereArray reflProbeWorldBounds;
 
 		// Buffers for various transient data that gets rebuilt every frame
 		//// Rebuilt every frame
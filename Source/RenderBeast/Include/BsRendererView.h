@@ -9,6 +9,7 @@
 #include "BsRendererObject.h"
 #include "BsBounds.h"
 #include "BsConvexVolume.h"
+#include "BsRendererCulling.h"
 
 namespace bs { namespace ct
 {
@@ -137,6 +138,9 @@ namespace bs { namespace ct
 	struct VisibilityInfo
 	{
 		Vector<bool> renderables;
+		Vector<bool> radialLights;
+		Vector<bool> spotLights;
+		Vector<bool> reflProbes;
 	};
 
 	/** Information used for culling an object against a view. */
@@ -210,35 +214,48 @@ namespace bs { namespace ct
 		const SPtr<RenderQueue>& getTransparentQueue() const { return mTransparentQueue; }
 
 		/**
-		 * Populates view render queues by determining visible renderable objects. 
+		 * Populates view render queues by determining visible renderable objects. Per-view visibility data is also
+		 * calculated and can be retrieved by calling getVisibilityMasks().
+		 *
+		 * Only modifies data owned by the view, and can therefore be called for different views in parallel.
 		 *
 		 * @param[in]	renderables			A set of renderable objects to iterate over and determine visibility for.
 		 * @param[in]	cullInfos			A set of world bounds & other information relevant for culling the provided
 		 *									renderable objects. Must be the same size as the @p renderables array.
-		 * @param[out]	visibility			Output parameter that will have the true bit set for any visible renderable
-		 *									object. If the bit for an object is already set to true, the method will never
-		 *									change it to false which allows the same bitfield to be provided to multiple
-		 *									renderer views. Must be the same size as the @p renderables array.
-		 *									
-		 *									As a side-effect, per-view visibility data is also calculated and can be
-		 *									retrieved by calling getVisibilityMask().
+		 * @param[in]	cullBounds			Same information as @p cullInfos, in a format suitable for batched culling.
 		 */
 		void determineVisible(const Vector<RendererObject*>& renderables, const Vector<CullInfo>& cullInfos,
-			Vector<bool>* visibility = nullptr);
+			const CullBoundsArray& cullBounds);
+
+		/**
+		 * Determines which lights and reflection probes are visible by the view. Results can be retrieved by calling
+		 * getVisibilityMasks().
+		 *
+		 * Only modifies data owned by the view, and can therefore be called for different views in parallel.
+		 *
+		 * @param[in]	radialLights		World bounds of all radial lights in the scene.
+		 * @param[in]	spotLights			World bounds of all spot lights in the scene.
+		 * @param[in]	reflProbes			World bounds of all reflection probes in the scene.
+		 */
+		void determineVisibleLights(const CullSphereArray& radialLights, const CullSphereArray& spotLights,
+			const CullSphereArray& reflProbes);
 
 		/**
 		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
 		 * which entry is or isn't visible by this view. Both inputs must be arrays of the same size.
 		 */
-		void calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const;
+		void calculateVisibility(const CullBoundsArray& bounds, Vector<bool>& visibility) const;
 
 		/**
 		* Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
 		* which entry is or isn't visible by this view. Both inputs must be arrays of the same size.
 		*/
-		void calculateVisibility(const Vector<Sphere>& bounds, Vector<bool>& visibility) const;
+		void calculateVisibility(const CullSphereArray& bounds, Vector<bool>& visibility) const;
 
-		/** Returns the visibility mask calculated with the last call to determineVisible(). */
+		/** 
+		 * Returns the visibility masks calculated with the last calls to determineVisible() and
+		 * determineVisibleLights().
+		 */
 		const VisibilityInfo& getVisibilityMasks() const { return mVisibility; }
 
 		/** 
@@ -604,6 +604,7 @@ namespace bs { namespace ct
 		SPtr<VertexBuffer> mFrustumVB;
 
 		Vector<bool> mRenderableVisibility; // Transient
+		Vector<UINT32> mShadowCasters; // Transient
 		Vector<ShadowMapOptions> mSpotLightShadowOptions; // Transient
 		Vector<ShadowMapOptions> mRadialLightShadowOptions; // Transient
 	};
@@ -35,6 +35,7 @@
 #include "BsLightGrid.h"
 #include "BsSkybox.h"
 #include "BsShadowRendering.h"
+#include "BsTaskScheduler.h"
 
 using namespace std::placeholders;
 
@@ -372,12 +373,69 @@ namespace bs { namespace ct
 	{
 		const SceneInfo& sceneInfo = mScene->getSceneInfo();
 
-		// Generate render queues per camera
-		sceneInfo.renderableVisibility.resize(sceneInfo.renderables.size(), false);
-		sceneInfo.renderableVisibility.assign(sceneInfo.renderableVisibility.size(), false);
+		// Determine visibility and generate render queues for each view. Views only modify their own data, so each one
+		// is processed by a separate task.
+		auto prepareViews = [&](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+			{
+				views[i]->determineVisible(sceneInfo.renderables, sceneInfo.renderableCullInfos,
+					sceneInfo.renderableCullBounds);
+
+				views[i]->determineVisibleLights(sceneInfo.radialLightWorldBounds, sceneInfo.spotLightWorldBounds,
+					sceneInfo.reflProbeWorldBounds);
+			}
+		};
+
+		gProfilerCPU().beginSample("PrepareViews");
+		TaskScheduler::instance().parallelFor("PrepareViews", 0, numViews, 1, prepareViews);
+		gProfilerCPU().endSample("PrepareViews");
+
+		// Merge visibility of all views, in view order so the result doesn't depend on the order tasks executed in
+		UINT32 numRenderables = (UINT32)sceneInfo.renderables.size();
+		UINT32 numRadialLights = (UINT32)sceneInfo.radialLights.size();
+		UINT32 numSpotLights = (UINT32)sceneInfo.spotLights.size();
+		UINT32 numProbes = (UINT32)sceneInfo.reflProbes.size();
+
+		sceneInfo.renderableVisibility.resize(numRenderables, false);
+		sceneInfo.renderableVisibility.assign(numRenderables, false);
+
+		sceneInfo.radialLightVisibility.resize(numRadialLights, false);
+		sceneInfo.radialLightVisibility.assign(numRadialLights, false);
+
+		sceneInfo.spotLightVisibility.resize(numSpotLights, false);
+		sceneInfo.spotLightVisibility.assign(numSpotLights, false);
+
+		mReflProbeVisibilityTemp.resize(numProbes, false);
+
+		for (UINT32 i = 0; i < numViews; i++)
+		{
+			const VisibilityInfo& visibility = views[i]->getVisibilityMasks();
+
+			for (UINT32 j = 0; j < numRenderables; j++)
+			{
+				if (visibility.renderables[j])
+					sceneInfo.renderableVisibility[j] = true;
+			}
 
-		for(UINT32 i = 0; i < numViews; i++)
-			views[i]->determineVisible(sceneInfo.renderables, sceneInfo.renderableCullInfos, &sceneInfo.renderableVisibility);
+			for (UINT32 j = 0; j < numRadialLights; j++)
+			{
+				if (visibility.radialLights[j])
+					sceneInfo.radialLightVisibility[j] = true;
+			}
+
+			for (UINT32 j = 0; j < numSpotLights; j++)
+			{
+				if (visibility.spotLights[j])
+					sceneInfo.spotLightVisibility[j] = true;
+			}
+
+			for (UINT32 j = 0; j < numProbes; j++)
+			{
+				if (visibility.reflProbes[j])
+					mReflProbeVisibilityTemp[j] = true;
+			}
+		}
 
 		// Generate a list of lights and their GPU buffers
 		UINT32 numDirLights = (UINT32)sceneInfo.directionalLights.size();
@@ -387,13 +445,7 @@ namespace bs { namespace ct
 			sceneInfo.directionalLights[i].getParameters(mLightDataTemp.back());
 		}
 
-		UINT32 numRadialLights = (UINT32)sceneInfo.radialLights.size();
 		UINT32 numVisibleRadialLights = 0;
-		sceneInfo.radialLightVisibility.resize(numRadialLights, false);
-		sceneInfo.radialLightVisibility.assign(numRadialLights, false);
-		for (UINT32 i = 0; i < numViews; i++)
-			views[i]->calculateVisibility(sceneInfo.radialLightWorldBounds, sceneInfo.radialLightVisibility);
-
 		for(UINT32 i = 0; i < numRadialLights; i++)
 		{
 			if (!sceneInfo.radialLightVisibility[i])
@@ -404,13 +456,7 @@ namespace bs { namespace ct
 			numVisibleRadialLights++;
 		}
 
-		UINT32 numSpotLights = (UINT32)sceneInfo.spotLights.size();
 		UINT32 numVisibleSpotLights = 0;
-		sceneInfo.spotLightVisibility.resize(numSpotLights, false);
-		sceneInfo.spotLightVisibility.assign(numSpotLights, false);
-		for (UINT32 i = 0; i < numViews; i++)
-			views[i]->calculateVisibility(sceneInfo.spotLightWorldBounds, sceneInfo.spotLightVisibility);
-
 		for (UINT32 i = 0; i < numSpotLights; i++)
 		{
 			if (!sceneInfo.spotLightVisibility[i])
@@ -425,12 +471,6 @@ namespace bs { namespace ct
 		mLightDataTemp.clear();
 
 		// Gemerate reflection probes and their GPU buffers
-		UINT32 numProbes = (UINT32)sceneInfo.reflProbes.size();
-
-		mReflProbeVisibilityTemp.resize(numProbes, false);
-		for (UINT32 i = 0; i < numViews; i++)
-			views[i]->calculateVisibility(sceneInfo.reflProbeWorldBounds, mReflProbeVisibilityTemp);
-
 		for(UINT32 i = 0; i < numProbes; i++)
 		{
 			if (!mReflProbeVisibilityTemp[i])
@@ -455,7 +495,6 @@ namespace bs { namespace ct
 		mReflProbeVisibilityTemp.clear();
 
 		// Update various buffers required by each renderable
-		UINT32 numRenderables = (UINT32)sceneInfo.renderables.size();
 		for (UINT32 i = 0; i < numRenderables; i++)
 		{
 			if (!sceneInfo.renderableVisibility[i])
@@ -1066,9 +1105,6 @@ namespace bs { namespace ct
 
 			views[i].setView(viewDesc);
 			views[i].updatePerViewBuffer();
-
-			const SceneInfo& sceneInfo = mScene->getSceneInfo();
-			views[i].determineVisible(sceneInfo.renderables, sceneInfo.renderableCullInfos);
 		}
 
 		RendererView* viewPtrs[] = { &views[0], &views[1], &views[2], &views[3], &views[4], &views[5] };
@@ -0,0 +1,460 @@
+//********************************** Banshee Engine (www.banshee3d.com) **************************************************//
+//**************** Copyright (c) 2016 Marko Pintera (marko.pintera@gmail.com). All rights reserved. **********************//
+#include "BsRendererCulling.h"
+#include "BsMath.h"
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_IX86)
+#	define BS_CULL_SSE 1
+#	include <xmmintrin.h>
+#else
+#	define BS_CULL_SSE 0
+#endif
+
+namespace bs { namespace ct
+{
+	/** Maximum number of planes a volume used for culling can have. Frustums have six. */
+	static const UINT32 MAX_CULL_PLANES = 32;
+
+	/** 
+	 * Minimum number of entries before culling is performed by traversing the bounding volume hierarchy. Smaller sets
+	 * are faster to cull by testing every entry.
+	 */
+	static const UINT32 MIN_TREE_CULL_SIZE = 512;
+
+	/** Plane data laid out for culling, with the absolute normal pre-calculated for box tests. */
+	struct CullPlane
+	{
+		float nx, ny, nz, d;
+		float absNx, absNy, absNz;
+	};
+
+	/** Converts the planes of the provided volume into a format suitable for culling. */
+	static UINT32 getCullPlanes(const ConvexVolume& volume, CullPlane* output, UINT32 maxPlanes)
+	{
+		const Vector<Plane>& planes = volume.getPlanes();
+		UINT32 numPlanes = std::min((UINT32)planes.size(), maxPlanes);
+
+		for(UINT32 i = 0; i < numPlanes; i++)
+		{
+			const Plane& plane = planes[i];
+
+			CullPlane& cullPlane = output[i];
+			cullPlane.nx = plane.normal.x;
+			cullPlane.ny = plane.normal.y;
+			cullPlane.nz = plane.normal.z;
+			cullPlane.d = plane.d;
+			cullPlane.absNx = Math::abs(plane.normal.x);
+			cullPlane.absNy = Math::abs(plane.normal.y);
+			cullPlane.absNz = Math::abs(plane.normal.z);
+		}
+
+		return numPlanes;
+	}
+
+	/** Tests a single sphere against a set of planes. Matches ConvexVolume::intersects(const Sphere&). */
+	static bool intersectsSphere(const CullPlane* planes, UINT32 numPlanes, float x, float y, float z, float radius)
+	{
+		for(UINT32 i = 0; i < numPlanes; i++)
+		{
+			const CullPlane& plane = planes[i];
+
+			float dist = x * plane.nx + y * plane.ny + z * plane.nz - plane.d;
+			if (dist < -radius)
+				return false;
+		}
+
+		return true;
+	}
+
+	/** Tests a single box against a set of planes. Matches ConvexVolume::intersects(const AABox&). */
+	static bool intersectsBox(const CullPlane* planes, UINT32 numPlanes, float x, float y, float z, float extentX,
+		float extentY, float extentZ)
+	{
+		for(UINT32 i = 0; i < numPlanes; i++)
+		{
+			const CullPlane& plane = planes[i];
+
+			float dist = x * plane.nx + y * plane.ny + z * plane.nz - plane.d;
+			float effectiveRadius = extentX * plane.absNx + extentY * plane.absNy + extentZ * plane.absNz;
+
+			if (dist < -effectiveRadius)
+				return false;
+		}
+
+		return true;
+	}
+
+	/** Returns an axis aligned box that fully encompasses the sphere. */
+	static AABox getSphereBox(const Sphere& sphere)
+	{
+		float radius = sphere.getRadius();
+		Vector3 extents(radius, radius, radius);
+
+		return AABox(sphere.getCenter() - extents, sphere.getCenter() + extents);
+	}
+
+	/** Returns an axis aligned box that fully encompasses both the sphere and the box of the provided bounds. */
+	static AABox getBoundsBox(const Bounds& bounds)
+	{
+		AABox output = getSphereBox(bounds.getSphere());
+		output.merge(bounds.getBox());
+
+		return output;
+	}
+
+#if BS_CULL_SSE
+	/** Tests four spheres against a set of planes. Returns a 4-bit mask with a bit set for each intersecting sphere. */
+	static int intersectsSphere4(const CullPlane* planes, UINT32 numPlanes, const float* x, const float* y,
+		const float* z, const float* radius)
+	{
+		__m128 centerX = _mm_loadu_ps(x);
+		__m128 centerY = _mm_loadu_ps(y);
+		__m128 centerZ = _mm_loadu_ps(z);
+		__m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius));
+
+		__m128 inside = _mm_cmpeq_ps(centerX, centerX);
+		for(UINT32 i = 0; i < numPlanes; i++)
+		{
+			const CullPlane& plane = planes[i];
+
+			__m128 dist = _mm_mul_ps(centerX, _mm_set1_ps(plane.nx));
+			dist = _mm_add_ps(dist, _mm_mul_ps(centerY, _mm_set1_ps(plane.ny)));
+			dist = _mm_add_ps(dist, _mm_mul_ps(centerZ, _mm_set1_ps(plane.nz)));
+			dist = _mm_sub_ps(dist, _mm_set1_ps(plane.d));
+
+			inside = _mm_and_ps(inside, _mm_cmpnlt_ps(dist, negRadius));
+		}
+
+		return _mm_movemask_ps(inside);
+	}
+
+	/** Tests four boxes against a set of planes. Returns a 4-bit mask with a bit set for each intersecting box. */
+	static int intersectsBox4(const CullPlane* planes, UINT32 numPlanes, const float* x, const float* y,
+		const float* z, const float* extentX, const float* extentY, const float* extentZ)
+	{
+		__m128 centerX = _mm_loadu_ps(x);
+		__m128 centerY = _mm_loadu_ps(y);
+		__m128 centerZ = _mm_loadu_ps(z);
+		__m128 halfSizeX = _mm_loadu_ps(extentX);
+		__m128 halfSizeY = _mm_loadu_ps(extentY);
+		__m128 halfSizeZ = _mm_loadu_ps(extentZ);
+
+		__m128 inside = _mm_cmpeq_ps(centerX, centerX);
+		for(UINT32 i = 0; i < numPlanes; i++)
+		{
+			const CullPlane& plane = planes[i];
+
+			__m128 dist = _mm_mul_ps(centerX, _mm_set1_ps(plane.nx));
+			dist = _mm_add_ps(dist, _mm_mul_ps(centerY, _mm_set1_ps(plane.ny)));
+			dist = _mm_add_ps(dist, _mm_mul_ps(centerZ, _mm_set1_ps(plane.nz)));
+			dist = _mm_sub_ps(dist, _mm_set1_ps(plane.d));
+
+			__m128 radius = _mm_mul_ps(halfSizeX, _mm_set1_ps(plane.absNx));
+			radius = _mm_add_ps(radius, _mm_mul_ps(halfSizeY, _mm_set1_ps(plane.absNy)));
+			radius = _mm_add_ps(radius, _mm_mul_ps(halfSizeZ, _mm_set1_ps(plane.absNz)));
+
+			inside = _mm_and_ps(inside, _mm_cmpnlt_ps(dist, _mm_sub_ps(_mm_setzero_ps(), radius)));
+		}
+
+		return _mm_movemask_ps(inside);
+	}
+#endif
+
+	void CullSphereArray::add(const Sphere& sphere)
+	{
+		add(sphere, getSphereBox(sphere));
+	}
+
+	void CullSphereArray::add(const Sphere& sphere, const AABox& treeBounds)
+	{
+		const Vector3& center = sphere.getCenter();
+
+		mCenterX.push_back(center.x);
+		mCenterY.push_back(center.y);
+		mCenterZ.push_back(center.z);
+		mRadius.push_back(sphere.getRadius());
+
+		mTreeIds.push_back(mTree.add(treeBounds, (UINT32)mTreeIds.size()));
+	}
+
+	void CullSphereArray::set(UINT32 idx, const Sphere& sphere)
+	{
+		set(idx, sphere, getSphereBox(sphere));
+	}
+
+	void CullSphereArray::set(UINT32 idx, const Sphere& sphere, const AABox& treeBounds)
+	{
+		const Vector3& center = sphere.getCenter();
+
+		mCenterX[idx] = center.x;
+		mCenterY[idx] = center.y;
+		mCenterZ[idx] = center.z;
+		mRadius[idx] = sphere.getRadius();
+
+		mTree.update(mTreeIds[idx], treeBounds);
+	}
+
+	Sphere CullSphereArray::get(UINT32 idx) const
+	{
+		return Sphere(Vector3(mCenterX[idx], mCenterY[idx], mCenterZ[idx]), mRadius[idx]);
+	}
+
+	void CullSphereArray::swap(UINT32 idxA, UINT32 idxB)
+	{
+		std::swap(mCenterX[idxA], mCenterX[idxB]);
+		std::swap(mCenterY[idxA], mCenterY[idxB]);
+		std::swap(mCenterZ[idxA], mCenterZ[idxB]);
+		std::swap(mRadius[idxA], mRadius[idxB]);
+
+		std::swap(mTreeIds[idxA], mTreeIds[idxB]);
+		mTree.setUserData(mTreeIds[idxA], idxA);
+		mTree.setUserData(mTreeIds[idxB], idxB);
+	}
+
+	void CullSphereArray::removeLast()
+	{
+		mCenterX.pop_back();
+		mCenterY.pop_back();
+		mCenterZ.pop_back();
+		mRadius.pop_back();
+
+		mTree.remove(mTreeIds.back());
+		mTreeIds.pop_back();
+	}
+
+	void CullSphereArray::cull(const ConvexVolume& volume, Vector<bool>& visibility) const
+	{
+		CullPlane planes[MAX_CULL_PLANES];
+		UINT32 numPlanes = getCullPlanes(volume, planes, MAX_CULL_PLANES);
+
+		UINT32 count = size();
+		if (count >= MIN_TREE_CULL_SIZE)
+		{
+			mTree.query(volume, [&](UINT32 idx, bool fullyInside)
+			{
+				if (fullyInside || intersectsSphere(planes, numPlanes, mCenterX[idx], mCenterY[idx], mCenterZ[idx],
+					mRadius[idx]))
+				{
+					visibility[idx] = true;
+				}
+			});
+
+			return;
+		}
+
+		UINT32 i = 0;
+
+#if BS_CULL_SSE
+		for (; (i + 4) <= count; i += 4)
+		{
+			int mask = intersectsSphere4(planes, numPlanes, &mCenterX[i], &mCenterY[i], &mCenterZ[i], &mRadius[i]);
+			if (mask == 0)
+				continue;
+
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				if ((mask & (1 << j)) != 0)
+					visibility[i + j] = true;
+			}
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			if (intersectsSphere(planes, numPlanes, mCenterX[i], mCenterY[i], mCenterZ[i], mRadius[i]))
+				visibility[i] = true;
+		}
+	}
+
+	void CullBoundsArray::add(const Bounds& bounds, UINT64 layer)
+	{
+		mSpheres.add(bounds.getSphere(), getBoundsBox(bounds));
+
+		const AABox& box = bounds.getBox();
+		Vector3 center = box.getCenter();
+		Vector3 extents = box.getHalfSize();
+
+		mBoxCenterX.push_back(center.x);
+		mBoxCenterY.push_back(center.y);
+		mBoxCenterZ.push_back(center.z);
+		mBoxExtentX.push_back(Math::abs(extents.x));
+		mBoxExtentY.push_back(Math::abs(extents.y));
+		mBoxExtentZ.push_back(Math::abs(extents.z));
+		mLayers.push_back(layer);
+	}
+
+	void CullBoundsArray::set(UINT32 idx, const Bounds& bounds)
+	{
+		mSpheres.set(idx, bounds.getSphere(), getBoundsBox(bounds));
+
+		const AABox& box = bounds.getBox();
+		Vector3 center = box.getCenter();
+		Vector3 extents = box.getHalfSize();
+
+		mBoxCenterX[idx] = center.x;
+		mBoxCenterY[idx] = center.y;
+		mBoxCenterZ[idx] = center.z;
+		mBoxExtentX[idx] = Math::abs(extents.x);
+		mBoxExtentY[idx] = Math::abs(extents.y);
+		mBoxExtentZ[idx] = Math::abs(extents.z);
+	}
+
+	void CullBoundsArray::swap(UINT32 idxA, UINT32 idxB)
+	{
+		mSpheres.swap(idxA, idxB);
+
+		std::swap(mBoxCenterX[idxA], mBoxCenterX[idxB]);
+		std::swap(mBoxCenterY[idxA], mBoxCenterY[idxB]);
+		std::swap(mBoxCenterZ[idxA], mBoxCenterZ[idxB]);
+		std::swap(mBoxExtentX[idxA], mBoxExtentX[idxB]);
+		std::swap(mBoxExtentY[idxA], mBoxExtentY[idxB]);
+		std::swap(mBoxExtentZ[idxA], mBoxExtentZ[idxB]);
+		std::swap(mLayers[idxA], mLayers[idxB]);
+	}
+
+	void CullBoundsArray::removeLast()
+	{
+		mSpheres.removeLast();
+
+		mBoxCenterX.pop_back();
+		mBoxCenterY.pop_back();
+		mBoxCenterZ.pop_back();
+		mBoxExtentX.pop_back();
+		mBoxExtentY.pop_back();
+		mBoxExtentZ.pop_back();
+		mLayers.pop_back();
+	}
+
+	void CullBoundsArray::cull(const ConvexVolume& volume, UINT64 layers, Vector<bool>& visibility) const
+	{
+		CullPlane planes[MAX_CULL_PLANES];
+		UINT32 numPlanes = getCullPlanes(volume, planes, MAX_CULL_PLANES);
+
+		const CullSphereArray& spheres = mSpheres;
+
+		UINT32 count = size();
+		if (count >= MIN_TREE_CULL_SIZE)
+		{
+			// Bounds fully inside the volume don't need to be tested further
+			spheres.mTree.query(volume, [&](UINT32 idx, bool fullyInside)
+			{
+				if ((mLayers[idx] & layers) == 0)
+					return;
+
+				if (!fullyInside)
+				{
+					if (!intersectsSphere(planes, numPlanes, spheres.mCenterX[idx], spheres.mCenterY[idx],
+						spheres.mCenterZ[idx], spheres.mRadius[idx]))
+					{
+						return;
+					}
+
+					if (!intersectsBox(planes, numPlanes, mBoxCenterX[idx], mBoxCenterY[idx], mBoxCenterZ[idx],
+						mBoxExtentX[idx], mBoxExtentY[idx], mBoxExtentZ[idx]))
+					{
+						return;
+					}
+				}
+
+				visibility[idx] = true;
+			});
+
+			return;
+		}
+
+		UINT32 i = 0;
+
+#if BS_CULL_SSE
+		for (; (i + 4) <= count; i += 4)
+		{
+			int mask = intersectsSphere4(planes, numPlanes, &spheres.mCenterX[i], &spheres.mCenterY[i],
+				&spheres.mCenterZ[i], &spheres.mRadius[i]);
+
+			// More precise with the box
+			if (mask != 0)
+			{
+				mask &= intersectsBox4(planes, numPlanes, &mBoxCenterX[i], &mBoxCenterY[i], &mBoxCenterZ[i],
+					&mBoxExtentX[i], &mBoxExtentY[i], &mBoxExtentZ[i]);
+			}
+
+			if (mask == 0)
+				continue;
+
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				if ((mask & (1 << j)) != 0 && (mLayers[i + j] & layers) != 0)
+					visibility[i + j] = true;
+			}
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			if ((mLayers[i] & layers) == 0)
+				continue;
+
+			if (!intersectsSphere(planes, numPlanes, spheres.mCenterX[i], spheres.mCenterY[i], spheres.mCenterZ[i],
+				spheres.mRadius[i]))
+			{
+				continue;
+			}
+
+			if (intersectsBox(planes, numPlanes, mBoxCenterX[i], mBoxCenterY[i], mBoxCenterZ[i], mBoxExtentX[i],
+				mBoxExtentY[i], mBoxExtentZ[i]))
+			{
+				visibility[i] = true;
+			}
+		}
+	}
+
+	void CullBoundsArray::findIntersecting(const ConvexVolume& volume, Vector<UINT32>& output) const
+	{
+		CullPlane planes[MAX_CULL_PLANES];
+		UINT32 numPlanes = getCullPlanes(volume, planes, MAX_CULL_PLANES);
+
+		const CullSphereArray& spheres = mSpheres;
+
+		UINT32 count = size();
+		if (count >= MIN_TREE_CULL_SIZE)
+		{
+			UINT32 start = (UINT32)output.size();
+			spheres.mTree.query(volume, [&](UINT32 idx, bool fullyInside)
+			{
+				if (fullyInside || intersectsSphere(planes, numPlanes, spheres.mCenterX[idx], spheres.mCenterY[idx],
+					spheres.mCenterZ[idx], spheres.mRadius[idx]))
+				{
+					output.push_back(idx);
+				}
+			});
+
+			// Keep the output in the same order as if every entry was tested, so it can be iterated over more efficiently
+			std::sort(output.begin() + start, output.end());
+			return;
+		}
+
+		UINT32 i = 0;
+
+#if BS_CULL_SSE
+		for (; (i + 4) <= count; i += 4)
+		{
+			int mask = intersectsSphere4(planes, numPlanes, &spheres.mCenterX[i], &spheres.mCenterY[i],
+				&spheres.mCenterZ[i], &spheres.mRadius[i]);
+
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				if ((mask & (1 << j)) != 0)
+					output.push_back(i + j);
+			}
+		}
+#endif
+
+		for (; i < count; i++)
+		{
+			if (intersectsSphere(planes, numPlanes, spheres.mCenterX[i], spheres.mCenterY[i], spheres.mCenterZ[i],
+				spheres.mRadius[i]))
+			{
+				output.push_back(i);
+			}
+		}
+	}
+}}
@@ -127,7 +127,7 @@ namespace bs {	namespace ct
 				light->setRendererId(lightId);
 
 				mInfo.radialLights.push_back(RendererLight(light));
-				mInfo.radialLightWorldBounds.push_back(light->getBounds());
+				mInfo.radialLightWorldBounds.add(light->getBounds());
 			}
 			else // Spot
 			{
@@ -135,7 +135,7 @@ namespace bs {	namespace ct
 				light->setRendererId(lightId);
 
 				mInfo.spotLights.push_back(RendererLight(light));
-				mInfo.spotLightWorldBounds.push_back(light->getBounds());
+				mInfo.spotLightWorldBounds.add(light->getBounds());
 			}
 		}
 	}
@@ -145,9 +145,9 @@ namespace bs {	namespace ct
 		UINT32 lightId = light->getRendererId();
 
 		if (light->getType() == LightType::Radial)
-			mInfo.radialLightWorldBounds[lightId] = light->getBounds();
+			mInfo.radialLightWorldBounds.set(lightId, light->getBounds());
 		else if(light->getType() == LightType::Spot)
-			mInfo.spotLightWorldBounds[lightId] = light->getBounds();
+			mInfo.spotLightWorldBounds.set(lightId, light->getBounds());
 	}
 
 	void RendererScene::unregisterLight(Light* light)
@@ -179,14 +179,14 @@ namespace bs {	namespace ct
 				{
 					// Swap current last element with the one we want to erase
 					std::swap(mInfo.radialLights[lightId], mInfo.radialLights[lastLightId]);
-					std::swap(mInfo.radialLightWorldBounds[lightId], mInfo.radialLightWorldBounds[lastLightId]);
+					mInfo.radialLightWorldBounds.swap(lightId, lastLightId);
 
 					lastLight->setRendererId(lightId);
 				}
 
 				// Last element is the one we want to erase
 				mInfo.radialLights.erase(mInfo.radialLights.end() - 1);
-				mInfo.radialLightWorldBounds.erase(mInfo.radialLightWorldBounds.end() - 1);
+				mInfo.radialLightWorldBounds.removeLast();
 			}
 			else // Spot
 			{
@@ -197,14 +197,14 @@ namespace bs {	namespace ct
 				{
 					// Swap current last element with the one we want to erase
 					std::swap(mInfo.spotLights[lightId], mInfo.spotLights[lastLightId]);
-					std::swap(mInfo.spotLightWorldBounds[lightId], mInfo.spotLightWorldBounds[lastLightId]);
+					mInfo.spotLightWorldBounds.swap(lightId, lastLightId);
 
 					lastLight->setRendererId(lightId);
 				}
 
 				// Last element is the one we want to erase
 				mInfo.spotLights.erase(mInfo.spotLights.end() - 1);
-				mInfo.spotLightWorldBounds.erase(mInfo.spotLightWorldBounds.end() - 1);
+				mInfo.spotLightWorldBounds.removeLast();
 			}
 		}
 	}
@@ -217,6 +217,7 @@ namespace bs {	namespace ct
 
 		mInfo.renderables.push_back(bs_new<RendererObject>());
 		mInfo.renderableCullInfos.push_back(CullInfo(renderable->getBounds(), renderable->getLayer()));
+		mInfo.renderableCullBounds.add(renderable->getBounds(), renderable->getLayer());
 
 		RendererObject* rendererObject = mInfo.renderables.back();
 		rendererObject->renderable = renderable;
@@ -341,6 +342,7 @@ namespace bs {	namespace ct
 
 		mInfo.renderables[renderableId]->updatePerObjectBuffer();
 		mInfo.renderableCullInfos[renderableId].bounds = renderable->getBounds();
+		mInfo.renderableCullBounds.set(renderableId, renderable->getBounds());
 	}
 
 	void RendererScene::unregisterRenderable(Renderable* renderable)
@@ -374,6 +376,7 @@ namespace bs {	namespace ct
 			// Swap current last element with the one we want to erase
 			std::swap(mInfo.renderables[renderableId], mInfo.renderables[lastRenderableId]);
 			std::swap(mInfo.renderableCullInfos[renderableId], mInfo.renderableCullInfos[lastRenderableId]);
+			mInfo.renderableCullBounds.swap(renderableId, lastRenderableId);
 
 			lastRenerable->setRendererId(renderableId);
 
@@ -384,6 +387,7 @@ namespace bs {	namespace ct
 		// Last element is the one we want to erase
 		mInfo.renderables.erase(mInfo.renderables.end() - 1);
 		mInfo.renderableCullInfos.erase(mInfo.renderableCullInfos.end() - 1);
+		mInfo.renderableCullBounds.removeLast();
 
 		bs_delete(rendererObject);
 	}
@@ -396,14 +400,14 @@ namespace bs {	namespace ct
 		mInfo.reflProbes.push_back(RendererReflectionProbe(probe));
 		RendererReflectionProbe& probeInfo = mInfo.reflProbes.back();
 
-		mInfo.reflProbeWorldBounds.push_back(probe->getBounds());
+		mInfo.reflProbeWorldBounds.add(probe->getBounds());
 	}
 
 	void RendererScene::updateReflectionProbe(ReflectionProbe* probe)
 	{
 		// Should only get called if transform changes, any other mInfo.ajor changes and ReflProbeInfo entry gets rebuild
 		UINT32 probeId = probe->getRendererId();
-		mInfo.reflProbeWorldBounds[probeId] = probe->getBounds();
+		mInfo.reflProbeWorldBounds.set(probeId, probe->getBounds());
 
 		RendererReflectionProbe& probeInfo = mInfo.reflProbes[probeId];
 		probeInfo.arrayDirty = true;
@@ -423,14 +427,14 @@ namespace bs {	namespace ct
 		{
 			// Swap current last element with the one we want to erase
 			std::swap(mInfo.reflProbes[probeId], mInfo.reflProbes[lastProbeId]);
-			std::swap(mInfo.reflProbeWorldBounds[probeId], mInfo.reflProbeWorldBounds[lastProbeId]);
+			mInfo.reflProbeWorldBounds.swap(probeId, lastProbeId);
 
-			probe->setRendererId(probeId);
+			lastProbe->setRendererId(probeId);
 		}
 
 		// Last element is the one we want to erase
-		mInfo.radialLights.erase(mInfo.radialLights.end() - 1);
-		mInfo.radialLightWorldBounds.erase(mInfo.radialLightWorldBounds.end() - 1);
+		mInfo.reflProbes.erase(mInfo.reflProbes.end() - 1);
+		mInfo.reflProbeWorldBounds.removeLast();
 
 		LightProbeCache::instance().unloadCachedTexture(probe->getUUID());
 	}
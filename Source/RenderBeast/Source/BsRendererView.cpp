@@ -163,7 +163,7 @@ namespace bs { namespace ct
 	}
 
 	void RendererView::determineVisible(const Vector<RendererObject*>& renderables, const Vector<CullInfo>& cullInfos,
-		Vector<bool>* visibility)
+		const CullBoundsArray& cullBounds)
 	{
 		mVisibility.renderables.clear();
 		mVisibility.renderables.resize(renderables.size(), false);
@@ -171,7 +171,7 @@ namespace bs { namespace ct
 		if (mProperties.isOverlay)
 			return;
 
-		calculateVisibility(cullInfos, mVisibility.renderables);
+		calculateVisibility(cullBounds, mVisibility.renderables);
 
 		// Update per-object param buffers and queue render elements
 		for(UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
@@ -195,54 +195,35 @@ namespace bs { namespace ct
 			}
 		}
 
-		if(visibility != nullptr)
-		{
-			for (UINT32 i = 0; i < (UINT32)renderables.size(); i++)
-			{
-				bool visible = (*visibility)[i];
-
-				(*visibility)[i] = visible || mVisibility.renderables[i];
-			}
-		}
-
 		mOpaqueQueue->sort();
 		mTransparentQueue->sort();
 	}
 
-	void RendererView::calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const
+	void RendererView::determineVisibleLights(const CullSphereArray& radialLights, const CullSphereArray& spotLights,
+		const CullSphereArray& reflProbes)
 	{
-		UINT64 cameraLayers = mProperties.visibleLayers;
-		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
+		mVisibility.radialLights.clear();
+		mVisibility.radialLights.resize(radialLights.size(), false);
 
-		for (UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
-		{
-			if ((cullInfos[i].layer & cameraLayers) == 0)
-				continue;
+		mVisibility.spotLights.clear();
+		mVisibility.spotLights.resize(spotLights.size(), false);
 
-			// Do frustum culling
-			// Note: This is bound to be a bottleneck at some point. When it is ensure that intersect methods use vector
-			// operations, as it is trivial to update them. Also consider spatial partitioning.
-			const Sphere& boundingSphere = cullInfos[i].bounds.getSphere();
-			if (worldFrustum.intersects(boundingSphere))
-			{
-				// More precise with the box
-				const AABox& boundingBox = cullInfos[i].bounds.getBox();
+		mVisibility.reflProbes.clear();
+		mVisibility.reflProbes.resize(reflProbes.size(), false);
 
-				if (worldFrustum.intersects(boundingBox))
-					visibility[i] = true;
-			}
-		}
+		calculateVisibility(radialLights, mVisibility.radialLights);
+		calculateVisibility(spotLights, mVisibility.spotLights);
+		calculateVisibility(reflProbes, mVisibility.reflProbes);
 	}
 
-	void RendererView::calculateVisibility(const Vector<Sphere>& bounds, Vector<bool>& visibility) const
+	void RendererView::calculateVisibility(const CullBoundsArray& bounds, Vector<bool>& visibility) const
 	{
-		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
+		bounds.cull(mProperties.cullFrustum, mProperties.visibleLayers, visibility);
+	}
 
-		for (UINT32 i = 0; i < (UINT32)bounds.size(); i++)
-		{
-			if (worldFrustum.intersects(bounds[i]))
-				visibility[i] = true;
-		}
+	void RendererView::calculateVisibility(const CullSphereArray& bounds, Vector<bool>& visibility) const
+	{
+		bounds.cull(mProperties.cullFrustum, visibility);
 	}
 
 	Vector2 RendererView::getDeviceZToViewZ(const Matrix4& projMatrix)
@@ -995,11 +995,11 @@ namespace bs { namespace ct
 
 			mDepthDirectionalMat.bind(shadowParamsBuffer);
 
-			for (UINT32 j = 0; j < sceneInfo.renderables.size(); j++)
-			{
-				if (!cascadeCullVolume.intersects(sceneInfo.renderableCullInfos[j].bounds.getSphere()))
-					continue;
+			mShadowCasters.clear();
+			sceneInfo.renderableCullBounds.findIntersecting(cascadeCullVolume, mShadowCasters);
 
+			for (UINT32 j : mShadowCasters)
+			{
 				scene.prepareRenderable(j, frameInfo);
 
 				RendererObject* renderable = sceneInfo.renderables[j];
@@ -1099,11 +1099,12 @@ namespace bs { namespace ct
 		}
 
 		ConvexVolume worldFrustum(worldPlanes);
-		for (UINT32 i = 0; i < sceneInfo.renderables.size(); i++)
-		{
-			if (!worldFrustum.intersects(sceneInfo.renderableCullInfos[i].bounds.getSphere()))
-				continue;
 
+		mShadowCasters.clear();
+		sceneInfo.renderableCullBounds.findIntersecting(worldFrustum, mShadowCasters);
+
+		for (UINT32 i : mShadowCasters)
+		{
 			scene.prepareRenderable(i, frameInfo);
 
 			RendererObject* renderable = sceneInfo.renderables[i];
@@ -1253,12 +1254,13 @@ namespace bs { namespace ct
 
 		// First cull against a global volume
 		ConvexVolume boundingVolume(boundingPlanes);
-		for (UINT32 i = 0; i < sceneInfo.renderables.size(); i++)
+
+		mShadowCasters.clear();
+		sceneInfo.renderableCullBounds.findIntersecting(boundingVolume, mShadowCasters);
+
+		for (UINT32 i : mShadowCasters)
 		{
 			const Sphere& bounds = sceneInfo.renderableCullInfos[i].bounds.getSphere();
-			if (!boundingVolume.intersects(bounds))
-				continue;
-
 			scene.prepareRenderable(i, frameInfo);
 
 			for(UINT32 j = 0; j < 6; j++)